@@ -24,6 +24,11 @@
     list(APPEND OPENMP_SOURCES ${OPENMP_SOURCES_DIR}/fix_rigid_nh_omp.cpp)
   endif()
 
+  if(PKG_KSPACE)
+    list(APPEND OPENMP_SOURCES ${OPENMP_SOURCES_DIR}/verlet_kspace_omp.cpp)
+    RegisterIntegrateStyle(${OPENMP_SOURCES_DIR}/verlet_kspace_omp.h)
+  endif()
+
   if(PKG_REAXFF)
     list(APPEND OPENMP_SOURCES ${OPENMP_SOURCES_DIR}/reaxff_bond_orders_omp.cpp
                                  ${OPENMP_SOURCES_DIR}/reaxff_hydrogen_bonds_omp.cpp
@@ -135,7 +135,7 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
       if (written > 0) {
         writer.write(vbuffer, written);
       } else if (written < 0) {
-        error->one(FLERR, "Error while writing dump atom/gz output");
+        write_error(FLERR, "Error while writing dump atom/gz output");
       }
 
       m += size_one;
@@ -145,15 +145,12 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpAtomGZ::write()
+void DumpAtomGZ::write_finish()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
@@ -141,7 +141,7 @@ void DumpAtomZstd::write_data(int n, double *mybuf)
       if (written > 0) {
         writer.write(vbuffer, written);
       } else if (written < 0) {
-        error->one(FLERR, "Error while writing dump atom/gz output");
+        write_error(FLERR, "Error while writing dump atom/gz output");
       }
 
       m += size_one;
@@ -151,15 +151,12 @@ void DumpAtomZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpAtomZstd::write()
+void DumpAtomZstd::write_finish()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
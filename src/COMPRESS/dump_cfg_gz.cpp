@@ -145,7 +145,7 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
           if (written > 0) {
             writer.write(vbuffer, written);
           } else if (written < 0) {
-            error->one(FLERR, "Error while writing dump cfg/gz output");
+            write_error(FLERR, "Error while writing dump cfg/gz output");
           }
           m++;
         }
@@ -176,7 +176,7 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
           if (written > 0) {
             writer.write(vbuffer, written);
           } else if (written < 0) {
-            error->one(FLERR, "Error while writing dump cfg/gz output");
+            write_error(FLERR, "Error while writing dump cfg/gz output");
           }
           m++;
         }
@@ -188,15 +188,12 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCFGGZ::write()
+void DumpCFGGZ::write_finish()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
@@ -153,7 +153,7 @@ void DumpCFGZstd::write_data(int n, double *mybuf)
           if (written > 0) {
             writer.write(vbuffer, written);
           } else if (written < 0) {
-            error->one(FLERR, "Error while writing dump cfg/gz output");
+            write_error(FLERR, "Error while writing dump cfg/gz output");
           }
           m++;
         }
@@ -184,7 +184,7 @@ void DumpCFGZstd::write_data(int n, double *mybuf)
           if (written > 0) {
             writer.write(vbuffer, written);
           } else if (written < 0) {
-            error->one(FLERR, "Error while writing dump cfg/gz output");
+            write_error(FLERR, "Error while writing dump cfg/gz output");
           }
           m++;
         }
@@ -196,15 +196,12 @@ void DumpCFGZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCFGZstd::write()
+void DumpCFGZstd::write_finish()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
@@ -40,7 +40,7 @@ class DumpCFGZstd : public DumpCFG {
   void openfile() override;
   void write_header(bigint) override;
   void write_data(int, double *) override;
-  void write() override;
+  void write_finish() override;
 
   int modify_param(int, char **) override;
 };
@@ -21,12 +21,15 @@
 #include "dump_custom_zstd.h"
 
 #include "file_writer.h"
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
+#include "memory.h"
 #include "update.h"
 
 #include <cstring>
 
+static constexpr int MINFRAME = 1048576;    // min # of chars compressed into one frame
 
 using namespace LAMMPS_NS;
 
@@ -98,6 +101,8 @@ void DumpCustomZstd::write_header(bigint ndump)
   std::string header;
 
   if ((multiproc) || (!multiproc && me == 0)) {
+    writer.startSnapshot(update->ntimestep);
+
     if (unit_flag && !unit_count) {
       ++unit_count;
       header = fmt::format("ITEM: UNITS\n{}\n",update->unit_style);
@@ -126,12 +131,43 @@ void DumpCustomZstd::write_header(bigint ndump)
   }
 }
 
+/* ----------------------------------------------------------------------
+   convert mybuf of doubles to one big formatted string in sbuf
+   for seekable files, each proc compresses its string into independent
+     frames in sbuf, so the filewriter proc only has to write them
+   return -1 if strlen exceeds an int, since used as arg in MPI calls in Dump
+------------------------------------------------------------------------- */
+
+int DumpCustomZstd::convert_string(int n, double *mybuf)
+{
+  int nchars = DumpCustom::convert_string(n, mybuf);
+  if (!writer.isSeekable() || (nchars <= 0)) return nchars;
+
+  // use one frame per thread, unless the frames would become too small
+
+  const int nchunk = MAX(MIN(comm->nthreads, nchars / MINFRAME), 1);
+  try {
+    writer.compressFrames(sbuf, nchars, frames, nchunk);
+  } catch (FileWriterException &e) {
+    error->one(FLERR, e.what());
+  }
+
+  if (frames.size() >= MAXSMALLINT) return -1;
+  if ((int) frames.size() > maxsbuf) {
+    maxsbuf = frames.size();
+    memory->grow(sbuf,maxsbuf,"dump:sbuf");
+  }
+  memcpy(sbuf, frames.data(), frames.size());
+  return frames.size();
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpCustomZstd::write_data(int n, double *mybuf)
 {
   if (buffer_flag == 1) {
-    writer.write(mybuf, n);
+    if (writer.isSeekable()) writer.writeFrames(mybuf, n);
+    else writer.write(mybuf, n);
   } else {
     constexpr size_t VBUFFER_SIZE = 256;
     char vbuffer[VBUFFER_SIZE];
@@ -152,7 +188,7 @@ void DumpCustomZstd::write_data(int n, double *mybuf)
         if (written > 0) {
           writer.write(vbuffer, written);
         } else if (written < 0) {
-          error->one(FLERR, "Error while writing dump custom/gz output");
+          write_error(FLERR, "Error while writing dump custom/gz output");
         }
         m++;
       }
@@ -163,16 +199,13 @@ void DumpCustomZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCustomZstd::write()
+void DumpCustomZstd::write_finish()
 {
-  DumpCustom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) {
-        writer.flush();
-      }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) {
+      writer.flush();
     }
   }
 }
@@ -192,6 +225,10 @@ int DumpCustomZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "seekable") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setSeekable(utils::logical(FLERR, arg[1], false, lmp) == 1);
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR,"Illegal dump_modify command: {}", e.what());
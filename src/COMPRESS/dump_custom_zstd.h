@@ -37,11 +37,13 @@ class DumpCustomZstd : public DumpCustom {
 
  protected:
   ZstdFileWriter writer;
+  std::vector<char> frames;    // compressed frames of this proc for seekable files
 
   void openfile() override;
   void write_header(bigint) override;
+  int convert_string(int, double *) override;
   void write_data(int, double *) override;
-  void write() override;
+  void write_finish() override;
 
   int modify_param(int, char **) override;
 };
@@ -134,7 +134,7 @@ void DumpLocalGZ::write_data(int n, double *mybuf)
         if (written > 0) {
           writer.write(vbuffer, written);
         } else if (written < 0) {
-          error->one(FLERR, "Error while writing dump local/gz output");
+          write_error(FLERR, "Error while writing dump local/gz output");
         }
         m++;
       }
@@ -145,15 +145,12 @@ void DumpLocalGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpLocalGZ::write()
+void DumpLocalGZ::write_finish()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
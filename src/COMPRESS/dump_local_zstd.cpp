@@ -142,7 +142,7 @@ void DumpLocalZstd::write_data(int n, double *mybuf)
         if (written > 0) {
           writer.write(vbuffer, written);
         } else if (written < 0) {
-          error->one(FLERR, "Error while writing dump local/gz output");
+          write_error(FLERR, "Error while writing dump local/gz output");
         }
         m++;
       }
@@ -153,15 +153,12 @@ void DumpLocalZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpLocalZstd::write()
+void DumpLocalZstd::write_finish()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
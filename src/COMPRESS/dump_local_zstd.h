@@ -41,7 +41,7 @@ class DumpLocalZstd : public DumpLocal {
   void openfile() override;
   void write_header(bigint) override;
   void write_data(int, double *) override;
-  void write() override;
+  void write_finish() override;
 
   int modify_param(int, char **) override;
 };
@@ -105,7 +105,7 @@ void DumpXYZGZ::write_data(int n, double *mybuf)
       if (written > 0) {
         writer.write(vbuffer, written);
       } else if (written < 0) {
-        error->one(FLERR, "Error while writing dump xyz/gz output");
+        write_error(FLERR, "Error while writing dump xyz/gz output");
       }
       m += size_one;
     }
@@ -114,15 +114,12 @@ void DumpXYZGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpXYZGZ::write()
+void DumpXYZGZ::write_finish()
 {
-  DumpXYZ::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
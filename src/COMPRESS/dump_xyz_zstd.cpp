@@ -113,7 +113,7 @@ void DumpXYZZstd::write_data(int n, double *mybuf)
       if (written > 0) {
         writer.write(vbuffer, written);
       } else if (written < 0) {
-        error->one(FLERR, "Error while writing dump xyz/gz output");
+        write_error(FLERR, "Error while writing dump xyz/gz output");
       }
       m += size_one;
     }
@@ -122,15 +122,12 @@ void DumpXYZZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpXYZZstd::write()
+void DumpXYZZstd::write_finish()
 {
-  DumpXYZ::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
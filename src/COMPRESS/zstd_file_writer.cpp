@@ -19,12 +19,24 @@
 
 #include "zstd_file_writer.h"
 #include "fmt/format.h"
+#include <algorithm>
 #include <cstdio>
 
 using namespace LAMMPS_NS;
 
+// the snapshot index of a seekable file is a zstd skippable frame with pairs of
+//   timestep and file offset of the first frame of each snapshot as int64_t,
+//   followed by the # of snapshots as int64_t and a magic string
+// zstd decompressors ignore skippable frames, so the file remains a valid zstd file
+// must match the definitions in reader.cpp
+
+static constexpr unsigned int INDEX_FRAME_MAGIC = 0x184D2A5D;
+static constexpr char INDEX_MAGIC[] = "LMPZSTIX";
+static constexpr int INDEX_MAGIC_SIZE = 8;
+
 ZstdFileWriter::ZstdFileWriter() :
-    compression_level(0), checksum_flag(1), cctx(nullptr), fp(nullptr)
+    compression_level(0), checksum_flag(1), seekable_flag(0), cctx(nullptr), fp(nullptr),
+    frame_open(false), nbytes(0)
 {
   out_buffer_size = ZSTD_CStreamOutSize();
   out_buffer = new char[out_buffer_size];
@@ -55,6 +67,15 @@ void ZstdFileWriter::open(const std::string &path, bool append)
 
   if (!fp) { throw FileWriterException(fmt::format("Could not open file '{}'", path)); }
 
+  if (append && seekable_flag) {
+    fclose(fp);
+    fp = nullptr;
+    throw FileWriterException("Cannot append to a seekable file");
+  }
+  frame_open = false;
+  nbytes = 0;
+  index.clear();
+
   cctx = ZSTD_createCCtx();
 
   if (!cctx) {
@@ -79,8 +100,9 @@ size_t ZstdFileWriter::write(const void *buffer, size_t length)
   do {
     ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
     ZSTD_compressStream2(cctx, &output, &input, mode);
-    fwrite(out_buffer, sizeof(char), output.pos, fp);
+    nbytes += fwrite(out_buffer, sizeof(char), output.pos, fp);
   } while (input.pos < input.size);
+  if (length > 0) frame_open = true;
 
   return length;
 }
@@ -98,7 +120,7 @@ void ZstdFileWriter::flush()
   do {
     ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
     remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
-    fwrite(out_buffer, sizeof(char), output.pos, fp);
+    nbytes += fwrite(out_buffer, sizeof(char), output.pos, fp);
   } while (remaining);
 
   fflush(fp);
@@ -110,6 +132,35 @@ void ZstdFileWriter::close()
 {
   if (!ZstdFileWriter::isopen()) return;
 
+  if (seekable_flag) {
+    end_frame();
+    write_index();
+  } else {
+    size_t remaining;
+    ZSTD_inBuffer input = {nullptr, 0, 0};
+    ZSTD_EndDirective mode = ZSTD_e_end;
+
+    do {
+      ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
+      remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+      fwrite(out_buffer, sizeof(char), output.pos, fp);
+    } while (remaining);
+  }
+
+  ZSTD_freeCCtx(cctx);
+  cctx = nullptr;
+  fclose(fp);
+  fp = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   end the frame data is currently streamed to, if any
+------------------------------------------------------------------------- */
+
+void ZstdFileWriter::end_frame()
+{
+  if (!frame_open) return;
+
   size_t remaining;
   ZSTD_inBuffer input = {nullptr, 0, 0};
   ZSTD_EndDirective mode = ZSTD_e_end;
@@ -117,13 +168,103 @@ void ZstdFileWriter::close()
   do {
     ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
     remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
-    fwrite(out_buffer, sizeof(char), output.pos, fp);
+    nbytes += fwrite(out_buffer, sizeof(char), output.pos, fp);
   } while (remaining);
 
-  ZSTD_freeCCtx(cctx);
-  cctx = nullptr;
-  fclose(fp);
-  fp = nullptr;
+  frame_open = false;
+}
+
+/* ----------------------------------------------------------------------
+   append snapshot index as skippable frame and footer to the file
+------------------------------------------------------------------------- */
+
+void ZstdFileWriter::write_index()
+{
+  const int64_t nsnapshot = index.size() / 2;
+  const unsigned int magic = INDEX_FRAME_MAGIC;
+  const unsigned int size = index.size() * sizeof(int64_t) + sizeof(int64_t) + INDEX_MAGIC_SIZE;
+
+  fwrite(&magic, sizeof(unsigned int), 1, fp);
+  fwrite(&size, sizeof(unsigned int), 1, fp);
+  fwrite(index.data(), sizeof(int64_t), index.size(), fp);
+  fwrite(&nsnapshot, sizeof(int64_t), 1, fp);
+  fwrite(INDEX_MAGIC, sizeof(char), INDEX_MAGIC_SIZE, fp);
+  index.clear();
+}
+
+/* ----------------------------------------------------------------------
+   begin a new snapshot in a seekable file
+   ends the current frame and records timestep and offset in the index
+------------------------------------------------------------------------- */
+
+void ZstdFileWriter::startSnapshot(bigint ntimestep)
+{
+  if (!isopen() || !seekable_flag) return;
+
+  end_frame();
+  index.push_back(ntimestep);
+  index.push_back(nbytes);
+}
+
+/* ----------------------------------------------------------------------
+   write data that has already been compressed into complete frames
+------------------------------------------------------------------------- */
+
+size_t ZstdFileWriter::writeFrames(const void *buffer, size_t length)
+{
+  if (!isopen()) return 0;
+
+  end_frame();
+  nbytes += fwrite(buffer, sizeof(char), length, fp);
+  return length;
+}
+
+/* ----------------------------------------------------------------------
+   compress text into nchunk independent frames, split at line boundaries
+   frames are compressed in parallel by multiple threads, if available
+   does not require an open file, so it can be called on any MPI rank
+   return total size of the frames
+------------------------------------------------------------------------- */
+
+size_t ZstdFileWriter::compressFrames(const char *text, size_t length, std::vector<char> &frames,
+                                      int nchunk) const
+{
+  nchunk = std::max(nchunk, 1);
+  std::vector<size_t> start(nchunk + 1, length);
+  start[0] = 0;
+  for (int i = 1; i < nchunk; ++i) {
+    size_t pos = std::max(length / nchunk * i, start[i - 1]);
+    while ((pos > 0) && (pos < length) && (text[pos - 1] != '\n')) ++pos;
+    start[i] = pos;
+  }
+
+  std::vector<std::vector<char>> chunks(nchunk);
+  std::vector<size_t> status(nchunk, 0);
+
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) num_threads(nchunk) schedule(static, 1)
+#endif
+  for (int i = 0; i < nchunk; ++i) {
+    const size_t size = start[i + 1] - start[i];
+    if (size == 0) continue;
+
+    ZSTD_CCtx *ctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, compression_level);
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_checksumFlag, checksum_flag);
+    chunks[i].resize(ZSTD_compressBound(size));
+    status[i] = ZSTD_compress2(ctx, chunks[i].data(), chunks[i].size(), text + start[i], size);
+    ZSTD_freeCCtx(ctx);
+    if (!ZSTD_isError(status[i])) chunks[i].resize(status[i]);
+  }
+
+  frames.clear();
+  for (int i = 0; i < nchunk; ++i) {
+    if (ZSTD_isError(status[i]))
+      throw FileWriterException(
+          fmt::format("Zstd compression failed: {}", ZSTD_getErrorName(status[i])));
+    frames.insert(frames.end(), chunks[i].begin(), chunks[i].end());
+  }
+  return frames.size();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -158,4 +299,19 @@ void ZstdFileWriter::setChecksum(bool enabled)
   checksum_flag = enabled ? 1 : 0;
 }
 
+/* ---------------------------------------------------------------------- */
+
+void ZstdFileWriter::setSeekable(bool enabled)
+{
+  if (isopen()) throw FileWriterException("Seekable flag can not be changed while file is open");
+  seekable_flag = enabled ? 1 : 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool ZstdFileWriter::isSeekable() const
+{
+  return seekable_flag != 0;
+}
+
 #endif
@@ -21,8 +21,10 @@
 #define LMP_ZSTD_FILE_WRITER_H
 
 #include "file_writer.h"
+#include "lmptype.h"
 
 #include <string>
+#include <vector>
 #include <zstd.h>
 
 #if ZSTD_VERSION_NUMBER < 10400
@@ -34,12 +36,20 @@ namespace LAMMPS_NS {
 class ZstdFileWriter : public FileWriter {
   int compression_level;
   int checksum_flag;
+  int seekable_flag;
 
   ZSTD_CCtx *cctx;
   FILE *fp;
   char *out_buffer;
   size_t out_buffer_size;
 
+  bool frame_open;                 // true if data was streamed to a frame not yet ended
+  bigint nbytes;                   // # of bytes written to file
+  std::vector<int64_t> index;      // pairs of timestep and file offset of each snapshot
+
+  void end_frame();
+  void write_index();
+
  public:
   ZstdFileWriter();
   ~ZstdFileWriter() override;
@@ -51,6 +61,13 @@ class ZstdFileWriter : public FileWriter {
 
   void setCompressionLevel(int level);
   void setChecksum(bool enabled);
+
+  void setSeekable(bool enabled);
+  bool isSeekable() const;
+  void startSnapshot(bigint ntimestep);
+  size_t writeFrames(const void *buffer, size_t length);
+  size_t compressFrames(const char *text, size_t length, std::vector<char> &frames,
+                        int nchunk) const;
 };
 }    // namespace LAMMPS_NS
 
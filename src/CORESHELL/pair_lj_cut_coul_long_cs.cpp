@@ -44,6 +44,7 @@ PairLJCutCoulLongCS::PairLJCutCoulLongCS(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
   ewaldflag = pppmflag = 1;
   respa_enable = 0;  // TODO: r-RESPA handling is inconsistent and thus disabled until fixed
   single_enable = 0; // TODO: single function does not match compute
+  mixed_prec_enable = 0;
   writedata = 1;
   ftable = nullptr;
   qdist = 0.0;
@@ -40,6 +40,7 @@ PairCoulLongDielectric::PairCoulLongDielectric(LAMMPS *_lmp) : PairCoulLong(_lmp
 {
   nmax = 0;
   single_enable = 0;
+  overlap_enable = 0;
   no_virial_fdotr_compute = 1;
 }
 
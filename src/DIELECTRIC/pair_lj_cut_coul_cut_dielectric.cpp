@@ -40,6 +40,8 @@ PairLJCutCoulCutDielectric::PairLJCutCoulCutDielectric(LAMMPS *_lmp) : PairLJCut
   efield = nullptr;
   epot = nullptr;
   nmax = 0;
+  overlap_enable = 0;
+  mixed_prec_enable = 0;
   no_virial_fdotr_compute = 1;
 }
 
@@ -41,6 +41,8 @@ static constexpr double EPSILON = 1.0e-6;
 PairLJCutCoulLongDielectric::PairLJCutCoulLongDielectric(LAMMPS *_lmp) : PairLJCutCoulLong(_lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
+  mixed_prec_enable = 0;
   cut_respa = nullptr;
   efield = nullptr;
   epot = nullptr;
@@ -61,6 +61,7 @@ PPPMKokkos<DeviceType>::PPPMKokkos(LAMMPS *lmp) : PPPM(lmp)
 
   group_group_enable = 0;
   triclinic_support = 1;
+  realfft_support = 0;
 
   peratom_allocate_flag = 0;
 
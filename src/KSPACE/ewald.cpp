@@ -36,13 +36,15 @@ using namespace LAMMPS_NS;
 using namespace MathConst;
 
 static constexpr double SMALL = 0.00001;
+static constexpr int BLOCK = 64;    // atoms per block of structure factor and force loops
 
 /* ---------------------------------------------------------------------- */
 
 Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   kxvecs(nullptr), kyvecs(nullptr), kzvecs(nullptr), ug(nullptr), eg(nullptr), vg(nullptr),
   ek(nullptr), sfacrl(nullptr), sfacim(nullptr), sfacrl_all(nullptr), sfacim_all(nullptr),
-  cs(nullptr), sn(nullptr), sfacrl_A(nullptr), sfacim_A(nullptr), sfacrl_A_all(nullptr),
+  cs(nullptr), sn(nullptr), sfacrl_frozen(nullptr), sfacim_frozen(nullptr), csblock(nullptr),
+  snblock(nullptr), qblock(nullptr), sfacrl_A(nullptr), sfacim_A(nullptr), sfacrl_A_all(nullptr),
   sfacim_A_all(nullptr), sfacrl_B(nullptr), sfacim_B(nullptr), sfacrl_B_all(nullptr),
   sfacim_B_all(nullptr)
 {
@@ -50,6 +52,7 @@ Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   kmax_created = 0;
   ewaldflag = 1;
   group_group_enable = 1;
+  frozen_support = 1;
 
   accuracy_relative = 0.0;
 
@@ -64,6 +67,10 @@ Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   cs = sn = nullptr;
 
   kcount = 0;
+
+  frozen_valid = 0;
+  kmax_frozen = 0;
+  natoms_frozen = -1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -89,6 +96,11 @@ Ewald::~Ewald()
   memory->destroy(ek);
   memory->destroy3d_offset(cs,-kmax_created);
   memory->destroy3d_offset(sn,-kmax_created);
+  delete[] sfacrl_frozen;
+  delete[] sfacim_frozen;
+  memory->destroy3d_offset(csblock,-kmax_frozen);
+  memory->destroy3d_offset(snblock,-kmax_frozen);
+  memory->destroy(qblock);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -198,6 +210,7 @@ void Ewald::init()
                         kcount,kmax,kmax3d);
     mesg += fmt::format("                  kxmax kymax kzmax  = {} {} {}\n",
                         kxmax,kymax,kzmax);
+    if (frozen_groupbit) mesg += "  reusing structure factor of frozen group\n";
     utils::logmesg(lmp,mesg);
   }
 }
@@ -327,11 +340,14 @@ void Ewald::setup()
   }
 
   // pre-compute Ewald coefficients
+  // K-vectors may have changed, so frozen structure factor must be redone
 
   if (triclinic == 0)
     coeffs();
   else
     coeffs_triclinic();
+
+  frozen_valid = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -396,14 +412,14 @@ void Ewald::compute(int eflag, int vflag)
   MPI_Allreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world);
 
   // K-space portion of electric field
-  // double loop over K-vectors and local atoms
+  // double loop over K-vectors and local atoms, blocked over atoms
   // perform per-atom calculations if needed
 
   double **f = atom->f;
   double *q = atom->q;
   int nlocal = atom->nlocal;
 
-  int kx,ky,kz;
+  int kx,ky,kz,ifrom,ito;
   double cypz,sypz,exprl,expim,partial,partial_peratom;
 
   for (i = 0; i < nlocal; i++) {
@@ -412,27 +428,30 @@ void Ewald::compute(int eflag, int vflag)
     ek[i][2] = 0.0;
   }
 
-  for (k = 0; k < kcount; k++) {
-    kx = kxvecs[k];
-    ky = kyvecs[k];
-    kz = kzvecs[k];
+  for (ifrom = 0; ifrom < nlocal; ifrom += BLOCK) {
+    ito = MIN(ifrom+BLOCK,nlocal);
+    for (k = 0; k < kcount; k++) {
+      kx = kxvecs[k];
+      ky = kyvecs[k];
+      kz = kzvecs[k];
 
-    for (i = 0; i < nlocal; i++) {
-      cypz = cs[ky][1][i]*cs[kz][2][i] - sn[ky][1][i]*sn[kz][2][i];
-      sypz = sn[ky][1][i]*cs[kz][2][i] + cs[ky][1][i]*sn[kz][2][i];
-      exprl = cs[kx][0][i]*cypz - sn[kx][0][i]*sypz;
-      expim = sn[kx][0][i]*cypz + cs[kx][0][i]*sypz;
-      partial = expim*sfacrl_all[k] - exprl*sfacim_all[k];
-      ek[i][0] += partial*eg[k][0];
-      ek[i][1] += partial*eg[k][1];
-      ek[i][2] += partial*eg[k][2];
-
-      if (evflag_atom) {
-        partial_peratom = exprl*sfacrl_all[k] + expim*sfacim_all[k];
-        if (eflag_atom) eatom[i] += q[i]*ug[k]*partial_peratom;
-        if (vflag_atom)
-          for (j = 0; j < 6; j++)
-            vatom[i][j] += ug[k]*vg[k][j]*partial_peratom;
+      for (i = ifrom; i < ito; i++) {
+        cypz = cs[ky][1][i]*cs[kz][2][i] - sn[ky][1][i]*sn[kz][2][i];
+        sypz = sn[ky][1][i]*cs[kz][2][i] + cs[ky][1][i]*sn[kz][2][i];
+        exprl = cs[kx][0][i]*cypz - sn[kx][0][i]*sypz;
+        expim = sn[kx][0][i]*cypz + cs[kx][0][i]*sypz;
+        partial = expim*sfacrl_all[k] - exprl*sfacim_all[k];
+        ek[i][0] += partial*eg[k][0];
+        ek[i][1] += partial*eg[k][1];
+        ek[i][2] += partial*eg[k][2];
+
+        if (evflag_atom) {
+          partial_peratom = exprl*sfacrl_all[k] + expim*sfacim_all[k];
+          if (eflag_atom) eatom[i] += q[i]*ug[k]*partial_peratom;
+          if (vflag_atom)
+            for (j = 0; j < 6; j++)
+              vatom[i][j] += ug[k]*vg[k][j]*partial_peratom;
+        }
       }
     }
   }
@@ -492,60 +511,101 @@ void Ewald::compute(int eflag, int vflag)
   if (slabflag == 1) slabcorr();
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   partial structure factors of my atoms
+   cs/sn tables and structure factor sums are computed one block of atoms
+     at a time, so the table rows of a block stay in cache for all K-vectors
+   sums continue from the previous block, so the result is the same as
+     for a single pass over all atoms
+------------------------------------------------------------------------- */
 
 void Ewald::eik_dot_r()
 {
-  int i,k,l,m,n,ic;
-  double cstr1,sstr1,cstr2,sstr2,cstr3,sstr3,cstr4,sstr4;
-  double sqk,clpm,slpm;
+  int ifrom,ito,n,ic,m;
+  const int nlocal = atom->nlocal;
 
-  double **x = atom->x;
-  double *q = atom->q;
-  int nlocal = atom->nlocal;
+  for (ic = 0; ic < 3; ic++) {
+    kbuilt[ic] = -1;
+    for (m = 1; m <= kmax; m++)
+      if (m*unitk[ic] * m*unitk[ic] <= gsqmx) kbuilt[ic] = m;
+  }
 
-  n = 0;
+  for (n = 0; n < kcount; n++) {
+    sfacrl[n] = 0.0;
+    sfacim[n] = 0.0;
+  }
+  if (frozen_groupbit) frozen_begin();
 
-  // (k,0,0), (0,l,0), (0,0,m)
+  for (ifrom = 0; ifrom < nlocal; ifrom += BLOCK) {
+    ito = MIN(ifrom+BLOCK,nlocal);
+    eik_block(ifrom,ito);
+    if (frozen_groupbit) sfac_gather(ifrom,ito);
+    else sfac_block(cs,sn,atom->q,ifrom,ito,sfacrl,sfacim);
+  }
+
+  if (frozen_groupbit) frozen_end();
+}
+
+/* ----------------------------------------------------------------------
+   cs/sn tables of atoms ifrom to ito-1
+------------------------------------------------------------------------- */
+
+void Ewald::eik_block(int ifrom, int ito)
+{
+  int i,m,ic;
+  double **x = atom->x;
 
   for (ic = 0; ic < 3; ic++) {
-    sqk = unitk[ic]*unitk[ic];
-    if (sqk <= gsqmx) {
-      cstr1 = 0.0;
-      sstr1 = 0.0;
-      for (i = 0; i < nlocal; i++) {
-        cs[0][ic][i] = 1.0;
-        sn[0][ic][i] = 0.0;
-        cs[1][ic][i] = cos(unitk[ic]*x[i][ic]);
-        sn[1][ic][i] = sin(unitk[ic]*x[i][ic]);
-        cs[-1][ic][i] = cs[1][ic][i];
-        sn[-1][ic][i] = -sn[1][ic][i];
-        cstr1 += q[i]*cs[1][ic][i];
-        sstr1 += q[i]*sn[1][ic][i];
+    if (kbuilt[ic] < 1) continue;
+    for (i = ifrom; i < ito; i++) {
+      cs[0][ic][i] = 1.0;
+      sn[0][ic][i] = 0.0;
+      cs[1][ic][i] = cos(unitk[ic]*x[i][ic]);
+      sn[1][ic][i] = sin(unitk[ic]*x[i][ic]);
+      cs[-1][ic][i] = cs[1][ic][i];
+      sn[-1][ic][i] = -sn[1][ic][i];
+    }
+    for (m = 2; m <= kbuilt[ic]; m++) {
+      for (i = ifrom; i < ito; i++) {
+        cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
+          sn[m-1][ic][i]*sn[1][ic][i];
+        sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
+          cs[m-1][ic][i]*sn[1][ic][i];
+        cs[-m][ic][i] = cs[m][ic][i];
+        sn[-m][ic][i] = -sn[m][ic][i];
       }
-      sfacrl[n] = cstr1;
-      sfacim[n++] = sstr1;
     }
   }
+}
+
+/* ----------------------------------------------------------------------
+   add charges qq of atoms ifrom to ito-1 with tables c/s
+     to structure factors srl/sim
+------------------------------------------------------------------------- */
+
+void Ewald::sfac_block(double ***c, double ***s, const double *qq, int ifrom, int ito,
+                       double *srl, double *sim)
+{
+  int i,k,l,m,n,ic;
+  double cstr1,sstr1,cstr2,sstr2,cstr3,sstr3,cstr4,sstr4;
+  double sqk,clpm,slpm;
+
+  n = 0;
+
+  // (k,0,0), (0,l,0), (0,0,m)
 
-  for (m = 2; m <= kmax; m++) {
+  for (m = 1; m <= kmax; m++) {
     for (ic = 0; ic < 3; ic++) {
       sqk = m*unitk[ic] * m*unitk[ic];
       if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
-            sn[m-1][ic][i]*sn[1][ic][i];
-          sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
-            cs[m-1][ic][i]*sn[1][ic][i];
-          cs[-m][ic][i] = cs[m][ic][i];
-          sn[-m][ic][i] = -sn[m][ic][i];
-          cstr1 += q[i]*cs[m][ic][i];
-          sstr1 += q[i]*sn[m][ic][i];
+        cstr1 = srl[n];
+        sstr1 = sim[n];
+        for (i = ifrom; i < ito; i++) {
+          cstr1 += qq[i]*c[m][ic][i];
+          sstr1 += qq[i]*s[m][ic][i];
         }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
+        srl[n] = cstr1;
+        sim[n++] = sstr1;
       }
     }
   }
@@ -556,20 +616,20 @@ void Ewald::eik_dot_r()
     for (l = 1; l <= kymax; l++) {
       sqk = (k*unitk[0] * k*unitk[0]) + (l*unitk[1] * l*unitk[1]);
       if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        cstr2 = 0.0;
-        sstr2 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cstr1 += q[i]*(cs[k][0][i]*cs[l][1][i] - sn[k][0][i]*sn[l][1][i]);
-          sstr1 += q[i]*(sn[k][0][i]*cs[l][1][i] + cs[k][0][i]*sn[l][1][i]);
-          cstr2 += q[i]*(cs[k][0][i]*cs[l][1][i] + sn[k][0][i]*sn[l][1][i]);
-          sstr2 += q[i]*(sn[k][0][i]*cs[l][1][i] - cs[k][0][i]*sn[l][1][i]);
+        cstr1 = srl[n];
+        sstr1 = sim[n];
+        cstr2 = srl[n+1];
+        sstr2 = sim[n+1];
+        for (i = ifrom; i < ito; i++) {
+          cstr1 += qq[i]*(c[k][0][i]*c[l][1][i] - s[k][0][i]*s[l][1][i]);
+          sstr1 += qq[i]*(s[k][0][i]*c[l][1][i] + c[k][0][i]*s[l][1][i]);
+          cstr2 += qq[i]*(c[k][0][i]*c[l][1][i] + s[k][0][i]*s[l][1][i]);
+          sstr2 += qq[i]*(s[k][0][i]*c[l][1][i] - c[k][0][i]*s[l][1][i]);
         }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
-        sfacrl[n] = cstr2;
-        sfacim[n++] = sstr2;
+        srl[n] = cstr1;
+        sim[n++] = sstr1;
+        srl[n] = cstr2;
+        sim[n++] = sstr2;
       }
     }
   }
@@ -580,20 +640,20 @@ void Ewald::eik_dot_r()
     for (m = 1; m <= kzmax; m++) {
       sqk = (l*unitk[1] * l*unitk[1]) + (m*unitk[2] * m*unitk[2]);
       if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        cstr2 = 0.0;
-        sstr2 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cstr1 += q[i]*(cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i]);
-          sstr1 += q[i]*(sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i]);
-          cstr2 += q[i]*(cs[l][1][i]*cs[m][2][i] + sn[l][1][i]*sn[m][2][i]);
-          sstr2 += q[i]*(sn[l][1][i]*cs[m][2][i] - cs[l][1][i]*sn[m][2][i]);
+        cstr1 = srl[n];
+        sstr1 = sim[n];
+        cstr2 = srl[n+1];
+        sstr2 = sim[n+1];
+        for (i = ifrom; i < ito; i++) {
+          cstr1 += qq[i]*(c[l][1][i]*c[m][2][i] - s[l][1][i]*s[m][2][i]);
+          sstr1 += qq[i]*(s[l][1][i]*c[m][2][i] + c[l][1][i]*s[m][2][i]);
+          cstr2 += qq[i]*(c[l][1][i]*c[m][2][i] + s[l][1][i]*s[m][2][i]);
+          sstr2 += qq[i]*(s[l][1][i]*c[m][2][i] - c[l][1][i]*s[m][2][i]);
         }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
-        sfacrl[n] = cstr2;
-        sfacim[n++] = sstr2;
+        srl[n] = cstr1;
+        sim[n++] = sstr1;
+        srl[n] = cstr2;
+        sim[n++] = sstr2;
       }
     }
   }
@@ -604,20 +664,20 @@ void Ewald::eik_dot_r()
     for (m = 1; m <= kzmax; m++) {
       sqk = (k*unitk[0] * k*unitk[0]) + (m*unitk[2] * m*unitk[2]);
       if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        cstr2 = 0.0;
-        sstr2 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cstr1 += q[i]*(cs[k][0][i]*cs[m][2][i] - sn[k][0][i]*sn[m][2][i]);
-          sstr1 += q[i]*(sn[k][0][i]*cs[m][2][i] + cs[k][0][i]*sn[m][2][i]);
-          cstr2 += q[i]*(cs[k][0][i]*cs[m][2][i] + sn[k][0][i]*sn[m][2][i]);
-          sstr2 += q[i]*(sn[k][0][i]*cs[m][2][i] - cs[k][0][i]*sn[m][2][i]);
+        cstr1 = srl[n];
+        sstr1 = sim[n];
+        cstr2 = srl[n+1];
+        sstr2 = sim[n+1];
+        for (i = ifrom; i < ito; i++) {
+          cstr1 += qq[i]*(c[k][0][i]*c[m][2][i] - s[k][0][i]*s[m][2][i]);
+          sstr1 += qq[i]*(s[k][0][i]*c[m][2][i] + c[k][0][i]*s[m][2][i]);
+          cstr2 += qq[i]*(c[k][0][i]*c[m][2][i] + s[k][0][i]*s[m][2][i]);
+          sstr2 += qq[i]*(s[k][0][i]*c[m][2][i] - c[k][0][i]*s[m][2][i]);
         }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
-        sfacrl[n] = cstr2;
-        sfacim[n++] = sstr2;
+        srl[n] = cstr1;
+        sim[n++] = sstr1;
+        srl[n] = cstr2;
+        sim[n++] = sstr2;
       }
     }
   }
@@ -630,68 +690,177 @@ void Ewald::eik_dot_r()
         sqk = (k*unitk[0] * k*unitk[0]) + (l*unitk[1] * l*unitk[1]) +
           (m*unitk[2] * m*unitk[2]);
         if (sqk <= gsqmx) {
-          cstr1 = 0.0;
-          sstr1 = 0.0;
-          cstr2 = 0.0;
-          sstr2 = 0.0;
-          cstr3 = 0.0;
-          sstr3 = 0.0;
-          cstr4 = 0.0;
-          sstr4 = 0.0;
-          for (i = 0; i < nlocal; i++) {
-            clpm = cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i];
-            slpm = sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i];
-            cstr1 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr1 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
-
-            clpm = cs[l][1][i]*cs[m][2][i] + sn[l][1][i]*sn[m][2][i];
-            slpm = -sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i];
-            cstr2 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr2 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
-
-            clpm = cs[l][1][i]*cs[m][2][i] + sn[l][1][i]*sn[m][2][i];
-            slpm = sn[l][1][i]*cs[m][2][i] - cs[l][1][i]*sn[m][2][i];
-            cstr3 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr3 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
-
-            clpm = cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i];
-            slpm = -sn[l][1][i]*cs[m][2][i] - cs[l][1][i]*sn[m][2][i];
-            cstr4 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr4 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
+          cstr1 = srl[n];
+          sstr1 = sim[n];
+          cstr2 = srl[n+1];
+          sstr2 = sim[n+1];
+          cstr3 = srl[n+2];
+          sstr3 = sim[n+2];
+          cstr4 = srl[n+3];
+          sstr4 = sim[n+3];
+          for (i = ifrom; i < ito; i++) {
+            clpm = c[l][1][i]*c[m][2][i] - s[l][1][i]*s[m][2][i];
+            slpm = s[l][1][i]*c[m][2][i] + c[l][1][i]*s[m][2][i];
+            cstr1 += qq[i]*(c[k][0][i]*clpm - s[k][0][i]*slpm);
+            sstr1 += qq[i]*(s[k][0][i]*clpm + c[k][0][i]*slpm);
+
+            clpm = c[l][1][i]*c[m][2][i] + s[l][1][i]*s[m][2][i];
+            slpm = -s[l][1][i]*c[m][2][i] + c[l][1][i]*s[m][2][i];
+            cstr2 += qq[i]*(c[k][0][i]*clpm - s[k][0][i]*slpm);
+            sstr2 += qq[i]*(s[k][0][i]*clpm + c[k][0][i]*slpm);
+
+            clpm = c[l][1][i]*c[m][2][i] + s[l][1][i]*s[m][2][i];
+            slpm = s[l][1][i]*c[m][2][i] - c[l][1][i]*s[m][2][i];
+            cstr3 += qq[i]*(c[k][0][i]*clpm - s[k][0][i]*slpm);
+            sstr3 += qq[i]*(s[k][0][i]*clpm + c[k][0][i]*slpm);
+
+            clpm = c[l][1][i]*c[m][2][i] - s[l][1][i]*s[m][2][i];
+            slpm = -s[l][1][i]*c[m][2][i] - c[l][1][i]*s[m][2][i];
+            cstr4 += qq[i]*(c[k][0][i]*clpm - s[k][0][i]*slpm);
+            sstr4 += qq[i]*(s[k][0][i]*clpm + c[k][0][i]*slpm);
           }
-          sfacrl[n] = cstr1;
-          sfacim[n++] = sstr1;
-          sfacrl[n] = cstr2;
-          sfacim[n++] = sstr2;
-          sfacrl[n] = cstr3;
-          sfacim[n++] = sstr3;
-          sfacrl[n] = cstr4;
-          sfacim[n++] = sstr4;
+          srl[n] = cstr1;
+          sim[n++] = sstr1;
+          srl[n] = cstr2;
+          sim[n++] = sstr2;
+          srl[n] = cstr3;
+          sim[n++] = sstr3;
+          srl[n] = cstr4;
+          sim[n++] = sstr4;
         }
       }
     }
   }
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   structure factors of atoms ifrom to ito-1 when a frozen group is set
+   mobile atoms are added to sfacrl/sfacim,
+     frozen atoms to sfacrl_frozen/sfacim_frozen only if they are stale
+   atoms are gathered into contiguous block tables first
+------------------------------------------------------------------------- */
+
+void Ewald::sfac_gather(int ifrom, int ito)
+{
+  int i,m,ic,nb,frozen;
+  const int *mask = atom->mask;
+  const double *q = atom->q;
+
+  for (frozen = 0; frozen < 2; frozen++) {
+    if (frozen && frozen_valid) break;
+
+    nb = 0;
+    for (i = ifrom; i < ito; i++) {
+      if (((mask[i] & frozen_groupbit) ? 1 : 0) != frozen) continue;
+      for (ic = 0; ic < 3; ic++) {
+        for (m = (triclinic ? -kbuilt[ic] : 0); m <= kbuilt[ic]; m++) {
+          csblock[m][ic][nb] = cs[m][ic][i];
+          snblock[m][ic][nb] = sn[m][ic][i];
+        }
+      }
+      qblock[nb++] = q[i];
+    }
+    if (nb == 0) continue;
+
+    double *srl = frozen ? sfacrl_frozen : sfacrl;
+    double *sim = frozen ? sfacim_frozen : sfacim;
+    if (triclinic) sfac_block_triclinic(csblock,snblock,qblock,0,nb,srl,sim);
+    else sfac_block(csblock,snblock,qblock,0,nb,srl,sim);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   prepare reuse of the structure factor of the frozen group
+   it stays valid until the K-vectors change in setup() or atoms are lost,
+     since atoms that do not move contribute a constant amount
+     no matter which processor owns them
+------------------------------------------------------------------------- */
+
+void Ewald::frozen_begin()
+{
+  if (kmax_frozen != kmax) {
+    delete[] sfacrl_frozen;
+    delete[] sfacim_frozen;
+    memory->destroy3d_offset(csblock,-kmax_frozen);
+    memory->destroy3d_offset(snblock,-kmax_frozen);
+    memory->destroy(qblock);
+    sfacrl_frozen = new double[kmax3d];
+    sfacim_frozen = new double[kmax3d];
+    memory->create3d_offset(csblock,-kmax,kmax,3,BLOCK,"ewald:csblock");
+    memory->create3d_offset(snblock,-kmax,kmax,3,BLOCK,"ewald:snblock");
+    memory->create(qblock,BLOCK,"ewald:qblock");
+    kmax_frozen = kmax;
+    frozen_valid = 0;
+  }
+
+  if (atom->natoms != natoms_frozen) frozen_valid = 0;
+
+  if (!frozen_valid) {
+    for (int n = 0; n < kcount; n++) {
+      sfacrl_frozen[n] = 0.0;
+      sfacim_frozen[n] = 0.0;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add structure factor of frozen group to that of the mobile atoms
+------------------------------------------------------------------------- */
+
+void Ewald::frozen_end()
+{
+  for (int n = 0; n < kcount; n++) {
+    sfacrl[n] += sfacrl_frozen[n];
+    sfacim[n] += sfacim_frozen[n];
+  }
+
+  frozen_valid = 1;
+  natoms_frozen = atom->natoms;
+}
+
+/* ----------------------------------------------------------------------
+   partial structure factors of my atoms for triclinic boxes
+   blocked the same way as eik_dot_r()
+------------------------------------------------------------------------- */
 
 void Ewald::eik_dot_r_triclinic()
 {
-  int i,k,l,m,n,ic;
-  double cstr1,sstr1;
-  double sqk,clpm,slpm;
+  int ifrom,ito,n;
+  const int nlocal = atom->nlocal;
+
+  kbuilt[0] = MAX(1,kxmax);
+  kbuilt[1] = MAX(1,kymax);
+  kbuilt[2] = MAX(1,kzmax);
+
+  for (n = 0; n < kcount; n++) {
+    sfacrl[n] = 0.0;
+    sfacim[n] = 0.0;
+  }
+  if (frozen_groupbit) frozen_begin();
+
+  for (ifrom = 0; ifrom < nlocal; ifrom += BLOCK) {
+    ito = MIN(ifrom+BLOCK,nlocal);
+    eik_block_triclinic(ifrom,ito);
+    if (frozen_groupbit) sfac_gather(ifrom,ito);
+    else sfac_block_triclinic(cs,sn,atom->q,ifrom,ito,sfacrl,sfacim);
+  }
+
+  if (frozen_groupbit) frozen_end();
+}
+
+/* ----------------------------------------------------------------------
+   cs/sn tables of atoms ifrom to ito-1 for triclinic boxes
+------------------------------------------------------------------------- */
+
+void Ewald::eik_block_triclinic(int ifrom, int ito)
+{
+  int i,m,ic;
+  double sqk;
 
   double **x = atom->x;
-  double *q = atom->q;
-  int nlocal = atom->nlocal;
 
   double unitk_lamda[3];
 
-  double max_kvecs[3];
-  max_kvecs[0] = kxmax;
-  max_kvecs[1] = kymax;
-  max_kvecs[2] = kzmax;
-
   // (k,0,0), (0,l,0), (0,0,m)
 
   for (ic = 0; ic < 3; ic++) {
@@ -702,7 +871,7 @@ void Ewald::eik_dot_r_triclinic()
     x2lamdaT(&unitk_lamda[0],&unitk_lamda[0]);
     sqk = unitk_lamda[ic]*unitk_lamda[ic];
     if (sqk <= gsqmx) {
-      for (i = 0; i < nlocal; i++) {
+      for (i = ifrom; i < ito; i++) {
         cs[0][ic][i] = 1.0;
         sn[0][ic][i] = 0.0;
         cs[1][ic][i] = cos(unitk_lamda[0]*x[i][0] + unitk_lamda[1]*x[i][1] + unitk_lamda[2]*x[i][2]);
@@ -714,14 +883,8 @@ void Ewald::eik_dot_r_triclinic()
   }
 
   for (ic = 0; ic < 3; ic++) {
-    for (m = 2; m <= max_kvecs[ic]; m++) {
-      unitk_lamda[0] = 0.0;
-      unitk_lamda[1] = 0.0;
-      unitk_lamda[2] = 0.0;
-      unitk_lamda[ic] = 2.0*MY_PI*m;
-      x2lamdaT(&unitk_lamda[0],&unitk_lamda[0]);
-      sqk = unitk_lamda[ic]*unitk_lamda[ic];
-      for (i = 0; i < nlocal; i++) {
+    for (m = 2; m <= kbuilt[ic]; m++) {
+      for (i = ifrom; i < ito; i++) {
         cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
           sn[m-1][ic][i]*sn[1][ic][i];
         sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
@@ -731,21 +894,34 @@ void Ewald::eik_dot_r_triclinic()
       }
     }
   }
+}
+
+/* ----------------------------------------------------------------------
+   add charges qq of atoms ifrom to ito-1 with tables c/s
+     to structure factors srl/sim for triclinic boxes
+------------------------------------------------------------------------- */
+
+void Ewald::sfac_block_triclinic(double ***c, double ***s, const double *qq, int ifrom,
+                                 int ito, double *srl, double *sim)
+{
+  int i,k,l,m,n;
+  double cstr1,sstr1;
+  double clpm,slpm;
 
   for (n = 0; n < kcount; n++) {
     k = kxvecs[n];
     l = kyvecs[n];
     m = kzvecs[n];
-    cstr1 = 0.0;
-    sstr1 = 0.0;
-    for (i = 0; i < nlocal; i++) {
-      clpm = cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i];
-      slpm = sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i];
-      cstr1 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-      sstr1 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
+    cstr1 = srl[n];
+    sstr1 = sim[n];
+    for (i = ifrom; i < ito; i++) {
+      clpm = c[l][1][i]*c[m][2][i] - s[l][1][i]*s[m][2][i];
+      slpm = s[l][1][i]*c[m][2][i] + c[l][1][i]*s[m][2][i];
+      cstr1 += qq[i]*(c[k][0][i]*clpm - s[k][0][i]*slpm);
+      sstr1 += qq[i]*(s[k][0][i]*clpm + c[k][0][i]*slpm);
     }
-    sfacrl[n] = cstr1;
-    sfacim[n] = sstr1;
+    srl[n] = cstr1;
+    sim[n] = sstr1;
   }
 }
 
@@ -1238,6 +1414,11 @@ double Ewald::memory_usage()
   bytes += (double)4 * kmax3d * sizeof(double);
   bytes += (double)nmax*3 * sizeof(double);
   bytes += (double)2 * (2*kmax+1)*3*nmax * sizeof(double);
+  if (kmax_frozen) {
+    bytes += (double)2 * kmax3d * sizeof(double);
+    bytes += (double)2 * (2*kmax_frozen+1)*3*BLOCK * sizeof(double);
+    bytes += (double)BLOCK * sizeof(double);
+  }
   return bytes;
 }
 
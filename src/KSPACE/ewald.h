@@ -51,6 +51,15 @@ class Ewald : public KSpace {
   double *sfacrl, *sfacim, *sfacrl_all, *sfacim_all;
   double ***cs, ***sn;
 
+  // structure factor of frozen group, reused while it stays valid
+
+  int frozen_valid, kmax_frozen;
+  bigint natoms_frozen;
+  int kbuilt[3];                     // highest row of cs/sn filled per dimension
+  double *sfacrl_frozen, *sfacim_frozen;
+  double ***csblock, ***snblock;     // cs/sn of atoms gathered from one block
+  double *qblock;
+
   // group-group interactions
 
   int group_allocate_flag;
@@ -59,6 +68,11 @@ class Ewald : public KSpace {
 
   double rms(int, double, bigint, double);
   virtual void eik_dot_r();
+  void eik_block(int, int);
+  void sfac_block(double ***, double ***, const double *, int, int, double *, double *);
+  void sfac_gather(int, int);
+  void frozen_begin();
+  void frozen_end();
   virtual void coeffs();
   virtual void allocate();
   virtual void deallocate();
@@ -68,6 +82,9 @@ class Ewald : public KSpace {
 
   int triclinic;
   void eik_dot_r_triclinic();
+  void eik_block_triclinic(int, int);
+  void sfac_block_triclinic(double ***, double ***, const double *, int, int, double *,
+                            double *);
   void coeffs_triclinic();
 
   // group-group interactions
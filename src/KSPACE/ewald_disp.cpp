@@ -91,13 +91,17 @@ static inline void shape_scalar_mult(double *dest, double f) {                //
 
 EwaldDisp::EwaldDisp(LAMMPS *lmp) : KSpace(lmp),
   kenergy(nullptr), kvirial(nullptr), energy_self_peratom(nullptr), virial_self_peratom(nullptr),
-  ekr_local(nullptr), hvec(nullptr), kvec(nullptr), B(nullptr), cek_local(nullptr), cek_global(nullptr)
+  ekr_local(nullptr), hvec(nullptr), kvec(nullptr), B(nullptr), cek_local(nullptr), cek_global(nullptr),
+  cek_frozen(nullptr)
 {
   ewaldflag = dispersionflag = dipoleflag = 1;
+  frozen_support = 1;
 
   memset(function, 0, EWALD_NFUNCS*sizeof(int));
   kenergy = kvirial = nullptr;
-  cek_local = cek_global = nullptr;
+  cek_local = cek_global = cek_frozen = nullptr;
+  frozen_valid = 0;
+  natoms_frozen = -1;
   ekr_local = nullptr;
   hvec = nullptr;
   kvec = nullptr;
@@ -339,6 +343,7 @@ void EwaldDisp::setup()
   init_coeffs();
   init_coeff_sums();
   init_self();
+  frozen_valid = 0;
 
   if (!(first_output||comm->me)) {
     first_output = 1;
@@ -419,6 +424,8 @@ void EwaldDisp::reallocate()
     bytes += (double)(nkvec-nkvec_max)*nsums*sizeof(complex);
     cek_global = new complex[nkvec*nsums];                // cek_global
     bytes += (double)(nkvec-nkvec_max)*nsums*sizeof(complex);
+    cek_frozen = new complex[nkvec*nsums];                // cek_frozen
+    bytes += (double)(nkvec-nkvec_max)*nsums*sizeof(complex);
     nkvec_max = nkvec;
   }
 
@@ -490,6 +497,7 @@ void EwaldDisp::deallocate()                                // free memory
   delete [] kvirial;                kvirial = nullptr;
   delete [] cek_local;                cek_local = nullptr;
   delete [] cek_global;                cek_global = nullptr;
+  delete [] cek_frozen;                cek_frozen = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -770,25 +778,35 @@ void EwaldDisp::compute(int eflag, int vflag)
 }
 
 
+/* ----------------------------------------------------------------------
+   e^(ik.r) tables are built in place in ekr_local, one atom at a time
+   atoms of a frozen group are left out of the sums once their
+     contribution is known, it is kept in cek_frozen until the
+     K-vectors change in setup() or atoms are lost
+------------------------------------------------------------------------- */
+
 void EwaldDisp::compute_ek()
 {
   cvector *ekr = ekr_local;
-  int lbytes = (2*nbox+1)*sizeof(cvector);
   hvector *h = nullptr;
   kvector *k, *nk = kvec+nkvec;
-  auto z = new cvector[2*nbox+1];
-  cvector z1, *zx, *zy, *zz, *zn = z+2*nbox;
+  cvector *z, z1, *zx, *zy, *zz, *zn;
   complex *cek, zxyz, zxy = COMPLEX_NULL, cx = COMPLEX_NULL;
   double mui[3];
   double *x = atom->x[0], *xn = x+3*atom->nlocal, *q = atom->q, qi = 0.0;
   double bi = 0.0, ci[7];
   double *mu = atom->mu ? atom->mu[0] : nullptr;
   int i, kx, ky, n = nkvec*nsums, *type = atom->type, tri = domain->triclinic;
+  int *mask = atom->mask, frozen;
   int func[EWALD_NFUNCS];
 
   memcpy(func, function, EWALD_NFUNCS*sizeof(int));
   memset(cek_local, 0, n*sizeof(complex));                // reset sums
+  if (frozen_groupbit && atom->natoms != natoms_frozen) frozen_valid = 0;
+  if (frozen_groupbit && !frozen_valid) memset(cek_frozen, 0, n*sizeof(complex));
   while (x<xn) {
+    z = ekr;
+    zn = z+2*nbox;
     zx = (zy = (zz = z+nbox)+1)-2;
     C_SET(zz->x, 1, 0); C_SET(zz->y, 1, 0); C_SET(zz->z, 1, 0);        // z[0]
     if (tri) {                                                // triclinic z[1]
@@ -807,7 +825,8 @@ void EwaldDisp::compute_ek()
       C_RMULT(zy->z, zz->z, z1.z); C_CONJ(zx->z, zy->z);
     }
     kx = ky = -1;
-    cek = cek_local;
+    frozen = frozen_groupbit && (*(mask++) & frozen_groupbit);
+    cek = frozen ? cek_frozen : cek_local;
     if (func[0]) qi = *(q++);
     if (func[1]) bi = B[*type];
     if (func[2]) memcpy(ci, B+7*type[0], 7*sizeof(double));
@@ -816,6 +835,8 @@ void EwaldDisp::compute_ek()
       mu += 4;
       h = hvec;
     }
+    if (frozen && frozen_valid) nk = kvec;                 // skip rho(k)
+    else nk = kvec+nkvec;
     for (k=kvec; k<nk; ++k) {                                // compute rho(k)
       if (ky!=k->y) {                                   // based on order in
         if (kx!=k->x) cx = z[kx = k->x].x;                // reallocate
@@ -836,12 +857,17 @@ void EwaldDisp::compute_ek()
         cek->re += zxyz.re*muk; (cek++)->im += zxyz.im*muk;
       }
     }
-    ekr = (cvector *) ((char *) memcpy(ekr, z, lbytes)+lbytes);
+    ekr += 2*nbox+1;
     ++type;
   }
+  if (frozen_groupbit) {
+    for (i=0; i<n; ++i) {
+      cek_local[i].re += cek_frozen[i].re; cek_local[i].im += cek_frozen[i].im;
+    }
+    frozen_valid = 1;
+    natoms_frozen = atom->natoms;
+  }
   MPI_Allreduce(cek_local, cek_global, 2*n, MPI_DOUBLE, MPI_SUM, world);
-
-  delete [] z;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -65,6 +65,9 @@ class EwaldDisp : public KSpace {
     double x, x2;
   } sum[EWALD_MAX_NSUMS];
   struct complex *cek_local, *cek_global;
+  struct complex *cek_frozen;    // sums of frozen group, reused while frozen_valid
+  int frozen_valid;
+  bigint natoms_frozen;
 
   double rms(int, double, bigint, double, double, double);
   void reallocate();
@@ -22,10 +22,12 @@
 
 #include "fft3d.h"
 
+#include "math_const.h"
 #include "remap.h"
 
 #include <cstdlib>
 #include <cmath>
+#include <cstring>
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -39,6 +41,12 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static void fft_3d_clear_real(struct fft_plan_3d *);
+static void fft_1d_mid(FFT_DATA *, int, struct fft_plan_3d *);
+static void fft_1d_slow(FFT_DATA *, int, struct fft_plan_3d *);
+static void fft_1d_r2c(FFT_SCALAR *, FFT_DATA *, struct fft_plan_3d *);
+static void fft_1d_c2r(FFT_DATA *, FFT_SCALAR *, struct fft_plan_3d *);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d FFTs:
 
@@ -240,6 +248,10 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
                           2 = permute twice = slow->fast, fast->mid, mid->slow
    nbuf                 returns size of internal storage buffers used by FFT
    usecollective        use collective MPI operations for remapping data
+                          0 = point-to-point, 1 = collective, 2 = node-aware collective
+   precision            precision of data sent in remaps, 1 = single, 2 = double
+   npgrid1,npgrid2      2d proc grid of pencil decompositions between 1d FFTs
+                          0,0 = choose grid as close to square as possible
 ------------------------------------------------------------------------- */
 
 struct fft_plan_3d *fft_3d_create_plan(
@@ -248,7 +260,8 @@ struct fft_plan_3d *fft_3d_create_plan(
        int in_klo, int in_khi,
        int out_ilo, int out_ihi, int out_jlo, int out_jhi,
        int out_klo, int out_khi,
-       int scaled, int permute, int *nbuf, int usecollective)
+       int scaled, int permute, int *nbuf, int usecollective, int precision,
+       int npgrid1, int npgrid2)
 {
   struct fft_plan_3d *plan;
   int me,nprocs,nthreads;
@@ -274,7 +287,10 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   // compute division of procs in 2 dimensions not on-processor
 
-  bifactor(nprocs,&np1,&np2);
+  if (npgrid1 > 0 && npgrid2 > 0 && npgrid1*npgrid2 == nprocs) {
+    np1 = npgrid1;
+    np2 = npgrid2;
+  } else bifactor(nprocs,&np1,&np2);
   ip1 = me % np1;
   ip2 = me/np1;
 
@@ -282,6 +298,7 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
+  fft_3d_clear_real(plan);
 
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
@@ -311,7 +328,7 @@ struct fft_plan_3d *fft_3d_create_plan(
     first_khi = (ip2+1)*nslow/np2 - 1;
     plan->pre_plan = remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                                           first_ilo,first_ihi,first_jlo,first_jhi,
-                                          first_klo,first_khi,2,0,0,FFT_PRECISION,0);
+                                          first_klo,first_khi,2,0,0,precision,0);
     if (plan->pre_plan == nullptr) return nullptr;
   }
 
@@ -333,7 +350,7 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan->mid1_plan = remap_3d_create_plan(comm, first_ilo,first_ihi,first_jlo,first_jhi,
                                          first_klo,first_khi,second_ilo,second_ihi,
                                          second_jlo,second_jhi,second_klo,second_khi,
-                                         2,1,0,FFT_PRECISION,usecollective);
+                                         2,1,0,precision,usecollective);
   if (plan->mid1_plan == nullptr) return nullptr;
 
   // 1d FFTs along mid axis
@@ -374,7 +391,7 @@ struct fft_plan_3d *fft_3d_create_plan(
                          second_jlo,second_jhi,second_klo,second_khi,
                          second_ilo,second_ihi,
                          third_jlo,third_jhi,third_klo,third_khi,
-                         third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
+                         third_ilo,third_ihi,2,1,0,precision,usecollective);
   if (plan->mid2_plan == nullptr) return nullptr;
 
   // 1d FFTs along slow axis
@@ -403,7 +420,7 @@ struct fft_plan_3d *fft_3d_create_plan(
                            third_klo,third_khi,third_ilo,third_ihi,
                            third_jlo,third_jhi,
                            out_klo,out_khi,out_ilo,out_ihi,
-                           out_jlo,out_jhi,2,(permute+1)%3,0,FFT_PRECISION,0);
+                           out_jlo,out_jhi,2,(permute+1)%3,0,precision,0);
     if (plan->post_plan == nullptr) return nullptr;
   }
 
@@ -595,6 +612,697 @@ struct fft_plan_3d *fft_3d_create_plan(
   return plan;
 }
 
+/* ----------------------------------------------------------------------
+   Perform 3d real-to-complex FFT
+
+   Arguments:
+   in           starting address of real input data on this proc
+   out          starting address of where complex output data for this proc
+                  will be placed (must not overlap with in)
+   plan         plan returned by previous call to fft_3d_create_plan_r2c
+
+   result is the forward transform on the Nfast/2+1 x Nmid x Nslow half
+     of the k-space grid, the remaining half is its complex conjugate
+------------------------------------------------------------------------- */
+
+void fft_3d_r2c(FFT_SCALAR *in, FFT_DATA *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR *rdata;
+  FFT_DATA *data,*copy;
+
+  // pre-remap of real values to prepare for 1st FFTs if needed
+
+  if (plan->pre_plan) {
+    remap_3d(in,plan->rcopy,(FFT_SCALAR *) plan->scratch,plan->pre_plan);
+    rdata = plan->rcopy;
+  } else rdata = in;
+
+  // 1d real-to-complex FFTs along fast axis
+
+  if (plan->pre_target == 0) data = out;
+  else data = plan->copy;
+  fft_1d_r2c(rdata,data,plan);
+
+  // 1st mid-remap to prepare for 2nd FFTs
+
+  if (plan->mid1_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  data = copy;
+
+  // 1d FFTs along mid axis
+
+  fft_1d_mid(data,1,plan);
+
+  // 2nd mid-remap to prepare for 3rd FFTs
+
+  if (plan->mid2_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  data = copy;
+
+  // 1d FFTs along slow axis
+
+  fft_1d_slow(data,1,plan);
+
+  // post-remap to put data in output format, destination is always out
+
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
+           (FFT_SCALAR *) plan->scratch, plan->post_plan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d complex-to-real FFT, inverse of fft_3d_r2c()
+
+   Arguments:
+   in           starting address of complex input data on this proc
+                  for the Nfast/2+1 half of the k-space grid, is destroyed
+   out          starting address of where real output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_r2c
+------------------------------------------------------------------------- */
+
+void fft_3d_c2r(FFT_DATA *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+  FFT_DATA *data,*copy;
+
+  // all complex stages run through in and the copy buffer
+  // with the same placement as the forward transform
+
+  if (plan->mid2_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) in, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->post_back_plan);
+  data = copy;
+
+  // 1d FFTs along slow axis
+
+  fft_1d_slow(data,-1,plan);
+
+  // reverse 2nd mid-remap
+
+  if (plan->mid1_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_back_plan);
+  data = copy;
+
+  // 1d FFTs along mid axis
+
+  fft_1d_mid(data,-1,plan);
+
+  // reverse 1st mid-remap
+
+  if (plan->pre_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_back_plan);
+  data = copy;
+
+  // 1d complex-to-real FFTs along fast axis
+  // go through rcopy when remapping afterwards or when out aliases data
+
+  if (plan->pre_back_plan) {
+    fft_1d_c2r(data,plan->rcopy,plan);
+    remap_3d(plan->rcopy,out,(FFT_SCALAR *) plan->scratch,plan->pre_back_plan);
+  } else if ((void *) data == (void *) out) {
+    fft_1d_c2r(data,plan->rcopy,plan);
+    memcpy(out,plan->rcopy,plan->total1*sizeof(FFT_SCALAR));
+  } else fft_1d_c2r(data,out,plan);
+
+  // scaling if required
+
+  if (plan->scaled) {
+    const FFT_SCALAR norm = plan->norm;
+    const int num = plan->normnum;
+    for (int i = 0; i < num; i++) out[i] *= norm;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Create plan for performing a 3d real-to-complex FFT and its inverse
+
+   Arguments:
+   comm                 MPI communicator for the P procs which own the data
+   nfast,nmid,nslow     size of global 3d real matrix
+   in_ilo,in_ihi        bounds of real data I own in fast index
+   in_jlo,in_jhi        bounds of real data I own in mid index
+   in_klo,in_khi        bounds of real data I own in slow index
+   out_ilo,out_ihi      bounds of complex data I own in fast index
+                          which runs from 0 to nfast/2
+   out_jlo,out_jhi      bounds of complex data I own in mid index
+   out_klo,out_khi      bounds of complex data I own in slow index
+   scaled               0 = no scaling of result, 1 = scaling of c2r result
+   nbuf                 returns size of internal storage buffers used by FFT
+   usecollective        use collective MPI operations for remapping data
+   precision            precision of data sent in remaps, 1 = single, 2 = double
+   npgrid1,npgrid2      2d proc grid of pencil decompositions, 0,0 = automatic
+
+   complex output is not permuted, the same plan does the c2r transform
+     from the complex layout back to the real layout
+------------------------------------------------------------------------- */
+
+struct fft_plan_3d *fft_3d_create_plan_r2c(
+       MPI_Comm comm, int nfast, int nmid, int nslow,
+       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+       int in_klo, int in_khi,
+       int out_ilo, int out_ihi, int out_jlo, int out_jhi,
+       int out_klo, int out_khi,
+       int scaled, int *nbuf, int usecollective, int precision,
+       int npgrid1, int npgrid2)
+{
+  struct fft_plan_3d *plan;
+  int me,nprocs;
+  int flag,remapflag;
+  int first_ilo,first_ihi,first_jlo,first_jhi,first_klo,first_khi;
+  int second_ilo,second_ihi,second_jlo,second_jhi,second_klo,second_khi;
+  int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
+  int in_size,out_size,first_size,second_size,third_size,copy_size,scratch_size;
+  int np1,np2,ip1,ip2;
+
+  // # of complex values along fast axis
+
+  const int nfc = nfast/2 + 1;
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+  if (npgrid1 > 0 && npgrid2 > 0 && npgrid1*npgrid2 == nprocs) {
+    np1 = npgrid1;
+    np2 = npgrid2;
+  } else bifactor(nprocs,&np1,&np2);
+  ip1 = me % np1;
+  ip2 = me/np1;
+
+  plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
+  if (plan == nullptr) return nullptr;
+  fft_3d_clear_real(plan);
+  plan->real = 1;
+  plan->pre_plan = plan->mid1_plan = plan->mid2_plan = plan->post_plan = nullptr;
+  plan->copy = plan->scratch = nullptr;
+
+  // remap real values to layout needed for 1st set of 1d FFTs
+  // not needed if all procs own entire fast axis initially
+
+  if (in_ilo == 0 && in_ihi == nfast-1)
+    flag = 0;
+  else
+    flag = 1;
+
+  MPI_Allreduce(&flag,&remapflag,1,MPI_INT,MPI_MAX,comm);
+
+  if (remapflag == 0) {
+    first_jlo = in_jlo;
+    first_jhi = in_jhi;
+    first_klo = in_klo;
+    first_khi = in_khi;
+  } else {
+    first_jlo = ip1*nmid/np1;
+    first_jhi = (ip1+1)*nmid/np1 - 1;
+    first_klo = ip2*nslow/np2;
+    first_khi = (ip2+1)*nslow/np2 - 1;
+    plan->pre_plan = remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                                          0,nfast-1,first_jlo,first_jhi,
+                                          first_klo,first_khi,1,0,0,precision,0);
+    plan->pre_back_plan = remap_3d_create_plan(comm,0,nfast-1,first_jlo,first_jhi,
+                                               first_klo,first_khi,
+                                               in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                                               1,0,0,precision,0);
+    if (plan->pre_plan == nullptr || plan->pre_back_plan == nullptr) return nullptr;
+  }
+  first_ilo = 0;
+  first_ihi = nfc - 1;
+
+  // 1d FFTs along fast axis, total1 counts real values
+
+  plan->length1 = nfast;
+  plan->clength1 = nfc;
+  plan->total1 = nfast * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+
+  // remap from 1st to 2nd FFT and back
+
+  second_ilo = ip1*nfc/np1;
+  second_ihi = (ip1+1)*nfc/np1 - 1;
+  second_jlo = 0;
+  second_jhi = nmid - 1;
+  second_klo = ip2*nslow/np2;
+  second_khi = (ip2+1)*nslow/np2 - 1;
+  plan->mid1_plan = remap_3d_create_plan(comm,first_ilo,first_ihi,first_jlo,first_jhi,
+                                         first_klo,first_khi,second_ilo,second_ihi,
+                                         second_jlo,second_jhi,second_klo,second_khi,
+                                         2,1,0,precision,usecollective);
+  plan->mid1_back_plan =
+    remap_3d_create_plan(comm,second_jlo,second_jhi,second_klo,second_khi,
+                         second_ilo,second_ihi,first_jlo,first_jhi,
+                         first_klo,first_khi,first_ilo,first_ihi,
+                         2,2,0,precision,usecollective);
+  if (plan->mid1_plan == nullptr || plan->mid1_back_plan == nullptr) return nullptr;
+
+  // 1d FFTs along mid axis
+
+  plan->length2 = nmid;
+  plan->total2 = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+
+  // remap from 2nd to 3rd FFT and back
+
+  third_ilo = ip1*nfc/np1;
+  third_ihi = (ip1+1)*nfc/np1 - 1;
+  third_jlo = ip2*nmid/np2;
+  third_jhi = (ip2+1)*nmid/np2 - 1;
+  third_klo = 0;
+  third_khi = nslow - 1;
+
+  plan->mid2_plan =
+    remap_3d_create_plan(comm,
+                         second_jlo,second_jhi,second_klo,second_khi,
+                         second_ilo,second_ihi,
+                         third_jlo,third_jhi,third_klo,third_khi,
+                         third_ilo,third_ihi,2,1,0,precision,usecollective);
+  plan->mid2_back_plan =
+    remap_3d_create_plan(comm,
+                         third_klo,third_khi,third_ilo,third_ihi,
+                         third_jlo,third_jhi,
+                         second_klo,second_khi,second_ilo,second_ihi,
+                         second_jlo,second_jhi,2,2,0,precision,usecollective);
+  if (plan->mid2_plan == nullptr || plan->mid2_back_plan == nullptr) return nullptr;
+
+  // 1d FFTs along slow axis
+
+  plan->length3 = nslow;
+  plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+
+  // remap from 3rd FFT to final distribution and back
+
+  plan->post_plan =
+    remap_3d_create_plan(comm,
+                         third_klo,third_khi,third_ilo,third_ihi,
+                         third_jlo,third_jhi,
+                         out_klo,out_khi,out_ilo,out_ihi,
+                         out_jlo,out_jhi,2,1,0,precision,0);
+  plan->post_back_plan =
+    remap_3d_create_plan(comm,
+                         out_ilo,out_ihi,out_jlo,out_jhi,
+                         out_klo,out_khi,
+                         third_ilo,third_ihi,third_jlo,third_jhi,
+                         third_klo,third_khi,2,2,0,precision,0);
+  if (plan->post_plan == nullptr || plan->post_back_plan == nullptr) return nullptr;
+
+  // configure plan memory pointers and allocate work space
+  // complex data lives in the user's complex array if big enough,
+  //   else in the copy buffer, the same choice is used in both directions
+  // rcopy holds real values along the 1st FFTs
+
+  in_size = (in_ihi-in_ilo+1) * (in_jhi-in_jlo+1) * (in_khi-in_klo+1);
+  out_size = (out_ihi-out_ilo+1) * (out_jhi-out_jlo+1) * (out_khi-out_klo+1);
+  first_size = nfc * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  second_size = (second_ihi-second_ilo+1) * (second_jhi-second_jlo+1) *
+    (second_khi-second_klo+1);
+  third_size = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) *
+    (third_khi-third_klo+1);
+
+  copy_size = 0;
+  plan->pre_target = plan->mid1_target = plan->mid2_target = 0;
+
+  if (first_size > out_size) {
+    plan->pre_target = 1;
+    copy_size = MAX(copy_size,first_size);
+  }
+  if (second_size > out_size) {
+    plan->mid1_target = 1;
+    copy_size = MAX(copy_size,second_size);
+  }
+  if (third_size > out_size) {
+    plan->mid2_target = 1;
+    copy_size = MAX(copy_size,third_size);
+  }
+
+  scratch_size = MAX(first_size,MAX(second_size,third_size));
+  scratch_size = MAX(scratch_size,out_size);
+  scratch_size = MAX(scratch_size,(MAX(in_size,plan->total1)+1)/2);
+
+  *nbuf = copy_size + scratch_size + (plan->total1+1)/2;
+
+  if (copy_size) {
+    plan->copy = (FFT_DATA *) malloc(copy_size*sizeof(FFT_DATA));
+    if (plan->copy == nullptr) return nullptr;
+  }
+
+  plan->scratch = (FFT_DATA *) malloc(scratch_size*sizeof(FFT_DATA));
+  plan->rcopy = (FFT_SCALAR *) malloc(MAX(plan->total1,1)*sizeof(FFT_SCALAR));
+  if (plan->scratch == nullptr || plan->rcopy == nullptr) return nullptr;
+
+  // system specific pre-computation of 1d FFT coeffs
+  // the mid and slow axis FFTs are complex-to-complex as in fft_3d()
+
+#if defined(FFT_MKL)
+  const int nlines = plan->total1/nfast;
+
+  DftiCreateDescriptor( &(plan->handle_real_forward), FFT_MKL_PREC, DFTI_REAL, 1,
+                        (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_real_forward, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)nlines);
+  DftiSetValue(plan->handle_real_forward, DFTI_PLACEMENT,DFTI_NOT_INPLACE);
+  DftiSetValue(plan->handle_real_forward, DFTI_CONJUGATE_EVEN_STORAGE,
+               DFTI_COMPLEX_COMPLEX);
+  DftiSetValue(plan->handle_real_forward, DFTI_INPUT_DISTANCE, (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_real_forward, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfc);
+  DftiCommitDescriptor(plan->handle_real_forward);
+
+  DftiCreateDescriptor( &(plan->handle_real_backward), FFT_MKL_PREC, DFTI_REAL, 1,
+                        (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_real_backward, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)nlines);
+  DftiSetValue(plan->handle_real_backward, DFTI_PLACEMENT,DFTI_NOT_INPLACE);
+  DftiSetValue(plan->handle_real_backward, DFTI_CONJUGATE_EVEN_STORAGE,
+               DFTI_COMPLEX_COMPLEX);
+  DftiSetValue(plan->handle_real_backward, DFTI_INPUT_DISTANCE, (MKL_LONG)nfc);
+  DftiSetValue(plan->handle_real_backward, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfast);
+  DftiCommitDescriptor(plan->handle_real_backward);
+
+  DftiCreateDescriptor( &(plan->handle_mid), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nmid);
+  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total2/nmid);
+  DftiSetValue(plan->handle_mid, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_mid, DFTI_INPUT_DISTANCE, (MKL_LONG)nmid);
+  DftiSetValue(plan->handle_mid, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nmid);
+  DftiCommitDescriptor(plan->handle_mid);
+
+  DftiCreateDescriptor( &(plan->handle_slow), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nslow);
+  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total3/nslow);
+  DftiSetValue(plan->handle_slow, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_slow, DFTI_INPUT_DISTANCE, (MKL_LONG)nslow);
+  DftiSetValue(plan->handle_slow, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nslow);
+  DftiCommitDescriptor(plan->handle_slow);
+
+#elif defined(FFT_FFTW3)
+  const int nlines = plan->total1/nfast;
+
+#if defined(FFT_FFTW_THREADS)
+  int nthreads = 1;
+#if defined(_OPENMP)
+  nthreads = omp_get_max_threads();
+#endif
+  if (nthreads > 1) {
+    FFTW_API(init_threads)();
+    FFTW_API(plan_with_nthreads)(nthreads);
+  }
+#endif
+
+  // real transforms are always out-of-place, so FFTW must see two distinct
+  // arrays during planning, the user arrays are not known yet
+
+  FFT_SCALAR *rtmp = (FFT_SCALAR *) FFTW_API(malloc)(MAX(plan->total1,1)*sizeof(FFT_SCALAR));
+  FFT_DATA *ctmp = (FFT_DATA *) FFTW_API(malloc)(MAX(nlines*nfc,1)*sizeof(FFT_DATA));
+  if (rtmp == nullptr || ctmp == nullptr) return nullptr;
+
+  plan->plan_real_forward =
+    FFTW_API(plan_many_dft_r2c)(1, &nfast,nlines,
+                                rtmp,&nfast,1,nfast,
+                                ctmp,&nfc,1,nfc,FFTW_ESTIMATE | FFTW_UNALIGNED);
+  plan->plan_real_backward =
+    FFTW_API(plan_many_dft_c2r)(1, &nfast,nlines,
+                                ctmp,&nfc,1,nfc,
+                                rtmp,&nfast,1,nfast,FFTW_ESTIMATE | FFTW_UNALIGNED);
+  FFTW_API(free)(rtmp);
+  FFTW_API(free)(ctmp);
+  plan->plan_mid_forward =
+    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            FFTW_FORWARD,FFTW_ESTIMATE);
+  plan->plan_mid_backward =
+    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            FFTW_BACKWARD,FFTW_ESTIMATE);
+  plan->plan_slow_forward =
+    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            FFTW_FORWARD,FFTW_ESTIMATE);
+  plan->plan_slow_backward =
+    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            FFTW_BACKWARD,FFTW_ESTIMATE);
+
+#else /* FFT_KISS */
+
+  // even nfast: one complex FFT of length nfast/2 per line
+  //   on the real values taken pairwise, split with twiddle factors
+  // odd nfast: full length complex FFT with zero imaginary part
+
+  if (nfast % 2 == 0) {
+    const int nhalf = nfast/2;
+    plan->cfg_real_forward = kiss_fft_alloc(nhalf,0,nullptr,nullptr);
+    plan->cfg_real_backward = kiss_fft_alloc(nhalf,1,nullptr,nullptr);
+    plan->rtwiddle = (FFT_DATA *) malloc(nhalf*sizeof(FFT_DATA));
+    if (plan->rtwiddle == nullptr) return nullptr;
+    for (int k = 0; k < nhalf; k++) {
+      const double phase = -LAMMPS_NS::MathConst::MY_2PI*k/nfast;
+      plan->rtwiddle[k].re = cos(phase);
+      plan->rtwiddle[k].im = sin(phase);
+    }
+  } else {
+    plan->cfg_real_forward = kiss_fft_alloc(nfast,0,nullptr,nullptr);
+    plan->cfg_real_backward = kiss_fft_alloc(nfast,1,nullptr,nullptr);
+  }
+  plan->rwork = (FFT_DATA *) malloc(2*nfast*sizeof(FFT_DATA));
+  if (plan->rwork == nullptr) return nullptr;
+
+  plan->cfg_mid_forward = kiss_fft_alloc(nmid,0,nullptr,nullptr);
+  plan->cfg_mid_backward = kiss_fft_alloc(nmid,1,nullptr,nullptr);
+
+  if (nslow == nmid) {
+    plan->cfg_slow_forward = plan->cfg_mid_forward;
+    plan->cfg_slow_backward = plan->cfg_mid_backward;
+  } else {
+    plan->cfg_slow_forward = kiss_fft_alloc(nslow,0,nullptr,nullptr);
+    plan->cfg_slow_backward = kiss_fft_alloc(nslow,1,nullptr,nullptr);
+  }
+
+#endif
+
+  if (scaled == 0)
+    plan->scaled = 0;
+  else {
+    plan->scaled = 1;
+    plan->norm = 1.0/((double)nfast*nmid*nslow);
+    plan->normnum = in_size;
+  }
+
+  return plan;
+}
+
+/* ----------------------------------------------------------------------
+   null the fields of a plan only set by fft_3d_create_plan_r2c()
+------------------------------------------------------------------------- */
+
+static void fft_3d_clear_real(struct fft_plan_3d *plan)
+{
+  plan->real = 0;
+  plan->clength1 = 0;
+  plan->pre_back_plan = plan->mid1_back_plan = nullptr;
+  plan->mid2_back_plan = plan->post_back_plan = nullptr;
+  plan->rcopy = nullptr;
+
+#if defined(FFT_MKL)
+  plan->handle_fast = nullptr;
+  plan->handle_real_forward = plan->handle_real_backward = nullptr;
+#elif defined(FFT_FFTW3)
+  plan->plan_fast_forward = plan->plan_fast_backward = nullptr;
+  plan->plan_real_forward = plan->plan_real_backward = nullptr;
+#else
+  plan->cfg_fast_forward = plan->cfg_fast_backward = nullptr;
+  plan->cfg_real_forward = plan->cfg_real_backward = nullptr;
+  plan->rtwiddle = plan->rwork = nullptr;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   1d FFTs along the mid or slow axis of a real-to-complex plan
+------------------------------------------------------------------------- */
+
+static void fft_1d_mid(FFT_DATA *data, int flag, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  if (flag == 1)
+    DftiComputeForward(plan->handle_mid,data);
+  else
+    DftiComputeBackward(plan->handle_mid,data);
+#elif defined(FFT_FFTW3)
+  if (flag == 1)
+    FFTW_API(execute_dft)(plan->plan_mid_forward,data,data);
+  else
+    FFTW_API(execute_dft)(plan->plan_mid_backward,data,data);
+#else
+  const int total = plan->total2;
+  const int length = plan->length2;
+  kiss_fft_cfg cfg = (flag == 1) ? plan->cfg_mid_forward : plan->cfg_mid_backward;
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(cfg,&data[offset],&data[offset]);
+#endif
+}
+
+static void fft_1d_slow(FFT_DATA *data, int flag, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  if (flag == 1)
+    DftiComputeForward(plan->handle_slow,data);
+  else
+    DftiComputeBackward(plan->handle_slow,data);
+#elif defined(FFT_FFTW3)
+  if (flag == 1)
+    FFTW_API(execute_dft)(plan->plan_slow_forward,data,data);
+  else
+    FFTW_API(execute_dft)(plan->plan_slow_backward,data,data);
+#else
+  const int total = plan->total3;
+  const int length = plan->length3;
+  kiss_fft_cfg cfg = (flag == 1) ? plan->cfg_slow_forward : plan->cfg_slow_backward;
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(cfg,&data[offset],&data[offset]);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   1d real-to-complex FFTs along the fast axis
+   each line of nfast real values gives nfast/2+1 complex values
+------------------------------------------------------------------------- */
+
+static void fft_1d_r2c(FFT_SCALAR *in, FFT_DATA *out, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  DftiComputeForward(plan->handle_real_forward,in,out);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft_r2c)(plan->plan_real_forward,in,out);
+#else
+  const int n = plan->length1;
+  const int nc = plan->clength1;
+  const int nlines = plan->total1/n;
+
+  if (n % 2 == 0) {
+
+    // z = FFT of x[2m] + i x[2m+1], then
+    // X[k] = (z[k] + conj z[m-k])/2 + w^k (z[k] - conj z[m-k])/2i
+
+    const int m = n/2;
+    const FFT_DATA *w = plan->rtwiddle;
+    for (int line = 0; line < nlines; line++) {
+      FFT_DATA *x = &out[line*nc];
+      kiss_fft(plan->cfg_real_forward,(FFT_DATA *) &in[line*n],x);
+
+      const FFT_SCALAR z0re = x[0].re;
+      const FFT_SCALAR z0im = x[0].im;
+      x[0].re = z0re + z0im;
+      x[0].im = 0.0;
+      x[m].re = z0re - z0im;
+      x[m].im = 0.0;
+
+      for (int k = 1; 2*k <= m; k++) {
+        const FFT_DATA a = x[k];
+        const FFT_DATA b = x[m-k];
+        const FFT_SCALAR ere = 0.5*(a.re + b.re);
+        const FFT_SCALAR eim = 0.5*(a.im - b.im);
+        const FFT_SCALAR ore = 0.5*(a.im + b.im);
+        const FFT_SCALAR oim = -0.5*(a.re - b.re);
+        const FFT_SCALAR tre = w[k].re*ore - w[k].im*oim;
+        const FFT_SCALAR tim = w[k].re*oim + w[k].im*ore;
+        x[k].re = ere + tre;
+        x[k].im = eim + tim;
+        x[m-k].re = ere - tre;
+        x[m-k].im = tim - eim;
+      }
+    }
+
+  } else {
+    FFT_DATA *tin = plan->rwork;
+    FFT_DATA *tout = plan->rwork + n;
+    for (int line = 0; line < nlines; line++) {
+      for (int i = 0; i < n; i++) {
+        tin[i].re = in[line*n+i];
+        tin[i].im = 0.0;
+      }
+      kiss_fft(plan->cfg_real_forward,tin,tout);
+      memcpy(&out[line*nc],tout,nc*sizeof(FFT_DATA));
+    }
+  }
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   1d complex-to-real FFTs along the fast axis, inverse of fft_1d_r2c()
+   input values are destroyed, output is not normalized
+------------------------------------------------------------------------- */
+
+static void fft_1d_c2r(FFT_DATA *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  DftiComputeBackward(plan->handle_real_backward,in,out);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft_c2r)(plan->plan_real_backward,in,out);
+#else
+  const int n = plan->length1;
+  const int nc = plan->clength1;
+  const int nlines = plan->total1/n;
+
+  // imaginary parts of X[0] and X[n/2] are ignored
+
+  if (n % 2 == 0) {
+
+    // z[k] = X[k] + conj X[m-k] + i w^-k (X[k] - conj X[m-k])
+    // inverse FFT of z gives x[2m] + i x[2m+1]
+
+    const int m = n/2;
+    const FFT_DATA *w = plan->rtwiddle;
+    FFT_DATA *z = plan->rwork;
+    for (int line = 0; line < nlines; line++) {
+      const FFT_DATA *x = &in[line*nc];
+
+      z[0].re = x[0].re + x[m].re;
+      z[0].im = x[0].re - x[m].re;
+
+      for (int k = 1; 2*k <= m; k++) {
+        const FFT_DATA a = x[k];
+        const FFT_DATA b = x[m-k];
+        const FFT_SCALAR ere = a.re + b.re;
+        const FFT_SCALAR eim = a.im - b.im;
+        const FFT_SCALAR dre = a.re - b.re;
+        const FFT_SCALAR dim = a.im + b.im;
+        const FFT_SCALAR ore = dre*w[k].re + dim*w[k].im;
+        const FFT_SCALAR oim = dim*w[k].re - dre*w[k].im;
+        z[k].re = ere - oim;
+        z[k].im = eim + ore;
+        if (2*k < m) {
+          z[m-k].re = ere + oim;
+          z[m-k].im = ore - eim;
+        }
+      }
+      kiss_fft(plan->cfg_real_backward,z,(FFT_DATA *) &out[line*n]);
+    }
+
+  } else {
+    FFT_DATA *tin = plan->rwork;
+    FFT_DATA *tout = plan->rwork + n;
+    for (int line = 0; line < nlines; line++) {
+      const FFT_DATA *x = &in[line*nc];
+      tin[0].re = x[0].re;
+      tin[0].im = 0.0;
+      for (int k = 1; k < nc; k++) {
+        tin[k] = x[k];
+        tin[n-k].re = x[k].re;
+        tin[n-k].im = -x[k].im;
+      }
+      kiss_fft(plan->cfg_real_backward,tin,tout);
+      for (int i = 0; i < n; i++) out[line*n+i] = tout[i].re;
+    }
+  }
+#endif
+}
+
 /* ----------------------------------------------------------------------
    Destroy a 3d fft plan
 ------------------------------------------------------------------------- */
@@ -605,25 +1313,38 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   if (plan->mid1_plan) remap_3d_destroy_plan(plan->mid1_plan);
   if (plan->mid2_plan) remap_3d_destroy_plan(plan->mid2_plan);
   if (plan->post_plan) remap_3d_destroy_plan(plan->post_plan);
+  if (plan->pre_back_plan) remap_3d_destroy_plan(plan->pre_back_plan);
+  if (plan->mid1_back_plan) remap_3d_destroy_plan(plan->mid1_back_plan);
+  if (plan->mid2_back_plan) remap_3d_destroy_plan(plan->mid2_back_plan);
+  if (plan->post_back_plan) remap_3d_destroy_plan(plan->post_back_plan);
 
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
+  if (plan->rcopy) free(plan->rcopy);
 
 #if defined(FFT_MKL)
-  DftiFreeDescriptor(&(plan->handle_fast));
+  if (plan->handle_fast) DftiFreeDescriptor(&(plan->handle_fast));
   DftiFreeDescriptor(&(plan->handle_mid));
   DftiFreeDescriptor(&(plan->handle_slow));
+  if (plan->handle_real_forward) DftiFreeDescriptor(&(plan->handle_real_forward));
+  if (plan->handle_real_backward) DftiFreeDescriptor(&(plan->handle_real_backward));
 #elif defined(FFT_FFTW3)
   FFTW_API(destroy_plan)(plan->plan_slow_forward);
   FFTW_API(destroy_plan)(plan->plan_slow_backward);
   FFTW_API(destroy_plan)(plan->plan_mid_forward);
   FFTW_API(destroy_plan)(plan->plan_mid_backward);
-  FFTW_API(destroy_plan)(plan->plan_fast_forward);
-  FFTW_API(destroy_plan)(plan->plan_fast_backward);
+  if (plan->plan_fast_forward) FFTW_API(destroy_plan)(plan->plan_fast_forward);
+  if (plan->plan_fast_backward) FFTW_API(destroy_plan)(plan->plan_fast_backward);
+  if (plan->plan_real_forward) FFTW_API(destroy_plan)(plan->plan_real_forward);
+  if (plan->plan_real_backward) FFTW_API(destroy_plan)(plan->plan_real_backward);
 #if defined(FFT_FFTW_THREADS)
   FFTW_API(cleanup_threads)();
 #endif
 #else
+  if (plan->cfg_real_forward) free(plan->cfg_real_forward);
+  if (plan->cfg_real_backward) free(plan->cfg_real_backward);
+  if (plan->rtwiddle) free(plan->rtwiddle);
+  if (plan->rwork) free(plan->rwork);
   if (plan->cfg_slow_forward != plan->cfg_fast_forward &&
       plan->cfg_slow_forward != plan->cfg_mid_forward) {
     free(plan->cfg_slow_forward);
@@ -730,6 +1451,28 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
   int total3 = plan->total3;
   int length3 = plan->length3;
 
+  // real-to-complex plans always do the full set of 1d FFTs
+  // the complex values along the fast axis go to the scratch buffer
+
+  if (plan->real) {
+    if ((total1 > 2*nsize) || (total2 > nsize) || (total3 > nsize)) return;
+    if (flag == 1) {
+      fft_1d_r2c((FFT_SCALAR *) data,plan->scratch,plan);
+      fft_1d_mid(data,1,plan);
+      fft_1d_slow(data,1,plan);
+    } else {
+      fft_1d_slow(data,-1,plan);
+      fft_1d_mid(data,-1,plan);
+      fft_1d_c2r(plan->scratch,(FFT_SCALAR *) data,plan);
+      if (plan->scaled) {
+        norm = plan->norm;
+        num = MIN(plan->normnum,total1);
+        for (i = 0; i < num; i++) ((FFT_SCALAR *) data)[i] *= norm;
+      }
+    }
+    return;
+  }
+
 // fftw3 and Dfti in MKL encode the number of transforms
 // into the plan, so we cannot operate on a smaller data set
 
@@ -103,11 +103,25 @@ struct fft_plan_3d {
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
 
+  // real-to-complex plans only
+  // backward transform runs the remaps in reverse with separate plans
+  // the fast axis is stored as Nfast/2+1 complex values in k-space
+
+  int real;                             // 1 if real-to-complex plan
+  int clength1;                         // # of complex values per 1st FFT
+  struct remap_plan_3d *pre_back_plan;  // reverse remaps for c2r
+  struct remap_plan_3d *mid1_back_plan;
+  struct remap_plan_3d *mid2_back_plan;
+  struct remap_plan_3d *post_back_plan;
+  FFT_SCALAR *rcopy;                    // real data along 1st FFTs
+
   // system specific 1d FFT info
 #if defined(FFT_MKL)
   DFTI_DESCRIPTOR *handle_fast;
   DFTI_DESCRIPTOR *handle_mid;
   DFTI_DESCRIPTOR *handle_slow;
+  DFTI_DESCRIPTOR *handle_real_forward;
+  DFTI_DESCRIPTOR *handle_real_backward;
 #elif defined(FFT_FFTW3)
   FFTW_API(plan) plan_fast_forward;
   FFTW_API(plan) plan_fast_backward;
@@ -115,6 +129,8 @@ struct fft_plan_3d {
   FFTW_API(plan) plan_mid_backward;
   FFTW_API(plan) plan_slow_forward;
   FFTW_API(plan) plan_slow_backward;
+  FFTW_API(plan) plan_real_forward;
+  FFTW_API(plan) plan_real_backward;
 #elif defined(FFT_KISS)
   kiss_fft_cfg cfg_fast_forward;
   kiss_fft_cfg cfg_fast_backward;
@@ -122,6 +138,10 @@ struct fft_plan_3d {
   kiss_fft_cfg cfg_mid_backward;
   kiss_fft_cfg cfg_slow_forward;
   kiss_fft_cfg cfg_slow_backward;
+  kiss_fft_cfg cfg_real_forward;    // half-length complex FFTs for even Nfast
+  kiss_fft_cfg cfg_real_backward;
+  FFT_DATA *rtwiddle;               // twiddle factors to split half-length FFTs
+  FFT_DATA *rwork;                  // per-line work space
 #endif
 };
 
@@ -130,7 +150,13 @@ struct fft_plan_3d {
 extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
-                                       int, int, int, int, int, int, int, int *, int);
+                                       int, int, int, int, int, int, int, int *, int, int, int,
+                                       int);
+struct fft_plan_3d *fft_3d_create_plan_r2c(MPI_Comm, int, int, int, int, int, int, int, int, int,
+                                           int, int, int, int, int, int, int, int *, int, int, int,
+                                           int);
+void fft_3d_r2c(FFT_SCALAR *, FFT_DATA *, struct fft_plan_3d *);
+void fft_3d_c2r(FFT_DATA *, FFT_SCALAR *, struct fft_plan_3d *);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
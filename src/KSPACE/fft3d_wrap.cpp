@@ -18,20 +18,39 @@
 
 using namespace LAMMPS_NS;
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   realflag = 1 creates a real-to-complex transform
+     in bounds are for the real data, out bounds for the complex data
+     on the nfast/2+1 half of the grid, permute must be 0
+     FORWARD is then r2c from in to out layout, BACKWARD is c2r
+     from out to in layout
+   precision = 1 sends data between procs in single precision
+     even if FFT_SCALAR is double, ignored by heFFTe
+------------------------------------------------------------------------- */
 
 FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
              int in_ilo, int in_ihi, int in_jlo, int in_jhi,
              int in_klo, int in_khi,
              int out_ilo, int out_ihi, int out_jlo, int out_jhi,
              int out_klo, int out_khi,
-             int scaled, int permute, int *nbuf, int usecollective) : Pointers(lmp)
+             int scaled, int permute, int *nbuf, int usecollective,
+             int realflag, int precision, int npgrid1, int npgrid2) :
+  Pointers(lmp), real(realflag)
 {
+  if (real && permute)
+    error->all(FLERR,"Real-to-complex 3d FFT does not support permuted output");
+
   #ifndef FFT_HEFFTE
-  plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
-                            in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
-                            out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
-                            scaled,permute,nbuf,usecollective);
+  if (real)
+    plan = fft_3d_create_plan_r2c(comm,nfast,nmid,nslow,
+                                  in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                                  out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                                  scaled,nbuf,usecollective,precision,npgrid1,npgrid2);
+  else
+    plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
+                              in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                              out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                              scaled,permute,nbuf,usecollective,precision,npgrid1,npgrid2);
   if (plan == nullptr) error->one(FLERR,"Could not create 3d FFT plan");
   #else
   heffte::plan_options options = heffte::default_options<heffte_backend>();
@@ -41,6 +60,18 @@ FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
   options.use_reorder = (permute != 0);
   hscale = (scaled == 0) ? heffte::scale::none : heffte::scale::full;
 
+  if (real) {
+    heffte_plan_r2c = std::unique_ptr<heffte::fft3d_r2c<heffte_backend>>(
+          new heffte::fft3d_r2c<heffte_backend>(
+                  heffte::box3d<>({in_ilo,in_jlo,in_klo}, {in_ihi, in_jhi, in_khi}),
+                  heffte::box3d<>({out_ilo,out_jlo,out_klo}, {out_ihi, out_jhi, out_khi}),
+                  0, comm, options)
+        );
+    *nbuf = heffte_plan_r2c->size_workspace();
+    heffte_workspace.resize(heffte_plan_r2c->size_workspace());
+    return;
+  }
+
   heffte_plan = std::unique_ptr<heffte::fft3d<heffte_backend>>(
         new heffte::fft3d<heffte_backend>(
                 heffte::box3d<>({in_ilo,in_jlo,in_klo}, {in_ihi, in_jhi, in_khi}),
@@ -66,8 +97,21 @@ FFT3d::~FFT3d()
 void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
 {
   #ifndef FFT_HEFFTE
-  fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
+  if (real) {
+    if (flag == 1) fft_3d_r2c(in,(FFT_DATA *) out,plan);
+    else fft_3d_c2r((FFT_DATA *) in,out,plan);
+  } else fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
   #else
+  if (real) {
+    if (flag == 1)
+      heffte_plan_r2c->forward(in,reinterpret_cast<std::complex<FFT_SCALAR>*>(out),
+                               reinterpret_cast<std::complex<FFT_SCALAR>*>(heffte_workspace.data()));
+    else
+      heffte_plan_r2c->backward(reinterpret_cast<std::complex<FFT_SCALAR>*>(in),out,
+                                reinterpret_cast<std::complex<FFT_SCALAR>*>(heffte_workspace.data()),
+                                hscale);
+    return;
+  }
   if (flag == 1)
       heffte_plan->forward(reinterpret_cast<std::complex<FFT_SCALAR>*>(in),
                            reinterpret_cast<std::complex<FFT_SCALAR>*>(out),
@@ -37,20 +37,24 @@ class FFT3d : protected Pointers {
   enum { FORWARD = 1, BACKWARD = -1 };
 
   FFT3d(class LAMMPS *, MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int,
-        int, int, int, int, int *, int);
+        int, int, int, int, int *, int, int realflag = 0, int precision = FFT_PRECISION,
+        int npgrid1 = 0, int npgrid2 = 0);
   ~FFT3d() override;
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
   void timing1d(FFT_SCALAR *, int, int);
+  int real_to_complex() const { return real; }
 
  private:
   #ifdef FFT_HEFFTE
   // the heFFTe plan supersedes the internal fft_plan_3d
   std::unique_ptr<heffte::fft3d<heffte_backend>> heffte_plan;
+  std::unique_ptr<heffte::fft3d_r2c<heffte_backend>> heffte_plan_r2c;
   std::vector<std::complex<FFT_SCALAR>> heffte_workspace;
   heffte::scale hscale;
   #else
   struct fft_plan_3d *plan;
   #endif
+  int real;    // 1 for real-to-complex transform
 };
 
 }    // namespace LAMMPS_NS
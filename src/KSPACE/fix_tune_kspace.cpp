@@ -18,8 +18,10 @@
 
 #include "fix_tune_kspace.h"
 
+#include "atom.h"
 #include "comm.h"
 #include "compute.h"
+#include "domain.h"
 #include "error.h"
 #include "force.h"
 #include "info.h"
@@ -27,6 +29,7 @@
 #include "modify.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "pppm.h"
 #include "timer.h"
 #include "update.h"
 
@@ -37,6 +40,7 @@
 
 #define SIGN(a,b) ((b) >= 0.0 ? fabs(a) : -fabs(a))
 static constexpr double GOLD = 1.618034;
+static constexpr int NMESH = 4;    // # of larger meshes tried in last PPPM stage
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -46,7 +50,7 @@ using namespace FixConst;
 FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg)
 {
-  if (narg < 3) error->all(FLERR,"Illegal fix tune/kspace command");
+  if (narg < 4) utils::missing_cmd_args(FLERR,"fix tune/kspace",error);
 
   global_freq = 1;
   firststep = 0;
@@ -59,11 +63,32 @@ FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
 
   ewald_time = pppm_time = msm_time = 0.0;
 
+  tune_pppm = 0;
+  itrial = -1;
+  tune_stage = 0;
+
   // parse arguments
 
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix tune/kspace command");
 
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"mode") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/kspace mode",error);
+      if (strcmp(arg[iarg+1],"style") == 0) tune_pppm = 0;
+      else if (strcmp(arg[iarg+1],"pppm") == 0) tune_pppm = 1;
+      else error->all(FLERR,"Unknown fix tune/kspace mode {}",arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"file") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/kspace file",error);
+      settings_file = arg[iarg+1];
+      iarg += 2;
+    } else error->all(FLERR,"Unknown fix tune/kspace keyword {}",arg[iarg]);
+  }
+  if (!settings_file.empty() && !tune_pppm)
+    error->all(FLERR,"Fix tune/kspace file requires mode pppm");
+
   // set up reneighboring
 
   force_reneighbor = 1;
@@ -96,6 +121,8 @@ void FixTuneKspace::init()
     error->all(FLERR,"Cannot use fix tune/kspace with TIP4P water");
   if (force->kspace->dipoleflag)
     error->all(FLERR,"Cannot use fix tune/kspace with dipole long-range solver");
+  if (tune_pppm && !(force->kspace->pppmflag && utils::strmatch(force->kspace_style,"^pppm")))
+    error->all(FLERR,"Fix tune/kspace mode pppm requires a pppm kspace style");
 
   store_old_kspace_settings();
   double old_acc = force->kspace->accuracy/force->kspace->two_charge_force;
@@ -118,6 +145,12 @@ void FixTuneKspace::pre_exchange()
   if (next_reneighbor != update->ntimestep) return;
   next_reneighbor = update->ntimestep + nevery;
 
+  if (tune_pppm) {
+    pppm_tune(get_timing_info());
+    last_spcpu = timer->elapsed(Timer::TOTAL);
+    return;
+  }
+
   auto info = new Info(lmp);
   bool has_msm = info->has_style("pair", base_pair_style + "/msm");
   delete info;
@@ -173,6 +206,7 @@ void FixTuneKspace::pre_exchange()
 
 /* ----------------------------------------------------------------------
    figure out CPU time per timestep since last time checked
+   return max time of all processors
 ------------------------------------------------------------------------- */
 
 double FixTuneKspace::get_timing_info()
@@ -193,6 +227,13 @@ double FixTuneKspace::get_timing_info()
     else dvalue = 0.0;
   }
 
+  // elapsed time differs between processors, use the slowest one,
+  // so all processors make the same decision about the next settings
+
+  double dmax;
+  MPI_Allreduce(&dvalue,&dmax,1,MPI_DOUBLE,MPI_MAX,world);
+  dvalue = dmax;
+
   last_step = new_step;
   last_spcpu = new_cpu;
 
@@ -262,7 +303,8 @@ void FixTuneKspace::update_pair_style(const std::string &new_pair_style,
 ------------------------------------------------------------------------- */
 
 void FixTuneKspace::update_kspace_style(const std::string &new_kspace_style,
-                                        const std::string &new_acc_str)
+                                        const std::string &new_acc_str,
+                                        const std::vector<std::string> &modify_args)
 {
   // delete old kspace style and create new one
 
@@ -273,6 +315,12 @@ void FixTuneKspace::update_kspace_style(const std::string &new_kspace_style,
   force->kspace->slabflag = old_slabflag;
   force->kspace->slab_volfactor = old_slab_volfactor;
 
+  if (!modify_args.empty()) {
+    std::vector<char *> args;
+    for (const auto &a : modify_args) args.push_back((char *) a.c_str());
+    force->kspace->modify_params(args.size(),args.data());
+  }
+
   // initialize new kspace style, pair style, molecular styles
 
   force->init();
@@ -288,6 +336,12 @@ void FixTuneKspace::update_kspace_style(const std::string &new_kspace_style,
 
   neighbor->init();
 
+  // a larger cutoff needs more ghost atoms and larger bins
+  // safe since this is called before atoms are exchanged and borders are rebuilt
+
+  comm->setup();
+  if (neighbor->style) neighbor->setup_bins();
+
   // Re-init computes to update pointers to virials, etc.
 
   for (int i = 0; i < modify->ncompute; i++) modify->compute[i]->init();
@@ -387,6 +441,171 @@ void FixTuneKspace::adjust_rcut(double time)
   update_kspace_style(kspace_style,acc_str);
 }
 
+/* ----------------------------------------------------------------------
+   time the previous PPPM trial and start the next one
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::pppm_tune(double time)
+{
+  if (itrial >= 0) trials[itrial].time = time;
+
+  itrial++;
+  while (itrial == (int) trials.size()) {
+    if (!pppm_next_stage()) {
+      pppm_finish();
+      return;
+    }
+  }
+
+  auto &trial = trials[itrial];
+  pppm_apply(trial);
+  if (comm->me == 0)
+    utils::logmesg(lmp,"PPPM trial {}: order {} diff {} mesh {} {} {} g_ewald {:.8g} "
+                   "Coulomb cutoff {:.8g} collective {} fft/real {}\n", itrial+1, trial.order,
+                   trial.diff ? "ad" : "ik", trial.grid[0], trial.grid[1], trial.grid[2],
+                   trial.g_ewald, trial.cut_coul, trial.collective ? "yes" : "no",
+                   trial.realfft ? "yes" : "no");
+}
+
+/* ----------------------------------------------------------------------
+   add trials for the next stage of the PPPM parameter search
+   each stage varies one group of parameters of the fastest trial so far:
+   1 = order and differentiation, 2 = Coulomb cutoff,
+   3 = collective remap and real-to-complex FFTs,
+   4 = NMESH successively larger meshes with sizes the FFTs can factor
+   mesh and g_ewald follow from the accuracy unless the mesh is set,
+   smaller meshes than from the accuracy are not tried, they would miss it
+   return false when the search is complete
+------------------------------------------------------------------------- */
+
+bool FixTuneKspace::pppm_next_stage()
+{
+  const int triclinic = domain->triclinic;
+  PPPMTrial trial;
+
+  tune_stage++;
+  if (tune_stage == 1) {
+    KSpace *kspace = force->kspace;
+    PPPMTrial current = {kspace->order, kspace->differentiation_flag, kspace->collective_flag,
+                         kspace->realfft_flag, {0,0,0}, {0,0,0}, 0.0, pair_cut_coul, 0.0};
+    for (int order = 3; order <= 7; order++) {
+      for (int diff = 0; diff <= 1; diff++) {
+        if (triclinic && diff) continue;
+        trial = current;
+        trial.order = order;
+        trial.diff = diff;
+        trials.push_back(trial);
+      }
+    }
+  } else if (tune_stage == 2) {
+    for (double scale : {0.8, 0.9, 1.1, 1.2}) {
+      trial = pppm_best();
+      trial.cut_coul *= scale;
+      trials.push_back(trial);
+    }
+  } else if (tune_stage == 3) {
+    trial = pppm_best();
+    trial.collective = !trial.collective;
+    trials.push_back(trial);
+    if (!triclinic) {
+      trial = pppm_best();
+      trial.realfft = !trial.realfft;
+      trials.push_back(trial);
+    }
+  } else if (tune_stage == 4) {
+    auto pppm = dynamic_cast<PPPM *>(force->kspace);
+    if (pppm) {
+      trial = pppm_best();
+      for (int i = 0; i < 3; i++) trial.mesh[i] = trial.grid[i];
+      for (int n = 0; n < NMESH; n++) {
+        for (int i = 0; i < 3; i++) {
+          trial.mesh[i]++;
+          while (!pppm->factorable(trial.mesh[i])) trial.mesh[i]++;
+        }
+        trials.push_back(trial);
+      }
+    }
+  } else return false;
+
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   switch pair cutoff and kspace settings to those of a trial
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::pppm_apply(PPPMTrial &trial)
+{
+  std::vector<std::string> args = {"order", std::to_string(trial.order),
+                                   "diff", trial.diff ? "ad" : "ik",
+                                   "collective", trial.collective ? "yes" : "no",
+                                   "fft/real", trial.realfft ? "yes" : "no"};
+  if (trial.mesh[0] > 0) {
+    args.emplace_back("mesh");
+    for (int i = 0; i < 3; i++) args.push_back(std::to_string(trial.mesh[i]));
+  }
+
+  store_old_kspace_settings();
+  update_pair_style(pair_style,trial.cut_coul);
+  update_kspace_style(kspace_style,acc_str,args);
+
+  trial.grid[0] = force->kspace->nx_pppm;
+  trial.grid[1] = force->kspace->ny_pppm;
+  trial.grid[2] = force->kspace->nz_pppm;
+  trial.g_ewald = force->kspace->g_ewald;
+}
+
+/* ----------------------------------------------------------------------
+   fastest timed trial, the first trial if none is timed yet
+------------------------------------------------------------------------- */
+
+const FixTuneKspace::PPPMTrial &FixTuneKspace::pppm_best() const
+{
+  int ibest = 0;
+  for (int i = 0; i < (int) trials.size(); i++)
+    if ((trials[i].time > 0.0) &&
+        ((trials[ibest].time <= 0.0) || (trials[i].time < trials[ibest].time))) ibest = i;
+  return trials[ibest];
+}
+
+/* ----------------------------------------------------------------------
+   use the fastest PPPM settings for the rest of the run,
+   report them and write them to the settings file
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::pppm_finish()
+{
+  PPPMTrial best = pppm_best();
+  pppm_apply(best);
+
+  // no more trials
+
+  next_reneighbor = -1;
+
+  if (comm->me == 0) {
+    auto mesg = fmt::format("kspace_modify order {} mesh {} {} {} diff {} collective {} "
+                            "fft/real {}", best.order, best.grid[0], best.grid[1],
+                            best.grid[2], best.diff ? "ad" : "ik",
+                            best.collective ? "yes" : "no", best.realfft ? "yes" : "no");
+    utils::logmesg(lmp,"Fastest PPPM settings after {} trials with {:.8g} seconds "
+                   "per step:\n  {}\n  g_ewald = {:.8g}, Coulomb cutoff = {:.8g}\n",
+                   trials.size(), best.time, mesg, best.g_ewald, best.cut_coul);
+
+    if (!settings_file.empty()) {
+      FILE *fp = fopen(settings_file.c_str(),"w");
+      if (fp == nullptr)
+        error->one(FLERR,"Cannot open fix tune/kspace file {}: {}",
+                   settings_file, utils::getsyserror());
+      fmt::print(fp,"# PPPM settings from fix tune/kspace on step {} for {} atoms "
+                 "on {} MPI tasks\n# {:.8g} seconds per step, g_ewald = {:.8g}\n"
+                 "variable tune_cut_coul equal {:.8g}\nkspace_style {} {}\n{}\n",
+                 update->ntimestep, atom->natoms, comm->nprocs, best.time, best.g_ewald,
+                 best.cut_coul, kspace_style, acc_str, mesg);
+      fclose(fp);
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    bracket a minimum using parabolic extrapolation
 ------------------------------------------------------------------------- */
@@ -34,7 +34,8 @@ class FixTuneKspace : public Fix {
   double get_timing_info();
   void store_old_kspace_settings();
   void update_pair_style(const std::string &, double);
-  void update_kspace_style(const std::string &, const std::string &);
+  void update_kspace_style(const std::string &, const std::string &,
+                           const std::vector<std::string> &modify_args = {});
   void adjust_rcut(double);
   void mnbrak();
   void brent0();
@@ -43,6 +44,8 @@ class FixTuneKspace : public Fix {
 
  private:
   int nevery;
+  int tune_pppm;                // 1 = tune PPPM parameters, 0 = tune kspace style and cutoff
+  std::string settings_file;    // file for fastest PPPM settings, empty if none
 
   int last_step;        // previous timestep when timing info was collected
   double last_spcpu;    // old elapsed CPU time value
@@ -71,6 +74,26 @@ class FixTuneKspace : public Fix {
   bool keep_bracketing, first_brent_pass;
   bool converged, need_fd2_brent;
 
+  // one timed PPPM parameter set
+
+  struct PPPMTrial {
+    int order, diff, collective, realfft;
+    int mesh[3];    // requested mesh, 0 = from accuracy
+    int grid[3];    // resulting mesh
+    double g_ewald;
+    double cut_coul;
+    double time;    // CPU time per step, 0.0 if not yet timed
+  };
+  std::vector<PPPMTrial> trials;
+  int itrial;         // index of trial currently running, -1 before first
+  int tune_stage;     // current stage of PPPM parameter search
+
+  void pppm_tune(double);
+  bool pppm_next_stage();
+  void pppm_apply(PPPMTrial &);
+  void pppm_finish();
+  const PPPMTrial &pppm_best() const;
+
   inline void shft3(double &a, double &b, double &c, const double d)
   {
     a = b;
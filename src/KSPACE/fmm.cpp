@@ -0,0 +1,1063 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   fast multipole method for non-periodic systems
+   Cartesian Taylor expansions of 1/r on a uniform octree,
+   see Lindsay and Krasny, J Comput Phys, 172, 879 (2001) for the
+   recurrence of the Taylor coefficients
+------------------------------------------------------------------------- */
+
+#include "fmm.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "math_const.h"
+#include "memory.h"
+#include "neighbor.h"
+#include "pair.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+static constexpr int MAXORDER = 12;
+static constexpr int MAXLEVEL = 6;
+static constexpr int NOFFSET = 7*7*7;    // M2L cell offsets of -3 to 3 in each dimension
+
+/* ---------------------------------------------------------------------- */
+
+FMM::FMM(LAMMPS *lmp) : KSpace(lmp),
+  celloffset(nullptr), count(nullptr), mine(nullptr), mpole(nullptr), local(nullptr),
+  m2lcoeff(nullptr), kvec(nullptr), kindex(nullptr), powfrom(nullptr), powdim(nullptr),
+  gradindex(nullptr), shiftterm(nullptr), m2lterm(nullptr), mineatom(nullptr),
+  mineleaf(nullptr), xqnear(nullptr), nearleaf(nullptr), leafstart(nullptr), nearsort(nullptr),
+  efield(nullptr), phi(nullptr), sendbuf(nullptr), recvbuf(nullptr), sendcount(nullptr),
+  senddispl(nullptr), recvcount(nullptr), recvdispl(nullptr), needbox(nullptr),
+  needmpole(nullptr)
+{
+  ewaldflag = 1;
+
+  // sums over all pairs of an isolated system need no charge neutrality
+
+  warn_nonneutral = 2;
+
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+
+  accuracy_relative = 0.0;
+  order = 8;
+  nleaf = 16;
+
+  nterms = 0;
+  nshift = nm2l = 0;
+  nlevels = 0;
+  ncells = maxcells = 0;
+  nmine = maxmine = 0;
+  nnear = maxnear = 0;
+  maxleaves = maxsend = maxrecv = 0;
+  cutoff = side = 0.0;
+  treelo[0] = treelo[1] = treelo[2] = 0.0;
+
+  allocate();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FMM::settings(int narg, char **arg)
+{
+  if (narg != 1) error->all(FLERR,"Illegal kspace_style {} command", force->kspace_style);
+
+  accuracy_relative = fabs(utils::numeric(FLERR,arg[0],false,lmp));
+  if (accuracy_relative > 1.0)
+    error->all(FLERR, "Invalid relative accuracy {:g} for kspace_style {}",
+               accuracy_relative, force->kspace_style);
+}
+
+/* ----------------------------------------------------------------------
+   free all memory
+------------------------------------------------------------------------- */
+
+FMM::~FMM()
+{
+  deallocate_terms();
+  memory->destroy(celloffset);
+  memory->destroy(count);
+  memory->destroy(mine);
+  memory->destroy(mpole);
+  memory->destroy(local);
+  memory->destroy(mineatom);
+  memory->destroy(mineleaf);
+  memory->destroy(xqnear);
+  memory->destroy(nearleaf);
+  memory->destroy(leafstart);
+  memory->destroy(nearsort);
+  memory->destroy(efield);
+  memory->destroy(phi);
+  memory->destroy(sendbuf);
+  memory->destroy(recvbuf);
+  memory->destroy(sendcount);
+  memory->destroy(senddispl);
+  memory->destroy(recvcount);
+  memory->destroy(recvdispl);
+  memory->destroy(needbox);
+  memory->destroy(needmpole);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FMM::init()
+{
+  if (me == 0) utils::logmesg(lmp,"FMM initialization ...\n");
+
+  // error check
+
+  triclinic_check();
+  if (domain->dimension == 2)
+    error->all(FLERR,"Cannot use FMM with 2d simulation");
+  if (!atom->q_flag) error->all(FLERR,"Kspace style requires atom attribute q");
+  if (domain->xperiodic || domain->yperiodic || domain->zperiodic)
+    error->all(FLERR,"Kspace style fmm requires non-periodic boundaries in all dimensions; "
+               "use kspace style pppm with kspace_modify slab for mixed boundaries");
+  if (slabflag)
+    error->all(FLERR,"Cannot use slab correction with kspace style fmm");
+  if (order < 2 || order > MAXORDER)
+    error->all(FLERR,"FMM order cannot be < 2 or > {}",MAXORDER);
+
+  // extract short-range Coulombic cutoff from pair style
+
+  pair_check();
+
+  int itmp;
+  auto p_cutoff = (double *) force->pair->extract("cut_coul",itmp);
+  if (p_cutoff == nullptr)
+    error->all(FLERR,"KSpace style is incompatible with Pair style");
+  cutoff = *p_cutoff;
+
+  // compute two charge force
+
+  two_charge();
+
+  scale = 1.0;
+  qqrd2e = force->qqrd2e;
+  qsum_qsq();
+  natoms_original = atom->natoms;
+
+  // set accuracy (force units) from accuracy_relative or accuracy_absolute
+
+  if (accuracy_absolute >= 0.0) accuracy = accuracy_absolute;
+  else accuracy = accuracy_relative * two_charge_force;
+
+  // g_ewald estimate from desired accuracy of real space sum
+  // same as for Ewald with the box volume
+
+  bigint natoms = atom->natoms;
+  double volume = domain->xprd * domain->yprd * domain->zprd;
+
+  if (!gewaldflag) {
+    if (accuracy <= 0.0)
+      error->all(FLERR,"KSpace accuracy must be > 0");
+    if (q2 == 0.0)
+      error->all(FLERR,"Must use 'kspace_modify gewald' for uncharged system");
+    g_ewald = accuracy*sqrt(natoms*cutoff*volume) / (2.0*q2);
+    if (g_ewald >= 1.0) g_ewald = (1.35 - 0.15*log(accuracy))/cutoff;
+    else g_ewald = sqrt(-log(g_ewald)) / cutoff;
+  }
+
+  if (nterms != (order+1)*(order+2)*(order+3)/6) allocate_terms();
+  setup();
+
+  // stats
+
+  double q2_over_sqrt = q2 / sqrt(natoms*cutoff*volume);
+  double spr = 2.0 *q2_over_sqrt * exp(-g_ewald*g_ewald*cutoff*cutoff);
+  double tpr = estimate_table_accuracy(q2_over_sqrt,spr);
+  double estimated_accuracy = sqrt(spr*spr + tpr*tpr);
+
+  if (me == 0) {
+    std::string mesg = fmt::format("  G vector (1/distance) = {:.8g}\n",g_ewald);
+    mesg += fmt::format("  estimated absolute RMS real-space force accuracy = {:.8g}\n",
+                        estimated_accuracy);
+    mesg += fmt::format("  estimated relative real-space force accuracy = {:.8g}\n",
+                        estimated_accuracy/two_charge_force);
+    mesg += fmt::format("  expansion order = {}, {} terms\n",order,nterms);
+    mesg += fmt::format("  tree levels = {}, leaf cell size = {:.8g}\n",
+                        nlevels,side/(1 << nlevels));
+    utils::logmesg(lmp,mesg);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   adjust tree to box, called initially and whenever box has changed
+------------------------------------------------------------------------- */
+
+void FMM::setup()
+{
+  set_tree();
+}
+
+/* ----------------------------------------------------------------------
+   process kspace_modify keywords specific to this style
+------------------------------------------------------------------------- */
+
+int FMM::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"fmm/leaf") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify fmm/leaf",error);
+    nleaf = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (nleaf < 1) error->all(FLERR,"Illegal kspace_modify fmm/leaf value {}",nleaf);
+    return 2;
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   compute the FMM long-range force, energy, virial
+------------------------------------------------------------------------- */
+
+void FMM::compute(int eflag, int vflag)
+{
+  // set energy/virial flags
+
+  ev_init(eflag,vflag);
+
+  if (vflag_atom)
+    error->all(FLERR,"Kspace style fmm does not (yet) support per-atom virial");
+
+  // if atom count has changed, update qsum and qsqsum
+
+  if (atom->natoms != natoms_original) {
+    qsum_qsq();
+    natoms_original = atom->natoms;
+  }
+
+  // return if there are no charges
+
+  if (qsqsum == 0.0) return;
+
+  // tree follows the box, which may shrink-wrap
+
+  set_tree();
+
+  // list my charges and their leaf cells
+
+  double **x = atom->x;
+  double *q = atom->q;
+  const int nlocal = atom->nlocal;
+
+  if (nlocal > maxmine) {
+    maxmine = atom->nmax;
+    memory->destroy(mineatom);
+    memory->destroy(mineleaf);
+    memory->destroy(efield);
+    memory->destroy(phi);
+    memory->create(mineatom,maxmine,"fmm:mineatom");
+    memory->create(mineleaf,maxmine,"fmm:mineleaf");
+    memory->create(efield,maxmine,3,"fmm:efield");
+    memory->create(phi,maxmine,"fmm:phi");
+  }
+
+  const int n = 1 << nlevels;
+  int ijk[3];
+  nmine = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (q[i] == 0.0) continue;
+    leaf_coords(x[i],ijk);
+    mineatom[nmine] = i;
+    mineleaf[nmine] = (ijk[2]*n + ijk[1])*n + ijk[0];
+    nmine++;
+  }
+
+  // charges near mine, then far field by multipole expansions
+
+  exchange_near();
+  near_field();
+  upward();
+  downward();
+  far_field();
+
+  // convert E-field to force, sum energy and virial
+
+  double **f = atom->f;
+  const double qscale = qqrd2e * scale;
+  double eng = 0.0;
+  double vir[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+  for (int k = 0; k < nmine; k++) {
+    const int i = mineatom[k];
+    const double fx = qscale * q[i]*efield[k][0];
+    const double fy = qscale * q[i]*efield[k][1];
+    const double fz = qscale * q[i]*efield[k][2];
+    f[i][0] += fx;
+    f[i][1] += fy;
+    f[i][2] += fz;
+
+    if (eflag_global) eng += q[i]*phi[k];
+    if (eflag_atom) eatom[i] += 0.5*qscale*q[i]*phi[k];
+
+    // virial of an isolated system from absolute positions
+
+    if (vflag_global) {
+      vir[0] += x[i][0]*fx;
+      vir[1] += x[i][1]*fy;
+      vir[2] += x[i][2]*fz;
+      vir[3] += x[i][0]*fy;
+      vir[4] += x[i][0]*fz;
+      vir[5] += x[i][1]*fz;
+    }
+  }
+
+  if (eflag_global) {
+    MPI_Allreduce(&eng,&energy,1,MPI_DOUBLE,MPI_SUM,world);
+    energy *= 0.5*qscale;
+  }
+  if (vflag_global) MPI_Allreduce(vir,virial,6,MPI_DOUBLE,MPI_SUM,world);
+}
+
+/* ----------------------------------------------------------------------
+   set root cell and # of levels of the octree
+   root cell is a cube around the box, padded by the skin so that
+   atoms stay inside until the next reneighboring.
+   leaf cells are no smaller than the Coulomb cutoff, so that charges
+   in non-adjacent cells are always beyond the cutoff
+------------------------------------------------------------------------- */
+
+void FMM::set_tree()
+{
+  const double *boxlo = domain->boxlo;
+  const double *boxhi = domain->boxhi;
+
+  side = MAX(domain->xprd,domain->yprd);
+  side = MAX(side,domain->zprd) + 2.0*neighbor->skin;
+  for (int d = 0; d < 3; d++) treelo[d] = 0.5*(boxlo[d]+boxhi[d]) - 0.5*side;
+
+  int maxlevel = 0;
+  while (maxlevel < MAXLEVEL && side/(1 << (maxlevel+1)) >= cutoff) maxlevel++;
+
+  nlevels = 0;
+  while (nlevels < maxlevel && atom->natoms > (bigint) nleaf << (3*nlevels)) nlevels++;
+
+  ncells = 0;
+  for (int l = 0; l <= nlevels; l++) {
+    celloffset[l] = ncells;
+    ncells += 1 << (3*l);
+  }
+  grow_cells();
+}
+
+/* ----------------------------------------------------------------------
+   allocate memory that is independent of order and tree size
+------------------------------------------------------------------------- */
+
+void FMM::allocate()
+{
+  memory->create(celloffset,MAXLEVEL+1,"fmm:celloffset");
+  memory->create(sendcount,nprocs,"fmm:sendcount");
+  memory->create(senddispl,nprocs,"fmm:senddispl");
+  memory->create(recvcount,nprocs,"fmm:recvcount");
+  memory->create(recvdispl,nprocs,"fmm:recvdispl");
+  memory->create(needbox,6*nprocs,"fmm:needbox");
+  memory->create(needmpole,6*(MAXLEVEL+1)*nprocs,"fmm:needmpole");
+}
+
+/* ----------------------------------------------------------------------
+   allocate cell data when the tree has grown
+------------------------------------------------------------------------- */
+
+void FMM::grow_cells()
+{
+  if (ncells <= maxcells) return;
+
+  maxcells = ncells;
+  memory->destroy(count);
+  memory->destroy(mine);
+  memory->destroy(mpole);
+  memory->destroy(local);
+  memory->create(count,maxcells,"fmm:count");
+  memory->create(mine,maxcells,"fmm:mine");
+  memory->create(mpole,(bigint)maxcells*nterms,"fmm:mpole");
+  memory->create(local,(bigint)maxcells*nterms,"fmm:local");
+}
+
+/* ----------------------------------------------------------------------
+   set up multi-indices and the index/coefficient tables of
+   the expansion shifts for the current order
+------------------------------------------------------------------------- */
+
+static double binomial(int n, int k)
+{
+  double b = 1.0;
+  for (int i = 1; i <= k; i++) b = b*(n-k+i)/i;
+  return b;
+}
+
+void FMM::allocate_terms()
+{
+  deallocate_terms();
+
+  const int p = order;
+  nterms = (p+1)*(p+2)*(p+3)/6;
+
+  memory->create(kvec,nterms,3,"fmm:kvec");
+  memory->create(kindex,p+1,p+1,p+1,"fmm:kindex");
+  memory->create(powfrom,nterms,"fmm:powfrom");
+  memory->create(powdim,nterms,"fmm:powdim");
+  memory->create(gradindex,nterms,3,"fmm:gradindex");
+  memory->create(m2lcoeff,NOFFSET*nterms,"fmm:m2lcoeff");
+
+  int t = 0;
+  for (int n = 0; n <= p; n++)
+    for (int a = n; a >= 0; a--)
+      for (int b = n-a; b >= 0; b--) {
+        kvec[t][0] = a;
+        kvec[t][1] = b;
+        kvec[t][2] = n-a-b;
+        kindex[a][b][n-a-b] = t++;
+      }
+
+  for (t = 0; t < nterms; t++) {
+    const int *k = kvec[t];
+    powfrom[t] = powdim[t] = -1;
+    for (int d = 0; d < 3; d++) {
+      int km[3] = {k[0], k[1], k[2]};
+      km[d]--;
+      gradindex[t][d] = (k[d] > 0) ? kindex[km[0]][km[1]][km[2]] : -1;
+      if (powfrom[t] < 0 && k[d] > 0) {
+        powfrom[t] = gradindex[t][d];
+        powdim[t] = d;
+      }
+    }
+  }
+
+  // M2M and L2L: all pairs (to,from) with from <= to componentwise
+  //   with = to - from, coeff = binomial(to,from)
+  // M2L: all pairs (to,from) with |to|+|from| <= order
+  //   with = to + from, coeff = (-1)^|from| binomial(to+from,to)
+
+  for (int pass = 0; pass < 2; pass++) {
+    nshift = nm2l = 0;
+    for (int to = 0; to < nterms; to++) {
+      const int *kt = kvec[to];
+      const int nt = kt[0]+kt[1]+kt[2];
+      for (int from = 0; from < nterms; from++) {
+        const int *kf = kvec[from];
+        const int nf = kf[0]+kf[1]+kf[2];
+        if (kf[0] <= kt[0] && kf[1] <= kt[1] && kf[2] <= kt[2]) {
+          if (pass) {
+            Term &term = shiftterm[nshift];
+            term.to = to;
+            term.from = from;
+            term.with = kindex[kt[0]-kf[0]][kt[1]-kf[1]][kt[2]-kf[2]];
+            term.coeff = binomial(kt[0],kf[0])*binomial(kt[1],kf[1])*binomial(kt[2],kf[2]);
+          }
+          nshift++;
+        }
+        if (nt+nf <= p) {
+          if (pass) {
+            Term &term = m2lterm[nm2l];
+            term.to = to;
+            term.from = from;
+            term.with = kindex[kt[0]+kf[0]][kt[1]+kf[1]][kt[2]+kf[2]];
+            term.coeff = ((nf % 2) ? -1.0 : 1.0) * binomial(kt[0]+kf[0],kt[0]) *
+              binomial(kt[1]+kf[1],kt[1])*binomial(kt[2]+kf[2],kt[2]);
+          }
+          nm2l++;
+        }
+      }
+    }
+    if (!pass) {
+      shiftterm = new Term[nshift];
+      m2lterm = new Term[nm2l];
+    }
+  }
+
+  // cell data depends on # of terms
+
+  memory->destroy(mpole);
+  memory->destroy(local);
+  memory->destroy(count);
+  memory->destroy(mine);
+  maxcells = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FMM::deallocate_terms()
+{
+  memory->destroy(kvec);
+  memory->destroy(kindex);
+  memory->destroy(powfrom);
+  memory->destroy(powdim);
+  memory->destroy(gradindex);
+  memory->destroy(m2lcoeff);
+  delete[] shiftterm;
+  delete[] m2lterm;
+  shiftterm = m2lterm = nullptr;
+  nterms = nshift = nm2l = 0;
+}
+
+/* ----------------------------------------------------------------------
+   coords of leaf cell that contains x
+------------------------------------------------------------------------- */
+
+void FMM::leaf_coords(const double *x, int *ijk)
+{
+  const int n = 1 << nlevels;
+  const double cellinv = n / side;
+  for (int d = 0; d < 3; d++) {
+    int c = static_cast<int>((x[d] - treelo[d])*cellinv);
+    ijk[d] = MAX(0,MIN(c,n-1));
+  }
+}
+
+/* ----------------------------------------------------------------------
+   center of cell (i,j,k) on level
+------------------------------------------------------------------------- */
+
+void FMM::cell_center(int level, int i, int j, int k, double *c)
+{
+  const double h = side / (1 << level);
+  c[0] = treelo[0] + (i+0.5)*h;
+  c[1] = treelo[1] + (j+0.5)*h;
+  c[2] = treelo[2] + (k+0.5)*h;
+}
+
+/* ----------------------------------------------------------------------
+   monomials h^k for all multi-indices k
+------------------------------------------------------------------------- */
+
+void FMM::powers(const double *h, double *pw)
+{
+  pw[0] = 1.0;
+  for (int t = 1; t < nterms; t++) pw[t] = pw[powfrom[t]] * h[powdim[t]];
+}
+
+/* ----------------------------------------------------------------------
+   Taylor coefficients a_k = 1/k! d^k/dR^k 1/|R| for all multi-indices k
+   from the recurrence
+   |R|^2 a_k = -(2-1/|k|) sum_d R_d a_{k-e_d} - (1-1/|k|) sum_d a_{k-2e_d}
+------------------------------------------------------------------------- */
+
+void FMM::taylor(const double *r, double *a)
+{
+  const double rsqinv = 1.0 / (r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+  a[0] = sqrt(rsqinv);
+
+  for (int t = 1; t < nterms; t++) {
+    const int *k = kvec[t];
+    const double ninv = 1.0 / (k[0]+k[1]+k[2]);
+    double s1 = 0.0, s2 = 0.0;
+    for (int d = 0; d < 3; d++) {
+      if (k[d] == 0) continue;
+      const int t1 = gradindex[t][d];
+      s1 += r[d]*a[t1];
+      if (k[d] > 1) s2 += a[gradindex[t1][d]];
+    }
+    a[t] = -((2.0-ninv)*s1 + (1.0-ninv)*s2) * rsqinv;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   multipole moments M_k = sum_j q_j (x_j - c)^k of my leaf cells,
+   shifted to their parents (M2M), then completed by other procs
+------------------------------------------------------------------------- */
+
+void FMM::upward()
+{
+  const double * const * const xq = xqnear;
+  std::vector<double> pw(nterms);
+  double c[3], h[3];
+
+  memset(mpole,0,sizeof(double)*ncells*nterms);
+  memset(count,0,sizeof(int)*ncells);
+  memset(mine,0,sizeof(int)*ncells);
+
+  // P2M
+
+  const int n = 1 << nlevels;
+  const int leaf0 = celloffset[nlevels];
+  for (int k = 0; k < nmine; k++) {
+    const int leaf = mineleaf[k];
+    cell_center(nlevels,leaf % n,(leaf / n) % n,leaf / (n*n),c);
+    for (int d = 0; d < 3; d++) h[d] = xq[k][d] - c[d];
+    powers(h,pw.data());
+
+    double *m = mpole + (bigint)(leaf0+leaf)*nterms;
+    for (int t = 0; t < nterms; t++) m[t] += xq[k][3]*pw[t];
+    count[leaf0+leaf]++;
+    mine[leaf0+leaf] = 1;
+  }
+
+  // M2M from child at c to parent at c - h
+
+  for (int l = nlevels; l > 0; l--) {
+    const int nl = 1 << l;
+    const double hl = 0.25*side/(nl/2);
+    for (int kz = 0; kz < nl; kz++)
+      for (int ky = 0; ky < nl; ky++)
+        for (int kx = 0; kx < nl; kx++) {
+          const int cell = celloffset[l] + (kz*nl + ky)*nl + kx;
+          if (!mine[cell]) continue;
+          const int parent = celloffset[l-1] + ((kz/2)*(nl/2) + ky/2)*(nl/2) + kx/2;
+          mine[parent] = 1;
+          count[parent] += count[cell];
+
+          h[0] = (kx & 1) ? hl : -hl;
+          h[1] = (ky & 1) ? hl : -hl;
+          h[2] = (kz & 1) ? hl : -hl;
+          powers(h,pw.data());
+
+          const double *mc = mpole + (bigint)cell*nterms;
+          double *mp = mpole + (bigint)parent*nterms;
+          for (int s = 0; s < nshift; s++) {
+            const Term &term = shiftterm[s];
+            mp[term.to] += term.coeff * mc[term.from] * pw[term.with];
+          }
+        }
+  }
+
+  exchange_mpole();
+}
+
+/* ----------------------------------------------------------------------
+   complete the multipole moments of the cells that M2L of my cells needs
+   (locally essential tree) instead of summing the whole tree over procs
+   each proc needs per level the range of its cells extended to the
+     children of the neighbors of their parents, levels 0 and 1 are unused
+   procs send their partial moments and counts of cells in that range
+------------------------------------------------------------------------- */
+
+void FMM::exchange_mpole()
+{
+  const int n = 1 << nlevels;
+  const int nbox = 6*(MAXLEVEL+1);
+  const int nper = nterms + 2;
+
+  // range of leaf cells with my charges
+
+  int leafbox[6] = {n, n, n, -1, -1, -1};
+  for (int k = 0; k < nmine; k++) {
+    const int leaf = mineleaf[k];
+    const int ijk[3] = {leaf % n, (leaf / n) % n, leaf / (n*n)};
+    for (int d = 0; d < 3; d++) {
+      leafbox[d] = MIN(leafbox[d],ijk[d]);
+      leafbox[3+d] = MAX(leafbox[3+d],ijk[d]);
+    }
+  }
+
+  // range of cells I need on each level, empty if lo > hi
+
+  int box[6*(MAXLEVEL+1)];
+  for (int l = 0; l <= MAXLEVEL; l++) {
+    int *b = box + 6*l;
+    for (int d = 0; d < 3; d++) {
+      b[d] = 0;
+      b[3+d] = -1;
+    }
+    if ((l < 2) || (l > nlevels) || (nmine == 0)) continue;
+    const int nl = 1 << l;
+    for (int d = 0; d < 3; d++) {
+      const int lo = leafbox[d] >> (nlevels-l);
+      const int hi = leafbox[3+d] >> (nlevels-l);
+      b[d] = MAX(0,2*(lo/2-1));
+      b[3+d] = MIN(nl-1,2*(hi/2+1)+1);
+    }
+  }
+  MPI_Allgather(box,nbox,MPI_INT,needmpole,nbox,MPI_INT,world);
+
+  // count, then pack index, count, and moments of my cells needed by other procs
+
+  for (int pass = 0; pass < 2; pass++) {
+    int nsend = 0;
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      senddispl[iproc] = nsend;
+      if (iproc == me || nmine == 0) {
+        sendcount[iproc] = 0;
+        continue;
+      }
+      for (int l = 2; l <= nlevels; l++) {
+        const int *b = needmpole + nbox*iproc + 6*l;
+        const int nl = 1 << l;
+        const int xlo = MAX(b[0],leafbox[0] >> (nlevels-l));
+        const int ylo = MAX(b[1],leafbox[1] >> (nlevels-l));
+        const int zlo = MAX(b[2],leafbox[2] >> (nlevels-l));
+        const int xhi = MIN(b[3],leafbox[3] >> (nlevels-l));
+        const int yhi = MIN(b[4],leafbox[4] >> (nlevels-l));
+        const int zhi = MIN(b[5],leafbox[5] >> (nlevels-l));
+        for (int kz = zlo; kz <= zhi; kz++)
+          for (int ky = ylo; ky <= yhi; ky++)
+            for (int kx = xlo; kx <= xhi; kx++) {
+              const int cell = celloffset[l] + (kz*nl + ky)*nl + kx;
+              if (!mine[cell]) continue;
+              if (pass) {
+                double *buf = sendbuf + nsend;
+                buf[0] = cell;
+                buf[1] = count[cell];
+                memcpy(buf+2,mpole + (bigint)cell*nterms,sizeof(double)*nterms);
+              }
+              nsend += nper;
+            }
+      }
+      if (!pass) sendcount[iproc] = nsend - senddispl[iproc];
+    }
+
+    if (!pass && nsend > maxsend) {
+      maxsend = nsend;
+      memory->destroy(sendbuf);
+      memory->create(sendbuf,maxsend,"fmm:sendbuf");
+    }
+  }
+
+  MPI_Alltoall(sendcount,1,MPI_INT,recvcount,1,MPI_INT,world);
+
+  int nrecv = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    recvdispl[iproc] = nrecv;
+    nrecv += recvcount[iproc];
+  }
+
+  if (nrecv > maxrecv) {
+    maxrecv = nrecv;
+    memory->destroy(recvbuf);
+    memory->create(recvbuf,maxrecv,"fmm:recvbuf");
+  }
+
+  MPI_Alltoallv(sendbuf,sendcount,senddispl,MPI_DOUBLE,
+                recvbuf,recvcount,recvdispl,MPI_DOUBLE,world);
+
+  // add partial moments of other procs to mine
+
+  for (int m = 0; m < nrecv; m += nper) {
+    const double *buf = recvbuf + m;
+    const int cell = static_cast<int>(buf[0]);
+    count[cell] += static_cast<int>(buf[1]);
+    double *mc = mpole + (bigint)cell*nterms;
+    for (int t = 0; t < nterms; t++) mc[t] += buf[2+t];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   local expansions L_k of cells that hold my charges,
+   from well separated cells (M2L) and from their parents (L2L)
+   the interaction list of a cell are the children of the neighbors
+   of its parent, which are not neighbors of the cell itself
+------------------------------------------------------------------------- */
+
+void FMM::downward()
+{
+  std::vector<double> pw(nterms);
+  double h[3];
+
+  memset(local,0,sizeof(double)*ncells*nterms);
+
+  for (int l = 2; l <= nlevels; l++) {
+    const int nl = 1 << l;
+    const double hl = side/nl;
+
+    // Taylor coefficients for all offsets of target - source cell
+
+    for (int dz = -3; dz <= 3; dz++)
+      for (int dy = -3; dy <= 3; dy++)
+        for (int dx = -3; dx <= 3; dx++) {
+          if (abs(dx) <= 1 && abs(dy) <= 1 && abs(dz) <= 1) continue;
+          h[0] = dx*hl;
+          h[1] = dy*hl;
+          h[2] = dz*hl;
+          taylor(h,m2lcoeff + (((dz+3)*7 + dy+3)*7 + dx+3)*nterms);
+        }
+
+    for (int kz = 0; kz < nl; kz++)
+      for (int ky = 0; ky < nl; ky++)
+        for (int kx = 0; kx < nl; kx++) {
+          const int cell = celloffset[l] + (kz*nl + ky)*nl + kx;
+          if (!mine[cell]) continue;
+          double *lc = local + (bigint)cell*nterms;
+
+          // L2L from parent at c - h to child at c
+
+          if (l > 2) {
+            const int parent = celloffset[l-1] + ((kz/2)*(nl/2) + ky/2)*(nl/2) + kx/2;
+            const double *lp = local + (bigint)parent*nterms;
+            h[0] = (kx & 1) ? 0.25*hl*2.0 : -0.25*hl*2.0;
+            h[1] = (ky & 1) ? 0.25*hl*2.0 : -0.25*hl*2.0;
+            h[2] = (kz & 1) ? 0.25*hl*2.0 : -0.25*hl*2.0;
+            powers(h,pw.data());
+            for (int s = 0; s < nshift; s++) {
+              const Term &term = shiftterm[s];
+              lc[term.from] += term.coeff * lp[term.to] * pw[term.with];
+            }
+          }
+
+          // M2L from interaction list
+
+          const int jxlo = MAX(0,2*(kx/2-1)), jxhi = MIN(nl-1,2*(kx/2+1)+1);
+          const int jylo = MAX(0,2*(ky/2-1)), jyhi = MIN(nl-1,2*(ky/2+1)+1);
+          const int jzlo = MAX(0,2*(kz/2-1)), jzhi = MIN(nl-1,2*(kz/2+1)+1);
+
+          for (int jz = jzlo; jz <= jzhi; jz++)
+            for (int jy = jylo; jy <= jyhi; jy++)
+              for (int jx = jxlo; jx <= jxhi; jx++) {
+                if (abs(jx-kx) <= 1 && abs(jy-ky) <= 1 && abs(jz-kz) <= 1) continue;
+                const int src = celloffset[l] + (jz*nl + jy)*nl + jx;
+                if (!count[src]) continue;
+
+                const double *m = mpole + (bigint)src*nterms;
+                const double *a = m2lcoeff +
+                  (((kz-jz+3)*7 + ky-jy+3)*7 + kx-jx+3)*nterms;
+                for (int s = 0; s < nm2l; s++) {
+                  const Term &term = m2lterm[s];
+                  lc[term.to] += term.coeff * m[term.from] * a[term.with];
+                }
+              }
+        }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   send my charges to procs with charges in the same or adjacent leaf cells
+   near list = my charges followed by received ones, sorted by leaf cell
+------------------------------------------------------------------------- */
+
+void FMM::exchange_near()
+{
+  const int n = 1 << nlevels;
+  double **x = atom->x;
+  double *q = atom->q;
+
+  // range of leaf cells with my charges, extended by one cell
+
+  int box[6] = {n, n, n, -1, -1, -1};
+  for (int k = 0; k < nmine; k++) {
+    const int leaf = mineleaf[k];
+    const int ijk[3] = {leaf % n, (leaf / n) % n, leaf / (n*n)};
+    for (int d = 0; d < 3; d++) {
+      box[d] = MIN(box[d],ijk[d]-1);
+      box[3+d] = MAX(box[3+d],ijk[d]+1);
+    }
+  }
+  MPI_Allgather(box,6,MPI_INT,needbox,6,MPI_INT,world);
+
+  // count and pack charges for each proc
+
+  int nsend = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    sendcount[iproc] = 0;
+    if (iproc == me) continue;
+    const int *nbox = needbox + 6*iproc;
+    for (int k = 0; k < nmine; k++) {
+      const int leaf = mineleaf[k];
+      const int ijk[3] = {leaf % n, (leaf / n) % n, leaf / (n*n)};
+      if (ijk[0] < nbox[0] || ijk[0] > nbox[3] || ijk[1] < nbox[1] || ijk[1] > nbox[4] ||
+          ijk[2] < nbox[2] || ijk[2] > nbox[5]) continue;
+      sendcount[iproc] += 4;
+    }
+    nsend += sendcount[iproc];
+  }
+
+  if (nsend > maxsend) {
+    maxsend = nsend;
+    memory->destroy(sendbuf);
+    memory->create(sendbuf,maxsend,"fmm:sendbuf");
+  }
+
+  nsend = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    senddispl[iproc] = nsend;
+    if (!sendcount[iproc]) continue;
+    const int *nbox = needbox + 6*iproc;
+    for (int k = 0; k < nmine; k++) {
+      const int leaf = mineleaf[k];
+      const int ijk[3] = {leaf % n, (leaf / n) % n, leaf / (n*n)};
+      if (ijk[0] < nbox[0] || ijk[0] > nbox[3] || ijk[1] < nbox[1] || ijk[1] > nbox[4] ||
+          ijk[2] < nbox[2] || ijk[2] > nbox[5]) continue;
+      const int i = mineatom[k];
+      sendbuf[nsend++] = x[i][0];
+      sendbuf[nsend++] = x[i][1];
+      sendbuf[nsend++] = x[i][2];
+      sendbuf[nsend++] = q[i];
+    }
+  }
+
+  MPI_Alltoall(sendcount,1,MPI_INT,recvcount,1,MPI_INT,world);
+
+  int nrecv = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    recvdispl[iproc] = nrecv;
+    nrecv += recvcount[iproc];
+  }
+
+  nnear = nmine + nrecv/4;
+  if (nnear > maxnear) {
+    maxnear = nnear;
+    memory->destroy(xqnear);
+    memory->destroy(nearleaf);
+    memory->destroy(nearsort);
+    memory->create(xqnear,maxnear,4,"fmm:xqnear");
+    memory->create(nearleaf,maxnear,"fmm:nearleaf");
+    memory->create(nearsort,maxnear,"fmm:nearsort");
+  }
+
+  for (int k = 0; k < nmine; k++) {
+    const int i = mineatom[k];
+    xqnear[k][0] = x[i][0];
+    xqnear[k][1] = x[i][1];
+    xqnear[k][2] = x[i][2];
+    xqnear[k][3] = q[i];
+    nearleaf[k] = mineleaf[k];
+  }
+
+  double *recvbuf = (nnear > 0) ? xqnear[nmine] : nullptr;
+  MPI_Alltoallv(sendbuf,sendcount,senddispl,MPI_DOUBLE,
+                recvbuf,recvcount,recvdispl,MPI_DOUBLE,world);
+
+  int ijk[3];
+  for (int k = nmine; k < nnear; k++) {
+    leaf_coords(xqnear[k],ijk);
+    nearleaf[k] = (ijk[2]*n + ijk[1])*n + ijk[0];
+  }
+
+  // counting sort by leaf cell
+
+  const int nleaves = n*n*n;
+  if (nleaves+1 > maxleaves) {
+    maxleaves = nleaves+1;
+    memory->destroy(leafstart);
+    memory->create(leafstart,maxleaves,"fmm:leafstart");
+  }
+
+  for (int c = 0; c <= nleaves; c++) leafstart[c] = 0;
+  for (int k = 0; k < nnear; k++) leafstart[nearleaf[k]+1]++;
+  for (int c = 1; c <= nleaves; c++) leafstart[c] += leafstart[c-1];
+  for (int k = 0; k < nnear; k++) nearsort[leafstart[nearleaf[k]]++] = k;
+  for (int c = nleaves; c > 0; c--) leafstart[c] = leafstart[c-1];
+  leafstart[0] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   direct sum over charges in the same and adjacent leaf cells
+   within the cutoff only the long-range part erf(g r)/r is added,
+   since the pair style computes erfc(g r)/r
+------------------------------------------------------------------------- */
+
+void FMM::near_field()
+{
+  const double * const * const xq = xqnear;
+  const int n = 1 << nlevels;
+  const double cutsq = cutoff*cutoff;
+  const double g2pis = 2.0*g_ewald/MY_PIS;
+
+  for (int k = 0; k < nmine; k++) {
+    const double xk = xq[k][0];
+    const double yk = xq[k][1];
+    const double zk = xq[k][2];
+    const int leaf = mineleaf[k];
+    const int kx = leaf % n;
+    const int ky = (leaf / n) % n;
+    const int kz = leaf / (n*n);
+    double pot = 0.0, ex = 0.0, ey = 0.0, ez = 0.0;
+
+    for (int jz = MAX(0,kz-1); jz <= MIN(n-1,kz+1); jz++)
+      for (int jy = MAX(0,ky-1); jy <= MIN(n-1,ky+1); jy++)
+        for (int jx = MAX(0,kx-1); jx <= MIN(n-1,kx+1); jx++) {
+          const int c = (jz*n + jy)*n + jx;
+          for (int s = leafstart[c]; s < leafstart[c+1]; s++) {
+            const int j = nearsort[s];
+            if (j == k) continue;
+            const double delx = xk - xq[j][0];
+            const double dely = yk - xq[j][1];
+            const double delz = zk - xq[j][2];
+            const double rsq = delx*delx + dely*dely + delz*delz;
+            const double r = sqrt(rsq);
+            double kernel, fpair;
+            if (rsq < cutsq) {
+              const double grij = g_ewald*r;
+              kernel = (1.0 - erfc(grij))/r;
+              fpair = (kernel - g2pis*exp(-grij*grij))/rsq;
+            } else {
+              kernel = 1.0/r;
+              fpair = kernel/rsq;
+            }
+            pot += xq[j][3]*kernel;
+            fpair *= xq[j][3];
+            ex += delx*fpair;
+            ey += dely*fpair;
+            ez += delz*fpair;
+          }
+        }
+
+    phi[k] = pot;
+    efield[k][0] = ex;
+    efield[k][1] = ey;
+    efield[k][2] = ez;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   evaluate local expansions of leaf cells at my charges (L2P)
+------------------------------------------------------------------------- */
+
+void FMM::far_field()
+{
+  if (nlevels < 2) return;
+
+  const double * const * const xq = xqnear;
+  const int n = 1 << nlevels;
+  const int leaf0 = celloffset[nlevels];
+  std::vector<double> pw(nterms);
+  double c[3], h[3];
+
+  for (int k = 0; k < nmine; k++) {
+    const int leaf = mineleaf[k];
+    cell_center(nlevels,leaf % n,(leaf / n) % n,leaf / (n*n),c);
+    for (int d = 0; d < 3; d++) h[d] = xq[k][d] - c[d];
+    powers(h,pw.data());
+
+    const double *lc = local + (bigint)(leaf0+leaf)*nterms;
+    double pot = 0.0, ex = 0.0, ey = 0.0, ez = 0.0;
+    for (int t = 0; t < nterms; t++) {
+      pot += lc[t]*pw[t];
+      const int *kt = kvec[t];
+      if (kt[0]) ex -= kt[0]*lc[t]*pw[gradindex[t][0]];
+      if (kt[1]) ey -= kt[1]*lc[t]*pw[gradindex[t][1]];
+      if (kt[2]) ez -= kt[2]*lc[t]*pw[gradindex[t][2]];
+    }
+    phi[k] += pot;
+    efield[k][0] += ex;
+    efield[k][1] += ey;
+    efield[k][2] += ez;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local arrays
+------------------------------------------------------------------------- */
+
+double FMM::memory_usage()
+{
+  double bytes = 2.0*maxcells*nterms * sizeof(double);
+  bytes += 2.0*maxcells * sizeof(int);
+  bytes += (double)NOFFSET*nterms * sizeof(double);
+  bytes += (double)(nshift + nm2l) * sizeof(Term);
+  bytes += (double)maxmine * (2*sizeof(int) + 4*sizeof(double));
+  bytes += (double)maxnear * (4*sizeof(double) + 2*sizeof(int));
+  bytes += (double)maxleaves * sizeof(int);
+  bytes += (double)(maxsend + maxrecv) * sizeof(double);
+  return bytes;
+}
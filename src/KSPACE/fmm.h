@@ -0,0 +1,112 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef KSPACE_CLASS
+// clang-format off
+KSpaceStyle(fmm,FMM);
+// clang-format on
+#else
+
+#ifndef LMP_FMM_H
+#define LMP_FMM_H
+
+#include "kspace.h"
+
+namespace LAMMPS_NS {
+
+class FMM : public KSpace {
+ public:
+  FMM(class LAMMPS *);
+  ~FMM() override;
+  void settings(int, char **) override;
+  void init() override;
+  void setup() override;
+  void compute(int, int) override;
+  int modify_param(int, char **) override;
+  double memory_usage() override;
+
+ protected:
+  int me, nprocs;
+  double cutoff;    // real-space Coulomb cutoff of pair style
+  int nleaf;        // target # of charges per leaf cell
+
+  // octree, level 0 is the root cell, leaves are at level nlevels
+
+  int nlevels;
+  double treelo[3];      // lower corner of root cell
+  double side;           // edge length of root cell
+  int ncells;            // # of cells in all levels
+  int maxcells;          // allocated # of cells
+  int *celloffset;       // index of first cell of each level
+  int *count;            // # of charges in each cell, summed over procs
+  int *mine;             // 1 if cell holds my charges
+  double *mpole;         // multipole moments of each cell
+  double *local;         // local expansion of each cell
+  double *m2lcoeff;      // Taylor coefficients of 1/r for M2L offsets of one level
+
+  // expansion coefficients are indexed by multi-indices k = (kx,ky,kz)
+  //   with |k| = kx+ky+kz <= order, ordered by |k|
+
+  int nterms;
+  int **kvec;            // exponents of each multi-index
+  int ***kindex;         // index of each multi-index
+  int *powfrom, *powdim; // h^k = h^powfrom[k] * h[powdim[k]]
+  int **gradindex;       // index of k - e_d, -1 if k_d = 0
+
+  struct Term {
+    int to, from, with;
+    double coeff;
+  };
+  Term *shiftterm, *m2lterm;    // index and coefficient triplets of M2M/L2L and M2L
+  int nshift, nm2l;
+
+  // my charges and those in neighboring leaf cells of other procs
+
+  int nmine, maxmine;
+  int *mineatom;         // local index of my charges
+  int *mineleaf;         // leaf cell of my charges
+  int nnear, maxnear;
+  double **xqnear;       // coords and charge of my charges followed by others
+  int *nearleaf;
+  int *leafstart;        // index of first charge of each leaf in sorted list
+  int maxleaves;
+  int *nearsort;         // near charges sorted by leaf cell
+  double **efield;       // electric field on my charges
+  double *phi;           // potential at my charges
+  double *sendbuf, *recvbuf;
+  int maxsend, maxrecv;
+  int *sendcount, *senddispl, *recvcount, *recvdispl;
+  int *needbox;          // range of leaf cells each proc needs charges from
+  int *needmpole;        // range of cells on each level each proc needs moments of
+
+  void set_tree();
+  void allocate();
+  void allocate_terms();
+  void deallocate_terms();
+  void grow_cells();
+  void leaf_coords(const double *, int *);
+  void powers(const double *, double *);
+  void cell_center(int, int, int, int, double *);
+  void taylor(const double *, double *);
+  void upward();
+  void exchange_mpole();
+  void downward();
+  void exchange_near();
+  void near_field();
+  void far_field();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
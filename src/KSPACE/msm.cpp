@@ -39,8 +39,8 @@ using namespace MathConst;
 static constexpr int MAX_LEVELS = 10;
 static constexpr int OFFSET = 16384;
 
-enum { REVERSE_RHO, REVERSE_AD, REVERSE_AD_PERATOM };
-enum { FORWARD_RHO, FORWARD_AD, FORWARD_AD_PERATOM };
+enum { REVERSE_RHO, REVERSE_AD, REVERSE_AD_PERATOM, REVERSE_AD_ALL };
+enum { FORWARD_RHO, FORWARD_AD, FORWARD_AD_PERATOM, FORWARD_AD_ALL };
 
 /* ---------------------------------------------------------------------- */
 
@@ -447,33 +447,57 @@ void MSM::compute(int eflag, int vflag)
                       gcall_buf1,gcall_buf2,MPI_DOUBLE);
 
   // forward communicate charge density values to fill ghost grid points
-  // compute direct sum interaction and then restrict to coarser grid
+  // restrict to coarser grid and start its ghost comm, then compute
+  //   direct sum interaction while the coarser grid messages are in flight
+  // started = 1 if ghost comm of current level was started by finer level
+
+  int started = 0;
 
   for (int n=0; n<=levels-2; n++) {
     if (!active_flag[n]) continue;
     current_level = n;
-    gc[n]->forward_comm(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
-                        gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
-    direct(n);
+    if (started)
+      gc[n]->forward_comm_finish(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
+                                 gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
+    else
+      gc[n]->forward_comm(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
+                          gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
     restriction(n);
+
+    // top grid level for periodic is filled by grid_swap_forward() instead
+
+    started = active_flag[n+1] && (n+1 < levels-1 || domain->nonperiodic);
+    if (started) {
+      current_level = n+1;
+      gc[n+1]->forward_comm_start(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
+                                  gc_buf1[n+1],gc_buf2[n+1],MPI_DOUBLE);
+    }
+    direct(n);
   }
 
   // compute direct interation for top grid level for non-periodic
   //   and for second from top grid level for periodic
+  // energy and per-atom virial ghost values are summed in a single comm
 
   if (active_flag[levels-1]) {
     if (domain->nonperiodic) {
       current_level = levels-1;
-      gc[levels-1]->
-        forward_comm(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
-                     gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
+      if (started)
+        gc[levels-1]->
+          forward_comm_finish(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
+                              gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
+      else
+        gc[levels-1]->
+          forward_comm(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
+                       gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
       direct_top(levels-1);
-      gc[levels-1]->
-        reverse_comm(Grid3d::KSPACE,this,REVERSE_AD,1,sizeof(double),
-                     gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
       if (vflag_atom)
         gc[levels-1]->
-          reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_PERATOM,6,sizeof(double),
+          reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_ALL,7,sizeof(double),
+                       gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
+      else
+        gc[levels-1]->
+          reverse_comm(Grid3d::KSPACE,this,REVERSE_AD,1,sizeof(double),
                        gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
 
     } else {
@@ -497,27 +521,27 @@ void MSM::compute(int eflag, int vflag)
     prolongation(n);
 
     current_level = n;
-    gc[n]->reverse_comm(Grid3d::KSPACE,this,REVERSE_AD,1,sizeof(double),
-                        gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
 
-    // extra per-atom virial communication
+    // per-atom virial is summed together with energy in one comm
 
     if (vflag_atom)
-      gc[n]->reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_PERATOM,6,sizeof(double),
+      gc[n]->reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_ALL,7,sizeof(double),
+                          gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
+    else
+      gc[n]->reverse_comm(Grid3d::KSPACE,this,REVERSE_AD,1,sizeof(double),
                           gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
   }
 
   // all procs communicate E-field values
   // to fill ghost cells surrounding their 3d bricks
+  // per-atom energy/virial is sent together with the E-field values
 
   current_level = 0;
-  gcall->forward_comm(Grid3d::KSPACE,this,FORWARD_AD,1,sizeof(double),
-                      gcall_buf1,gcall_buf2,MPI_DOUBLE);
-
-  // extra per-atom energy/virial communication
-
   if (vflag_atom)
-    gcall->forward_comm(Grid3d::KSPACE,this,FORWARD_AD_PERATOM,6,sizeof(double),
+    gcall->forward_comm(Grid3d::KSPACE,this,FORWARD_AD_ALL,7,sizeof(double),
+                        gcall_buf1,gcall_buf2,MPI_DOUBLE);
+  else
+    gcall->forward_comm(Grid3d::KSPACE,this,FORWARD_AD,1,sizeof(double),
                         gcall_buf1,gcall_buf2,MPI_DOUBLE);
 
   // calculate the force on my particles (interpolation)
@@ -679,7 +703,7 @@ void MSM::allocate_peratom()
 
   // create commgrid object for per-atom virial using all processors
 
-  npergrid = 6;
+  npergrid = 7;
   memory->destroy(gcall_buf1);
   memory->destroy(gcall_buf2);
   memory->create(gcall_buf1,npergrid*ngcall_buf1,"pppm:gcall_buf1");
@@ -704,7 +728,7 @@ void MSM::allocate_peratom()
     // create commgrid object for per-atom virial
 
     if (active_flag[n]) {
-      npergrid = 6;
+      npergrid = 7;
       memory->destroy(gc_buf1[n]);
       memory->destroy(gc_buf2[n]);
       memory->create(gc_buf1[n],npergrid*ngc_buf1[n],"pppm:gc_buf1");
@@ -2237,19 +2261,16 @@ void MSM::direct_peratom_top(int n)
 }
 
 /* ----------------------------------------------------------------------
-   MSM restriction procedure for intermediate grid levels, interpolate
-   charges from finer grid to coarser grid
+   set up 1d restriction/prolongation weights between level n and n+1
+   store offsets of stencil points on finer grid in index
+   return # of stencil points
 ------------------------------------------------------------------------- */
 
-void MSM::restriction(int n)
+int MSM::setup_stencil(int n, int *index)
 {
   const int p = order-1;
 
-  double ***qgrid1 = qgrid[n];
-  double ***qgrid2 = qgrid[n+1];
-
   int k = 0;
-  int *index = new int[p+2];
   for (int nu=-p; nu<=p; nu++) {
     if (nu%2 == 0 && nu != 0) continue;
     phi1d[0][k] = compute_phi(nu*delxinv[n+1]/delxinv[n]);
@@ -2258,6 +2279,24 @@ void MSM::restriction(int n)
     index[k] = nu;
     k++;
   }
+  return k;
+}
+
+/* ----------------------------------------------------------------------
+   MSM restriction procedure for intermediate grid levels, interpolate
+   charges from finer grid to coarser grid
+------------------------------------------------------------------------- */
+
+void MSM::restriction(int n)
+{
+  const int p = order-1;
+
+  double ***qgrid1 = qgrid[n];
+  double ***qgrid2 = qgrid[n+1];
+
+  int k;
+  int *index = new int[p+2];
+  setup_stencil(n,index);
 
   int ip,jp,kp,ic,jc,kc,i,j;
   int ii,jj,kk;
@@ -2332,16 +2371,9 @@ void MSM::prolongation(int n)
   double ***v5grid1 = v5grid[n];
   double ***v5grid2 = v5grid[n+1];
 
-  int k = 0;
+  int k;
   int *index = new int[p+2];
-  for (int nu=-p; nu<=p; nu++) {
-    if (nu%2 == 0 && nu != 0) continue;
-    phi1d[0][k] = compute_phi(nu*delxinv[n+1]/delxinv[n]);
-    phi1d[1][k] = compute_phi(nu*delyinv[n+1]/delyinv[n]);
-    phi1d[2][k] = compute_phi(nu*delzinv[n+1]/delzinv[n]);
-    index[k] = nu;
-    k++;
-  }
+  setup_stencil(n,index);
 
   int ip,jp,kp,ic,jc,kc,i,j;
   int ii,jj,kk;
@@ -2552,6 +2584,30 @@ void MSM::pack_forward_grid(int flag, void *vbuf, int nlist, int *list)
       buf[k++] = v4src[list[i]];
       buf[k++] = v5src[list[i]];
     }
+  } else if (flag == FORWARD_AD_ALL) {
+    double ***egridn = egrid[n];
+    double ***v0gridn = v0grid[n];
+    double ***v1gridn = v1grid[n];
+    double ***v2gridn = v2grid[n];
+    double ***v3gridn = v3grid[n];
+    double ***v4gridn = v4grid[n];
+    double ***v5gridn = v5grid[n];
+    double *esrc = &egridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v0src = &v0gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v1src = &v1gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v2src = &v2gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v3src = &v3gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v4src = &v4gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v5src = &v5gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    for (int i = 0; i < nlist; i++) {
+      buf[k++] = esrc[list[i]];
+      buf[k++] = v0src[list[i]];
+      buf[k++] = v1src[list[i]];
+      buf[k++] = v2src[list[i]];
+      buf[k++] = v3src[list[i]];
+      buf[k++] = v4src[list[i]];
+      buf[k++] = v5src[list[i]];
+    }
   }
 }
 
@@ -2598,6 +2654,30 @@ void MSM::unpack_forward_grid(int flag, void *vbuf, int nlist, int *list)
       v4src[list[i]] = buf[k++];
       v5src[list[i]] = buf[k++];
     }
+  } else if (flag == FORWARD_AD_ALL) {
+    double ***egridn = egrid[n];
+    double ***v0gridn = v0grid[n];
+    double ***v1gridn = v1grid[n];
+    double ***v2gridn = v2grid[n];
+    double ***v3gridn = v3grid[n];
+    double ***v4gridn = v4grid[n];
+    double ***v5gridn = v5grid[n];
+    double *esrc = &egridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v0src = &v0gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v1src = &v1gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v2src = &v2gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v3src = &v3gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v4src = &v4gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v5src = &v5gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    for (int i = 0; i < nlist; i++) {
+      esrc[list[i]] = buf[k++];
+      v0src[list[i]] = buf[k++];
+      v1src[list[i]] = buf[k++];
+      v2src[list[i]] = buf[k++];
+      v3src[list[i]] = buf[k++];
+      v4src[list[i]] = buf[k++];
+      v5src[list[i]] = buf[k++];
+    }
   }
 }
 
@@ -2644,6 +2724,30 @@ void MSM::pack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
       buf[k++] = v4src[list[i]];
       buf[k++] = v5src[list[i]];
     }
+  } else if (flag == REVERSE_AD_ALL) {
+    double ***egridn = egrid[n];
+    double ***v0gridn = v0grid[n];
+    double ***v1gridn = v1grid[n];
+    double ***v2gridn = v2grid[n];
+    double ***v3gridn = v3grid[n];
+    double ***v4gridn = v4grid[n];
+    double ***v5gridn = v5grid[n];
+    double *esrc = &egridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v0src = &v0gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v1src = &v1gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v2src = &v2gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v3src = &v3gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v4src = &v4gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v5src = &v5gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    for (int i = 0; i < nlist; i++) {
+      buf[k++] = esrc[list[i]];
+      buf[k++] = v0src[list[i]];
+      buf[k++] = v1src[list[i]];
+      buf[k++] = v2src[list[i]];
+      buf[k++] = v3src[list[i]];
+      buf[k++] = v4src[list[i]];
+      buf[k++] = v5src[list[i]];
+    }
   }
 }
 
@@ -2690,6 +2794,30 @@ void MSM::unpack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
       v4src[list[i]] += buf[k++];
       v5src[list[i]] += buf[k++];
     }
+  } else if (flag == REVERSE_AD_ALL) {
+    double ***egridn = egrid[n];
+    double ***v0gridn = v0grid[n];
+    double ***v1gridn = v1grid[n];
+    double ***v2gridn = v2grid[n];
+    double ***v3gridn = v3grid[n];
+    double ***v4gridn = v4grid[n];
+    double ***v5gridn = v5grid[n];
+    double *esrc = &egridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v0src = &v0gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v1src = &v1gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v2src = &v2gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v3src = &v3gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v4src = &v4gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    double *v5src = &v5gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]];
+    for (int i = 0; i < nlist; i++) {
+      esrc[list[i]] += buf[k++];
+      v0src[list[i]] += buf[k++];
+      v1src[list[i]] += buf[k++];
+      v2src[list[i]] += buf[k++];
+      v3src[list[i]] += buf[k++];
+      v4src[list[i]] += buf[k++];
+      v5src[list[i]] += buf[k++];
+    }
   }
 }
 
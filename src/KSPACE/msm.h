@@ -117,8 +117,9 @@ class MSM : public KSpace {
   void direct_peratom(int);
   void direct_top(int);
   void direct_peratom_top(int);
-  void restriction(int);
-  void prolongation(int);
+  int setup_stencil(int, int *);
+  virtual void restriction(int);
+  virtual void prolongation(int);
   void grid_swap_forward(int, double ***&);
   void grid_swap_reverse(int, double ***&);
   virtual void fieldforce();
@@ -37,6 +37,7 @@ using namespace EwaldConst;
 PairBuckCoulLong::PairBuckCoulLong(LAMMPS *lmp) : Pair(lmp)
 {
   ewaldflag = pppmflag = 1;
+  overlap_enable = 1;
   writedata = 1;
   ftable = nullptr;
   cut_lj = nullptr;
@@ -38,6 +38,7 @@ using namespace EwaldConst;
 PairCoulLong::PairCoulLong(LAMMPS *lmp) : Pair(lmp)
 {
   ewaldflag = pppmflag = 1;
+  overlap_enable = 1;
   ftable = nullptr;
   qdist = 0.0;
   cut_respa = nullptr;
@@ -44,8 +44,12 @@ PairLJCutCoulLong::PairLJCutCoulLong(LAMMPS *lmp) : Pair(lmp)
 {
   ewaldflag = pppmflag = 1;
   respa_enable = 1;
+  overlap_enable = 1;
+  mixed_prec_enable = 1;
   writedata = 1;
   ftable = nullptr;
+  cutsqf = cut_ljsqf = nullptr;
+  lj1f = lj2f = lj3f = lj4f = offsetf = nullptr;
   qdist = 0.0;
   cut_respa = nullptr;
 }
@@ -71,22 +75,55 @@ PairLJCutCoulLong::~PairLJCutCoulLong()
     memory->destroy(offset);
   }
   if (ftable) free_tables();
+
+  memory->destroy(cutsqf);
+  memory->destroy(cut_ljsqf);
+  memory->destroy(lj1f);
+  memory->destroy(lj2f);
+  memory->destroy(lj3f);
+  memory->destroy(lj4f);
+  memory->destroy(offsetf);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairLJCutCoulLong::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  if (mixed_prec_flag) {
+    coeff_single(cutsqf,cutsq);
+    coeff_single(cut_ljsqf,cut_ljsq);
+    coeff_single(lj1f,lj1);
+    coeff_single(lj2f,lj2);
+    coeff_single(lj3f,lj3);
+    coeff_single(lj4f,lj4);
+    coeff_single(offsetf,offset);
+    eval<float>(eflag);
+  } else eval<double>(eflag);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   force kernel with distances and forces in precision flt_t
+   coords are read in double, their differences are stored in flt_t
+   per-atom forces and energies are accumulated in double
+   Coulomb lookup tables are always in double precision
+------------------------------------------------------------------------- */
+
+template <class flt_t> void PairLJCutCoulLong::eval(int eflag)
 {
   int i,ii,j,jj,inum,jnum,itype,jtype,itable;
-  double qtmp,xtmp,ytmp,ztmp,delx,dely,delz,evdwl,ecoul,fpair;
+  double qtmp,xtmp,ytmp,ztmp,evdwl,ecoul;
   double fraction,table;
-  double r,r2inv,r6inv,forcecoul,forcelj,factor_coul,factor_lj;
-  double grij,expm2,prefactor,t,erfc;
+  flt_t delx,dely,delz,fpair;
+  flt_t r,r2inv,r6inv,forcecoul,forcelj,factor_coul,factor_lj;
+  flt_t grij,expm2,prefactor,t,erfc;
   int *ilist,*jlist,*numneigh,**firstneigh;
-  double rsq;
+  flt_t rsq;
 
   evdwl = ecoul = 0.0;
-  ev_init(eflag,vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -98,6 +135,19 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
   int newton_pair = force->newton_pair;
   double qqrd2e = force->qqrd2e;
 
+  flt_t **cutsq_p = coeff_prec(cutsq,cutsqf,flt_t());
+  flt_t **cut_ljsq_p = coeff_prec(cut_ljsq,cut_ljsqf,flt_t());
+  flt_t **lj1_p = coeff_prec(lj1,lj1f,flt_t());
+  flt_t **lj2_p = coeff_prec(lj2,lj2f,flt_t());
+  flt_t **lj3_p = coeff_prec(lj3,lj3f,flt_t());
+  flt_t **lj4_p = coeff_prec(lj4,lj4f,flt_t());
+  flt_t **offset_p = coeff_prec(offset,offsetf,flt_t());
+  const flt_t cut_coulsq_p = cut_coulsq;
+  const flt_t tabinnersq_p = tabinnersq;
+  const flt_t g_ewald_p = g_ewald;
+  const flt_t ewald_p = EWALD_P, ewald_f = EWALD_F;
+  const flt_t a1 = A1, a2 = A2, a3 = A3, a4 = A4, a5 = A5;
+
   inum = list->inum;
   ilist = list->ilist;
   numneigh = list->numneigh;
@@ -127,19 +177,19 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
       rsq = delx*delx + dely*dely + delz*delz;
       jtype = type[j];
 
-      if (rsq < cutsq[itype][jtype]) {
-        r2inv = 1.0/rsq;
-
-        if (rsq < cut_coulsq) {
-          if (!ncoultablebits || rsq <= tabinnersq) {
-            r = sqrt(rsq);
-            grij = g_ewald * r;
-            expm2 = exp(-grij*grij);
-            t = 1.0 / (1.0 + EWALD_P*grij);
-            erfc = t * (A1+t*(A2+t*(A3+t*(A4+t*A5)))) * expm2;
-            prefactor = qqrd2e * qtmp*q[j]/r;
-            forcecoul = prefactor * (erfc + EWALD_F*grij*expm2);
-            if (factor_coul < 1.0) forcecoul -= (1.0-factor_coul)*prefactor;
+      if (rsq < cutsq_p[itype][jtype]) {
+        r2inv = (flt_t) 1.0/rsq;
+
+        if (rsq < cut_coulsq_p) {
+          if (!ncoultablebits || rsq <= tabinnersq_p) {
+            r = std::sqrt(rsq);
+            grij = g_ewald_p * r;
+            expm2 = std::exp(-grij*grij);
+            t = (flt_t) 1.0 / ((flt_t) 1.0 + ewald_p*grij);
+            erfc = t * (a1+t*(a2+t*(a3+t*(a4+t*a5)))) * expm2;
+            prefactor = (flt_t) (qqrd2e * qtmp*q[j]) / r;
+            forcecoul = prefactor * (erfc + ewald_f*grij*expm2);
+            if (factor_coul < 1.0) forcecoul -= ((flt_t) 1.0-factor_coul)*prefactor;
           } else {
             union_int_float_t rsq_lookup;
             rsq_lookup.f = rsq;
@@ -151,14 +201,14 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
             if (factor_coul < 1.0) {
               table = ctable[itable] + fraction*dctable[itable];
               prefactor = qtmp*q[j] * table;
-              forcecoul -= (1.0-factor_coul)*prefactor;
+              forcecoul -= ((flt_t) 1.0-factor_coul)*prefactor;
             }
           }
         } else forcecoul = 0.0;
 
-        if (rsq < cut_ljsq[itype][jtype]) {
+        if (rsq < cut_ljsq_p[itype][jtype]) {
           r6inv = r2inv*r2inv*r2inv;
-          forcelj = r6inv * (lj1[itype][jtype]*r6inv - lj2[itype][jtype]);
+          forcelj = r6inv * (lj1_p[itype][jtype]*r6inv - lj2_p[itype][jtype]);
         } else forcelj = 0.0;
 
         fpair = (forcecoul + factor_lj*forcelj) * r2inv;
@@ -173,8 +223,8 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
         }
 
         if (eflag) {
-          if (rsq < cut_coulsq) {
-            if (!ncoultablebits || rsq <= tabinnersq)
+          if (rsq < cut_coulsq_p) {
+            if (!ncoultablebits || rsq <= tabinnersq_p)
               ecoul = prefactor*erfc;
             else {
               table = etable[itable] + fraction*detable[itable];
@@ -183,9 +233,9 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
             if (factor_coul < 1.0) ecoul -= (1.0-factor_coul)*prefactor;
           } else ecoul = 0.0;
 
-          if (rsq < cut_ljsq[itype][jtype]) {
-            evdwl = r6inv*(lj3[itype][jtype]*r6inv-lj4[itype][jtype]) -
-              offset[itype][jtype];
+          if (rsq < cut_ljsq_p[itype][jtype]) {
+            evdwl = r6inv*(lj3_p[itype][jtype]*r6inv-lj4_p[itype][jtype]) -
+              offset_p[itype][jtype];
             evdwl *= factor_lj;
           } else evdwl = 0.0;
         }
@@ -195,8 +245,6 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
       }
     }
   }
-
-  if (vflag_fdotr) virial_fdotr_compute();
 }
 
 /* ---------------------------------------------------------------------- */
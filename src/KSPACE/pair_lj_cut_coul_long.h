@@ -56,8 +56,11 @@ class PairLJCutCoulLong : public Pair {
   double *cut_respa;
   double qdist;    // TIP4P distance from O site to negative charge
   double g_ewald;
+  float **cutsqf, **cut_ljsqf;    // for mixed precision
+  float **lj1f, **lj2f, **lj3f, **lj4f, **offsetf;
 
   virtual void allocate();
+  template <class flt_t> void eval(int);
 };
 
 }    // namespace LAMMPS_NS
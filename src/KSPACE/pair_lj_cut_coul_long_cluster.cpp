@@ -0,0 +1,339 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_coul_long_cluster.h"
+
+#include "atom.h"
+#include "error.h"
+#include "ewald_const.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace EwaldConst;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCoulLongCluster::PairLJCutCoulLongCluster(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
+{
+  respa_enable = 0;
+  overlap_enable = 0;
+  mixed_prec_enable = 0;
+  no_virial_fdotr_compute = 1;
+  clustersize = 4;
+  maxpack = 0;
+  xpack = nullptr;
+  typepack = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCoulLongCluster::~PairLJCutCoulLongCluster()
+{
+  if (copymode) return;
+
+  memory->destroy(xpack);
+  memory->destroy(typepack);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCoulLongCluster::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  pack_clusters();
+
+  if (clustersize == 8) {
+    if (evflag) eval<8, 1>();
+    else eval<8, 0>();
+  } else {
+    if (evflag) eval<4, 1>();
+    else eval<4, 0>();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy coords, charges and types into cluster order
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulLongCluster::pack_clusters()
+{
+  const int csize = clustersize;
+  const int nclus = list->nclus;
+  const int *clatom = list->clatom;
+  double **x = atom->x;
+  double *q = atom->q;
+  int *type = atom->type;
+
+  if (nclus > maxpack) {
+    maxpack = list->maxclus;
+    memory->destroy(xpack);
+    memory->destroy(typepack);
+    memory->create(xpack, 4 * csize * maxpack, "pair:xpack");
+    memory->create(typepack, csize * maxpack, "pair:typepack");
+  }
+
+  for (int c = 0; c < nclus; c++) {
+    double *xc = &xpack[4 * csize * c];
+    int *tc = &typepack[csize * c];
+    for (int m = 0; m < csize; m++) {
+      const int i = clatom[c * csize + m];
+      if (i >= 0) {
+        xc[m] = x[i][0];
+        xc[csize + m] = x[i][1];
+        xc[2 * csize + m] = x[i][2];
+        xc[3 * csize + m] = q[i];
+        tc[m] = type[i];
+      } else {
+        xc[m] = xc[csize + m] = xc[2 * csize + m] = xc[3 * csize + m] = 0.0;
+        tc[m] = 1;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   cluster-pair kernel, full list, forces only on owned I atoms
+   Coulomb uses the analytic erfc() approximation, no tables
+------------------------------------------------------------------------- */
+
+template <int CSIZE, int EVFLAG> void PairLJCutCoulLongCluster::eval()
+{
+  int i, j, ii, jj, jnum, itype, jtype;
+  double qtmp, xtmp, ytmp, ztmp, delx, dely, delz, rsq, r2inv, r6inv, r;
+  double forcecoul, forcelj, fpair, factor_coul, factor_lj;
+  double grij, expm2, prefactor, t, erfc;
+  double evdwl = 0.0, ecoul = 0.0;
+  int *jlist;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  double *q = atom->q;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double *special_coul = force->special_coul;
+  double *special_lj = force->special_lj;
+  const double qqrd2e = force->qqrd2e;
+
+  const int stride = 1 + list->cmaskwords;
+  const int *_noalias clatom = list->clatom;
+  const double *_noalias xp = xpack;
+  const int *_noalias tp = typepack;
+
+  for (ii = 0; ii < list->cinum; ii++) {
+    const int ci = list->cilist[ii];
+    const double *_noalias xi = &xp[4 * CSIZE * ci];
+    const int *_noalias ti = &tp[CSIZE * ci];
+    const int *jclist = list->cfirstneigh[ci];
+    const int jcnum = list->cnumneigh[ci];
+
+    double fxi[CSIZE], fyi[CSIZE], fzi[CSIZE];
+    for (int mi = 0; mi < CSIZE; mi++) fxi[mi] = fyi[mi] = fzi[mi] = 0.0;
+
+    for (jj = 0; jj < jcnum; jj++) {
+      const int *entry = &jclist[jj * stride];
+      const int cj = entry[0];
+      uint64_t bits = static_cast<uint32_t>(entry[1]);
+      if (CSIZE == 8) bits |= static_cast<uint64_t>(static_cast<uint32_t>(entry[2])) << 32;
+
+      const double *_noalias xj = &xp[4 * CSIZE * cj];
+      const int *_noalias tj = &tp[CSIZE * cj];
+
+      for (int mi = 0; mi < CSIZE; mi++) {
+        const unsigned int ibits = (bits >> (mi * CSIZE)) & ((1U << CSIZE) - 1);
+        if (!ibits) continue;
+
+        xtmp = xi[mi];
+        ytmp = xi[CSIZE + mi];
+        ztmp = xi[2 * CSIZE + mi];
+        qtmp = qqrd2e * xi[3 * CSIZE + mi];
+        itype = ti[mi];
+        const double *_noalias cutsqi = cutsq[itype];
+        const double *_noalias cut_ljsqi = cut_ljsq[itype];
+        const double *_noalias lj1i = lj1[itype];
+        const double *_noalias lj2i = lj2[itype];
+
+        double sfx = 0.0, sfy = 0.0, sfz = 0.0;
+        for (int mj = 0; mj < CSIZE; mj++) {
+          delx = xtmp - xj[mj];
+          dely = ytmp - xj[CSIZE + mj];
+          delz = ztmp - xj[2 * CSIZE + mj];
+          rsq = delx * delx + dely * dely + delz * delz;
+          jtype = tj[mj];
+          const bool inter = ((ibits >> mj) & 1U) && (rsq < cutsqi[jtype]);
+          const bool incoul = inter && (rsq < cut_coulsq);
+          const bool inlj = inter && (rsq < cut_ljsqi[jtype]);
+          const double rsqsafe = inter ? rsq : 1.0;
+
+          r2inv = 1.0 / rsqsafe;
+          r = sqrt(rsqsafe);
+          grij = g_ewald * r;
+          expm2 = exp(-grij * grij);
+          t = 1.0 / (1.0 + EWALD_P * grij);
+          erfc = t * (A1 + t * (A2 + t * (A3 + t * (A4 + t * A5)))) * expm2;
+          prefactor = qtmp * xj[3 * CSIZE + mj] / r;
+          forcecoul = incoul ? prefactor * (erfc + EWALD_F * grij * expm2) : 0.0;
+
+          r6inv = r2inv * r2inv * r2inv;
+          forcelj = inlj ? r6inv * (lj1i[jtype] * r6inv - lj2i[jtype]) : 0.0;
+
+          fpair = (forcecoul + forcelj) * r2inv;
+
+          sfx += delx * fpair;
+          sfy += dely * fpair;
+          sfz += delz * fpair;
+
+          if (EVFLAG && inter) {
+            if (eflag_either) {
+              ecoul = incoul ? prefactor * erfc : 0.0;
+              evdwl = inlj ? r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) -
+                      offset[itype][jtype] : 0.0;
+            }
+            ev_tally_full(clatom[CSIZE * ci + mi], evdwl, ecoul, fpair, delx, dely, delz);
+          }
+        }
+        fxi[mi] += sfx;
+        fyi[mi] += sfy;
+        fzi[mi] += sfz;
+      }
+    }
+
+    for (int mi = 0; mi < CSIZE; mi++) {
+      i = clatom[CSIZE * ci + mi];
+      if (i < 0 || i >= nlocal) continue;
+      f[i][0] += fxi[mi];
+      f[i][1] += fyi[mi];
+      f[i][2] += fzi[mi];
+    }
+  }
+
+  // special pairs are kept out of the cluster masks and handled per atom
+
+  for (ii = 0; ii < list->inum; ii++) {
+    i = list->ilist[ii];
+    qtmp = q[i];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    jlist = list->firstneigh[i];
+    jnum = list->numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      factor_coul = special_coul[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < cutsq[itype][jtype]) {
+        r2inv = 1.0 / rsq;
+
+        if (rsq < cut_coulsq) {
+          r = sqrt(rsq);
+          grij = g_ewald * r;
+          expm2 = exp(-grij * grij);
+          t = 1.0 / (1.0 + EWALD_P * grij);
+          erfc = t * (A1 + t * (A2 + t * (A3 + t * (A4 + t * A5)))) * expm2;
+          prefactor = qqrd2e * qtmp * q[j] / r;
+          forcecoul = prefactor * (erfc + EWALD_F * grij * expm2);
+          if (factor_coul < 1.0) forcecoul -= (1.0 - factor_coul) * prefactor;
+        } else
+          forcecoul = 0.0;
+
+        if (rsq < cut_ljsq[itype][jtype]) {
+          r6inv = r2inv * r2inv * r2inv;
+          forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype]);
+        } else
+          forcelj = 0.0;
+
+        fpair = (forcecoul + factor_lj * forcelj) * r2inv;
+
+        f[i][0] += delx * fpair;
+        f[i][1] += dely * fpair;
+        f[i][2] += delz * fpair;
+
+        if (EVFLAG) {
+          if (eflag_either) {
+            if (rsq < cut_coulsq) {
+              ecoul = prefactor * erfc;
+              if (factor_coul < 1.0) ecoul -= (1.0 - factor_coul) * prefactor;
+            } else
+              ecoul = 0.0;
+
+            if (rsq < cut_ljsq[itype][jtype]) {
+              evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) - offset[itype][jtype];
+              evdwl *= factor_lj;
+            } else
+              evdwl = 0.0;
+          }
+          ev_tally_full(i, evdwl, ecoul, fpair, delx, dely, delz);
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   global settings, optional trailing cluster keyword
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulLongCluster::settings(int narg, char **arg)
+{
+  if ((narg > 2) && (strcmp(arg[narg - 2], "cluster") == 0)) {
+    clustersize = utils::inumeric(FLERR, arg[narg - 1], false, lmp);
+    if ((clustersize != 4) && (clustersize != 8))
+      error->all(FLERR, "Pair style {} cluster size must be 4 or 8", force->pair_style);
+    narg -= 2;
+  }
+  PairLJCutCoulLong::settings(narg, arg);
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulLongCluster::init_style()
+{
+  // the cluster kernel always evaluates erfc() analytically
+
+  ncoultablebits = 0;
+  PairLJCutCoulLong::init_style();
+
+  auto req = neighbor->find_request(this);
+  req->enable_full();
+  req->set_cluster(clustersize);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJCutCoulLongCluster::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double) 4 * clustersize * maxpack * sizeof(double);
+  bytes += (double) clustersize * maxpack * sizeof(int);
+  return bytes;
+}
@@ -47,6 +47,8 @@ PairLJCutTIP4PLong::PairLJCutTIP4PLong(LAMMPS *lmp) :
 
   single_enable = 0;
   respa_enable = 0;
+  overlap_enable = 0;
+  mixed_prec_enable = 0;
   writedata = 1;
 
   nmax = 0;
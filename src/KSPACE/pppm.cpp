@@ -73,6 +73,10 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   pppmflag = 1;
   group_group_enable = 1;
   triclinic = domain->triclinic;
+  realfft_support = 1;
+  realfft = 0;
+  overlap_support = 1;
+  fieldforce_part = 0;
 
   nfactors = 3;
   factors = new int[nfactors];
@@ -281,6 +285,10 @@ void PPPM::init()
   if (peratom_allocate_flag) deallocate_peratom();
   if (group_allocate_flag) deallocate_groups();
 
+  // real-to-complex FFTs are not (yet) supported for triclinic boxes
+
+  realfft = (realfft_flag && realfft_support && !triclinic) ? 1 : 0;
+
   // setup FFT grid resolution and g_ewald
   // normally one iteration thru while loop is all that is required
   // if grid stencil does not extend beyond neighbor proc
@@ -358,6 +366,9 @@ void PPPM::init()
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                        estimated_accuracy/two_charge_force);
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    if (realfft) mesg += "  using real-to-complex FFTs\n";
+    if (remap_precision < FFT_PRECISION)
+      mesg += "  using single precision FFT remaps\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
     utils::logmesg(lmp,mesg);
@@ -460,6 +471,34 @@ void PPPM::setup()
     }
   }
 
+  // with real-to-complex FFTs the conjugate partner of a k-point is implied
+  // the partner of a Nyquist index is the same index with the same sign,
+  //   so terms odd in a Nyquist component cancel in the full k-space sum
+  //   but would not cancel with only half of k-space, remove them
+
+  if (realfft) {
+    n = 0;
+    for (k = nzlo_fft; k <= nzhi_fft; k++) {
+      for (j = nylo_fft; j <= nyhi_fft; j++) {
+        for (i = nxlo_fft; i <= nxhi_fft; i++) {
+          const int nyqx = (2*i == nx_pppm);
+          const int nyqy = (2*j == ny_pppm);
+          const int nyqz = (2*k == nz_pppm);
+          if (nyqx != nyqy) vg[n][3] = 0.0;
+          if (nyqx != nyqz) vg[n][4] = 0.0;
+          if (nyqy != nyqz) vg[n][5] = 0.0;
+          n++;
+        }
+      }
+    }
+
+    if (nx_pppm % 2 == 0) fkx[nx_pppm/2] = 0.0;
+    if (ny_pppm % 2 == 0 && nylo_fft <= ny_pppm/2 && ny_pppm/2 <= nyhi_fft)
+      fky[ny_pppm/2] = 0.0;
+    if (nz_pppm % 2 == 0 && nzlo_fft <= nz_pppm/2 && nz_pppm/2 <= nzhi_fft)
+      fkz[nz_pppm/2] = 0.0;
+  }
+
   if (differentiation_flag == 1) compute_gf_ad();
   else compute_gf_ik();
 }
@@ -633,11 +672,23 @@ void PPPM::compute(int eflag, int vflag)
 
   // all procs communicate density values from their ghost cells
   //   to fully sum contribution in their 3d bricks
+  // owned cells which receive no ghost contributions are copied
+  //   to the FFT grid while the ghost values are in flight
   // remap from 3d decomposition to FFT decomposition
 
-  gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
-                   gc_buf1,gc_buf2,MPI_FFT_SCALAR);
-  brick2fft();
+  if (overlap_support) {
+    gc->reverse_comm_start(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                           gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    brick2fft_interior();
+    gc->reverse_comm_finish(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                            gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    brick2fft_boundary();
+    remap->perform(density_fft,density_fft,work1);
+  } else {
+    gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    brick2fft();
+  }
 
   // compute potential gradient on my FFT grid and
   //   portion of e_long on this proc's FFT grid
@@ -648,28 +699,47 @@ void PPPM::compute(int eflag, int vflag)
 
   // all procs communicate E-field values
   // to fill ghost cells surrounding their 3d bricks
+  // forces on atoms whose stencil has only owned cells are computed
+  //   while the ghost values are in flight
 
-  if (differentiation_flag == 1)
-    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD,1,sizeof(FFT_SCALAR),
-                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
-  else
-    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK,3,sizeof(FFT_SCALAR),
+  int which,nper;
+  if (differentiation_flag == 1) {
+    which = FORWARD_AD;
+    nper = 1;
+  } else {
+    which = FORWARD_IK;
+    nper = 3;
+  }
+
+  if (overlap_support && !evflag_atom) {
+    gc->forward_comm_start(Grid3d::KSPACE,this,which,nper,sizeof(FFT_SCALAR),
+                           gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    fieldforce_part = 1;
+    fieldforce();
+    gc->forward_comm_finish(Grid3d::KSPACE,this,which,nper,sizeof(FFT_SCALAR),
+                            gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    fieldforce_part = 2;
+    fieldforce();
+    fieldforce_part = 0;
+  } else {
+    gc->forward_comm(Grid3d::KSPACE,this,which,nper,sizeof(FFT_SCALAR),
                      gc_buf1,gc_buf2,MPI_FFT_SCALAR);
 
-  // extra per-atom energy/virial communication
+    // extra per-atom energy/virial communication
 
-  if (evflag_atom) {
-    if (differentiation_flag == 1 && vflag_atom)
-      gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD_PERATOM,6,sizeof(FFT_SCALAR),
-                       gc_buf1,gc_buf2,MPI_FFT_SCALAR);
-    else if (differentiation_flag == 0)
-      gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK_PERATOM,7,sizeof(FFT_SCALAR),
-                       gc_buf1,gc_buf2,MPI_FFT_SCALAR);
-  }
+    if (evflag_atom) {
+      if (differentiation_flag == 1 && vflag_atom)
+        gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD_PERATOM,6,sizeof(FFT_SCALAR),
+                         gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+      else if (differentiation_flag == 0)
+        gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK_PERATOM,7,sizeof(FFT_SCALAR),
+                         gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    }
 
-  // calculate the force on my particles
+    // calculate the force on my particles
 
-  fieldforce();
+    fieldforce();
+  }
 
   // extra per-atom energy/virial communication
 
@@ -778,6 +848,12 @@ void PPPM::allocate()
 
   nfft_both = MAX(nfft,nfft_brick);
 
+  // with real-to-complex FFTs nfft counts the complex k-space values,
+  //   density_fft holds real values on the full x extent
+
+  if (realfft)
+    nfft_both = MAX(nfft_both,nx_pppm * (nyhi_fft-nylo_fft+1) * (nzhi_fft-nzlo_fft+1));
+
   // allocate distributed grid data
 
   memory->create3d_offset(density_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
@@ -836,20 +912,43 @@ void PPPM::allocate()
 
   int tmp;
 
+  if (realfft) {
+
+    // real-to-complex FFTs: real data on the full x extent of the
+    //   FFT decomposition or in the 3d bricks, k-space data on half of x
+    // 1st FFT is only used forward, 2nd FFT only backward
+
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     0,nx_pppm-1,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+    remap = new Remap(lmp,world,
+                      nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                      0,nx_pppm-1,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                      1,0,0,remap_precision,collective_flag);
+    return;
+  }
+
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                    1,0,0,FFT_PRECISION,collective_flag);
+                    1,0,0,remap_precision,collective_flag);
 }
 
 /* ----------------------------------------------------------------------
@@ -1382,14 +1481,22 @@ void PPPM::set_grid_local()
   // global indices range from 0 to N-1
   // each proc owns entire x-dimension, clumps of columns in y,z dimensions
   // npey_fft,npez_fft = # of procs in y,z dims
-  // if nprocs is small enough, proc can own 1 or more entire xy planes,
+  // if set by kspace_modify fft/grid, use that proc grid,
+  //   it is also used for the pencils inside the 3d FFTs
+  // else if nprocs is small enough, proc can own 1 or more entire xy planes,
   //   else proc owns 2d sub-blocks of yz plane
   // me_y,me_z = which proc (0-npe_fft-1) I am in y,z dimensions
   // nlo_fft,nhi_fft = lower/upper limit of the section
   //   of the global FFT mesh that I own in x-pencil decomposition
 
   int npey_fft,npez_fft;
-  if (nz_pppm >= nprocs) {
+  if (npy_fft) {
+    if (npy_fft > ny_pppm || npz_fft > nz_pppm)
+      error->all(FLERR,"Kspace_modify fft/grid {}x{} exceeds PPPM mesh {}x{} in y,z",
+                 npy_fft,npz_fft,ny_pppm,nz_pppm);
+    npey_fft = npy_fft;
+    npez_fft = npz_fft;
+  } else if (nz_pppm >= nprocs) {
     npey_fft = 1;
     npez_fft = nprocs;
   } else procs2grid2d(nprocs,ny_pppm,nz_pppm,&npey_fft,&npez_fft);
@@ -1397,8 +1504,11 @@ void PPPM::set_grid_local()
   int me_y = me % npey_fft;
   int me_z = me / npey_fft;
 
+  // with real-to-complex FFTs the x-pencils are nx_pppm/2+1 long in k-space
+
   nxlo_fft = 0;
-  nxhi_fft = nx_pppm - 1;
+  if (realfft) nxhi_fft = nx_pppm/2;
+  else nxhi_fft = nx_pppm - 1;
   nylo_fft = me_y*ny_pppm/npey_fft;
   nyhi_fft = (me_y+1)*ny_pppm/npey_fft - 1;
   nzlo_fft = me_z*nz_pppm/npez_fft;
@@ -1707,8 +1817,8 @@ void PPPM::compute_gf_ad()
 
 void PPPM::compute_sf_precoeff()
 {
-  int i,k,l,m,n;
-  int nx,ny,nz,kper,lper,mper;
+  int i,k,l,m,n,ip,npartner;
+  int nx,ny,nz,kper,lper,mper,kp,lp,mp,lpartner,mpartner;
   double wx0[5],wy0[5],wz0[5],wx1[5],wy1[5],wz1[5],wx2[5],wy2[5],wz2[5];
   double qx0,qy0,qz0,qx1,qy1,qz1,qx2,qy2,qz2;
   double u0,u1,u2,u3,u4,u5,u6;
@@ -1717,56 +1827,76 @@ void PPPM::compute_sf_precoeff()
   n = 0;
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
     mper = m - nz_pppm*(2*m/nz_pppm);
+    mpartner = (2*m == nz_pppm) ? mper : -mper;
 
     for (l = nylo_fft; l <= nyhi_fft; l++) {
       lper = l - ny_pppm*(2*l/ny_pppm);
+      lpartner = (2*l == ny_pppm) ? lper : -lper;
 
       for (k = nxlo_fft; k <= nxhi_fft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
 
+        // with real-to-complex FFTs a point with 0 < kx < nx_pppm/2 also
+        //   accumulates the coefficients of its conjugate partner -k,
+        //   Green's function is even so the sums in compute_gf_ad() match
+
+        npartner = (realfft && k > 0 && 2*k < nx_pppm) ? 2 : 1;
+
         sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = 0.0;
-        for (i = 0; i < 5; i++) {
-
-          qx0 = MY_2PI*(kper+nx_pppm*(i-2));
-          qx1 = MY_2PI*(kper+nx_pppm*(i-1));
-          qx2 = MY_2PI*(kper+nx_pppm*(i  ));
-          wx0[i] = powsinxx(0.5*qx0/nx_pppm,order);
-          wx1[i] = powsinxx(0.5*qx1/nx_pppm,order);
-          wx2[i] = powsinxx(0.5*qx2/nx_pppm,order);
-
-          qy0 = MY_2PI*(lper+ny_pppm*(i-2));
-          qy1 = MY_2PI*(lper+ny_pppm*(i-1));
-          qy2 = MY_2PI*(lper+ny_pppm*(i  ));
-          wy0[i] = powsinxx(0.5*qy0/ny_pppm,order);
-          wy1[i] = powsinxx(0.5*qy1/ny_pppm,order);
-          wy2[i] = powsinxx(0.5*qy2/ny_pppm,order);
-
-          qz0 = MY_2PI*(mper+nz_pppm*(i-2));
-          qz1 = MY_2PI*(mper+nz_pppm*(i-1));
-          qz2 = MY_2PI*(mper+nz_pppm*(i  ));
-
-          wz0[i] = powsinxx(0.5*qz0/nz_pppm,order);
-          wz1[i] = powsinxx(0.5*qz1/nz_pppm,order);
-          wz2[i] = powsinxx(0.5*qz2/nz_pppm,order);
-        }
+        for (ip = 0; ip < npartner; ip++) {
+          if (ip == 0) {
+            kp = kper;
+            lp = lper;
+            mp = mper;
+          } else {
+            kp = -kper;
+            lp = lpartner;
+            mp = mpartner;
+          }
 
-        for (nx = 0; nx < 5; nx++) {
-          for (ny = 0; ny < 5; ny++) {
-            for (nz = 0; nz < 5; nz++) {
-              u0 = wx0[nx]*wy0[ny]*wz0[nz];
-              u1 = wx1[nx]*wy0[ny]*wz0[nz];
-              u2 = wx2[nx]*wy0[ny]*wz0[nz];
-              u3 = wx0[nx]*wy1[ny]*wz0[nz];
-              u4 = wx0[nx]*wy2[ny]*wz0[nz];
-              u5 = wx0[nx]*wy0[ny]*wz1[nz];
-              u6 = wx0[nx]*wy0[ny]*wz2[nz];
-
-              sum1 += u0*u1;
-              sum2 += u0*u2;
-              sum3 += u0*u3;
-              sum4 += u0*u4;
-              sum5 += u0*u5;
-              sum6 += u0*u6;
+          for (i = 0; i < 5; i++) {
+
+            qx0 = MY_2PI*(kp+nx_pppm*(i-2));
+            qx1 = MY_2PI*(kp+nx_pppm*(i-1));
+            qx2 = MY_2PI*(kp+nx_pppm*(i  ));
+            wx0[i] = powsinxx(0.5*qx0/nx_pppm,order);
+            wx1[i] = powsinxx(0.5*qx1/nx_pppm,order);
+            wx2[i] = powsinxx(0.5*qx2/nx_pppm,order);
+
+            qy0 = MY_2PI*(lp+ny_pppm*(i-2));
+            qy1 = MY_2PI*(lp+ny_pppm*(i-1));
+            qy2 = MY_2PI*(lp+ny_pppm*(i  ));
+            wy0[i] = powsinxx(0.5*qy0/ny_pppm,order);
+            wy1[i] = powsinxx(0.5*qy1/ny_pppm,order);
+            wy2[i] = powsinxx(0.5*qy2/ny_pppm,order);
+
+            qz0 = MY_2PI*(mp+nz_pppm*(i-2));
+            qz1 = MY_2PI*(mp+nz_pppm*(i-1));
+            qz2 = MY_2PI*(mp+nz_pppm*(i  ));
+
+            wz0[i] = powsinxx(0.5*qz0/nz_pppm,order);
+            wz1[i] = powsinxx(0.5*qz1/nz_pppm,order);
+            wz2[i] = powsinxx(0.5*qz2/nz_pppm,order);
+          }
+
+          for (nx = 0; nx < 5; nx++) {
+            for (ny = 0; ny < 5; ny++) {
+              for (nz = 0; nz < 5; nz++) {
+                u0 = wx0[nx]*wy0[ny]*wz0[nz];
+                u1 = wx1[nx]*wy0[ny]*wz0[nz];
+                u2 = wx2[nx]*wy0[ny]*wz0[nz];
+                u3 = wx0[nx]*wy1[ny]*wz0[nz];
+                u4 = wx0[nx]*wy2[ny]*wz0[nz];
+                u5 = wx0[nx]*wy0[ny]*wz1[nz];
+                u6 = wx0[nx]*wy0[ny]*wz2[nz];
+
+                sum1 += u0*u1;
+                sum2 += u0*u2;
+                sum3 += u0*u3;
+                sum4 += u0*u4;
+                sum5 += u0*u5;
+                sum6 += u0*u6;
+              }
             }
           }
         }
@@ -1904,6 +2034,56 @@ void PPPM::brick2fft()
   remap->perform(density_fft,density_fft,work1);
 }
 
+/* ----------------------------------------------------------------------
+   copy interior owned cells of density from 3d brick to FFT grid,
+   they need no contributions from ghost cells of other procs
+------------------------------------------------------------------------- */
+
+void PPPM::brick2fft_interior()
+{
+  int ixlo,ixhi,iylo,iyhi,izlo,izhi;
+  gc->get_bounds_interior(ixlo,ixhi,iylo,iyhi,izlo,izhi);
+
+  const int nx = nxhi_in - nxlo_in + 1;
+  const int ny = nyhi_in - nylo_in + 1;
+
+  for (int iz = izlo; iz <= izhi; iz++)
+    for (int iy = iylo; iy <= iyhi; iy++) {
+      int n = ((iz-nzlo_in)*ny + iy-nylo_in)*nx + ixlo-nxlo_in;
+      for (int ix = ixlo; ix <= ixhi; ix++)
+        density_fft[n++] = density_brick[iz][iy][ix];
+    }
+}
+
+/* ----------------------------------------------------------------------
+   copy all other owned cells of density from 3d brick to FFT grid
+------------------------------------------------------------------------- */
+
+void PPPM::brick2fft_boundary()
+{
+  int ixlo,ixhi,iylo,iyhi,izlo,izhi;
+  gc->get_bounds_interior(ixlo,ixhi,iylo,iyhi,izlo,izhi);
+  if (ixlo > ixhi || iylo > iyhi || izlo > izhi) {
+    ixlo = nxhi_in+1;
+    ixhi = nxhi_in;
+  }
+
+  int n = 0;
+  for (int iz = nzlo_in; iz <= nzhi_in; iz++)
+    for (int iy = nylo_in; iy <= nyhi_in; iy++) {
+      if (iz < izlo || iz > izhi || iy < iylo || iy > iyhi) {
+        for (int ix = nxlo_in; ix <= nxhi_in; ix++)
+          density_fft[n++] = density_brick[iz][iy][ix];
+      } else {
+        for (int ix = nxlo_in; ix < ixlo; ix++)
+          density_fft[n++] = density_brick[iz][iy][ix];
+        n += ixhi - ixlo + 1;
+        for (int ix = ixhi+1; ix <= nxhi_in; ix++)
+          density_fft[n++] = density_brick[iz][iy][ix];
+      }
+    }
+}
+
 /* ----------------------------------------------------------------------
    FFT-based Poisson solver
 ------------------------------------------------------------------------- */
@@ -1924,14 +2104,18 @@ void PPPM::poisson_ik()
   double eng;
 
   // transform charge density (r -> k)
+  // real-to-complex FFT reads density_fft directly
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
+  if (realfft) fft1->compute(density_fft,work1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work1[n++] = density_fft[i];
+      work1[n++] = ZEROF;
+    }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+  }
 
   // global energy and virial contribution
 
@@ -1944,6 +2128,7 @@ void PPPM::poisson_ik()
       n = 0;
       for (i = 0; i < nfft; i++) {
         eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        if (realfft) eng *= kweight(i);
         for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
         if (eflag_global) energy += eng;
         n += 2;
@@ -1951,8 +2136,9 @@ void PPPM::poisson_ik()
     } else {
       n = 0;
       for (i = 0; i < nfft; i++) {
-        energy +=
-          s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        if (realfft) eng *= kweight(i);
+        energy += eng;
         n += 2;
       }
     }
@@ -1993,15 +2179,7 @@ void PPPM::poisson_ik()
         n += 2;
       }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdx_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(vdx_brick);
 
   // y direction gradient
 
@@ -2014,15 +2192,7 @@ void PPPM::poisson_ik()
         n += 2;
       }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdy_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(vdy_brick);
 
   // z direction gradient
 
@@ -2035,15 +2205,7 @@ void PPPM::poisson_ik()
         n += 2;
       }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdz_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(vdz_brick);
 }
 
 /* ----------------------------------------------------------------------
@@ -2052,7 +2214,7 @@ void PPPM::poisson_ik()
 
 void PPPM::poisson_ik_triclinic()
 {
-  int i,j,k,n;
+  int i,n;
 
   // compute gradients of V(r) in each of 3 dims by transforming ik*V(k)
   // FFT leaves data in 3d brick decomposition
@@ -2067,15 +2229,7 @@ void PPPM::poisson_ik_triclinic()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdx_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(vdx_brick);
 
   // y direction gradient
 
@@ -2086,15 +2240,7 @@ void PPPM::poisson_ik_triclinic()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdy_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(vdy_brick);
 
   // z direction gradient
 
@@ -2105,15 +2251,7 @@ void PPPM::poisson_ik_triclinic()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdz_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(vdz_brick);
 }
 
 /* ----------------------------------------------------------------------
@@ -2122,18 +2260,22 @@ void PPPM::poisson_ik_triclinic()
 
 void PPPM::poisson_ad()
 {
-  int i,j,k,n;
+  int i,j,n;
   double eng;
 
   // transform charge density (r -> k)
+  // real-to-complex FFT reads density_fft directly
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
+  if (realfft) fft1->compute(density_fft,work1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work1[n++] = density_fft[i];
+      work1[n++] = ZEROF;
+    }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+  }
 
   // global energy and virial contribution
 
@@ -2146,6 +2288,7 @@ void PPPM::poisson_ad()
       n = 0;
       for (i = 0; i < nfft; i++) {
         eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        if (realfft) eng *= kweight(i);
         for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
         if (eflag_global) energy += eng;
         n += 2;
@@ -2153,8 +2296,9 @@ void PPPM::poisson_ad()
     } else {
       n = 0;
       for (i = 0; i < nfft; i++) {
-        energy +=
-          s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        if (realfft) eng *= kweight(i);
+        energy += eng;
         n += 2;
       }
     }
@@ -2180,15 +2324,7 @@ void PPPM::poisson_ad()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        u_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(u_brick);
 }
 
 /* ----------------------------------------------------------------------
@@ -2197,7 +2333,7 @@ void PPPM::poisson_ad()
 
 void PPPM::poisson_peratom()
 {
-  int i,j,k,n;
+  int i,n;
 
   // energy
 
@@ -2209,15 +2345,7 @@ void PPPM::poisson_peratom()
       n += 2;
     }
 
-    fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-    n = 0;
-    for (k = nzlo_in; k <= nzhi_in; k++)
-      for (j = nylo_in; j <= nyhi_in; j++)
-        for (i = nxlo_in; i <= nxhi_in; i++) {
-          u_brick[k][j][i] = work2[n];
-          n += 2;
-        }
+    fft2_to_brick(u_brick);
   }
 
   // 6 components of virial in v0 thru v5
@@ -2231,15 +2359,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v0_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(v0_brick);
 
   n = 0;
   for (i = 0; i < nfft; i++) {
@@ -2248,15 +2368,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v1_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(v1_brick);
 
   n = 0;
   for (i = 0; i < nfft; i++) {
@@ -2265,15 +2377,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v2_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(v2_brick);
 
   n = 0;
   for (i = 0; i < nfft; i++) {
@@ -2282,15 +2386,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v3_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(v3_brick);
 
   n = 0;
   for (i = 0; i < nfft; i++) {
@@ -2299,15 +2395,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v4_brick[k][j][i] = work2[n];
-        n += 2;
-      }
+  fft2_to_brick(v4_brick);
 
   n = 0;
   for (i = 0; i < nfft; i++) {
@@ -2316,13 +2404,37 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
+  fft2_to_brick(v5_brick);
+}
+
+/* ----------------------------------------------------------------------
+   inverse FFT of work2 and copy of the real result into a brick
+   real-to-complex FFTs return reals in density_fft (unit stride),
+   otherwise the transform is in place and real parts are copied
+------------------------------------------------------------------------- */
+
+void PPPM::fft2_to_brick(FFT_SCALAR ***brick)
+{
+  int i,j,k,n;
+
+  if (realfft) {
+    fft2->compute(work2,density_fft,FFT3d::BACKWARD);
+
+    n = 0;
+    for (k = nzlo_in; k <= nzhi_in; k++)
+      for (j = nylo_in; j <= nyhi_in; j++)
+        for (i = nxlo_in; i <= nxhi_in; i++)
+          brick[k][j][i] = density_fft[n++];
+    return;
+  }
+
   fft2->compute(work2,work2,FFT3d::BACKWARD);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
-        v5_brick[k][j][i] = work2[n];
+        brick[k][j][i] = work2[n];
         n += 2;
       }
 }
@@ -2360,6 +2472,7 @@ void PPPM::fieldforce_ik()
   int nlocal = atom->nlocal;
 
   for (i = 0; i < nlocal; i++) {
+    if (fieldforce_skip(i)) continue;
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2430,6 +2543,7 @@ void PPPM::fieldforce_ad()
   int nlocal = atom->nlocal;
 
   for (i = 0; i < nlocal; i++) {
+    if (fieldforce_skip(i)) continue;
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2949,17 +3063,24 @@ int PPPM::timing_3d(int n, double &time3d)
 {
   double time1,time2;
 
+  // real-to-complex FFTs transform between density_fft and work1
+
+  FFT_SCALAR *rdata = work1;
+  if (realfft) {
+    rdata = density_fft;
+    for (int i = 0; i < nfft_both; i++) density_fft[i] = ZEROF;
+  }
   for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = platform::walltime();
 
   for (int i = 0; i < n; i++) {
-    fft1->compute(work1,work1,FFT3d::FORWARD);
-    fft2->compute(work1,work1,FFT3d::BACKWARD);
+    fft1->compute(rdata,work1,FFT3d::FORWARD);
+    fft2->compute(work1,rdata,FFT3d::BACKWARD);
     if (differentiation_flag != 1) {
-      fft2->compute(work1,work1,FFT3d::BACKWARD);
-      fft2->compute(work1,work1,FFT3d::BACKWARD);
+      fft2->compute(work1,rdata,FFT3d::BACKWARD);
+      fft2->compute(work1,rdata,FFT3d::BACKWARD);
     }
   }
 
@@ -3220,6 +3341,7 @@ void PPPM::make_rho_groups(int groupbit_A, int groupbit_B, int AA_flag)
 void PPPM::poisson_groups(int AA_flag)
 {
   int i,j,k,n;
+  double eng;
 
   // reuse memory (already declared)
 
@@ -3230,23 +3352,29 @@ void PPPM::poisson_groups(int AA_flag)
 
   // group A
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work_A[n++] = density_A_fft[i];
-    work_A[n++] = ZEROF;
-  }
+  if (realfft) fft1->compute(density_A_fft,work_A,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work_A[n++] = density_A_fft[i];
+      work_A[n++] = ZEROF;
+    }
 
-  fft1->compute(work_A,work_A,FFT3d::FORWARD);
+    fft1->compute(work_A,work_A,FFT3d::FORWARD);
+  }
 
   // group B
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work_B[n++] = density_B_fft[i];
-    work_B[n++] = ZEROF;
-  }
+  if (realfft) fft1->compute(density_B_fft,work_B,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work_B[n++] = density_B_fft[i];
+      work_B[n++] = ZEROF;
+    }
 
-  fft1->compute(work_B,work_B,FFT3d::FORWARD);
+    fft1->compute(work_B,work_B,FFT3d::FORWARD);
+  }
 
   // group-group energy and force contribution,
   //  keep everything in reciprocal space so
@@ -3260,8 +3388,9 @@ void PPPM::poisson_groups(int AA_flag)
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    e2group += s2 * greensfn[i] *
-      (work_A[n]*work_B[n] + work_A[n+1]*work_B[n+1]);
+    eng = s2 * greensfn[i] * (work_A[n]*work_B[n] + work_A[n+1]*work_B[n+1]);
+    if (realfft) eng *= kweight(i);
+    e2group += eng;
     n += 2;
   }
 
@@ -3292,6 +3421,7 @@ void PPPM::poisson_groups(int AA_flag)
     for (j = nylo_fft; j <= nyhi_fft; j++)
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
         partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
+        if (realfft) partial_group *= kweight(n/2);
         f2group[0] += fkx[i] * partial_group;
         n += 2;
       }
@@ -3303,6 +3433,7 @@ void PPPM::poisson_groups(int AA_flag)
     for (j = nylo_fft; j <= nyhi_fft; j++)
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
         partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
+        if (realfft) partial_group *= kweight(n/2);
         f2group[1] += fky[j] * partial_group;
         n += 2;
       }
@@ -3314,6 +3445,7 @@ void PPPM::poisson_groups(int AA_flag)
     for (j = nylo_fft; j <= nyhi_fft; j++)
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
         partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
+        if (realfft) partial_group *= kweight(n/2);
         f2group[2] += fkz[k] * partial_group;
         n += 2;
       }
@@ -40,6 +40,8 @@ class PPPM : public KSpace {
 
   void compute_group_group(int, int, int) override;
 
+  int factorable(int);
+
  protected:
   int me, nprocs;
   int nfactors;
@@ -82,9 +84,21 @@ class PPPM : public KSpace {
   class Remap *remap;
   class Grid3d *gc;
 
+  // real-to-complex FFTs store only kx = 0 to nx_pppm/2 in k-space,
+  //   each of those points also stands for its conjugate partner -k
+
+  int realfft_support;    // 1 if style can use real-to-complex FFTs
+  int realfft;            // 1 if real-to-complex FFTs are in use
+
   FFT_SCALAR *gc_buf1, *gc_buf2;
   int ngc_buf1, ngc_buf2, npergrid;
 
+  // grid comm can overlap with copying owned cells to the FFT grid
+  //   and with fieldforce() on atoms whose stencil has only owned cells
+
+  int overlap_support;    // 1 if fieldforce_ik/ad() honor fieldforce_part
+  int fieldforce_part;    // 0 = all atoms, 1 = stencil in owned cells, 2 = others
+
   // group-group interactions
 
   int group_allocate_flag;
@@ -111,7 +125,6 @@ class PPPM : public KSpace {
   virtual void allocate_peratom();
   virtual void deallocate();
   virtual void deallocate_peratom();
-  int factorable(int);
   virtual double compute_df_kspace();
   virtual double estimate_ik_error(double, double, bigint);
   virtual double compute_qopt();
@@ -123,6 +136,8 @@ class PPPM : public KSpace {
   virtual void particle_map();
   virtual void make_rho();
   virtual void brick2fft();
+  void brick2fft_interior();
+  void brick2fft_boundary();
 
   virtual void poisson();
   virtual void poisson_ik();
@@ -134,12 +149,25 @@ class PPPM : public KSpace {
 
   virtual void poisson_peratom();
   virtual void fieldforce_peratom();
+  void fft2_to_brick(FFT_SCALAR ***);
   void procs2grid2d(int, int, int, int *, int *);
   void compute_rho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_drho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_rho_coeff();
   virtual void slabcorr();
 
+  // 1 if atom i is not part of the atoms selected by fieldforce_part
+
+  inline int fieldforce_skip(int i) const
+  {
+    if (fieldforce_part == 0) return 0;
+    const int *p2g = part2grid[i];
+    const int owned = (p2g[0] + nlower >= nxlo_in) && (p2g[0] + nupper <= nxhi_in) &&
+        (p2g[1] + nlower >= nylo_in) && (p2g[1] + nupper <= nyhi_in) &&
+        (p2g[2] + nlower >= nzlo_in) && (p2g[2] + nupper <= nzhi_in);
+    return (fieldforce_part == 1) ? !owned : owned;
+  }
+
   // grid communication
 
   void pack_forward_grid(int, void *, int, int *) override;
@@ -187,6 +215,18 @@ class PPPM : public KSpace {
     double s = sx * sy * sz;
     return s * s;
   };
+
+  /* ----------------------------------------------------------------------
+   weight of FFT point n in k-space sums with real-to-complex FFTs
+     kx = 0 and kx = nx_pppm/2 are their own conjugate partners in x,
+     all other points count twice
+------------------------------------------------------------------------- */
+
+  inline double kweight(int n) const
+  {
+    const int i = n % (nxhi_fft - nxlo_fft + 1);
+    return (i == 0 || 2 * i == nx_pppm) ? 1.0 : 2.0;
+  };
 };
 
 }    // namespace LAMMPS_NS
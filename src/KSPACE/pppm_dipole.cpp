@@ -48,6 +48,7 @@ static constexpr FFT_SCALAR ZEROF = 0.0;
 
 enum { REVERSE_MU };
 enum { FORWARD_MU, FORWARD_MU_PERATOM };
+enum { EFIELD, EGRAD, VIRIAL };
 
 /* ---------------------------------------------------------------------- */
 
@@ -173,6 +174,8 @@ void PPPMDipole::init()
   deallocate();
   if (peratom_allocate_flag) deallocate_peratom();
 
+  realfft = (realfft_flag && realfft_support) ? 1 : 0;
+
   // setup FFT grid resolution and g_ewald
   // normally one iteration thru while loop is all that is required
   // if grid stencil does not extend beyond neighbor proc
@@ -249,6 +252,9 @@ void PPPMDipole::init()
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                        estimated_accuracy/two_charge_force);
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    if (realfft) mesg += "  using real-to-complex FFTs\n";
+    if (remap_precision < FFT_PRECISION)
+      mesg += "  using single precision FFT remaps\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
     utils::logmesg(lmp,mesg);
@@ -562,6 +568,12 @@ void PPPMDipole::allocate()
 
   nfft_both = MAX(nfft,nfft_brick);
 
+  // with real-to-complex FFTs nfft counts the complex k-space values,
+  //   the density_fft arrays hold real values on the full x extent
+
+  if (realfft)
+    nfft_both = MAX(nfft_both,nx_pppm * (nyhi_fft-nylo_fft+1) * (nzhi_fft-nzlo_fft+1));
+
   // allocate distributed grid data
 
   memory->create3d_offset(densityx_brick_dipole,nzlo_out,nzhi_out,nylo_out,nyhi_out,
@@ -623,20 +635,43 @@ void PPPMDipole::allocate()
 
   int tmp;
 
+  if (realfft) {
+
+    // real-to-complex FFTs: real data on the full x extent of the
+    //   FFT decomposition or in the 3d bricks, k-space data on half of x
+    // 1st FFT is only used forward, 2nd FFT only backward
+
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     0,nx_pppm-1,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+    remap = new Remap(lmp,world,
+                      nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                      0,nx_pppm-1,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                      1,0,0,remap_precision,collective_flag);
+    return;
+  }
+
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                    1,0,0,FFT_PRECISION,collective_flag);
+                    1,0,0,remap_precision,collective_flag);
 }
 
 /* ----------------------------------------------------------------------
@@ -919,6 +954,9 @@ double PPPMDipole::compute_qopt_dipole()
 
   const int twoorder = 2*order;
 
+  // sum over the full x extent, with real-to-complex FFTs the x-pencils
+  //   of the FFT decomposition only hold kx = 0 to nx_pppm/2
+
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
     mper = m - nz_pppm*(2*m/nz_pppm);
     snz = square(sin(0.5*unitkz*mper*zprd_slab/nz_pppm));
@@ -927,7 +965,7 @@ double PPPMDipole::compute_qopt_dipole()
       lper = l - ny_pppm*(2*l/ny_pppm);
       sny = square(sin(0.5*unitky*lper*yprd/ny_pppm));
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = 0; k < nx_pppm; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         snx = square(sin(0.5*unitkx*kper*xprd/nx_pppm));
 
@@ -1307,67 +1345,84 @@ void PPPMDipole::brick2fft_dipole()
 
 void PPPMDipole::poisson_ik_dipole()
 {
-  int i,j,k,n,ii;
-  double eng;
+  int i,j,k,n,ii,ip,npartner;
+  double eng,sy,sz;
   double wreal,wimg;
+  double fk[3],vgk[6];
 
   // transform dipole density (r -> k)
+  // real-to-complex FFTs read the real density directly
+
+  if (realfft) {
+    fft1->compute(densityx_fft_dipole,work1,FFT3d::FORWARD);
+    fft1->compute(densityy_fft_dipole,work2,FFT3d::FORWARD);
+    fft1->compute(densityz_fft_dipole,work3,FFT3d::FORWARD);
+  } else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work1[n] = densityx_fft_dipole[i];
+      work1[n+1] = ZEROF;
+      work2[n] = densityy_fft_dipole[i];
+      work2[n+1] = ZEROF;
+      work3[n] = densityz_fft_dipole[i];
+      work3[n+1] = ZEROF;
+      n += 2;
+    }
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n] = densityx_fft_dipole[i];
-    work1[n+1] = ZEROF;
-    work2[n] = densityy_fft_dipole[i];
-    work2[n+1] = ZEROF;
-    work3[n] = densityz_fft_dipole[i];
-    work3[n+1] = ZEROF;
-    n += 2;
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work2,work2,FFT3d::FORWARD);
+    fft1->compute(work3,work3,FFT3d::FORWARD);
   }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
-  fft1->compute(work2,work2,FFT3d::FORWARD);
-  fft1->compute(work3,work3,FFT3d::FORWARD);
-
   // global energy and virial contribution
+  // with real-to-complex FFTs a point with 0 < kx < nx_pppm/2 also stands
+  //   for its conjugate partner, which is the same point with the Nyquist
+  //   components of ky,kz negated, so it is evaluated a 2nd time
 
   bigint ngridtotal = (bigint) nx_pppm * ny_pppm * nz_pppm;
   double scaleinv = 1.0/ngridtotal;
   double s2 = scaleinv*scaleinv;
 
   if (eflag_global || vflag_global) {
-    if (vflag_global) {
-      n = 0;
-      ii = 0;
-      for (k = nzlo_fft; k <= nzhi_fft; k++)
-        for (j = nylo_fft; j <= nyhi_fft; j++)
-          for (i = nxlo_fft; i <= nxhi_fft; i++) {
-            wreal = (work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-            wimg = (work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
+    n = 0;
+    ii = 0;
+    for (k = nzlo_fft; k <= nzhi_fft; k++) {
+      sz = (2*k == nz_pppm) ? -1.0 : 1.0;
+      for (j = nylo_fft; j <= nyhi_fft; j++) {
+        sy = (2*j == ny_pppm) ? -1.0 : 1.0;
+        for (i = nxlo_fft; i <= nxhi_fft; i++) {
+          npartner = (realfft && i > 0 && 2*i < nx_pppm) ? 2 : 1;
+          for (ip = 0; ip < npartner; ip++) {
+            fk[0] = fkx[i];
+            fk[1] = fky[j];
+            fk[2] = fkz[k];
+            for (int jj = 0; jj < 6; jj++) vgk[jj] = vg[ii][jj];
+            if (ip) {
+              fk[1] *= sy;
+              fk[2] *= sz;
+              vgk[3] *= sy;
+              vgk[4] *= sz;
+              vgk[5] *= sy*sz;
+            }
+
+            wreal = (work1[n]*fk[0] + work2[n]*fk[1] + work3[n]*fk[2]);
+            wimg = (work1[n+1]*fk[0] + work2[n+1]*fk[1] + work3[n+1]*fk[2]);
             eng = s2 * greensfn[ii] * (wreal*wreal + wimg*wimg);
-            for (int jj = 0; jj < 6; jj++) virial[jj] += eng*vg[ii][jj];
-            virial[0] += 2.0*s2*greensfn[ii]*fkx[i]*(work1[n]*wreal + work1[n+1]*wimg);
-            virial[1] += 2.0*s2*greensfn[ii]*fky[j]*(work2[n]*wreal + work2[n+1]*wimg);
-            virial[2] += 2.0*s2*greensfn[ii]*fkz[k]*(work3[n]*wreal + work3[n+1]*wimg);
-            virial[3] += 2.0*s2*greensfn[ii]*fky[j]*(work1[n]*wreal + work1[n+1]*wimg);
-            virial[4] += 2.0*s2*greensfn[ii]*fkz[k]*(work1[n]*wreal + work1[n+1]*wimg);
-            virial[5] += 2.0*s2*greensfn[ii]*fkz[k]*(work2[n]*wreal + work2[n+1]*wimg);
+            if (vflag_global) {
+              for (int jj = 0; jj < 6; jj++) virial[jj] += eng*vgk[jj];
+              virial[0] += 2.0*s2*greensfn[ii]*fk[0]*(work1[n]*wreal + work1[n+1]*wimg);
+              virial[1] += 2.0*s2*greensfn[ii]*fk[1]*(work2[n]*wreal + work2[n+1]*wimg);
+              virial[2] += 2.0*s2*greensfn[ii]*fk[2]*(work3[n]*wreal + work3[n+1]*wimg);
+              virial[3] += 2.0*s2*greensfn[ii]*fk[1]*(work1[n]*wreal + work1[n+1]*wimg);
+              virial[4] += 2.0*s2*greensfn[ii]*fk[2]*(work1[n]*wreal + work1[n+1]*wimg);
+              virial[5] += 2.0*s2*greensfn[ii]*fk[2]*(work2[n]*wreal + work2[n+1]*wimg);
+            }
             if (eflag_global) energy += eng;
-            ii++;
-            n += 2;
-          }
-    } else {
-      n = 0;
-      ii = 0;
-      for (k = nzlo_fft; k <= nzhi_fft; k++)
-        for (j = nylo_fft; j <= nyhi_fft; j++)
-          for (i = nxlo_fft; i <= nxhi_fft; i++) {
-            wreal = (work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-            wimg = (work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-            energy +=
-            s2 * greensfn[ii] * (wreal*wreal + wimg*wimg);
-            ii++;
-            n += 2;
           }
+          ii++;
+          n += 2;
+        }
+      }
     }
   }
 
@@ -1389,209 +1444,19 @@ void PPPMDipole::poisson_ik_dipole()
 
   if (vflag_atom) poisson_peratom_dipole();
 
-  // compute electric potential
+  // compute electric field and its gradient
   // FFT leaves data in 3d brick decomposition
 
-  // Ex
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-        work4[n+1] = fkx[i]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        ux_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Ey
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-        work4[n+1] = fky[j]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        uy_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Ez
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-        work4[n+1] = fkz[k]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        uz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Vxx
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = -fkx[i]*fkx[i]*(work1[n+1]*fkx[i] +
-                                   work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        work4[n+1] = fkx[i]*fkx[i]*(work1[n]*fkx[i] +
-                                    work2[n]*fky[j] + work3[n]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdxx_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Vyy
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = -fky[j]*fky[j]*(work1[n+1]*fkx[i] +
-                                   work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        work4[n+1] = fky[j]*fky[j]*(work1[n]*fkx[i] +
-                                    work2[n]*fky[j] + work3[n]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdyy_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Vzz
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = -fkz[k]*fkz[k]*(work1[n+1]*fkx[i] +
-                                   work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        work4[n+1] = fkz[k]*fkz[k]*(work1[n]*fkx[i] +
-                                    work2[n]*fky[j] + work3[n]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdzz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Vxy
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = -fkx[i]*fky[j]*(work1[n+1]*fkx[i] +
-                                   work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        work4[n+1] = fkx[i]*fky[j]*(work1[n]*fkx[i] +
-                                    work2[n]*fky[j] + work3[n]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdxy_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Vxz
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = -fkx[i]*fkz[k]*(work1[n+1]*fkx[i] +
-                                   work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        work4[n+1] = fkx[i]*fkz[k]*(work1[n]*fkx[i] +
-                                    work2[n]*fky[j] + work3[n]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdxz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // Vyz
+  poisson_field_dipole(EFIELD,0,0,ux_brick_dipole);
+  poisson_field_dipole(EFIELD,1,0,uy_brick_dipole);
+  poisson_field_dipole(EFIELD,2,0,uz_brick_dipole);
 
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = -fky[j]*fkz[k]*(work1[n+1]*fkx[i] +
-                                   work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-        work4[n+1] = fky[j]*fkz[k]*(work1[n]*fkx[i] +
-                                    work2[n]*fky[j] + work3[n]*fkz[k]);
-        n += 2;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdyz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
+  poisson_field_dipole(EGRAD,0,0,vdxx_brick_dipole);
+  poisson_field_dipole(EGRAD,1,1,vdyy_brick_dipole);
+  poisson_field_dipole(EGRAD,2,2,vdzz_brick_dipole);
+  poisson_field_dipole(EGRAD,0,1,vdxy_brick_dipole);
+  poisson_field_dipole(EGRAD,0,2,vdxz_brick_dipole);
+  poisson_field_dipole(EGRAD,1,2,vdyz_brick_dipole);
 }
 
 /* ----------------------------------------------------------------------
@@ -1600,451 +1465,129 @@ void PPPMDipole::poisson_ik_dipole()
 
 void PPPMDipole::poisson_peratom_dipole()
 {
-  int i,ii,j,k,n;
-
   // 18 components of virial in v0 thru v5
 
   if (!vflag_atom) return;
 
-  // V0x
+  poisson_field_dipole(VIRIAL,0,0,v0x_brick_dipole);
+  poisson_field_dipole(VIRIAL,1,0,v0y_brick_dipole);
+  poisson_field_dipole(VIRIAL,2,0,v0z_brick_dipole);
 
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(vg[ii][0]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkx[i]*work1[n]);
-        work4[n+1] = fkx[i]*(vg[ii][0]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkx[i]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
+  poisson_field_dipole(VIRIAL,0,1,v1x_brick_dipole);
+  poisson_field_dipole(VIRIAL,1,1,v1y_brick_dipole);
+  poisson_field_dipole(VIRIAL,2,1,v1z_brick_dipole);
 
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
+  poisson_field_dipole(VIRIAL,0,2,v2x_brick_dipole);
+  poisson_field_dipole(VIRIAL,1,2,v2y_brick_dipole);
+  poisson_field_dipole(VIRIAL,2,2,v2z_brick_dipole);
 
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v0x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
+  poisson_field_dipole(VIRIAL,0,3,v3x_brick_dipole);
+  poisson_field_dipole(VIRIAL,1,3,v3y_brick_dipole);
+  poisson_field_dipole(VIRIAL,2,3,v3z_brick_dipole);
 
-  // V0y
+  poisson_field_dipole(VIRIAL,0,4,v4x_brick_dipole);
+  poisson_field_dipole(VIRIAL,1,4,v4y_brick_dipole);
+  poisson_field_dipole(VIRIAL,2,4,v4z_brick_dipole);
 
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(vg[ii][0]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkx[i]*work1[n]);
-        work4[n+1] = fky[j]*(vg[ii][0]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkx[i]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v0y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V0z
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(vg[ii][0]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkx[i]*work1[n]);
-        work4[n+1] = fkz[k]*(vg[ii][0]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkx[i]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v0z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V1x
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(vg[ii][1]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fky[j]*work2[n]);
-        work4[n+1] = fkx[i]*(vg[ii][1]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fky[j]*work2[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v1x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V1y
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(vg[ii][1]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fky[j]*work2[n]);
-        work4[n+1] = fky[j]*(vg[ii][1]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fky[j]*work2[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v1y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V1z
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(vg[ii][1]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fky[j]*work2[n]);
-        work4[n+1] = fkz[k]*(vg[ii][1]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fky[j]*work2[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v1z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V2x
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(vg[ii][2]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work3[n]);
-        work4[n+1] = fkx[i]*(vg[ii][2]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work3[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v2x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V2y
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(vg[ii][2]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work3[n]);
-        work4[n+1] = fky[j]*(vg[ii][2]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work3[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v2y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V2z
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(vg[ii][2]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work3[n]);
-        work4[n+1] = fkz[k]*(vg[ii][2]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work3[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v2z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V3x
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(vg[ii][3]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fky[j]*work1[n]);
-        work4[n+1] = fkx[i]*(vg[ii][3]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fky[j]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v3x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V3y
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(vg[ii][3]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fky[j]*work1[n]);
-        work4[n+1] = fky[j]*(vg[ii][3]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fky[j]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v3y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V3z
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(vg[ii][3]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fky[j]*work1[n]);
-        work4[n+1] = fkz[k]*(vg[ii][3]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fky[j]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v3z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V4x
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(vg[ii][4]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work1[n]);
-        work4[n+1] = fkx[i]*(vg[ii][4]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v4x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V4y
-
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(vg[ii][4]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work1[n]);
-        work4[n+1] = fky[j]*(vg[ii][4]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v4y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V4z
+  poisson_field_dipole(VIRIAL,0,5,v5x_brick_dipole);
+  poisson_field_dipole(VIRIAL,1,5,v5y_brick_dipole);
+  poisson_field_dipole(VIRIAL,2,5,v5z_brick_dipole);
+}
 
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(vg[ii][4]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work1[n]);
-        work4[n+1] = fkz[k]*(vg[ii][4]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work1[n+1]);
-        n += 2;
-        ii++;
-      }
+/* ----------------------------------------------------------------------
+   coefficients c of a field F(k) = c . W(k) computed from the scaled
+     dipole density W(k) = (work1,work2,work3) at a single k-point
+   EFIELD: F = k_a (k . W) = electric field component a
+   EGRAD:  F = i k_a k_b (k . W) = field gradient component ab
+   VIRIAL: F = k_a (vg_b (k . W) + 2 k_p W_q) = per-atom virial b,
+     component a, with p,q set by the virial component b
+------------------------------------------------------------------------- */
 
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
+static inline void field_coeff_dipole(int type, int a, int b, const double *fk,
+                                      const double *vgk, double *coeff)
+{
+  static constexpr int vkdim[6] = {0, 1, 2, 1, 2, 2};
+  static constexpr int vwdim[6] = {0, 1, 2, 0, 0, 1};
+
+  if (type == EFIELD) {
+    for (int c = 0; c < 3; c++) coeff[c] = fk[a]*fk[c];
+  } else if (type == EGRAD) {
+    for (int c = 0; c < 3; c++) coeff[c] = fk[a]*fk[b]*fk[c];
+  } else {
+    for (int c = 0; c < 3; c++) coeff[c] = fk[a]*vgk[b]*fk[c];
+    coeff[vwdim[b]] += 2.0*fk[a]*fk[vkdim[b]];
+  }
+}
 
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v4z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
+/* ----------------------------------------------------------------------
+   compute a field from the dipole density in k-space, see
+     field_coeff_dipole(), and transform it into a 3d brick
+   with real-to-complex FFTs the field at a k-point with a Nyquist
+     component is averaged with the field at the same point with all its
+     Nyquist components negated, this is the conjugate partner the complex
+     FFT implicitly adds when only the real part of the result is kept
+------------------------------------------------------------------------- */
 
-  // V5x
+void PPPMDipole::poisson_field_dipole(int type, int a, int b, FFT_SCALAR ***brick)
+{
+  int i,j,k,n,ii,c;
+  double sx,sy,sz,fre,fim;
+  double fk[3],vgk[6],coeff[3],coeffn[3];
 
   n = 0;
   ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
+  for (k = nzlo_fft; k <= nzhi_fft; k++) {
+    sz = (realfft && 2*k == nz_pppm) ? -1.0 : 1.0;
+    for (j = nylo_fft; j <= nyhi_fft; j++) {
+      sy = (realfft && 2*j == ny_pppm) ? -1.0 : 1.0;
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkx[i]*(vg[ii][5]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work2[n]);
-        work4[n+1] = fkx[i]*(vg[ii][5]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work2[n+1]);
-        n += 2;
-        ii++;
-      }
-
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v5x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
-
-  // V5y
+        sx = (realfft && 2*i == nx_pppm) ? -1.0 : 1.0;
+
+        fk[0] = fkx[i];
+        fk[1] = fky[j];
+        fk[2] = fkz[k];
+        field_coeff_dipole(type,a,b,fk,vg[ii],coeff);
+
+        if (sx < 0.0 || sy < 0.0 || sz < 0.0) {
+          fk[0] *= sx;
+          fk[1] *= sy;
+          fk[2] *= sz;
+          for (c = 0; c < 6; c++) vgk[c] = vg[ii][c];
+          vgk[3] *= sx*sy;
+          vgk[4] *= sx*sz;
+          vgk[5] *= sy*sz;
+          field_coeff_dipole(type,a,b,fk,vgk,coeffn);
+          for (c = 0; c < 3; c++) coeff[c] = 0.5*(coeff[c] + coeffn[c]);
+        }
 
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fky[j]*(vg[ii][5]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work2[n]);
-        work4[n+1] = fky[j]*(vg[ii][5]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work2[n+1]);
+        fre = coeff[0]*work1[n] + coeff[1]*work2[n] + coeff[2]*work3[n];
+        fim = coeff[0]*work1[n+1] + coeff[1]*work2[n+1] + coeff[2]*work3[n+1];
+        if (type == EGRAD) {
+          work4[n] = -fim;
+          work4[n+1] = fre;
+        } else {
+          work4[n] = fre;
+          work4[n+1] = fim;
+        }
         n += 2;
         ii++;
       }
+    }
+  }
 
-  fft2->compute(work4,work4,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        v5y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
-      }
+  // real-to-complex FFTs return reals in densityx_fft_dipole (unit stride),
+  //   which is free after the forward transforms
 
-  // V5z
+  if (realfft) {
+    fft2->compute(work4,densityx_fft_dipole,FFT3d::BACKWARD);
 
-  n = 0;
-  ii = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++)
-    for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        work4[n] = fkz[k]*(vg[ii][5]*(work1[n]*fkx[i] + work2[n]*fky[j] +
-                                      work3[n]*fkz[k]) + 2.0*fkz[k]*work2[n]);
-        work4[n+1] = fkz[k]*(vg[ii][5]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
-                                        work3[n+1]*fkz[k]) + 2.0*fkz[k]*work2[n+1]);
-        n += 2;
-        ii++;
-      }
+    n = 0;
+    for (k = nzlo_in; k <= nzhi_in; k++)
+      for (j = nylo_in; j <= nyhi_in; j++)
+        for (i = nxlo_in; i <= nxhi_in; i++)
+          brick[k][j][i] = densityx_fft_dipole[n++];
+    return;
+  }
 
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
@@ -2052,7 +1595,7 @@ void PPPMDipole::poisson_peratom_dipole()
   for (k = nzlo_in; k <= nzhi_in; k++)
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
-        v5z_brick_dipole[k][j][i] = work4[n];
+        brick[k][j][i] = work4[n];
         n += 2;
       }
 }
@@ -2506,24 +2049,31 @@ int PPPMDipole::timing_3d(int n, double &time3d)
 {
   double time1,time2;
 
+  // real-to-complex FFTs transform between densityx_fft_dipole and work1
+
+  FFT_SCALAR *rdata = work1;
+  if (realfft) {
+    rdata = densityx_fft_dipole;
+    for (int i = 0; i < nfft_both; i++) densityx_fft_dipole[i] = ZEROF;
+  }
   for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = platform::walltime();
 
   for (int i = 0; i < n; i++) {
-    fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
-    fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
-    fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
-    fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
+    fft1->compute(rdata,work1,FFT3d::FFT3d::FORWARD);
+    fft1->compute(rdata,work1,FFT3d::FFT3d::FORWARD);
+    fft1->compute(rdata,work1,FFT3d::FFT3d::FORWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
+    fft2->compute(work1,rdata,FFT3d::FFT3d::BACKWARD);
   }
 
   MPI_Barrier(world);
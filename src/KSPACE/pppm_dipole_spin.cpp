@@ -156,6 +156,8 @@ void PPPMDipoleSpin::init()
   deallocate();
   if (peratom_allocate_flag) deallocate_peratom();
 
+  realfft = (realfft_flag && realfft_support) ? 1 : 0;
+
   // setup FFT grid resolution and g_ewald
   // normally one iteration thru while loop is all that is required
   // if grid stencil does not extend beyond neighbor proc
@@ -221,6 +223,9 @@ void PPPMDipoleSpin::init()
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                        estimated_accuracy/two_charge_force);
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    if (realfft) mesg += "  using real-to-complex FFTs\n";
+    if (remap_precision < FFT_PRECISION)
+      mesg += "  using single precision FFT remaps\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
     utils::logmesg(lmp,mesg);
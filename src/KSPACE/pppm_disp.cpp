@@ -102,6 +102,7 @@ PPPMDisp::PPPMDisp(LAMMPS *lmp) : KSpace(lmp),
 {
   triclinic_support = 0;
   pppmflag = dispersionflag = 1;
+  realfft = realfft_6 = 0;
   triclinic = domain->triclinic;
 
   nfactors = 3;
@@ -332,6 +333,13 @@ void PPPMDisp::init()
       function[k] = 1;
     }
 
+  // real-to-complex FFTs for the Coulomb mesh and the geometric mixing mesh
+  // arithmetic and no mixing already pack two real meshes into each
+  //   complex FFT and keep complex-to-complex transforms
+
+  realfft = (realfft_flag && function[0]) ? 1 : 0;
+  realfft_6 = (realfft_flag && function[1]) ? 1 : 0;
+
   // warn, if function[0] is not set but charge attribute is set!
 
   if (!function[0] && atom->q_flag && me == 0)
@@ -428,7 +436,7 @@ void PPPMDisp::init()
       if (nx_pppm >= OFFSET || ny_pppm >= OFFSET || nz_pppm >= OFFSET)
         error->all(FLERR,"PPPMDisp Coulomb grid is too large");
 
-      set_grid_local(order,nx_pppm,ny_pppm,nz_pppm,
+      set_grid_local(order,realfft,nx_pppm,ny_pppm,nz_pppm,
                      shift,shiftone,shiftatom_lo,shiftatom_hi,
                      nlower,nupper,
                      nxlo_fft,nylo_fft,nzlo_fft,
@@ -484,7 +492,7 @@ void PPPMDisp::init()
       if (nx_pppm_6 >= OFFSET || ny_pppm_6 >= OFFSET || nz_pppm_6 >= OFFSET)
         error->all(FLERR,"PPPMDisp Dispersion grid is too large");
 
-      set_grid_local(order_6,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+      set_grid_local(order_6,realfft_6,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                      shift_6,shiftone_6,shiftatom_lo_6,shiftatom_hi_6,
                      nlower_6,nupper_6,
                      nxlo_fft_6,nylo_fft_6,nzlo_fft_6,
@@ -536,7 +544,7 @@ void PPPMDisp::init()
     compute_gf_denom(gf_b,order);
     compute_rho_coeff(rho_coeff,drho_coeff,order);
     if (differentiation_flag == 1)
-      compute_sf_precoeff(nx_pppm,ny_pppm,nz_pppm,order,
+      compute_sf_precoeff(nx_pppm,ny_pppm,nz_pppm,order,realfft,
                           nxlo_fft,nylo_fft,nzlo_fft,
                           nxhi_fft,nyhi_fft,nzhi_fft,
                           sf_precoeff1,sf_precoeff2,sf_precoeff3,
@@ -546,7 +554,7 @@ void PPPMDisp::init()
     compute_gf_denom(gf_b_6,order_6);
     compute_rho_coeff(rho_coeff_6,drho_coeff_6,order_6);
     if (differentiation_flag == 1)
-      compute_sf_precoeff(nx_pppm_6,ny_pppm_6,nz_pppm_6,order_6,
+      compute_sf_precoeff(nx_pppm_6,ny_pppm_6,nz_pppm_6,order_6,realfft_6,
                           nxlo_fft_6,nylo_fft_6,nzlo_fft_6,
                           nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
                           sf_precoeff1_6,sf_precoeff2_6,sf_precoeff3_6,
@@ -571,6 +579,9 @@ void PPPMDisp::init()
       mesg += fmt::format("  Coulomb estimated relative force accuracy = {:.8g}\n",
                           acc/two_charge_force);
       mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+      if (realfft) mesg += "  using real-to-complex FFTs\n";
+      if (remap_precision < FFT_PRECISION)
+        mesg += "  using single precision FFT remaps\n";
       mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                           ngrid_max,nfft_both_max);
       utils::logmesg(lmp,mesg);
@@ -595,6 +606,9 @@ void PPPMDisp::init()
       mesg += fmt::format("  Dispersion estimated relative force accuracy "
                           "= {:.8}\n",acc_6/two_charge_force);
       mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+      if (realfft_6) mesg += "  using real-to-complex FFTs\n";
+      if (remap_precision < FFT_PRECISION)
+        mesg += "  using single precision FFT remaps\n";
       mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                           ngrid_6_max,nfft_both_6_max);
       utils::logmesg(lmp,mesg);
@@ -804,14 +818,14 @@ void PPPMDisp::reset_grid()
   // reset portion of global grid that each proc owns
 
   if (function[0])
-    set_grid_local(order,nx_pppm,ny_pppm,nz_pppm,
+    set_grid_local(order,realfft,nx_pppm,ny_pppm,nz_pppm,
                    shift,shiftone,shiftatom_lo,shiftatom_hi,
                    nlower,nupper,
                    nxlo_fft,nylo_fft,nzlo_fft,
                    nxhi_fft,nyhi_fft,nzhi_fft);
 
   if (function[1] + function[2] + function[3])
-    set_grid_local(order_6,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+    set_grid_local(order_6,realfft_6,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                    shift_6,shiftone_6,shiftatom_lo_6,shiftatom_hi_6,
                    nlower_6,nupper_6,
                    nxlo_fft_6,nylo_fft_6,nzlo_fft_6,
@@ -839,7 +853,7 @@ void PPPMDisp::reset_grid()
     compute_gf_denom(gf_b,order);
     compute_rho_coeff(rho_coeff,drho_coeff,order);
     if (differentiation_flag == 1)
-      compute_sf_precoeff(nx_pppm,ny_pppm,nz_pppm,order,
+      compute_sf_precoeff(nx_pppm,ny_pppm,nz_pppm,order,realfft,
                           nxlo_fft,nylo_fft,nzlo_fft,
                           nxhi_fft,nyhi_fft,nzhi_fft,
                           sf_precoeff1,sf_precoeff2,sf_precoeff3,
@@ -849,7 +863,7 @@ void PPPMDisp::reset_grid()
     compute_gf_denom(gf_b_6,order_6);
     compute_rho_coeff(rho_coeff_6,drho_coeff_6,order_6);
     if (differentiation_flag == 1)
-      compute_sf_precoeff(nx_pppm_6,ny_pppm_6,nz_pppm_6,order_6,
+      compute_sf_precoeff(nx_pppm_6,ny_pppm_6,nz_pppm_6,order_6,realfft_6,
                           nxlo_fft_6,nylo_fft_6,nzlo_fft_6,
                           nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
                           sf_precoeff1_6,sf_precoeff2_6,sf_precoeff3_6,
@@ -1723,6 +1737,12 @@ void _noopt PPPMDisp::allocate()
 
     nfft_both = MAX(nfft,nfft_brick);
 
+    // with real-to-complex FFTs nfft counts the complex k-space values,
+    //   density_fft holds real values on the full x extent
+
+    if (realfft)
+      nfft_both = MAX(nfft_both,nx_pppm * (nyhi_fft-nylo_fft+1) * (nzhi_fft-nzlo_fft+1));
+
     // allocate distributed grid data
 
     memory->create(work1,2*nfft_both,"pppm/disp:work1");
@@ -1775,22 +1795,42 @@ void _noopt PPPMDisp::allocate()
     // 2nd FFT returns data in 3d brick decomposition
     // remap takes data from 3d brick to FFT decomposition
 
+    // with real-to-complex FFTs the real data spans the full x extent,
+    //   1st FFT is only used forward, 2nd FFT only backward
+
     int tmp;
 
-    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     0,0,&tmp,collective_flag);
+    if (realfft) {
+      fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       0,nx_pppm-1,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+      fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+      remap = new Remap(lmp,world,
+                        nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                        0,nx_pppm-1,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                        1,0,0,remap_precision,collective_flag);
+    } else {
+      fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
-    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                     0,0,&tmp,collective_flag);
+      fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                       0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
-    remap = new Remap(lmp,world,
-                      nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                      1,0,0,FFT_PRECISION,collective_flag);
+      remap = new Remap(lmp,world,
+                        nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                        nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                        1,0,0,remap_precision,collective_flag);
+    }
   }
 
   // --------------------------------------
@@ -1845,6 +1885,9 @@ void _noopt PPPMDisp::allocate()
       (nzhi_fft_6-nzlo_fft_6+1);
 
     nfft_both_6 = MAX(nfft_6,nfft_brick_6);
+    if (realfft_6)
+      nfft_both_6 = MAX(nfft_both_6,nx_pppm_6 * (nyhi_fft_6-nylo_fft_6+1) *
+                        (nzhi_fft_6-nzlo_fft_6+1));
 
     // create 2 FFTs and a Remap
     // 1st FFT keeps data in FFT decomposition
@@ -1853,23 +1896,43 @@ void _noopt PPPMDisp::allocate()
 
     int tmp;
 
-    fft1_6 =
-      new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                0,0,&tmp,collective_flag);
+    if (realfft_6) {
+      fft1_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  0,nx_pppm_6-1,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+      fft2_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  0,0,&tmp,collective_flag,1,remap_precision,npy_fft,npz_fft);
+
+      remap_6 =
+        new Remap(lmp,world,
+                  nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
+                  0,nx_pppm_6-1,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  1,0,0,remap_precision,collective_flag);
+    } else {
+      fft1_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
-    fft2_6 =
-      new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                0,0,&tmp,collective_flag);
+      fft2_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
+                  0,0,&tmp,collective_flag,0,remap_precision,npy_fft,npz_fft);
 
-    remap_6 =
-      new Remap(lmp,world,
-                nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                1,0,0,FFT_PRECISION,collective_flag);
+      remap_6 =
+        new Remap(lmp,world,
+                  nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  1,0,0,remap_precision,collective_flag);
+    }
   }
 
   // --------------------------------------
@@ -2721,7 +2784,7 @@ void PPPMDisp::set_grid_global()
      n xyz lo/hi fft = FFT columns that I own (all of x dim, 2d decomp in yz)
 ------------------------------------------------------------------------- */
 
-void PPPMDisp::set_grid_local(int order_either,
+void PPPMDisp::set_grid_local(int order_either, int realfft_either,
                               int nx_either, int ny_either, int nz_either,
                               double &shift_either, double &shiftone_either,
                               double &shiftatom_lo_either,double &shiftatom_hi_either,
@@ -2761,14 +2824,21 @@ void PPPMDisp::set_grid_local(int order_either,
   // global indices range from 0 to N-1
   // each proc owns entire x-dimension, clumps of columns in y,z dimensions
   // npey_fft,npez_fft = # of procs in y,z dims
-  // if nprocs is small enough, proc can own 1 or more entire xy planes,
+  // if set by kspace_modify fft/grid, use that proc grid
+  // else if nprocs is small enough, proc can own 1 or more entire xy planes,
   //   else proc owns 2d sub-blocks of yz plane
   // me_y,me_z = which proc (0-npe_fft-1) I am in y,z dimensions
   // nlo_fft,nhi_fft = lower/upper limit of the section
   //   of the global FFT mesh that I own in x-pencil decomposition
 
   int npey_fft,npez_fft;
-  if (nz_either >= nprocs) {
+  if (npy_fft) {
+    if (npy_fft > ny_either || npz_fft > nz_either)
+      error->all(FLERR,"Kspace_modify fft/grid {}x{} exceeds PPPMDisp mesh {}x{} in y,z",
+                 npy_fft,npz_fft,ny_either,nz_either);
+    npey_fft = npy_fft;
+    npez_fft = npz_fft;
+  } else if (nz_either >= nprocs) {
     npey_fft = 1;
     npez_fft = nprocs;
   } else procs2grid2d(nprocs,ny_either,nz_either,&npey_fft,&npez_fft);
@@ -2776,8 +2846,11 @@ void PPPMDisp::set_grid_local(int order_either,
   int me_y = me % npey_fft;
   int me_z = me / npey_fft;
 
+  // with real-to-complex FFTs the x-pencils are nx_either/2+1 long in k-space
+
   nxlo_fft_either = 0;
-  nxhi_fft_either = nx_either - 1;
+  if (realfft_either) nxhi_fft_either = nx_either/2;
+  else nxhi_fft_either = nx_either - 1;
   nylo_fft_either = me_y*ny_either/npey_fft;
   nyhi_fft_either = (me_y+1)*ny_either/npey_fft - 1;
   nzlo_fft_either = me_z*nz_either/npez_fft;
@@ -3758,13 +3831,13 @@ void PPPMDisp::compute_gf()
    and Coulomb interaction
 ------------------------------------------------------------------------- */
 
-void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord,
+void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord, int realfft_either,
                                    int nxlo_ft, int nylo_ft, int nzlo_ft,
                                    int nxhi_ft, int nyhi_ft, int nzhi_ft,
                                    double *sf_pre1, double *sf_pre2, double *sf_pre3,
                                    double *sf_pre4, double *sf_pre5, double *sf_pre6)
 {
-  int i,k,l,m,n;
+  int i,k,l,m,n,ip,npartner;
   double *prd;
 
   // volume-dependent factors
@@ -3783,7 +3856,7 @@ void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord,
   double unitky = (2.0*MY_PI/yprd);
   double unitkz = (2.0*MY_PI/zprd_slab);
 
-  int nx,ny,nz,kper,lper,mper;
+  int nx,ny,nz,kper,lper,mper,kp,lp,mp,lpartner,mpartner;
   double argx,argy,argz;
   double wx0[5],wy0[5],wz0[5],wx1[5],wy1[5],wz1[5],wx2[5],wy2[5],wz2[5];
   double qx0,qy0,qz0,qx1,qy1,qz1,qx2,qy2,qz2;
@@ -3795,73 +3868,93 @@ void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord,
   n = 0;
   for (m = nzlo_ft; m <= nzhi_ft; m++) {
     mper = m - nzp*(2*m/nzp);
+    mpartner = (2*m == nzp) ? mper : -mper;
 
     for (l = nylo_ft; l <= nyhi_ft; l++) {
       lper = l - nyp*(2*l/nyp);
+      lpartner = (2*l == nyp) ? lper : -lper;
 
       for (k = nxlo_ft; k <= nxhi_ft; k++) {
         kper = k - nxp*(2*k/nxp);
 
+        // with real-to-complex FFTs a point with 0 < kx < nxp/2 also
+        //   accumulates the coefficients of its conjugate partner -k,
+        //   Green's function is even so the sums in compute_sf_coeff() match
+
+        npartner = (realfft_either && k > 0 && 2*k < nxp) ? 2 : 1;
+
         sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = 0.0;
-        for (i = -nb; i <= nb; i++) {
-
-          qx0 = unitkx*(kper+nxp*i);
-          qx1 = unitkx*(kper+nxp*(i+1));
-          qx2 = unitkx*(kper+nxp*(i+2));
-          wx0[i+2] = 1.0;
-          wx1[i+2] = 1.0;
-          wx2[i+2] = 1.0;
-          argx = 0.5*qx0*xprd/nxp;
-          if (argx != 0.0) wx0[i+2] = pow(sin(argx)/argx,ord);
-          argx = 0.5*qx1*xprd/nxp;
-          if (argx != 0.0) wx1[i+2] = pow(sin(argx)/argx,ord);
-          argx = 0.5*qx2*xprd/nxp;
-          if (argx != 0.0) wx2[i+2] = pow(sin(argx)/argx,ord);
-
-          qy0 = unitky*(lper+nyp*i);
-          qy1 = unitky*(lper+nyp*(i+1));
-          qy2 = unitky*(lper+nyp*(i+2));
-          wy0[i+2] = 1.0;
-          wy1[i+2] = 1.0;
-          wy2[i+2] = 1.0;
-          argy = 0.5*qy0*yprd/nyp;
-          if (argy != 0.0) wy0[i+2] = pow(sin(argy)/argy,ord);
-          argy = 0.5*qy1*yprd/nyp;
-          if (argy != 0.0) wy1[i+2] = pow(sin(argy)/argy,ord);
-          argy = 0.5*qy2*yprd/nyp;
-          if (argy != 0.0) wy2[i+2] = pow(sin(argy)/argy,ord);
-
-          qz0 = unitkz*(mper+nzp*i);
-          qz1 = unitkz*(mper+nzp*(i+1));
-          qz2 = unitkz*(mper+nzp*(i+2));
-          wz0[i+2] = 1.0;
-          wz1[i+2] = 1.0;
-          wz2[i+2] = 1.0;
-          argz = 0.5*qz0*zprd_slab/nzp;
-          if (argz != 0.0) wz0[i+2] = pow(sin(argz)/argz,ord);
-          argz = 0.5*qz1*zprd_slab/nzp;
-          if (argz != 0.0) wz1[i+2] = pow(sin(argz)/argz,ord);
-           argz = 0.5*qz2*zprd_slab/nzp;
-          if (argz != 0.0) wz2[i+2] = pow(sin(argz)/argz,ord);
-        }
+        for (ip = 0; ip < npartner; ip++) {
+          if (ip == 0) {
+            kp = kper;
+            lp = lper;
+            mp = mper;
+          } else {
+            kp = -kper;
+            lp = lpartner;
+            mp = mpartner;
+          }
 
-        for (nx = 0; nx <= 4; nx++) {
-          for (ny = 0; ny <= 4; ny++) {
-            for (nz = 0; nz <= 4; nz++) {
-              u0 = wx0[nx]*wy0[ny]*wz0[nz];
-              u1 = wx1[nx]*wy0[ny]*wz0[nz];
-              u2 = wx2[nx]*wy0[ny]*wz0[nz];
-              u3 = wx0[nx]*wy1[ny]*wz0[nz];
-              u4 = wx0[nx]*wy2[ny]*wz0[nz];
-              u5 = wx0[nx]*wy0[ny]*wz1[nz];
-              u6 = wx0[nx]*wy0[ny]*wz2[nz];
-
-              sum1 += u0*u1;
-              sum2 += u0*u2;
-              sum3 += u0*u3;
-              sum4 += u0*u4;
-              sum5 += u0*u5;
-              sum6 += u0*u6;
+          for (i = -nb; i <= nb; i++) {
+
+            qx0 = unitkx*(kp+nxp*i);
+            qx1 = unitkx*(kp+nxp*(i+1));
+            qx2 = unitkx*(kp+nxp*(i+2));
+            wx0[i+2] = 1.0;
+            wx1[i+2] = 1.0;
+            wx2[i+2] = 1.0;
+            argx = 0.5*qx0*xprd/nxp;
+            if (argx != 0.0) wx0[i+2] = pow(sin(argx)/argx,ord);
+            argx = 0.5*qx1*xprd/nxp;
+            if (argx != 0.0) wx1[i+2] = pow(sin(argx)/argx,ord);
+            argx = 0.5*qx2*xprd/nxp;
+            if (argx != 0.0) wx2[i+2] = pow(sin(argx)/argx,ord);
+
+            qy0 = unitky*(lp+nyp*i);
+            qy1 = unitky*(lp+nyp*(i+1));
+            qy2 = unitky*(lp+nyp*(i+2));
+            wy0[i+2] = 1.0;
+            wy1[i+2] = 1.0;
+            wy2[i+2] = 1.0;
+            argy = 0.5*qy0*yprd/nyp;
+            if (argy != 0.0) wy0[i+2] = pow(sin(argy)/argy,ord);
+            argy = 0.5*qy1*yprd/nyp;
+            if (argy != 0.0) wy1[i+2] = pow(sin(argy)/argy,ord);
+            argy = 0.5*qy2*yprd/nyp;
+            if (argy != 0.0) wy2[i+2] = pow(sin(argy)/argy,ord);
+
+            qz0 = unitkz*(mp+nzp*i);
+            qz1 = unitkz*(mp+nzp*(i+1));
+            qz2 = unitkz*(mp+nzp*(i+2));
+            wz0[i+2] = 1.0;
+            wz1[i+2] = 1.0;
+            wz2[i+2] = 1.0;
+            argz = 0.5*qz0*zprd_slab/nzp;
+            if (argz != 0.0) wz0[i+2] = pow(sin(argz)/argz,ord);
+            argz = 0.5*qz1*zprd_slab/nzp;
+            if (argz != 0.0) wz1[i+2] = pow(sin(argz)/argz,ord);
+             argz = 0.5*qz2*zprd_slab/nzp;
+            if (argz != 0.0) wz2[i+2] = pow(sin(argz)/argz,ord);
+          }
+
+          for (nx = 0; nx <= 4; nx++) {
+            for (ny = 0; ny <= 4; ny++) {
+              for (nz = 0; nz <= 4; nz++) {
+                u0 = wx0[nx]*wy0[ny]*wz0[nz];
+                u1 = wx1[nx]*wy0[ny]*wz0[nz];
+                u2 = wx2[nx]*wy0[ny]*wz0[nz];
+                u3 = wx0[nx]*wy1[ny]*wz0[nz];
+                u4 = wx0[nx]*wy2[ny]*wz0[nz];
+                u5 = wx0[nx]*wy0[ny]*wz1[nz];
+                u6 = wx0[nx]*wy0[ny]*wz2[nz];
+
+                sum1 += u0*u1;
+                sum2 += u0*u2;
+                sum3 += u0*u3;
+                sum4 += u0*u4;
+                sum5 += u0*u5;
+                sum6 += u0*u6;
+              }
             }
           }
         }
@@ -4537,35 +4630,51 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
   double eng;
 
   // transform charge/dispersion density (r -> k)
+  // real-to-complex FFT reads dfft directly
 
-  n = 0;
-  for (i = 0; i < nft; i++) {
-    wk1[n++] = dfft[i];
-    wk1[n++] = ZEROF;
-  }
+  const int realfft_either = ft1->real_to_complex();
 
-  ft1->compute(wk1,wk1,FFT3d::FORWARD);
+  if (realfft_either) ft1->compute(dfft,wk1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nft; i++) {
+      wk1[n++] = dfft[i];
+      wk1[n++] = ZEROF;
+    }
+
+    ft1->compute(wk1,wk1,FFT3d::FORWARD);
+  }
 
   // if requested, compute energy and virial contribution
+  // with real-to-complex FFTs each point stands in for its conjugate
+  //   partner as well, the off-diagonal virial terms use the coefficients
+  //   averaged over both, which vanish on a single Nyquist component
 
   bigint ngridtotal = (bigint) nx_p * ny_p * nz_p;
   double scaleinv = 1.0/ngridtotal;
   double s2 = scaleinv*scaleinv;
+  const int nxk = nxhi_ft - nxlo_ft + 1;
 
   if (eflag_global || vflag_global) {
     if (vflag_global) {
       n = 0;
       for (i = 0; i < nft; i++) {
         eng = s2 * gfn[i] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
-        for (j = 0; j < 6; j++) vir[j] += eng*vcoeff[i][j];
+        if (realfft_either) {
+          eng *= kweight(i,nxk,nx_p);
+          for (j = 0; j < 3; j++) vir[j] += eng*vcoeff[i][j];
+          for (j = 0; j < 3; j++) vir[j+3] += eng*vcoeff2[i][j];
+        } else
+          for (j = 0; j < 6; j++) vir[j] += eng*vcoeff[i][j];
         if (eflag_global) egy += eng;
         n += 2;
       }
     } else {
       n = 0;
       for (i = 0; i < nft; i++) {
-        egy +=
-          s2 * gfn[i] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
+        eng = s2 * gfn[i] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
+        if (realfft_either) eng *= kweight(i,nxk,nx_p);
+        egy += eng;
         n += 2;
       }
     }
@@ -4584,6 +4693,63 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
   // FFT leaves data in 3d brick decomposition
   // copy it into inner portion of vdx,vdy,vdz arrays
 
+  // with real-to-complex FFTs each gradient needs its own complex-to-real FFT
+  //   of a Hermitian field, i.e. k averaged with its conjugate partner
+
+  if (realfft_either) {
+
+    // x direction gradient
+
+    n = 0;
+    for (k = nzlo_ft; k <= nzhi_ft; k++)
+      for (j = nylo_ft; j <= nyhi_ft; j++)
+        for (i = nxlo_ft; i <= nxhi_ft; i++) {
+          wk2[n] = -0.5*(kx[i]-kx2[i])*wk1[n+1];
+          wk2[n+1] = 0.5*(kx[i]-kx2[i])*wk1[n];
+          n += 2;
+        }
+
+    fft2_to_brick(wk2,dfft,ft2,nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,vx_brick);
+
+    // y direction gradient
+
+    n = 0;
+    for (k = nzlo_ft; k <= nzhi_ft; k++)
+      for (j = nylo_ft; j <= nyhi_ft; j++)
+        for (i = nxlo_ft; i <= nxhi_ft; i++) {
+          wk2[n] = -0.5*(ky[j]-ky2[j])*wk1[n+1];
+          wk2[n+1] = 0.5*(ky[j]-ky2[j])*wk1[n];
+          n += 2;
+        }
+
+    fft2_to_brick(wk2,dfft,ft2,nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,vy_brick);
+
+    // z direction gradient
+
+    n = 0;
+    for (k = nzlo_ft; k <= nzhi_ft; k++)
+      for (j = nylo_ft; j <= nyhi_ft; j++)
+        for (i = nxlo_ft; i <= nxhi_ft; i++) {
+          wk2[n] = -0.5*(kz[k]-kz2[k])*wk1[n+1];
+          wk2[n+1] = 0.5*(kz[k]-kz2[k])*wk1[n];
+          n += 2;
+        }
+
+    fft2_to_brick(wk2,dfft,ft2,nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,vz_brick);
+
+    // per-atom energy
+
+    if (eflag_atom) {
+      for (i = 0; i < 2*nft; i++) wk2[i] = wk1[i];
+      fft2_to_brick(wk2,dfft,ft2,nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,u_pa);
+    }
+
+    if (vflag_atom) poisson_peratom(wk1,wk2,dfft,ft2,vcoeff,vcoeff2,nft,
+                                    nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,
+                                    v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa);
+    return;
+  }
+
   // x & y direction gradient
 
   n = 0;
@@ -4651,7 +4817,7 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
         }
   }
 
-  if (vflag_atom) poisson_peratom(wk1,wk2,ft2,vcoeff,vcoeff2,nft,
+  if (vflag_atom) poisson_peratom(wk1,wk2,dfft,ft2,vcoeff,vcoeff2,nft,
                                   nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,
                                   v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa);
 }
@@ -4678,35 +4844,49 @@ void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
   double eng;
 
   // transform charge/dispersion density (r -> k)
+  // real-to-complex FFT reads dfft directly
 
-  n = 0;
-  for (i = 0; i < nft; i++) {
-    wk1[n++] = dfft[i];
-    wk1[n++] = ZEROF;
-  }
+  const int realfft_either = ft1->real_to_complex();
+
+  if (realfft_either) ft1->compute(dfft,wk1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nft; i++) {
+      wk1[n++] = dfft[i];
+      wk1[n++] = ZEROF;
+    }
 
-  ft1->compute(wk1,wk1,FFT3d::FORWARD);
+    ft1->compute(wk1,wk1,FFT3d::FORWARD);
+  }
 
   // if requested, compute energy and virial contribution
+  // with real-to-complex FFTs use the partner-averaged off-diagonal terms
 
   bigint ngridtotal = (bigint) nx_p * ny_p * nz_p;
   double scaleinv = 1.0/ngridtotal;
   double s2 = scaleinv*scaleinv;
+  const int nxk = nxhi_ft - nxlo_ft + 1;
 
   if (eflag_global || vflag_global) {
     if (vflag_global) {
       n = 0;
       for (i = 0; i < nft; i++) {
         eng = s2 * gfn[i] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
-        for (j = 0; j < 6; j++) vir[j] += eng*vcoeff[i][j];
+        if (realfft_either) {
+          eng *= kweight(i,nxk,nx_p);
+          for (j = 0; j < 3; j++) vir[j] += eng*vcoeff[i][j];
+          for (j = 0; j < 3; j++) vir[j+3] += eng*vcoeff2[i][j];
+        } else
+          for (j = 0; j < 6; j++) vir[j] += eng*vcoeff[i][j];
         if (eflag_global) egy += eng;
         n += 2;
       }
     } else {
       n = 0;
       for (i = 0; i < nft; i++) {
-        egy +=
-          s2 * gfn[i] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
+        eng = s2 * gfn[i] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
+        if (realfft_either) eng *= kweight(i,nxk,nx_p);
+        egy += eng;
         n += 2;
       }
     }
@@ -4730,17 +4910,21 @@ void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
         n += 2;
      }
 
-  ft2->compute(wk2,wk2,FFT3d::BACKWARD);
+  if (realfft_either)
+    fft2_to_brick(wk2,dfft,ft2,nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,u_pa);
+  else {
+    ft2->compute(wk2,wk2,FFT3d::BACKWARD);
 
-  n = 0;
-  for (k = nzlo_i; k <= nzhi_i; k++)
-    for (j = nylo_i; j <= nyhi_i; j++)
-      for (i = nxlo_i; i <= nxhi_i; i++) {
-        u_pa[k][j][i] = wk2[n];
-        n += 2;
-      }
+    n = 0;
+    for (k = nzlo_i; k <= nzhi_i; k++)
+      for (j = nylo_i; j <= nyhi_i; j++)
+        for (i = nxlo_i; i <= nxhi_i; i++) {
+          u_pa[k][j][i] = wk2[n];
+          n += 2;
+        }
+  }
 
-  if (vflag_atom) poisson_peratom(wk1,wk2,ft2,vcoeff,vcoeff2,nft,
+  if (vflag_atom) poisson_peratom(wk1,wk2,dfft,ft2,vcoeff,vcoeff2,nft,
                                   nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,
                                   v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa);
 }
@@ -4749,7 +4933,8 @@ void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
    Fourier Transform for per atom virial calculations
 ------------------------------------------------------------------------- */
 
-void PPPMDisp::poisson_peratom(FFT_SCALAR* wk1, FFT_SCALAR* wk2, LAMMPS_NS::FFT3d* ft2,
+void PPPMDisp::poisson_peratom(FFT_SCALAR* wk1, FFT_SCALAR* wk2, FFT_SCALAR* dfft,
+                               LAMMPS_NS::FFT3d* ft2,
                                double** vcoeff, double** vcoeff2, int nft,
                                int nxlo_i, int nylo_i, int nzlo_i,
                                int nxhi_i, int nyhi_i, int nzhi_i,
@@ -4758,9 +4943,30 @@ void PPPMDisp::poisson_peratom(FFT_SCALAR* wk1, FFT_SCALAR* wk2, LAMMPS_NS::FFT3
                                FFT_SCALAR*** v3_pa, FFT_SCALAR*** v4_pa,
                                FFT_SCALAR*** v5_pa)
 {
- // v0 & v1 term
-
   int n, i, j, k;
+
+  // with real-to-complex FFTs transform each term separately,
+  //   the off-diagonal terms use the partner-averaged coefficients
+
+  if (ft2->real_to_complex()) {
+    FFT_SCALAR ***v_pa[6] = {v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa};
+
+    for (int m = 0; m < 6; m++) {
+      n = 0;
+      for (i = 0; i < nft; i++) {
+        const double c = (m < 3) ? vcoeff[i][m] : vcoeff2[i][m-3];
+        wk2[n] = wk1[n]*c;
+        wk2[n+1] = wk1[n+1]*c;
+        n += 2;
+      }
+
+      fft2_to_brick(wk2,dfft,ft2,nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,v_pa[m]);
+    }
+    return;
+  }
+
+  // v0 & v1 term
+
   n = 0;
   for (i = 0; i < nft; i++) {
     wk2[n] = wk1[n]*vcoeff[i][0] + wk1[n+1]*vcoeff[i][1];
@@ -4818,6 +5024,27 @@ void PPPMDisp::poisson_peratom(FFT_SCALAR* wk1, FFT_SCALAR* wk2, LAMMPS_NS::FFT3
 
 }
 
+/* ----------------------------------------------------------------------
+   complex-to-real FFT of k-space data in wk2 to 3d brick decomposition
+   dfft holds the real result, copy it into inner portion of brick
+------------------------------------------------------------------------- */
+
+void PPPMDisp::fft2_to_brick(FFT_SCALAR* wk2, FFT_SCALAR* dfft, LAMMPS_NS::FFT3d* ft2,
+                             int nxlo_i, int nylo_i, int nzlo_i,
+                             int nxhi_i, int nyhi_i, int nzhi_i,
+                             FFT_SCALAR*** brick)
+{
+  int i,j,k,n;
+
+  ft2->compute(wk2,dfft,FFT3d::BACKWARD);
+
+  n = 0;
+  for (k = nzlo_i; k <= nzhi_i; k++)
+    for (j = nylo_i; j <= nyhi_i; j++)
+      for (i = nxlo_i; i <= nxhi_i; i++)
+        brick[k][j][i] = dfft[n++];
+}
+
 /* ----------------------------------------------------------------------
    Poisson solver for one mesh with 2 different dispersion densities
    for ik scheme
@@ -8189,20 +8416,37 @@ int PPPMDisp::timing_3d(int n, double &time3d)
   if (function[2]) mixing = 4;
   if (function[3]) mixing = nsplit_alloc/2;
 
-  if (function[0]) for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
-  if (function[1] + function[2] + function[3])
+  // real-to-complex FFTs need separate real and k-space buffers
+
+  FFT_SCALAR *rdata = nullptr, *rdata_6 = nullptr;
+
+  if (function[0]) {
+    for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+    rdata = work1;
+    if (realfft) {
+      for (int i = 0; i < nfft_both; i++) density_fft[i] = ZEROF;
+      rdata = density_fft;
+    }
+  }
+  if (function[1] + function[2] + function[3]) {
     for (int i = 0; i < 2*nfft_both_6; i++) work1_6[i] = ZEROF;
+    rdata_6 = work1_6;
+    if (realfft_6) {
+      for (int i = 0; i < nfft_both_6; i++) density_fft_g[i] = ZEROF;
+      rdata_6 = density_fft_g;
+    }
+  }
 
   MPI_Barrier(world);
   time1 = platform::walltime();
 
   if (function[0]) {
     for (int i = 0; i < n; i++) {
-      fft1->compute(work1,work1,FFT3d::FORWARD);
-      fft2->compute(work1,work1,FFT3d::BACKWARD);
+      fft1->compute(rdata,work1,FFT3d::FORWARD);
+      fft2->compute(work1,rdata,FFT3d::BACKWARD);
       if (differentiation_flag != 1) {
-        fft2->compute(work1,work1,FFT3d::BACKWARD);
-        fft2->compute(work1,work1,FFT3d::BACKWARD);
+        fft2->compute(work1,rdata,FFT3d::BACKWARD);
+        fft2->compute(work1,rdata,FFT3d::BACKWARD);
       }
     }
   }
@@ -8216,11 +8460,11 @@ int PPPMDisp::timing_3d(int n, double &time3d)
 
   if (function[1] + function[2] + function[3]) {
     for (int i = 0; i < n; i++) {
-      fft1_6->compute(work1_6,work1_6,FFT3d::FORWARD);
-      fft2_6->compute(work1_6,work1_6,FFT3d::BACKWARD);
+      fft1_6->compute(rdata_6,work1_6,FFT3d::FORWARD);
+      fft2_6->compute(work1_6,rdata_6,FFT3d::BACKWARD);
       if (differentiation_flag != 1) {
-        fft2_6->compute(work1_6,work1_6,FFT3d::BACKWARD);
-        fft2_6->compute(work1_6,work1_6,FFT3d::BACKWARD);
+        fft2_6->compute(work1_6,rdata_6,FFT3d::BACKWARD);
+        fft2_6->compute(work1_6,rdata_6,FFT3d::BACKWARD);
       }
     }
   }
@@ -60,6 +60,8 @@ class PPPMDisp : public KSpace {
   int nsplit;
   int nsplit_alloc;
   int function[EWALD_FUNCS];
+  int realfft;      // 1 if Coulomb mesh uses real-to-complex FFTs
+  int realfft_6;    // 1 if dispersion mesh uses real-to-complex FFTs
 
   double delxinv, delyinv, delzinv, delvolinv;
   double delxinv_6, delyinv_6, delzinv_6, delvolinv_6;
@@ -207,7 +209,7 @@ class PPPMDisp : public KSpace {
 
   void set_grid_global();
   void set_grid_global_6();
-  void set_grid_local(int, int, int, int, double &, double &, double &, double &,
+  void set_grid_local(int, int, int, int, int, double &, double &, double &, double &,
                       int &, int &, int &, int &, int &, int &, int &, int &);
   void set_init_g6();
   void set_n_pppm_6();
@@ -243,8 +245,8 @@ class PPPMDisp : public KSpace {
   void compute_gf_denom(double *, int);
   double gf_denom(double, double, double, double *, int);
 
-  void compute_sf_precoeff(int, int, int, int, int, int, int, int, int, int, double *, double *,
-                           double *, double *, double *, double *);
+  void compute_sf_precoeff(int, int, int, int, int, int, int, int, int, int, int, double *,
+                           double *, double *, double *, double *, double *);
   void compute_gf();
   void compute_sf_coeff();
   void compute_gf_6();
@@ -278,9 +280,12 @@ class PPPMDisp : public KSpace {
                           double **, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
                           FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***);
 
-  virtual void poisson_peratom(FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *, double **, double **,
-                               int, int, int, int, int, int, int, FFT_SCALAR ***, FFT_SCALAR ***,
-                               FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***);
+  virtual void poisson_peratom(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *,
+                               double **, double **, int, int, int, int, int, int, int,
+                               FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
+                               FFT_SCALAR ***, FFT_SCALAR ***);
+  void fft2_to_brick(FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *, int, int, int, int, int, int,
+                     FFT_SCALAR ***);
   virtual void poisson_2s_ik(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR ***, FFT_SCALAR ***,
                              FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
                              FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
@@ -334,6 +339,19 @@ class PPPMDisp : public KSpace {
   void unpack_forward_grid(int, void *, int, int *) override;
   void pack_reverse_grid(int, void *, int, int *) override;
   void unpack_reverse_grid(int, void *, int, int *) override;
+
+  /* ----------------------------------------------------------------------
+   weight of FFT point n in k-space sums with real-to-complex FFTs
+     nxk = x extent of the k-space pencils, nxp = x extent of the mesh
+     kx = 0 and kx = nxp/2 are their own conjugate partners in x,
+     all other points count twice
+------------------------------------------------------------------------- */
+
+  static inline double kweight(int n, int nxk, int nxp)
+  {
+    const int i = n % nxk;
+    return (i == 0 || 2 * i == nxp) ? 1.0 : 2.0;
+  };
 };
 
 }    // namespace LAMMPS_NS
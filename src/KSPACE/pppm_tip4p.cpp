@@ -38,6 +38,7 @@ PPPMTIP4P::PPPMTIP4P(LAMMPS *lmp) : PPPM(lmp)
 {
   triclinic_support = 1;
   tip4pflag = 1;
+  overlap_support = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -15,6 +15,7 @@
 #include "remap.h"
 
 #include <cstdlib>
+#include <cstring>
 
 #define PACK_DATA FFT_SCALAR
 
@@ -23,6 +24,10 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static int remap_3d_node_create(struct remap_plan_3d *);
+static void remap_3d_node(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
+static void remap_3d_node_destroy(struct remap_node_3d *);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d remaps:
 
@@ -74,6 +79,49 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
     else
       scratch = plan->scratch;
 
+    // reduced precision messages are converted after packing
+    //   and before unpacking, self data is not converted
+
+    if (plan->precision < FFT_PRECISION) {
+      float *scratch_single = plan->scratch_single;
+      float *sendbuf_single = plan->sendbuf_single;
+      int j,n;
+
+      for (irecv = 0; irecv < plan->nrecv; irecv++)
+        MPI_Irecv(&scratch_single[plan->recv_bufloc[irecv]],plan->recv_size[irecv],
+                  MPI_FLOAT,plan->recv_proc[irecv],0,
+                  plan->comm,&plan->request[irecv]);
+
+      for (isend = 0; isend < plan->nsend; isend++) {
+        plan->pack(&in[plan->send_offset[isend]],
+                   plan->sendbuf,&plan->packplan[isend]);
+        n = plan->send_size[isend];
+        for (j = 0; j < n; j++) sendbuf_single[j] = plan->sendbuf[j];
+        MPI_Send(sendbuf_single,n,MPI_FLOAT,
+                 plan->send_proc[isend],0,plan->comm);
+      }
+
+      if (plan->self) {
+        isend = plan->nsend;
+        irecv = plan->nrecv;
+        plan->pack(&in[plan->send_offset[isend]],
+                   &scratch[plan->recv_bufloc[irecv]],
+                   &plan->packplan[isend]);
+        plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                     &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+      }
+
+      for (i = 0; i < plan->nrecv; i++) {
+        MPI_Waitany(plan->nrecv,plan->request,&irecv,MPI_STATUS_IGNORE);
+        FFT_SCALAR *dest = &scratch[plan->recv_bufloc[irecv]];
+        const float *src = &scratch_single[plan->recv_bufloc[irecv]];
+        n = plan->recv_size[irecv];
+        for (j = 0; j < n; j++) dest[j] = src[j];
+        plan->unpack(dest,&out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+      }
+      return;
+    }
+
     // post all recvs into scratch space
 
     for (irecv = 0; irecv < plan->nrecv; irecv++)
@@ -110,6 +158,12 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
                    &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
     }
 
+  // use node-aware All2Allv for remap communication
+
+  } else if (plan->usecollective == 2) {
+    if (plan->memory == 0) remap_3d_node(in,out,buf,plan);
+    else remap_3d_node(in,out,plan->scratch,plan);
+
   // use All2Allv collective for remap communication
 
   } else {
@@ -173,9 +227,25 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
         }
       }
 
-      MPI_Alltoallv(packedSendBuffer, sendcnts, sdispls,
-                    MPI_FFT_SCALAR, packedRecvBuffer, rcvcnts,
-                    rdispls, MPI_FFT_SCALAR, plan->comm);
+      // reduced precision data is exchanged in temporary float buffers
+
+      if (plan->precision < FFT_PRECISION) {
+        auto singleSendBuffer = (float *) malloc(sizeof(float) * sendBufferSize);
+        auto singleRecvBuffer = (float *) malloc(sizeof(float) * recvBufferSize);
+        for (int i=0;i<sendBufferSize;i++)
+          singleSendBuffer[i] = packedSendBuffer[i];
+        MPI_Alltoallv(singleSendBuffer, sendcnts, sdispls,
+                      MPI_FLOAT, singleRecvBuffer, rcvcnts,
+                      rdispls, MPI_FLOAT, plan->comm);
+        for (int i=0;i<recvBufferSize;i++)
+          packedRecvBuffer[i] = singleRecvBuffer[i];
+        free(singleSendBuffer);
+        free(singleRecvBuffer);
+      } else {
+        MPI_Alltoallv(packedSendBuffer, sendcnts, sdispls,
+                      MPI_FFT_SCALAR, packedRecvBuffer, rcvcnts,
+                      rdispls, MPI_FFT_SCALAR, plan->comm);
+      }
 
       // unpack the data from the recv buffer into out
 
@@ -221,10 +291,16 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
    memory               user provides buffer memory for remap or system does
                           0 = user provides memory
                           1 = system provides memory
-   precision            precision of data
+   precision            precision of data sent between procs
                           1 = single precision (4 bytes per datum)
                           2 = double precision (8 bytes per datum)
+                          cannot exceed precision of FFT_SCALAR,
+                          lower precision converts data on the fly
    usecollective        whether to use collective MPI or point-to-point
+                          0 = point-to-point
+                          1 = MPI_Alltoallv within procs that share data
+                          2 = node-aware MPI_Alltoallv, data is aggregated
+                              within shared-memory nodes first
 ------------------------------------------------------------------------- */
 
 struct remap_plan_3d *remap_3d_create_plan(
@@ -233,7 +309,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   int in_klo, int in_khi,
   int out_ilo, int out_ihi, int out_jlo, int out_jhi,
   int out_klo, int out_khi,
-  int nqty, int permute, int memory, int /*precision*/, int usecollective)
+  int nqty, int permute, int memory, int precision, int usecollective)
 
 {
 
@@ -252,6 +328,12 @@ struct remap_plan_3d *remap_3d_create_plan(
   plan = (struct remap_plan_3d *) malloc(sizeof(struct remap_plan_3d));
   if (plan == nullptr) return nullptr;
   plan->usecollective = usecollective;
+  plan->commringlen = 0;
+  plan->commringlist = nullptr;
+  plan->node = nullptr;
+  plan->precision = MIN(precision,FFT_PRECISION);
+  plan->sendbuf_single = nullptr;
+  plan->scratch_single = nullptr;
 
   // store parameters in local data structs
 
@@ -341,7 +423,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // plan->nsend = # of sends not including self
 
   if (nsend && plan->send_proc[nsend-1] == me) {
-    if (plan->usecollective) // for collectives include self in nsend list
+    if (plan->usecollective == 1) // for collectives include self in nsend list
       plan->nsend = nsend;
     else
       plan->nsend = nsend - 1;
@@ -453,7 +535,7 @@ struct remap_plan_3d *remap_3d_create_plan(
 
   // create sub-comm rank list
 
-  if (plan->usecollective) {
+  if (plan->usecollective == 1) {
     plan->commringlist = nullptr;
 
     // merge recv and send rank lists
@@ -558,7 +640,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // for collectives include self in the nsend list
 
   if (nrecv && plan->recv_proc[nrecv-1] == me) {
-    if (plan->usecollective) plan->nrecv = nrecv;
+    if (plan->usecollective == 1) plan->nrecv = nrecv;
     else plan->nrecv = nrecv - 1;
   } else plan->nrecv = nrecv;
 
@@ -587,6 +669,21 @@ struct remap_plan_3d *remap_3d_create_plan(
     if (plan->sendbuf == nullptr) return nullptr;
   }
 
+  // for reduced precision point-to-point comm, messages are converted
+  //   in separate buffers, the recv buffer holds all recvs like scratch
+
+  if (plan->precision < FFT_PRECISION && !plan->usecollective) {
+    if (size) {
+      plan->sendbuf_single = (float *) malloc(size*sizeof(float));
+      if (plan->sendbuf_single == nullptr) return nullptr;
+    }
+    if (nrecv > 0) {
+      plan->scratch_single =
+        (float *) malloc((size_t)nqty*out.isize*out.jsize*out.ksize * sizeof(float));
+      if (plan->scratch_single == nullptr) return nullptr;
+    }
+  }
+
   // if requested, allocate internal scratch space for recvs,
   // only need it if I will receive any data (including self)
 
@@ -605,7 +702,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // communicator for the plan based off an MPI_Group created with
   // ranks from the commringlist
 
-  if ((plan->usecollective && (plan->commringlen > 0))) {
+  if ((plan->usecollective == 1) && (plan->commringlen > 0)) {
     MPI_Group orig_group, new_group;
     MPI_Comm_group(comm, &orig_group);
     MPI_Group_incl(orig_group, plan->commringlen,
@@ -616,14 +713,19 @@ struct remap_plan_3d *remap_3d_create_plan(
   // if using collective and the comm ring list is empty create
   // a communicator for the plan with an empty group
 
-  else if ((plan->usecollective) && (plan->commringlen == 0)) {
+  else if ((plan->usecollective == 1) && (plan->commringlen == 0)) {
     MPI_Comm_create(comm, MPI_GROUP_EMPTY, &plan->comm);
   }
 
-  // not using collective - dup comm
+  // not using collective or node-aware collective - dup comm
 
   else MPI_Comm_dup(comm,&plan->comm);
 
+  // setup gather/exchange/scatter of node-aware collective
+
+  if (plan->usecollective == 2)
+    if (!remap_3d_node_create(plan)) return nullptr;
+
   // return pointer to plan
 
   return plan;
@@ -637,14 +739,16 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
 {
   // free MPI communicator
 
-  if (!(plan->usecollective) || (plan->commringlen != 0))
+  if ((plan->usecollective != 1) || (plan->commringlen != 0))
     MPI_Comm_free(&plan->comm);
 
-  if (plan->usecollective) {
+  if (plan->usecollective == 1) {
     if (plan->commringlist != nullptr)
       free(plan->commringlist);
   }
 
+  if (plan->node) remap_3d_node_destroy(plan->node);
+
   // free internal arrays
 
   if (plan->nsend || plan->self) {
@@ -653,6 +757,7 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
     free(plan->send_proc);
     free(plan->packplan);
     if (plan->sendbuf) free(plan->sendbuf);
+    if (plan->sendbuf_single) free(plan->sendbuf_single);
   }
 
   if (plan->nrecv || plan->self) {
@@ -663,6 +768,7 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
     free(plan->request);
     free(plan->unpackplan);
     if (plan->scratch) free(plan->scratch);
+    if (plan->scratch_single) free(plan->scratch_single);
   }
 
   // free plan itself
@@ -698,3 +804,336 @@ int remap_3d_collide(struct extent_3d *block1, struct extent_3d *block2,
 
   return 1;
 }
+
+/* ----------------------------------------------------------------------
+   Setup node-aware all-to-all of a 3d remap plan
+   uses send/recv lists of the plan, not including self
+   each proc packs all its sends into one buffer ordered by recv proc,
+     procs are ordered by node and by rank within node
+   leader of each node gathers buffers of its procs, reorders them by
+     recv node, exchanges them with other leaders, reorders the result
+     by recv proc and scatters it to the procs of its node
+   return 0 if memory could not be allocated, else 1
+------------------------------------------------------------------------- */
+
+static int remap_3d_node_create(struct remap_plan_3d *plan)
+{
+  struct remap_node_3d *node;
+  int i,l,n,iproc,pos,me,nprocs,nodeme,nodesize,inode,nnodes,size;
+  int *procnode = nullptr, *nodefirst = nullptr, *order = nullptr;
+  int *sendcnt = nullptr, *recvcnt = nullptr, *offset = nullptr;
+  int *allsend = nullptr, *allrecv = nullptr, *cursor = nullptr;
+
+  // free all work arrays and the partially set up node on every exit
+
+  auto cleanup = [&](int success) {
+    free(procnode);
+    free(nodefirst);
+    free(order);
+    free(sendcnt);
+    free(recvcnt);
+    free(offset);
+    free(allsend);
+    free(allrecv);
+    free(cursor);
+    if (!success && plan->node) {
+      remap_3d_node_destroy(plan->node);
+      plan->node = nullptr;
+    }
+    return success;
+  };
+
+  MPI_Comm_rank(plan->comm,&me);
+  MPI_Comm_size(plan->comm,&nprocs);
+
+  node = (struct remap_node_3d *) calloc(1,sizeof(struct remap_node_3d));
+  if (node == nullptr) return 0;
+  plan->node = node;
+
+  // split procs into shared-memory nodes, lowest rank of a node is its leader
+  // node index = rank of its leader in leader_comm
+
+  MPI_Comm_split_type(plan->comm,MPI_COMM_TYPE_SHARED,me,MPI_INFO_NULL,&node->node_comm);
+  MPI_Comm_rank(node->node_comm,&nodeme);
+  MPI_Comm_size(node->node_comm,&nodesize);
+  node->leader = (nodeme == 0) ? 1 : 0;
+  MPI_Comm_split(plan->comm,node->leader ? 0 : MPI_UNDEFINED,me,&node->leader_comm);
+
+  inode = nnodes = 0;
+  if (node->leader) {
+    MPI_Comm_rank(node->leader_comm,&inode);
+    MPI_Comm_size(node->leader_comm,&nnodes);
+  }
+  MPI_Bcast(&inode,1,MPI_INT,0,node->node_comm);
+  MPI_Bcast(&nnodes,1,MPI_INT,0,node->node_comm);
+  node->nnodes = nnodes;
+
+  // order = procs sorted by node and by rank within node
+  // nodefirst = index in order of first proc of each node
+
+  int mine[2] = {inode,nodeme};
+  procnode = (int *) malloc(2*nprocs*sizeof(int));
+  nodefirst = (int *) calloc(nnodes+1,sizeof(int));
+  order = (int *) malloc(nprocs*sizeof(int));
+  sendcnt = (int *) calloc(nprocs,sizeof(int));
+  recvcnt = (int *) calloc(nprocs,sizeof(int));
+  if (!procnode || !nodefirst || !order || !sendcnt || !recvcnt) return cleanup(0);
+
+  MPI_Allgather(mine,2,MPI_INT,procnode,2,MPI_INT,plan->comm);
+  for (iproc = 0; iproc < nprocs; iproc++) nodefirst[procnode[2*iproc]+1]++;
+  for (n = 0; n < nnodes; n++) nodefirst[n+1] += nodefirst[n];
+  for (iproc = 0; iproc < nprocs; iproc++) {
+    pos = nodefirst[procnode[2*iproc]] + procnode[2*iproc+1];
+    order[pos] = iproc;
+  }
+
+  // offsets of my sends and recvs in my buffers
+
+  for (i = 0; i < plan->nsend; i++) sendcnt[plan->send_proc[i]] = plan->send_size[i];
+  for (i = 0; i < plan->nrecv; i++) recvcnt[plan->recv_proc[i]] = plan->recv_size[i];
+
+  node->send_bufloc = (int *) malloc((plan->nsend+1)*sizeof(int));
+  node->recv_bufloc = (int *) malloc((plan->nrecv+1)*sizeof(int));
+  offset = (int *) malloc(nprocs*sizeof(int));
+  if (!node->send_bufloc || !node->recv_bufloc || !offset) return cleanup(0);
+
+  node->sendsize = 0;
+  for (pos = 0; pos < nprocs; pos++) {
+    offset[order[pos]] = node->sendsize;
+    node->sendsize += sendcnt[order[pos]];
+  }
+  for (i = 0; i < plan->nsend; i++) node->send_bufloc[i] = offset[plan->send_proc[i]];
+
+  node->recvsize = 0;
+  for (pos = 0; pos < nprocs; pos++) {
+    offset[order[pos]] = node->recvsize;
+    node->recvsize += recvcnt[order[pos]];
+  }
+  for (i = 0; i < plan->nrecv; i++) node->recv_bufloc[i] = offset[plan->recv_proc[i]];
+  free(offset);
+  offset = nullptr;
+
+  const int single = (plan->precision < FFT_PRECISION);
+  const size_t esize = single ? sizeof(float) : sizeof(FFT_SCALAR);
+
+  node->sendbuf = (char *) malloc(MAX(node->sendsize,1)*esize);
+  node->recvbuf = (char *) malloc(MAX(node->recvsize,1)*esize);
+  if (!node->sendbuf || !node->recvbuf) return cleanup(0);
+
+  // leader collects send and recv counts of all procs of its node
+
+  if (node->leader) {
+    allsend = (int *) malloc((size_t)nodesize*nprocs*sizeof(int));
+    allrecv = (int *) malloc((size_t)nodesize*nprocs*sizeof(int));
+    if (!allsend || !allrecv) return cleanup(0);
+  }
+  MPI_Gather(sendcnt,nprocs,MPI_INT,allsend,nprocs,MPI_INT,0,node->node_comm);
+  MPI_Gather(recvcnt,nprocs,MPI_INT,allrecv,nprocs,MPI_INT,0,node->node_comm);
+
+  if (node->leader) {
+    node->gathercnts = (int *) calloc(nodesize,sizeof(int));
+    node->gatherdispls = (int *) calloc(nodesize,sizeof(int));
+    node->scattercnts = (int *) calloc(nodesize,sizeof(int));
+    node->scatterdispls = (int *) calloc(nodesize,sizeof(int));
+    node->exchsendcnts = (int *) calloc(nnodes,sizeof(int));
+    node->exchsenddispls = (int *) calloc(nnodes,sizeof(int));
+    node->exchrecvcnts = (int *) calloc(nnodes,sizeof(int));
+    node->exchrecvdispls = (int *) calloc(nnodes,sizeof(int));
+    cursor = (int *) calloc(nodesize,sizeof(int));
+    if (!node->gathercnts || !node->gatherdispls || !node->scattercnts ||
+        !node->scatterdispls || !node->exchsendcnts || !node->exchsenddispls ||
+        !node->exchrecvcnts || !node->exchrecvdispls || !cursor) return cleanup(0);
+
+    for (l = 0; l < nodesize; l++) {
+      for (iproc = 0; iproc < nprocs; iproc++) {
+        node->gathercnts[l] += allsend[l*nprocs+iproc];
+        node->scattercnts[l] += allrecv[l*nprocs+iproc];
+      }
+      if (l) {
+        node->gatherdispls[l] = node->gatherdispls[l-1] + node->gathercnts[l-1];
+        node->scatterdispls[l] = node->scatterdispls[l-1] + node->scattercnts[l-1];
+      }
+    }
+
+    // gathered data is ordered by send proc and then by recv proc
+    // exchanged data is ordered by recv node, send proc, recv proc
+    // a send proc's data for one recv node is contiguous
+
+    node->seg_out = (int *) malloc(3*MAX(nnodes*nodesize,1)*sizeof(int));
+    if (!node->seg_out) return cleanup(0);
+    node->nseg_out = 0;
+    size = 0;
+    for (n = 0; n < nnodes; n++) {
+      for (l = 0; l < nodesize; l++) {
+        int count = 0;
+        for (pos = nodefirst[n]; pos < nodefirst[n+1]; pos++)
+          count += allsend[l*nprocs+order[pos]];
+        if (count) {
+          node->seg_out[3*node->nseg_out] = node->gatherdispls[l] + cursor[l];
+          node->seg_out[3*node->nseg_out+1] = size;
+          node->seg_out[3*node->nseg_out+2] = count;
+          node->nseg_out++;
+        }
+        cursor[l] += count;
+        node->exchsendcnts[n] += count;
+        size += count;
+      }
+      if (n) node->exchsenddispls[n] = node->exchsenddispls[n-1] + node->exchsendcnts[n-1];
+    }
+
+    // data recvd from each node is ordered by its send procs, then by recv proc
+    // scattered data is ordered by recv proc, then by send proc
+    // every datum recvd from a send proc for a recv proc is one segment
+
+    int nseg = 0;
+    for (l = 0; l < nodesize; l++)
+      for (iproc = 0; iproc < nprocs; iproc++)
+        if (allrecv[l*nprocs+iproc]) nseg++;
+
+    node->seg_in = (int *) malloc(3*MAX(nseg,1)*sizeof(int));
+    if (!node->seg_in) return cleanup(0);
+    node->nseg_in = 0;
+    for (l = 0; l < nodesize; l++) cursor[l] = 0;
+    size = 0;
+    for (n = 0; n < nnodes; n++) {
+      for (pos = nodefirst[n]; pos < nodefirst[n+1]; pos++) {
+        iproc = order[pos];
+        for (l = 0; l < nodesize; l++) {
+          int count = allrecv[l*nprocs+iproc];
+          if (count == 0) continue;
+          node->seg_in[3*node->nseg_in] = size;
+          node->seg_in[3*node->nseg_in+1] = node->scatterdispls[l] + cursor[l];
+          node->seg_in[3*node->nseg_in+2] = count;
+          node->nseg_in++;
+          cursor[l] += count;
+          node->exchrecvcnts[n] += count;
+          size += count;
+        }
+      }
+      if (n) node->exchrecvdispls[n] = node->exchrecvdispls[n-1] + node->exchrecvcnts[n-1];
+    }
+
+    int gathersize = 0;
+    int scattersize = 0;
+    for (l = 0; l < nodesize; l++) {
+      gathersize += node->gathercnts[l];
+      scattersize += node->scattercnts[l];
+    }
+    node->gatherbuf = (char *) malloc(MAX(gathersize,1)*esize);
+    node->exchsendbuf = (char *) malloc(MAX(gathersize,1)*esize);
+    node->exchrecvbuf = (char *) malloc(MAX(scattersize,1)*esize);
+    node->scatterbuf = (char *) malloc(MAX(scattersize,1)*esize);
+    if (!node->gatherbuf || !node->exchsendbuf || !node->exchrecvbuf || !node->scatterbuf)
+      return cleanup(0);
+  }
+
+  return cleanup(1);
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d remap with node-aware all-to-all
+   scratch holds self data and converted recvs of reduced precision
+------------------------------------------------------------------------- */
+
+static void remap_3d_node(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *scratch,
+                          struct remap_plan_3d *plan)
+{
+  struct remap_node_3d *node = plan->node;
+  int i,j,n,isend,irecv;
+
+  const int single = (plan->precision < FFT_PRECISION);
+  const size_t esize = single ? sizeof(float) : sizeof(FFT_SCALAR);
+  MPI_Datatype datatype = single ? MPI_FLOAT : MPI_FFT_SCALAR;
+
+  // pack all sends into one buffer, converting reduced precision data
+
+  for (isend = 0; isend < plan->nsend; isend++) {
+    if (single) {
+      plan->pack(&in[plan->send_offset[isend]],plan->sendbuf,&plan->packplan[isend]);
+      float *dest = (float *) node->sendbuf + node->send_bufloc[isend];
+      n = plan->send_size[isend];
+      for (j = 0; j < n; j++) dest[j] = plan->sendbuf[j];
+    } else {
+      plan->pack(&in[plan->send_offset[isend]],
+                 (FFT_SCALAR *) node->sendbuf + node->send_bufloc[isend],
+                 &plan->packplan[isend]);
+    }
+  }
+
+  // gather on leader, exchange between leaders, scatter from leader
+
+  MPI_Gatherv(node->sendbuf,node->sendsize,datatype,node->gatherbuf,
+              node->gathercnts,node->gatherdispls,datatype,0,node->node_comm);
+
+  if (node->leader) {
+    for (i = 0; i < 3*node->nseg_out; i += 3)
+      memcpy(node->exchsendbuf + esize*node->seg_out[i+1],
+             node->gatherbuf + esize*node->seg_out[i],esize*node->seg_out[i+2]);
+    MPI_Alltoallv(node->exchsendbuf,node->exchsendcnts,node->exchsenddispls,datatype,
+                  node->exchrecvbuf,node->exchrecvcnts,node->exchrecvdispls,datatype,
+                  node->leader_comm);
+    for (i = 0; i < 3*node->nseg_in; i += 3)
+      memcpy(node->scatterbuf + esize*node->seg_in[i+1],
+             node->exchrecvbuf + esize*node->seg_in[i],esize*node->seg_in[i+2]);
+  }
+
+  MPI_Scatterv(node->scatterbuf,node->scattercnts,node->scatterdispls,datatype,
+               node->recvbuf,node->recvsize,datatype,0,node->node_comm);
+
+  // copy in -> scratch -> out for self data
+
+  if (plan->self) {
+    isend = plan->nsend;
+    irecv = plan->nrecv;
+    plan->pack(&in[plan->send_offset[isend]],
+               &scratch[plan->recv_bufloc[irecv]],
+               &plan->packplan[isend]);
+    plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+  }
+
+  // unpack all recvs, converting reduced precision data
+
+  for (irecv = 0; irecv < plan->nrecv; irecv++) {
+    if (single) {
+      FFT_SCALAR *dest = &scratch[plan->recv_bufloc[irecv]];
+      const float *src = (float *) node->recvbuf + node->recv_bufloc[irecv];
+      n = plan->recv_size[irecv];
+      for (j = 0; j < n; j++) dest[j] = src[j];
+      plan->unpack(dest,&out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+    } else {
+      plan->unpack((FFT_SCALAR *) node->recvbuf + node->recv_bufloc[irecv],
+                   &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Destroy node-aware all-to-all of a 3d remap plan
+------------------------------------------------------------------------- */
+
+static void remap_3d_node_destroy(struct remap_node_3d *node)
+{
+  MPI_Comm_free(&node->node_comm);
+  if (node->leader_comm != MPI_COMM_NULL) MPI_Comm_free(&node->leader_comm);
+
+  free(node->send_bufloc);
+  free(node->recv_bufloc);
+  free(node->sendbuf);
+  free(node->recvbuf);
+  free(node->gathercnts);
+  free(node->gatherdispls);
+  free(node->scattercnts);
+  free(node->scatterdispls);
+  free(node->exchsendcnts);
+  free(node->exchsenddispls);
+  free(node->exchrecvcnts);
+  free(node->exchrecvdispls);
+  free(node->seg_out);
+  free(node->seg_in);
+  free(node->gatherbuf);
+  free(node->exchsendbuf);
+  free(node->exchrecvbuf);
+  free(node->scatterbuf);
+  free(node);
+}
@@ -15,11 +15,41 @@
 
 #include "lmpfftsettings.h"
 
+// details of how to do a node-aware all-to-all for a 3d remap
+// data is gathered on one leader proc per shared-memory node,
+//   exchanged between leaders, then scattered to procs of the node
+
+struct remap_node_3d {
+  MPI_Comm node_comm;      // procs sharing memory with me
+  MPI_Comm leader_comm;    // leaders of all nodes, MPI_COMM_NULL if not a leader
+  int leader;              // 1 if I am the leader of my node
+  int nnodes;              // # of nodes
+  int *send_bufloc;        // offset of each send in sendbuf
+  int *recv_bufloc;        // offset of each recv in recvbuf
+  int sendsize, recvsize;  // total # of datums I send/recv, not including self
+  char *sendbuf;           // all my sends, ordered by recv proc
+  char *recvbuf;           // all my recvs, ordered by send proc
+
+  // only used by leader
+
+  int *gathercnts, *gatherdispls;        // MPI_Gatherv counts/displs per node proc
+  int *scattercnts, *scatterdispls;      // MPI_Scatterv counts/displs per node proc
+  int *exchsendcnts, *exchsenddispls;    // MPI_Alltoallv counts/displs per node
+  int *exchrecvcnts, *exchrecvdispls;
+  int nseg_out, nseg_in;                 // # of segments in seg_out/seg_in
+  int *seg_out;                          // (from,to,size) to reorder gathered data
+  int *seg_in;                           // (from,to,size) to reorder exchanged data
+  char *gatherbuf, *exchsendbuf, *exchrecvbuf, *scatterbuf;
+};
+
 // details of how to do a 3d remap
 
 struct remap_plan_3d {
   FFT_SCALAR *sendbuf;    // buffer for MPI sends
   FFT_SCALAR *scratch;    // scratch buffer for MPI recvs
+  int precision;          // 1 = send data in single precision, 2 = in double
+  float *sendbuf_single;  // single precision send and recv buffers
+  float *scratch_single;  //   if precision is lower than FFT_SCALAR
   void (*pack)(FFT_SCALAR *, FFT_SCALAR *, struct pack_plan_3d *);
   // which pack function to use
   void (*unpack)(FFT_SCALAR *, FFT_SCALAR *, struct pack_plan_3d *);
@@ -39,7 +69,9 @@ struct remap_plan_3d {
   int self;                           // whether I send/recv with myself
   int memory;                         // user provides scratch space or not
   MPI_Comm comm;                      // group of procs performing remap
-  int usecollective;                  // use collective or point-to-point MPI
+  int usecollective;                  // 0 = point-to-point MPI, 1 = collective,
+                                      // 2 = node-aware collective
+  struct remap_node_3d *node;         // node-aware all-to-all, if usecollective = 2
   int commringlen;                    // length of commringlist
   int *commringlist;                  // ranks on communication ring of this plan
 };
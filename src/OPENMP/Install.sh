@@ -31,6 +31,7 @@ action () {
 
 for file in *_omp.cpp; do
   test $file = thr_omp.cpp && continue
+  test $file = verlet_kspace_omp.cpp && continue
   dep=${file%_omp.cpp}.cpp
   action $file $dep
 done
@@ -38,11 +39,14 @@ done
 for file in *_omp.h; do
   test $file = thr_omp.h && continue
   test $file = reaxff_omp.h && continue
+  test $file = verlet_kspace_omp.h && continue
   dep=${file%_omp.h}.h
   action $file $dep
 done
 
 action reaxff_omp.h reaxff_api.h
+action verlet_kspace_omp.cpp pppm.cpp
+action verlet_kspace_omp.h pppm.h
 action thr_omp.h
 action thr_omp.cpp
 action thr_data.h
@@ -36,6 +36,7 @@ using namespace MathConst;
 EwaldOMP::EwaldOMP(LAMMPS *lmp) : Ewald(lmp), ThrOMP(lmp, THR_KSPACE)
 {
   triclinic_support = 1;
+  frozen_support = 0;
   suffix_flag |= Suffix::OMP;
 }
 
@@ -29,6 +29,7 @@ class ThrData;
 class FixOMP : public Fix {
   friend class ThrOMP;
   friend class RespaOMP;
+  friend class VerletKSpaceOMP;
 
  public:
   FixOMP(class LAMMPS *, int, char **);
@@ -315,6 +315,12 @@ void MSMOMP::direct_eval(const int nn)
   }
 }
 
+/* ----------------------------------------------------------------------
+   scatter per-atom energy/virial of direct sum to the neighbor grid points
+   each thread owns a range of target z planes, so no two threads update
+   the same grid point and the order of summation matches the serial code
+------------------------------------------------------------------------- */
+
 template <int VFLAG_ATOM>
 void MSMOMP::direct_peratom(const int nn)
 {
@@ -334,7 +340,6 @@ void MSMOMP::direct_peratom(const int nn)
   const double * _noalias const v4_directn = v4_direct[nn];
   const double * _noalias const v5_directn = v5_direct[nn];
 
-
   const int alphan = alpha[nn];
   const int betaxn = betax[nn];
   const int betayn = betay[nn];
@@ -351,45 +356,94 @@ void MSMOMP::direct_peratom(const int nn)
   const int numz = nzhi_in[nn] - nzlo_inn + 1;
   const int numy = nyhi_in[nn] - nylo_inn + 1;
   const int numx = nxhi_in[nn] - nxlo_inn + 1;
-  const int inum = numz*numy*numx;
+
+  // target z planes, including ghost planes
+
+  const int nzlo_outn = nzlo_out[nn];
+  const int nplanes = nzhi_out[nn] - nzlo_outn + 1;
 
   const int zper = domain->zperiodic;
   const int yper = domain->yperiodic;
   const int xper = domain->xperiodic;
 
-  int i,icx,icy,icz,ix,iy,iz,k;
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE
+#endif
+  {
+    int i,ifrom,ito,tid,icx,icy,icz,ix,iy,iz,k;
 
+    loop_setup_thr(ifrom, ito, tid, nplanes, comm->nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
 
-  for (i = 0; i < inum; ++i) {
+    // range of target planes of this thread and of source planes reaching them
 
-    // infer outer loop indices icx, icy, icz from master loop index i
+    const int kklo = nzlo_outn + ifrom;
+    const int kkhi = nzlo_outn + ito - 1;
+    const int iczlo = MAX(0,kklo - nzhi_direct - nzlo_inn);
+    const int iczhi = MIN(numz-1,kkhi - nzlo_inn);
 
-    icz = i/(numy*numx);
-    icy = (i - icz*numy*numx) / numx;
-    icx = i - icz*numy*numx - icy*numx;
-    icz += nzlo_inn;
-    icy += nylo_inn;
-    icx += nxlo_inn;
+    const int istart = iczlo*numy*numx;
+    const int istop = (iczhi < iczlo) ? istart : (iczhi+1)*numy*numx;
 
-    const int kmax = zper ? nzhi_direct : MIN(nzhi_direct,betazn - icz);
-    const int jmin = yper ? nylo_direct : MAX(nylo_direct,alphan - icy);
-    const int jmax = yper ? nyhi_direct : MIN(nyhi_direct,betayn - icy);
-    const int imin = xper ? nxlo_direct : MAX(nxlo_direct,alphan - icx);
-    const int imax = xper ? nxhi_direct : MIN(nxhi_direct,betaxn - icx);
+    for (i = istart; i < istop; ++i) {
 
-    const double qtmp = qgridn[icz][icy][icx]; // charge on center grid point
+      // infer outer loop indices icx, icy, icz from master loop index i
 
+      icz = i/(numy*numx);
+      icy = (i - icz*numy*numx) / numx;
+      icx = i - icz*numy*numx - icy*numx;
+      icz += nzlo_inn;
+      icy += nylo_inn;
+      icx += nxlo_inn;
+
+      const int kmin = MAX(1,kklo - icz);
+      const int kmax = MIN(kkhi - icz, zper ? nzhi_direct : MIN(nzhi_direct,betazn - icz));
+      const int jmin = yper ? nylo_direct : MAX(nylo_direct,alphan - icy);
+      const int jmax = yper ? nyhi_direct : MIN(nyhi_direct,betayn - icy);
+      const int imin = xper ? nxlo_direct : MAX(nxlo_direct,alphan - icx);
+      const int imax = xper ? nxhi_direct : MIN(nxhi_direct,betaxn - icx);
 
-    // use hemisphere to avoid double computation of pair-wise
-    //   interactions in direct sum (no computations in -z direction)
+      const double qtmp = qgridn[icz][icy][icx]; // charge on center grid point
 
-    for (iz = 1; iz <= kmax; iz++) {
-      const int kk = icz+iz;
-      const int zk = (iz + nzhi_direct)*ny;
-      for (iy = jmin; iy <= jmax; iy++) {
+      // use hemisphere to avoid double computation of pair-wise
+      //   interactions in direct sum (no computations in -z direction)
+
+      for (iz = kmin; iz <= kmax; iz++) {
+        const int kk = icz+iz;
+        const int zk = (iz + nzhi_direct)*ny;
+        for (iy = jmin; iy <= jmax; iy++) {
+          const int jj = icy+iy;
+          const int zyk = (zk + iy + nyhi_direct)*nx;
+          double * _noalias const egridnkj = &egridn[kk][jj][icx];
+          for (ix = imin; ix <= imax; ix++) {
+            k = zyk + ix + nxhi_direct;
+            const int ii = icx+ix;
+            const double gtmp = g_directn[k];
+
+            egridnkj[ix] += gtmp * qtmp;
+
+            if (VFLAG_ATOM) {
+              v0gridn[kk][jj][ii] += v0_directn[k] * qtmp;
+              v1gridn[kk][jj][ii] += v1_directn[k] * qtmp;
+              v2gridn[kk][jj][ii] += v2_directn[k] * qtmp;
+              v3gridn[kk][jj][ii] += v3_directn[k] * qtmp;
+              v4gridn[kk][jj][ii] += v4_directn[k] * qtmp;
+              v5gridn[kk][jj][ii] += v5_directn[k] * qtmp;
+            }
+          }
+        }
+      }
+
+      // iz=0 updates the source plane itself
+
+      if (icz < kklo || icz > kkhi) continue;
+
+      const int zk = nzhi_direct*ny;
+      for (iy = 1; iy <= jmax; iy++) {
         const int jj = icy+iy;
         const int zyk = (zk + iy + nyhi_direct)*nx;
-        double * _noalias const egridnkj = &egridn[kk][jj][icx];
+        double * _noalias const egridnkj = &egridn[icz][jj][icx];
         for (ix = imin; ix <= imax; ix++) {
           k = zyk + ix + nxhi_direct;
           const int ii = icx+ix;
@@ -398,25 +452,21 @@ void MSMOMP::direct_peratom(const int nn)
           egridnkj[ix] += gtmp * qtmp;
 
           if (VFLAG_ATOM) {
-            v0gridn[kk][jj][ii] += v0_directn[k] * qtmp;
-            v1gridn[kk][jj][ii] += v1_directn[k] * qtmp;
-            v2gridn[kk][jj][ii] += v2_directn[k] * qtmp;
-            v3gridn[kk][jj][ii] += v3_directn[k] * qtmp;
-            v4gridn[kk][jj][ii] += v4_directn[k] * qtmp;
-            v5gridn[kk][jj][ii] += v5_directn[k] * qtmp;
+            v0gridn[icz][jj][ii] += v0_directn[k] * qtmp;
+            v1gridn[icz][jj][ii] += v1_directn[k] * qtmp;
+            v2gridn[icz][jj][ii] += v2_directn[k] * qtmp;
+            v3gridn[icz][jj][ii] += v3_directn[k] * qtmp;
+            v4gridn[icz][jj][ii] += v4_directn[k] * qtmp;
+            v5gridn[icz][jj][ii] += v5_directn[k] * qtmp;
           }
         }
       }
-    }
 
-    // iz=0
+      // iz=0, iy=0
 
-    const int zk = nzhi_direct*ny;
-    for (iy = 1; iy <= jmax; iy++) {
-      const int jj = icy+iy;
-      const int zyk = (zk + iy + nyhi_direct)*nx;
-      double * _noalias const egridnkj = &egridn[icz][jj][icx];
-      for (ix = imin; ix <= imax; ix++) {
+      const int zyk = (zk + nyhi_direct)*nx;
+      double * _noalias const egridnkj = &egridn[icz][icy][icx];
+      for (ix = 1; ix <= imax; ix++) {
         k = zyk + ix + nxhi_direct;
         const int ii = icx+ix;
         const double gtmp = g_directn[k];
@@ -424,44 +474,265 @@ void MSMOMP::direct_peratom(const int nn)
         egridnkj[ix] += gtmp * qtmp;
 
         if (VFLAG_ATOM) {
-          v0gridn[icz][jj][ii] += v0_directn[k] * qtmp;
-          v1gridn[icz][jj][ii] += v1_directn[k] * qtmp;
-          v2gridn[icz][jj][ii] += v2_directn[k] * qtmp;
-          v3gridn[icz][jj][ii] += v3_directn[k] * qtmp;
-          v4gridn[icz][jj][ii] += v4_directn[k] * qtmp;
-          v5gridn[icz][jj][ii] += v5_directn[k] * qtmp;
+          v0gridn[icz][icy][ii] += v0_directn[k] * qtmp;
+          v1gridn[icz][icy][ii] += v1_directn[k] * qtmp;
+          v2gridn[icz][icy][ii] += v2_directn[k] * qtmp;
+          v3gridn[icz][icy][ii] += v3_directn[k] * qtmp;
+          v4gridn[icz][icy][ii] += v4_directn[k] * qtmp;
+          v5gridn[icz][icy][ii] += v5_directn[k] * qtmp;
         }
       }
-    }
 
-    // iz=0, iy=0
+      // iz=0, iy=0, ix=0
 
-    const int zyk = (zk + nyhi_direct)*nx;
-    double * _noalias const egridnkj = &egridn[icz][icy][icx];
-    for (ix = 1; ix <= imax; ix++) {
-      k = zyk + ix + nxhi_direct;
-      const int ii = icx+ix;
+      k = zyk + nxhi_direct;
       const double gtmp = g_directn[k];
+      egridnkj[0] += 0.5 * gtmp * qtmp;
 
-      egridnkj[ix] += gtmp * qtmp;
+      // virial is zero for iz=0, iy=0, ix=0
 
-      if (VFLAG_ATOM) {
-        v0gridn[icz][icy][ii] += v0_directn[k] * qtmp;
-        v1gridn[icz][icy][ii] += v1_directn[k] * qtmp;
-        v2gridn[icz][icy][ii] += v2_directn[k] * qtmp;
-        v3gridn[icz][icy][ii] += v3_directn[k] * qtmp;
-        v4gridn[icz][icy][ii] += v4_directn[k] * qtmp;
-        v5gridn[icz][icy][ii] += v5_directn[k] * qtmp;
+    }
+    thr->timer(Timer::KSPACE);
+  } // end of omp parallel region
+}
+
+/* ----------------------------------------------------------------------
+   range of stencil points first..last of coarse point with fine index c
+   whose fine grid index c+index[k] lies within lo..hi
+------------------------------------------------------------------------- */
+
+static inline void stencil_range(const int *index, const int npts, const int c,
+                                 const int lo, const int hi, int &first, int &last)
+{
+  first = 0;
+  while (first < npts && c+index[first] < lo) first++;
+  last = npts-1;
+  while (last >= first && c+index[last] > hi) last--;
+}
+
+/* ----------------------------------------------------------------------
+   MSM restriction procedure for intermediate grid levels, calculate
+   charge density on coarser grid. threads gather into disjoint sets
+   of coarse grid points, non-periodic bounds are resolved before the
+   innermost loops, so those have a fixed trip count.
+------------------------------------------------------------------------- */
+
+void MSMOMP::restriction(int n)
+{
+  const int p = order-1;
+  int *index = new int[p+2];
+  const int npts = setup_stencil(n,index);
+
+  const double * _noalias const * _noalias const * _noalias const qgrid1 = qgrid[n];
+  double * _noalias const * _noalias const * _noalias const qgrid2 = qgrid[n+1];
+  const double * _noalias const phix = phi1d[0];
+  const double * _noalias const phiy = phi1d[1];
+  const double * _noalias const phiz = phi1d[2];
+
+  // zero out charge on coarser grid
+
+  memset(&(qgrid2[nzlo_out[n+1]][nylo_out[n+1]][nxlo_out[n+1]]),0,ngrid[n+1]*sizeof(double));
+
+  // bounds of fine grid points, ghost extent already covers periodic images
+
+  const int xlo = domain->xperiodic ? nxlo_out[n] : alpha[n];
+  const int xhi = domain->xperiodic ? nxhi_out[n] : betax[n];
+  const int ylo = domain->yperiodic ? nylo_out[n] : alpha[n];
+  const int yhi = domain->yperiodic ? nyhi_out[n] : betay[n];
+  const int zlo = domain->zperiodic ? nzlo_out[n] : alpha[n];
+  const int zhi = domain->zperiodic ? nzhi_out[n] : betaz[n];
+
+  const int xratio = static_cast<int> (delxinv[n]/delxinv[n+1]);
+  const int yratio = static_cast<int> (delyinv[n]/delyinv[n+1]);
+  const int zratio = static_cast<int> (delzinv[n]/delzinv[n+1]);
+
+  // merge two outer loops into one for better threading
+
+  const int nzlo_inn = nzlo_in[n+1];
+  const int nylo_inn = nylo_in[n+1];
+  const int numy = nyhi_in[n+1] - nylo_inn + 1;
+  const int inum = (nzhi_in[n+1] - nzlo_inn + 1) * numy;
+  const int nxlo_inn = nxlo_in[n+1];
+  const int nxhi_inn = nxhi_in[n+1];
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(index)
+#endif
+  {
+    int i,ifrom,ito,tid,ip,jp,kp,ic,jc,kc,ii,j,k;
+    int ifirst,ilast,jfirst,jlast,kfirst,klast;
+    double q2sum,phizy;
+
+    loop_setup_thr(ifrom, ito, tid, inum, comm->nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+
+    for (i = ifrom; i < ito; ++i) {
+      kp = nzlo_inn + i/numy;
+      jp = nylo_inn + i%numy;
+      kc = kp * zratio;
+      jc = jp * yratio;
+      stencil_range(index,npts,kc,zlo,zhi,kfirst,klast);
+      stencil_range(index,npts,jc,ylo,yhi,jfirst,jlast);
+
+      for (ip = nxlo_inn; ip <= nxhi_inn; ip++) {
+        ic = ip * xratio;
+        stencil_range(index,npts,ic,xlo,xhi,ifirst,ilast);
+
+        q2sum = 0.0;
+        for (k = kfirst; k <= klast; k++) {
+          for (j = jfirst; j <= jlast; j++) {
+            const double * _noalias const qrow = &qgrid1[kc+index[k]][jc+index[j]][ic];
+            phizy = phiy[j]*phiz[k];
+            for (ii = ifirst; ii <= ilast; ii++)
+              q2sum += qrow[index[ii]] * phix[ii]*phizy;
+          }
+        }
+        qgrid2[kp][jp][ip] += q2sum;
       }
     }
+    thr->timer(Timer::KSPACE);
+  } // end of omp parallel region
 
-    // iz=0, iy=0, ix=0
+  delete[] index;
+}
 
-    k = zyk + nxhi_direct;
-    const double gtmp = g_directn[k];
-    egridnkj[0] += 0.5 * gtmp * qtmp;
+/* ----------------------------------------------------------------------
+   MSM prolongation procedure for intermediate grid levels, interpolate
+   per-atom energy/virial from coarser grid to finer grid
+------------------------------------------------------------------------- */
 
-    // virial is zero for iz=0, iy=0, ix=0
+void MSMOMP::prolongation(int n)
+{
+  if (vflag_atom)
+    prolongation_eval<1>(n);
+  else
+    prolongation_eval<0>(n);
+}
 
-  }
+/* ----------------------------------------------------------------------
+   the stencils of neighboring coarse points overlap on the finer grid,
+   so each thread owns a range of fine z planes and adds only the part of
+   each stencil within them. this keeps the order of summation of the
+   serial code for every fine grid point.
+------------------------------------------------------------------------- */
+
+template <int VFLAG_ATOM>
+void MSMOMP::prolongation_eval(const int n)
+{
+  const int p = order-1;
+  int *index = new int[p+2];
+  const int npts = setup_stencil(n,index);
+
+  double * _noalias const * _noalias const * _noalias const egrid1 = egrid[n];
+  const double * _noalias const * _noalias const * _noalias const egrid2 = egrid[n+1];
+  const double * _noalias const phix = phi1d[0];
+  const double * _noalias const phiy = phi1d[1];
+  const double * _noalias const phiz = phi1d[2];
+
+  double ***v0grid1 = v0grid[n];
+  double ***v0grid2 = v0grid[n+1];
+  double ***v1grid1 = v1grid[n];
+  double ***v1grid2 = v1grid[n+1];
+  double ***v2grid1 = v2grid[n];
+  double ***v2grid2 = v2grid[n+1];
+  double ***v3grid1 = v3grid[n];
+  double ***v3grid2 = v3grid[n+1];
+  double ***v4grid1 = v4grid[n];
+  double ***v4grid2 = v4grid[n+1];
+  double ***v5grid1 = v5grid[n];
+  double ***v5grid2 = v5grid[n+1];
+
+  const int xlo = domain->xperiodic ? nxlo_out[n] : alpha[n];
+  const int xhi = domain->xperiodic ? nxhi_out[n] : betax[n];
+  const int ylo = domain->yperiodic ? nylo_out[n] : alpha[n];
+  const int yhi = domain->yperiodic ? nyhi_out[n] : betay[n];
+  const int zlo = domain->zperiodic ? nzlo_out[n] : alpha[n];
+  const int zhi = domain->zperiodic ? nzhi_out[n] : betaz[n];
+
+  const int xratio = static_cast<int> (delxinv[n]/delxinv[n+1]);
+  const int yratio = static_cast<int> (delyinv[n]/delyinv[n+1]);
+  const int zratio = static_cast<int> (delzinv[n]/delzinv[n+1]);
+
+  const int nzlo_outn = nzlo_out[n];
+  const int nplanes = nzhi_out[n] - nzlo_outn + 1;
+
+  const int nxlo_inn = nxlo_in[n+1];
+  const int nxhi_inn = nxhi_in[n+1];
+  const int nylo_inn = nylo_in[n+1];
+  const int nyhi_inn = nyhi_in[n+1];
+  const int nzlo_inn = nzlo_in[n+1];
+  const int nzhi_inn = nzhi_in[n+1];
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(index,v0grid1,v0grid2,v1grid1,v1grid2,v2grid1,v2grid2,v3grid1,v3grid2,v4grid1,v4grid2,v5grid1,v5grid2)
+#endif
+  {
+    int ifrom,ito,tid,ip,jp,kp,ic,jc,kc,ii,jj,kk,i,j,k;
+    int ifirst,ilast,jfirst,jlast,kfirst,klast;
+    double phizy,phi3d,etmp2;
+    double v0tmp2,v1tmp2,v2tmp2,v3tmp2,v4tmp2,v5tmp2;
+    v0tmp2 = v1tmp2 = v2tmp2 = v3tmp2 = v4tmp2 = v5tmp2 = 0.0;
+
+    loop_setup_thr(ifrom, ito, tid, nplanes, comm->nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+
+    const int kklo = MAX(zlo,nzlo_outn + ifrom);
+    const int kkhi = MIN(zhi,nzlo_outn + ito - 1);
+
+    for (kp = nzlo_inn; kp <= nzhi_inn; kp++) {
+      kc = kp * zratio;
+      stencil_range(index,npts,kc,kklo,kkhi,kfirst,klast);
+      if (kfirst > klast) continue;
+
+      for (jp = nylo_inn; jp <= nyhi_inn; jp++) {
+        jc = jp * yratio;
+        stencil_range(index,npts,jc,ylo,yhi,jfirst,jlast);
+
+        for (ip = nxlo_inn; ip <= nxhi_inn; ip++) {
+          ic = ip * xratio;
+          stencil_range(index,npts,ic,xlo,xhi,ifirst,ilast);
+
+          etmp2 = egrid2[kp][jp][ip];
+
+          if (VFLAG_ATOM) {
+            v0tmp2 = v0grid2[kp][jp][ip];
+            v1tmp2 = v1grid2[kp][jp][ip];
+            v2tmp2 = v2grid2[kp][jp][ip];
+            v3tmp2 = v3grid2[kp][jp][ip];
+            v4tmp2 = v4grid2[kp][jp][ip];
+            v5tmp2 = v5grid2[kp][jp][ip];
+          }
+
+          for (k = kfirst; k <= klast; k++) {
+            kk = kc+index[k];
+            for (j = jfirst; j <= jlast; j++) {
+              jj = jc+index[j];
+              phizy = phiy[j]*phiz[k];
+              double * _noalias const erow = &egrid1[kk][jj][ic];
+              for (i = ifirst; i <= ilast; i++)
+                erow[index[i]] += etmp2 * (phix[i]*phizy);
+
+              if (VFLAG_ATOM) {
+                for (i = ifirst; i <= ilast; i++) {
+                  ii = ic+index[i];
+                  phi3d = phix[i]*phizy;
+                  v0grid1[kk][jj][ii] += v0tmp2 * phi3d;
+                  v1grid1[kk][jj][ii] += v1tmp2 * phi3d;
+                  v2grid1[kk][jj][ii] += v2tmp2 * phi3d;
+                  v3grid1[kk][jj][ii] += v3tmp2 * phi3d;
+                  v4grid1[kk][jj][ii] += v4tmp2 * phi3d;
+                  v5grid1[kk][jj][ii] += v5tmp2 * phi3d;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    thr->timer(Timer::KSPACE);
+  } // end of omp parallel region
+
+  delete[] index;
 }
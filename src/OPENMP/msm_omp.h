@@ -31,11 +31,14 @@ class MSMOMP : public MSM, public ThrOMP {
 
  protected:
   void direct(int) override;
+  void restriction(int) override;
+  void prolongation(int) override;
   void compute(int, int) override;
 
  private:
   template <int, int, int> void direct_eval(int);
   template <int> void direct_peratom(int);
+  template <int> void prolongation_eval(int);
 };
 
 }    // namespace LAMMPS_NS
@@ -24,6 +24,7 @@
 #include "force.h"
 #include "math_const.h"
 #include "math_special.h"
+#include "memory.h"
 
 #include <cmath>
 #include <cstring>
@@ -40,6 +41,7 @@ using namespace MathSpecial;
 
 static constexpr FFT_SCALAR ZEROF = 0.0;
 static constexpr double EPS_HOC = 1.0e-7;
+static constexpr int MAXORDER = 7;    // same as in pppm.cpp
 
 /* ---------------------------------------------------------------------- */
 
@@ -47,6 +49,11 @@ PPPMOMP::PPPMOMP(LAMMPS *lmp) : PPPM(lmp), ThrOMP(lmp, THR_KSPACE)
 {
   triclinic_support = 1;
   suffix_flag |= Suffix::OMP;
+  thr_offset = thr_num = 0;
+
+  nbiny = nbinz = 0;
+  maxrhosort = maxrhobin = 0;
+  rhosort = rhobinstart = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -89,6 +96,19 @@ PPPMOMP::~PPPMOMP()
     ThrData *thr = fix->get_thr(tid);
     thr->init_pppm(-order,memory);
   }
+  memory->destroy(rhosort);
+  memory->destroy(rhobinstart);
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local arrays
+------------------------------------------------------------------------- */
+
+double PPPMOMP::memory_usage()
+{
+  double bytes = PPPM::memory_usage();
+  bytes += (double)(maxrhosort + maxrhobin) * sizeof(int);
+  return bytes;
 }
 
 /* ----------------------------------------------------------------------
@@ -319,7 +339,7 @@ void PPPMOMP::compute(int eflag, int vflag)
 #else
     const int tid = 0;
 #endif
-    ThrData *thr = fix->get_thr(tid);
+    ThrData *thr = fix->get_thr(thr_offset+tid);
     thr->timer(Timer::START);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
@@ -342,73 +362,145 @@ void PPPMOMP::make_rho()
 
   // no local atoms => nothing else to do
 
+  if (atom->nlocal == 0) return;
+
+  bin_rho();
+
+  if (order == 5) make_rho_thr<5>();
+  else if (order == 7) make_rho_thr<7>();
+  else make_rho_thr<0>();
+}
+
+/* ----------------------------------------------------------------------
+   sort local atoms into blocks of order x order grid lines in y and z
+   by the lowest grid line their stencil reaches. a stencil thus spans
+   at most two neighboring blocks in y and z and blocks of equal parity
+   in both directions (same color) never update the same grid point
+------------------------------------------------------------------------- */
+
+void PPPMOMP::bin_rho()
+{
   const int nlocal = atom->nlocal;
-  if (nlocal == 0) return;
+  const auto * _noalias const p2g = (int3_t *) part2grid[0];
+
+  nbiny = (nyhi_out - nylo_out + order) / order;
+  nbinz = (nzhi_out - nzlo_out + order) / order;
+  const int nbins = nbiny*nbinz;
+
+  if (nbins >= maxrhobin) {
+    maxrhobin = nbins+1;
+    memory->destroy(rhobinstart);
+    memory->create(rhobinstart,maxrhobin,"pppm/omp:rhobinstart");
+  }
+  if (nlocal > maxrhosort) {
+    maxrhosort = atom->nmax;
+    memory->destroy(rhosort);
+    memory->create(rhosort,maxrhosort,"pppm/omp:rhosort");
+  }
+
+  // counting sort with rhobinstart[b] = index of first atom in block b
+
+  int b, i;
+  for (b = 0; b <= nbins; ++b) rhobinstart[b] = 0;
+
+  for (i = 0; i < nlocal; ++i) {
+    b = ((p2g[i].t+nlower-nzlo_out)/order)*nbiny + (p2g[i].b+nlower-nylo_out)/order;
+    ++rhobinstart[b+1];
+  }
+  for (b = 1; b <= nbins; ++b) rhobinstart[b] += rhobinstart[b-1];
 
+  for (i = 0; i < nlocal; ++i) {
+    b = ((p2g[i].t+nlower-nzlo_out)/order)*nbiny + (p2g[i].b+nlower-nylo_out)/order;
+    rhosort[rhobinstart[b]++] = i;
+  }
+  for (b = nbins; b > 0; --b) rhobinstart[b] = rhobinstart[b-1];
+  rhobinstart[0] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   threaded charge assignment from blocks of sorted atoms
+   threads process the blocks of one color at a time, so they update
+   disjoint parts of the density grid without locks or private copies.
+   ORDER > 0 is the stencil order at compile time, 0 uses order.
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPMOMP::make_rho_thr()
+{
+  const int ord = ORDER ? ORDER : order;
   const int ix = nxhi_out - nxlo_out + 1;
   const int iy = nyhi_out - nylo_out + 1;
+  const int nby = nbiny;
+  const int nbz = nbinz;
+
+  FFT_SCALAR * _noalias const d = &(density_brick[nzlo_out][nylo_out][nxlo_out]);
+  const double * _noalias const q = atom->q;
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  const auto * _noalias const p2g = (int3_t *) part2grid[0];
+  const int * _noalias const sorted = rhosort;
+  const int * _noalias const binstart = rhobinstart;
+
+  const double boxlox = boxlo[0];
+  const double boxloy = boxlo[1];
+  const double boxloz = boxlo[2];
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE
 #endif
   {
-    const double * _noalias const q = atom->q;
-    const auto * _noalias const x = (dbl3_t *) atom->x[0];
-    const auto * _noalias const p2g = (int3_t *) part2grid[0];
-
-    const double boxlox = boxlo[0];
-    const double boxloy = boxlo[1];
-    const double boxloz = boxlo[2];
-
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
-    ThrData *thr = fix->get_thr(tid);
+    ThrData *thr = fix->get_thr(thr_offset+tid);
     thr->timer(Timer::START);
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
+    const FFT_SCALAR * _noalias const r1dx = r1d[0] + nlower;
+    const FFT_SCALAR * _noalias const r1dy = r1d[1] + nlower;
+    const FFT_SCALAR * _noalias const r1dz = r1d[2] + nlower;
 
     // loop over my charges, add their contribution to nearby grid points
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    for (int color = 0; color < 4; ++color) {
+      const int cy = color & 1;
+      const int cz = color >> 1;
+      const int ncy = (nby - cy + 1) / 2;
+      const int ncz = (nbz - cz + 1) / 2;
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
-
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower-nzlo_out)*ix*iy >= jto)
-           || ((nz+nupper-nzlo_out+1)*ix*iy < jfrom) ) continue;
-
-      const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
-      const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
-      const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
-
-      compute_rho1d_thr(r1d,dx,dy,dz);
-
-      const FFT_SCALAR z0 = delvolinv * q[i];
-
-      for (int n = nlower; n <= nupper; ++n) {
-        const int jn = (nz+n-nzlo_out)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
-
-        for (int m = nlower; m <= nupper; ++m) {
-          const int jm = jn+(ny+m-nylo_out)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
-
-          for (int l = nlower; l <= nupper; ++l) {
-            const int jl = jm+nx+l-nxlo_out;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
-
-            d[jl] += x0*r1d[0][l];
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+      for (int ib = 0; ib < ncy*ncz; ++ib) {
+        const int b = (cz + 2*(ib / ncy))*nby + cy + 2*(ib % ncy);
+
+        for (int k = binstart[b]; k < binstart[b+1]; ++k) {
+          const int i = sorted[k];
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
+          const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
+          const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
+          const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
+
+          compute_rho1d_thr(r1d,dx,dy,dz);
+
+          const FFT_SCALAR z0 = delvolinv * q[i];
+          FFT_SCALAR * _noalias const d0 =
+            d + ((nz+nlower-nzlo_out)*iy + ny+nlower-nylo_out)*ix + nx+nlower-nxlo_out;
+
+          for (int n = 0; n < ord; ++n) {
+            const FFT_SCALAR y0 = z0*r1dz[n];
+            for (int m = 0; m < ord; ++m) {
+              FFT_SCALAR * _noalias const dl = d0 + (n*iy + m)*ix;
+              const FFT_SCALAR x0 = y0*r1dy[m];
+              for (int l = 0; l < ord; ++l)
+                dl[l] += x0*r1dx[l];
+            }
           }
         }
       }
@@ -422,14 +514,24 @@ void PPPMOMP::make_rho()
 ------------------------------------------------------------------------- */
 
 void PPPMOMP::fieldforce_ik()
+{
+  if (order == 5) fieldforce_ik_thr<5>();
+  else if (order == 7) fieldforce_ik_thr<7>();
+  else fieldforce_ik_thr<0>();
+}
+
+template <int ORDER>
+void PPPMOMP::fieldforce_ik_thr()
 {
   // loop over my charges, interpolate electric field from nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
-  // (mx,my,mz) = global coords of moving stencil pt
   // ek = 3 components of E-field on particle
+  // field is summed per x offset of the stencil first, so that
+  //   the innermost loop has no dependencies and can be vectorized
 
-  const int nthreads = comm->nthreads;
+  const int ord = ORDER ? ORDER : order;
+  const int nthreads = thr_num ? thr_num : comm->nthreads;
   const int nlocal = atom->nlocal;
 
   // no local atoms => nothing to do
@@ -449,18 +551,23 @@ void PPPMOMP::fieldforce_ik()
 #pragma omp parallel LMP_DEFAULT_NONE
 #endif
   {
-    FFT_SCALAR x0,y0,z0,ekx,eky,ekz;
-    int i,ifrom,ito,tid,l,m,n,mx,my,mz;
+    FFT_SCALAR ekx,eky,ekz;
+    FFT_SCALAR ex[MAXORDER],ey[MAXORDER],ez[MAXORDER];
+    int i,ifrom,ito,tid,l,m,n;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
     // get per thread data
-    ThrData *thr = fix->get_thr(tid);
+    ThrData *thr = fix->get_thr(thr_offset+tid);
     thr->timer(Timer::START);
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
+    const FFT_SCALAR * _noalias const r1dx = r1d[0] + nlower;
+    const FFT_SCALAR * _noalias const r1dy = r1d[1] + nlower;
+    const FFT_SCALAR * _noalias const r1dz = r1d[2] + nlower;
 
     for (i = ifrom; i < ito; ++i) {
+      if (fieldforce_skip(i)) continue;
       const int nx = p2g[i].a;
       const int ny = p2g[i].b;
       const int nz = p2g[i].t;
@@ -470,22 +577,29 @@ void PPPMOMP::fieldforce_ik()
 
       compute_rho1d_thr(r1d,dx,dy,dz);
 
-      ekx = eky = ekz = ZEROF;
-      for (n = nlower; n <= nupper; n++) {
-        mz = n+nz;
-        z0 = r1d[2][n];
-        for (m = nlower; m <= nupper; m++) {
-          my = m+ny;
-          y0 = z0*r1d[1][m];
-          for (l = nlower; l <= nupper; l++) {
-            mx = l+nx;
-            x0 = y0*r1d[0][l];
-            ekx -= x0*vdx_brick[mz][my][mx];
-            eky -= x0*vdy_brick[mz][my][mx];
-            ekz -= x0*vdz_brick[mz][my][mx];
+      for (l = 0; l < ord; l++) ex[l] = ey[l] = ez[l] = ZEROF;
+      for (n = 0; n < ord; n++) {
+        const int mz = n+nz+nlower;
+        const FFT_SCALAR z0 = r1dz[n];
+        for (m = 0; m < ord; m++) {
+          const int my = m+ny+nlower;
+          const FFT_SCALAR y0 = z0*r1dy[m];
+          const FFT_SCALAR * _noalias const vx = &vdx_brick[mz][my][nx+nlower];
+          const FFT_SCALAR * _noalias const vy = &vdy_brick[mz][my][nx+nlower];
+          const FFT_SCALAR * _noalias const vz = &vdz_brick[mz][my][nx+nlower];
+          for (l = 0; l < ord; l++) {
+            ex[l] -= y0*vx[l];
+            ey[l] -= y0*vy[l];
+            ez[l] -= y0*vz[l];
           }
         }
       }
+      ekx = eky = ekz = ZEROF;
+      for (l = 0; l < ord; l++) {
+        ekx += r1dx[l]*ex[l];
+        eky += r1dx[l]*ey[l];
+        ekz += r1dx[l]*ez[l];
+      }
 
       // convert E-field to force
 
@@ -504,7 +618,16 @@ void PPPMOMP::fieldforce_ik()
 
 void PPPMOMP::fieldforce_ad()
 {
-  const int nthreads = comm->nthreads;
+  if (order == 5) fieldforce_ad_thr<5>();
+  else if (order == 7) fieldforce_ad_thr<7>();
+  else fieldforce_ad_thr<0>();
+}
+
+template <int ORDER>
+void PPPMOMP::fieldforce_ad_thr()
+{
+  const int ord = ORDER ? ORDER : order;
+  const int nthreads = thr_num ? thr_num : comm->nthreads;
   const int nlocal = atom->nlocal;
 
   // no local atoms => nothing to do
@@ -519,8 +642,8 @@ void PPPMOMP::fieldforce_ad()
   // loop over my charges, interpolate electric field from nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
-  // (mx,my,mz) = global coords of moving stencil pt
   // ek = 3 components of E-field on particle
+  // as for ik, the stencil is summed per x offset first
 
   const auto * _noalias const x = (dbl3_t *) atom->x[0];
   const double * _noalias const q = atom->q;
@@ -536,18 +659,26 @@ void PPPMOMP::fieldforce_ad()
   {
     double s1,s2,s3,sf;
     FFT_SCALAR ekx,eky,ekz;
-    int i,ifrom,ito,tid,l,m,n,mx,my,mz;
+    FFT_SCALAR ux[MAXORDER],uy[MAXORDER],uz[MAXORDER];
+    int i,ifrom,ito,tid,l,m,n;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
     // get per thread data
-    ThrData *thr = fix->get_thr(tid);
+    ThrData *thr = fix->get_thr(thr_offset+tid);
     thr->timer(Timer::START);
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
     FFT_SCALAR * const * const d1d = static_cast<FFT_SCALAR **>(thr->get_drho1d());
+    const FFT_SCALAR * _noalias const r1dx = r1d[0] + nlower;
+    const FFT_SCALAR * _noalias const r1dy = r1d[1] + nlower;
+    const FFT_SCALAR * _noalias const r1dz = r1d[2] + nlower;
+    const FFT_SCALAR * _noalias const d1dx = d1d[0] + nlower;
+    const FFT_SCALAR * _noalias const d1dy = d1d[1] + nlower;
+    const FFT_SCALAR * _noalias const d1dz = d1d[2] + nlower;
 
     for (i = ifrom; i < ito; ++i) {
+      if (fieldforce_skip(i)) continue;
       const int nx = p2g[i].a;
       const int ny = p2g[i].b;
       const int nz = p2g[i].t;
@@ -558,19 +689,28 @@ void PPPMOMP::fieldforce_ad()
       compute_rho1d_thr(r1d,dx,dy,dz);
       compute_drho1d_thr(d1d,dx,dy,dz);
 
-      ekx = eky = ekz = ZEROF;
-      for (n = nlower; n <= nupper; n++) {
-        mz = n+nz;
-        for (m = nlower; m <= nupper; m++) {
-          my = m+ny;
-          for (l = nlower; l <= nupper; l++) {
-            mx = l+nx;
-            ekx += d1d[0][l]*r1d[1][m]*r1d[2][n]*u_brick[mz][my][mx];
-            eky += r1d[0][l]*d1d[1][m]*r1d[2][n]*u_brick[mz][my][mx];
-            ekz += r1d[0][l]*r1d[1][m]*d1d[2][n]*u_brick[mz][my][mx];
+      for (l = 0; l < ord; l++) ux[l] = uy[l] = uz[l] = ZEROF;
+      for (n = 0; n < ord; n++) {
+        const int mz = n+nz+nlower;
+        for (m = 0; m < ord; m++) {
+          const int my = m+ny+nlower;
+          const FFT_SCALAR wx = r1dy[m]*r1dz[n];
+          const FFT_SCALAR wy = d1dy[m]*r1dz[n];
+          const FFT_SCALAR wz = r1dy[m]*d1dz[n];
+          const FFT_SCALAR * _noalias const u = &u_brick[mz][my][nx+nlower];
+          for (l = 0; l < ord; l++) {
+            ux[l] += wx*u[l];
+            uy[l] += wy*u[l];
+            uz[l] += wz*u[l];
           }
         }
       }
+      ekx = eky = ekz = ZEROF;
+      for (l = 0; l < ord; l++) {
+        ekx += d1dx[l]*ux[l];
+        eky += r1dx[l]*uy[l];
+        ekz += r1dx[l]*uz[l];
+      }
       ekx *= hx_inv;
       eky *= hy_inv;
       ekz *= hz_inv;
@@ -608,7 +748,7 @@ void PPPMOMP::fieldforce_ad()
 
 void PPPMOMP::fieldforce_peratom()
 {
-  const int nthreads = comm->nthreads;
+  const int nthreads = thr_num ? thr_num : comm->nthreads;
   const int nlocal = atom->nlocal;
 
   // no local atoms => nothing to do
@@ -634,7 +774,7 @@ void PPPMOMP::fieldforce_peratom()
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
     // get per thread data
-    ThrData *thr = fix->get_thr(tid);
+    ThrData *thr = fix->get_thr(thr_offset+tid);
     thr->timer(Timer::START);
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
@@ -30,8 +30,26 @@ class PPPMOMP : public PPPM, public ThrOMP {
   PPPMOMP(class LAMMPS *);
   ~PPPMOMP() override;
   void compute(int, int) override;
+  double memory_usage() override;
+
+  // run on nthr threads using per-thread data starting at tid offset
+  // used by run_style verlet/kspace/omp, nthr = 0 restores all threads
+
+  void set_thr_range(int offset, int nthr)
+  {
+    thr_offset = offset;
+    thr_num = nthr;
+  }
 
  protected:
+  int thr_offset;    // index of first per-thread data object used by this style
+  int thr_num;       // # of threads used for compute, 0 = all
+
+  int nbiny, nbinz;            // # of blocks of grid lines for charge assignment
+  int maxrhosort, maxrhobin;
+  int *rhosort;                // local atom indices sorted by block
+  int *rhobinstart;            // index of first atom of each block in rhosort
+
   void allocate() override;
 
   void compute_gf_ik() override;
@@ -43,6 +61,10 @@ class PPPMOMP : public PPPM, public ThrOMP {
   void fieldforce_peratom() override;
 
  private:
+  void bin_rho();
+  template <int ORDER> void make_rho_thr();
+  template <int ORDER> void fieldforce_ik_thr();
+  template <int ORDER> void fieldforce_ad_thr();
   void compute_rho1d_thr(FFT_SCALAR *const *const, const FFT_SCALAR &, const FFT_SCALAR &,
                          const FFT_SCALAR &);
   void compute_drho1d_thr(FFT_SCALAR *const *const, const FFT_SCALAR &, const FFT_SCALAR &,
@@ -0,0 +1,307 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "verlet_kspace_omp.h"
+
+#include "angle.h"
+#include "atom.h"
+#include "bond.h"
+#include "comm.h"
+#include "dihedral.h"
+#include "domain.h"
+#include "error.h"
+#include "fix_omp.h"
+#include "force.h"
+#include "improper.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "output.h"
+#include "pair.h"
+#include "pppm_omp.h"
+#include "timer.h"
+#include "update.h"
+
+#include "omp_compat.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+VerletKSpaceOMP::VerletKSpaceOMP(LAMMPS *lmp, int narg, char **arg) :
+  Verlet(lmp, narg, arg), ThrOMP(lmp, THR_INTGR), kspace_omp(nullptr)
+{
+  if (narg != 1) error->all(FLERR,"Illegal run_style verlet/kspace/omp command");
+  kspace_threads = utils::inumeric(FLERR,arg[0],false,lmp);
+  if (kspace_threads < 1)
+    error->all(FLERR,"Illegal run_style verlet/kspace/omp thread count {}", kspace_threads);
+  concurrent = 0;
+}
+
+/* ----------------------------------------------------------------------
+   initialization before run
+------------------------------------------------------------------------- */
+
+void VerletKSpaceOMP::init()
+{
+  Verlet::init();
+
+#if !defined(_OPENMP)
+  error->all(FLERR,"Run style verlet/kspace/omp requires OpenMP support");
+#endif
+
+  if (!force->kspace)
+    error->all(FLERR,"Run style verlet/kspace/omp requires a kspace style");
+  kspace_omp = dynamic_cast<PPPMOMP *>(force->kspace);
+  if (!kspace_omp)
+    error->all(FLERR,"Run style verlet/kspace/omp requires kspace style pppm/omp");
+  if (kspace_threads >= comm->nthreads)
+    error->all(FLERR,"Run style verlet/kspace/omp uses {} kspace threads, but only {} "
+               "OpenMP threads are available", kspace_threads, comm->nthreads);
+
+  // kspace may not modify coordinates or write forces outside the
+  //   per-thread arrays while pair and bonded forces are computed
+  // pair styles with internal communication would call MPI from a second thread
+
+  if (domain->triclinic)
+    error->all(FLERR,"Run style verlet/kspace/omp does not support triclinic boxes");
+  if (force->kspace->slabflag)
+    error->all(FLERR,"Run style verlet/kspace/omp does not support kspace_modify slab");
+  if (force->pair && (force->pair->comm_forward || force->pair->comm_reverse ||
+                      force->pair->comm_reverse_off))
+    error->all(FLERR,"Run style verlet/kspace/omp does not support pair style {}",
+               force->pair_style);
+  if (atom->erforce || atom->desph || atom->drho)
+    error->all(FLERR,"Run style verlet/kspace/omp does not support atom style {}",
+               atom->atom_style);
+
+  concurrent = kspace_compute_flag;
+
+  if (comm->me == 0)
+    utils::logmesg(Verlet::lmp,"Kspace on {} and pair/bonded forces on {} OpenMP thread(s) "
+                   "per MPI task\n", kspace_threads, comm->nthreads - kspace_threads);
+}
+
+/* ----------------------------------------------------------------------
+   run for N steps
+   same as Verlet::run(), but kspace runs concurrently with pair and bonded
+------------------------------------------------------------------------- */
+
+void VerletKSpaceOMP::run(int n)
+{
+  bigint ntimestep;
+  int nflag,sortflag;
+
+  int n_post_integrate = modify->n_post_integrate;
+  int n_pre_exchange = modify->n_pre_exchange;
+  int n_pre_neighbor = modify->n_pre_neighbor;
+  int n_post_neighbor = modify->n_post_neighbor;
+  int n_pre_force = modify->n_pre_force;
+  int n_pre_reverse = modify->n_pre_reverse;
+  int n_post_force_any = modify->n_post_force_any;
+  int n_end_of_step = modify->n_end_of_step;
+
+  if (atom->sortfreq > 0) sortflag = 1;
+  else sortflag = 0;
+
+  for (int i = 0; i < n; i++) {
+    if (timer->check_timeout(i)) {
+      update->nsteps = i;
+      break;
+    }
+
+    ntimestep = ++update->ntimestep;
+    ev_set(ntimestep);
+
+    // initial time integration
+
+    timer->stamp();
+    modify->initial_integrate(vflag);
+    if (n_post_integrate) modify->post_integrate();
+    timer->stamp(Timer::MODIFY);
+
+    // regular communication vs neighbor list rebuild
+
+    nflag = neighbor->decide();
+
+    if (nflag == 0) {
+      timer->stamp();
+      comm->forward_comm();
+      timer->stamp(Timer::COMM);
+    } else {
+      if (n_pre_exchange) {
+        timer->stamp();
+        modify->pre_exchange();
+        timer->stamp(Timer::MODIFY);
+      }
+      if (triclinic) domain->x2lamda(atom->nlocal);
+      domain->pbc();
+      if (domain->box_change) {
+        domain->reset_box();
+        comm->setup();
+        if (neighbor->style) neighbor->setup_bins();
+      }
+      timer->stamp();
+      comm->exchange();
+      if (sortflag && ntimestep >= atom->nextsort) atom->sort();
+      comm->borders();
+      if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
+      timer->stamp(Timer::COMM);
+      if (n_pre_neighbor) {
+        modify->pre_neighbor();
+        timer->stamp(Timer::MODIFY);
+      }
+      neighbor->build(1);
+      timer->stamp(Timer::NEIGH);
+      if (n_post_neighbor) {
+        modify->post_neighbor();
+        timer->stamp(Timer::MODIFY);
+      }
+    }
+
+    // force computations
+    // important for pair to come before bonded contributions
+    // since some bonded potentials tally pairwise energy/virial
+    // and Pair:ev_tally() needs to be called before any tallying
+
+    if (atom->soaflag) atom->soa_pack();
+    force_clear();
+
+    timer->stamp();
+
+    if (n_pre_force) {
+      modify->pre_force(vflag);
+      timer->stamp(Timer::MODIFY);
+    }
+
+    // per-atom tallies size per-thread arrays by the thread count,
+    //   so those steps compute all forces with all threads
+
+    if (concurrent && !(eflag & ENERGY_ATOM) && !(vflag & (VIRIAL_ATOM | VIRIAL_CENTROID))) {
+      force_concurrent();
+      timer->stamp(Timer::PAIR);
+    } else {
+      if (pair_compute_flag) {
+        if (force->pair->costflag) force->pair->compute_cost(eflag,vflag);
+        else force->pair->compute(eflag,vflag);
+        timer->stamp(Timer::PAIR);
+      }
+
+      if (atom->molecular != Atom::ATOMIC) {
+        if (force->bond) force->bond->compute(eflag,vflag);
+        if (force->angle) force->angle->compute(eflag,vflag);
+        if (force->dihedral) force->dihedral->compute(eflag,vflag);
+        if (force->improper) force->improper->compute(eflag,vflag);
+        timer->stamp(Timer::BOND);
+      }
+
+      if (kspace_compute_flag) {
+        force->kspace->compute(eflag,vflag);
+        timer->stamp(Timer::KSPACE);
+      }
+    }
+
+    if (n_pre_reverse) {
+      modify->pre_reverse(eflag,vflag);
+      timer->stamp(Timer::MODIFY);
+    }
+
+    // reverse communication of forces
+
+    if (force->newton) {
+      comm->reverse_comm();
+      timer->stamp(Timer::COMM);
+    }
+    atom->soa_valid = 0;
+
+    // force modifications, final time integration, diagnostics
+
+    if (n_post_force_any) modify->post_force(vflag);
+    modify->final_integrate();
+    if (n_end_of_step) modify->end_of_step();
+    timer->stamp(Timer::MODIFY);
+
+    // all output
+
+    if (ntimestep == output->next) {
+      timer->stamp();
+      output->write(ntimestep);
+      timer->stamp(Timer::OUTPUT);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute kspace on the master thread with a team of kspace_threads,
+   while a second team with the remaining threads computes pair and
+   bonded forces. only the master thread calls MPI.
+   the pair team uses per-thread force arrays 0 to npair-1 and the
+   kspace team those from npair on, so no style may reduce forces
+   inside the concurrent region. all arrays are merged afterwards.
+------------------------------------------------------------------------- */
+
+void VerletKSpaceOMP::force_concurrent()
+{
+#if defined(_OPENMP)
+  const int nthreads = comm->nthreads;
+  const int npair = nthreads - kspace_threads;
+  const int nkspace = kspace_threads;
+  const int max_levels = omp_get_max_active_levels();
+  void *last_omp_style = fix->last_omp_style;
+
+  fix->last_omp_style = nullptr;
+  kspace_omp->set_thr_range(npair, nkspace);
+  comm->nthreads = npair;
+  omp_set_max_active_levels(2);
+
+#pragma omp parallel num_threads(2) LMP_DEFAULT_NONE
+  {
+    if (omp_get_thread_num() == 0) {
+      omp_set_num_threads(nkspace);
+      force->kspace->compute(eflag,vflag);
+    } else {
+      omp_set_num_threads(npair);
+      if (pair_compute_flag) {
+        if (force->pair->costflag) force->pair->compute_cost(eflag,vflag);
+        else force->pair->compute(eflag,vflag);
+      }
+      if (atom->molecular != Atom::ATOMIC) {
+        if (force->bond) force->bond->compute(eflag,vflag);
+        if (force->angle) force->angle->compute(eflag,vflag);
+        if (force->dihedral) force->dihedral->compute(eflag,vflag);
+        if (force->improper) force->improper->compute(eflag,vflag);
+      }
+    }
+  }
+
+  omp_set_max_active_levels(max_levels);
+  comm->nthreads = nthreads;
+  kspace_omp->set_thr_range(0, 0);
+  fix->last_omp_style = last_omp_style;
+
+  // merge forces and torques of both teams
+
+  const int nall = atom->nlocal + atom->nghost;
+
+#pragma omp parallel LMP_DEFAULT_NONE
+  {
+    const int tid = omp_get_thread_num();
+    data_reduce_thr(atom->f[0], nall, nthreads, 3, tid);
+    if (atom->torque) data_reduce_thr(atom->torque[0], nall, nthreads, 3, tid);
+  }
+  fix->did_reduce();
+#endif
+}
@@ -0,0 +1,46 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef INTEGRATE_CLASS
+// clang-format off
+IntegrateStyle(verlet/kspace/omp,VerletKSpaceOMP);
+// clang-format on
+#else
+
+#ifndef LMP_VERLET_KSPACE_OMP_H
+#define LMP_VERLET_KSPACE_OMP_H
+
+#include "thr_omp.h"
+#include "verlet.h"
+
+namespace LAMMPS_NS {
+
+class VerletKSpaceOMP : public Verlet, public ThrOMP {
+ public:
+  VerletKSpaceOMP(class LAMMPS *, int, char **);
+
+  void init() override;
+  void run(int) override;
+
+ protected:
+  int kspace_threads;          // # of OpenMP threads reserved for kspace
+  int concurrent;              // 1 if kspace runs concurrently with pair and bonded
+  class PPPMOMP *kspace_omp;
+
+  void force_concurrent();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -29,6 +29,7 @@ using namespace EwaldConst;
 PairLJCutCoulLongOpt::PairLJCutCoulLongOpt(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
   respa_enable = 0;
+  mixed_prec_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -109,6 +109,8 @@ DumpVTK::DumpVTK(LAMMPS *lmp, int narg, char **arg) :
 {
   if (narg == 5) error->all(FLERR,"No dump vtk arguments specified");
 
+  async_allow = 0;
+
   pack_choice.clear();
   vtype.clear();
   name.clear();
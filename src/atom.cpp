@@ -39,6 +39,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
+#include <vector>
 
 #ifdef LMP_GPU
 #include "fix_gpu.h"
@@ -51,6 +53,19 @@ using namespace MathConst;
 static constexpr int DELTA = 1;
 static constexpr double EPSILON = 1.0e-6;
 static constexpr double EPS_ZCOORD = 1.0e-12;
+static constexpr int SOAPAD = 8;             // SoA streams padded to 64 bytes
+static constexpr double SOAFAR = 1.0e20;     // coord of SoA padding
+
+// error in a line of a data file section
+// when reading in parallel, only the procs parsing the line detect it
+
+template <typename... Args>
+static void data_error(Error *error, int parallel, const std::string &file, int line,
+                       const std::string &format, Args &&...args)
+{
+  if (parallel) error->one(file, line, format, std::forward<Args>(args)...);
+  else error->all(file, line, format, std::forward<Args>(args)...);
+}
 
 /* ----------------------------------------------------------------------
    one instance per AtomVec style in style_atom.h
@@ -103,8 +118,13 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp), atom_style(nullptr), avec(nullptr), a
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_LINEAR;
+  soaflag = soa_valid = 0;
+  soa_stride = 0;
+  xsoa = nullptr;
   maxbin = maxnext = 0;
   binhead = nullptr;
+  binrank = nullptr;
   next = permute = nullptr;
 
   // --------------------------------------------------------------------
@@ -294,6 +314,8 @@ Atom::~Atom()
 
   delete[] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binrank);
+  memory->sfree(xsoa);
   memory->destroy(next);
   memory->destroy(permute);
 
@@ -379,6 +401,8 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortorder = old->sortorder;
+  soaflag = old->soaflag;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -851,6 +875,22 @@ void Atom::modify_params(int narg, char **arg)
       if ((sortfreq >= 0) && firstgroupname)
         error->all(FLERR,"Atom_modify sort and first options cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"sort/order") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort/order", error);
+      if (strcmp(arg[iarg+1],"linear") == 0) sortorder = SORT_LINEAR;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortorder = SORT_MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortorder = SORT_HILBERT;
+      else error->all(FLERR,"Illegal atom_modify sort/order argument: {}", arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"soa") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify soa", error);
+      soaflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (!soaflag) {
+        memory->sfree(xsoa);
+        xsoa = nullptr;
+        soa_stride = 0;
+      }
+      iarg += 2;
     } else error->all(FLERR,"Illegal atom_modify command argument: {}", arg[iarg]);
   }
 }
@@ -1042,11 +1082,14 @@ void Atom::deallocate_topology()
    unpack N lines from Atom section of data file
    call atom-style specific method to parse each line
    triclinic_general = 1 if data file defines a general triclinic box
+   keepflag = 1 to keep all atoms inside the simulation box,
+     not just the ones in my sub-domain, caller must migrate them
+     used when reading in parallel, so per-line errors are raised on one proc
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
                       int type_offset, int shiftflag, double *shift,
-                      int labelflag, int *ilabel, int triclinic_general)
+                      int labelflag, int *ilabel, int triclinic_general, int keepflag)
 {
   int xptr,iptr;
   imageint imagedata;
@@ -1071,65 +1114,18 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 
   if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3))
-    error->all(FLERR,"Incorrect format in {}: {}{}", location,
-               utils::trim(buf), utils::errorurl(2));
+    data_error(error, keepflag, FLERR, "Incorrect format in {}: {}{}", location, utils::trim(buf),
+               utils::errorurl(2));
 
   *next = '\n';
 
-  // set bounds for my proc
-  // if periodic and I am lo/hi proc, adjust bounds by EPSILON
-  // ensures all data atoms will be owned even with round-off
+  // set bounds for my proc, or of entire box if keepflag is set
 
   int dimension = domain->dimension;
   int triclinic = domain->triclinic;
 
-  double epsilon[3];
-  if (triclinic) epsilon[0] = epsilon[1] = epsilon[2] = EPSILON;
-  else {
-    epsilon[0] = domain->prd[0] * EPSILON;
-    epsilon[1] = domain->prd[1] * EPSILON;
-    epsilon[2] = domain->prd[2] * EPSILON;
-  }
-
   double sublo[3],subhi[3];
-  if (triclinic == 0) {
-    sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
-    sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
-    sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
-  } else {
-    sublo[0] = domain->sublo_lamda[0]; subhi[0] = domain->subhi_lamda[0];
-    sublo[1] = domain->sublo_lamda[1]; subhi[1] = domain->subhi_lamda[1];
-    sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
-  }
-
-  if (comm->layout != Comm::LAYOUT_TILED) {
-    if (domain->xperiodic) {
-      if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
-      if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
-    }
-    if (domain->yperiodic) {
-      if (comm->myloc[1] == 0) sublo[1] -= epsilon[1];
-      if (comm->myloc[1] == comm->procgrid[1]-1) subhi[1] += epsilon[1];
-    }
-    if (domain->zperiodic) {
-      if (comm->myloc[2] == 0) sublo[2] -= epsilon[2];
-      if (comm->myloc[2] == comm->procgrid[2]-1) subhi[2] += epsilon[2];
-    }
-
-  } else {
-    if (domain->xperiodic) {
-      if (comm->mysplit[0][0] == 0.0) sublo[0] -= epsilon[0];
-      if (comm->mysplit[0][1] == 1.0) subhi[0] += epsilon[0];
-    }
-    if (domain->yperiodic) {
-      if (comm->mysplit[1][0] == 0.0) sublo[1] -= epsilon[1];
-      if (comm->mysplit[1][1] == 1.0) subhi[1] += epsilon[1];
-    }
-    if (domain->zperiodic) {
-      if (comm->mysplit[2][0] == 0.0) sublo[2] -= epsilon[2];
-      if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
-    }
-  }
+  data_atoms_bounds(sublo,subhi,keepflag);
 
   // xptr = which word in line starts xyz coords
   // iptr = which word in line starts ix,iy,iz image flags
@@ -1160,19 +1156,19 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
     } else if ((nvalues < nwords) ||
                ((nvalues > nwords) && (!utils::strmatch(values[nwords],"^#")))) {
-      error->all(FLERR, "Incorrect format in {}: {}{}", location,
-                 utils::trim(buf), utils::errorurl(2));
+      data_error(error, keepflag, FLERR, "Incorrect format in {}: {}{}", location, utils::trim(buf),
+                 utils::errorurl(2));
 
     // extract the atom coords and image flags (if they exist)
 
     } else {
       int imx = 0, imy = 0, imz = 0;
       if (imageflag) {
-        imx = utils::inumeric(FLERR,values[iptr],false,lmp);
-        imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
-        imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
+        imx = utils::inumeric(FLERR,values[iptr],keepflag,lmp);
+        imy = utils::inumeric(FLERR,values[iptr+1],keepflag,lmp);
+        imz = utils::inumeric(FLERR,values[iptr+2],keepflag,lmp);
         if ((dimension == 2) && (imz != 0))
-          error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+          data_error(error, keepflag, FLERR, "Z-direction image flag must be 0 for 2d-systems");
         if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
         if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
         if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
@@ -1181,16 +1177,17 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
         (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
         (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
 
-      xdata[0] = utils::numeric(FLERR,values[xptr],false,lmp);
-      xdata[1] = utils::numeric(FLERR,values[xptr+1],false,lmp);
-      xdata[2] = utils::numeric(FLERR,values[xptr+2],false,lmp);
+      xdata[0] = utils::numeric(FLERR,values[xptr],keepflag,lmp);
+      xdata[1] = utils::numeric(FLERR,values[xptr+1],keepflag,lmp);
+      xdata[2] = utils::numeric(FLERR,values[xptr+2],keepflag,lmp);
 
       // for 2d simulation:
       // check if z coord is within EPS_ZCOORD of zero and set to zero
 
       if (dimension == 2) {
         if (fabs(xdata[2]) > EPS_ZCOORD)
-          error->all(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+          data_error(error, keepflag, FLERR,
+                     "Read_data atom z coord is non-zero for 2d simulation");
         xdata[2] = 0.0;
       }
 
@@ -1260,13 +1257,97 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 }
 
+/* ----------------------------------------------------------------------
+   set bounds of atoms data_atoms() keeps, either my sub-domain
+     or the entire box if keepflag is set
+   in lamda coords for triclinic boxes
+------------------------------------------------------------------------- */
+
+void Atom::data_atoms_bounds(double *sublo, double *subhi, int keepflag)
+{
+  // if periodic and I am lo/hi proc, adjust bounds by EPSILON
+  // ensures all data atoms will be owned even with round-off
+
+  int triclinic = domain->triclinic;
+
+  double epsilon[3];
+  if (triclinic) epsilon[0] = epsilon[1] = epsilon[2] = EPSILON;
+  else {
+    epsilon[0] = domain->prd[0] * EPSILON;
+    epsilon[1] = domain->prd[1] * EPSILON;
+    epsilon[2] = domain->prd[2] * EPSILON;
+  }
+
+  if (triclinic == 0) {
+    sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
+    sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
+    sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
+  } else {
+    sublo[0] = domain->sublo_lamda[0]; subhi[0] = domain->subhi_lamda[0];
+    sublo[1] = domain->sublo_lamda[1]; subhi[1] = domain->subhi_lamda[1];
+    sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
+  }
+
+  if (keepflag) {
+    if (triclinic == 0) {
+      sublo[0] = domain->boxlo[0]; subhi[0] = domain->boxhi[0];
+      sublo[1] = domain->boxlo[1]; subhi[1] = domain->boxhi[1];
+      sublo[2] = domain->boxlo[2]; subhi[2] = domain->boxhi[2];
+    } else {
+      sublo[0] = sublo[1] = sublo[2] = 0.0;
+      subhi[0] = subhi[1] = subhi[2] = 1.0;
+    }
+    if (domain->xperiodic) {
+      sublo[0] -= epsilon[0];
+      subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      sublo[1] -= epsilon[1];
+      subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      sublo[2] -= epsilon[2];
+      subhi[2] += epsilon[2];
+    }
+
+  } else if (comm->layout != Comm::LAYOUT_TILED) {
+    if (domain->xperiodic) {
+      if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
+      if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      if (comm->myloc[1] == 0) sublo[1] -= epsilon[1];
+      if (comm->myloc[1] == comm->procgrid[1]-1) subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      if (comm->myloc[2] == 0) sublo[2] -= epsilon[2];
+      if (comm->myloc[2] == comm->procgrid[2]-1) subhi[2] += epsilon[2];
+    }
+
+  } else {
+    if (domain->xperiodic) {
+      if (comm->mysplit[0][0] == 0.0) sublo[0] -= epsilon[0];
+      if (comm->mysplit[0][1] == 1.0) subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      if (comm->mysplit[1][0] == 0.0) sublo[1] -= epsilon[1];
+      if (comm->mysplit[1][1] == 1.0) subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      if (comm->mysplit[2][0] == 0.0) sublo[2] -= epsilon[2];
+      if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    unpack N lines from Velocity section of data file
    check that atom IDs are > 0 and <= map_tag_max
    call style-specific routine to parse line-
+   parallel = 1 if procs parse different lines
 ------------------------------------------------------------------------ */
 
-void Atom::data_vels(int n, char *buf, tagint id_offset)
+void Atom::data_vels(int n, char *buf, tagint id_offset, int parallel)
 {
   int m;
   char *next;
@@ -1283,10 +1364,11 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
     if (values.size() == 0) {
       // skip over empty or comment lines
     } else if ((int)values.size() != avec->size_data_vel) {
-      error->all(FLERR, "Incorrect format in Velocities section of data file: {}{}",
-                 utils::trim(buf), utils::errorurl(2));
+      data_error(error, parallel, FLERR,
+                 "Incorrect format in Velocities section of data file: {}{}", utils::trim(buf),
+                 utils::errorurl(2));
     } else {
-      tagint tagdata = utils::tnumeric(FLERR,values[0],false,lmp) + id_offset;
+      tagint tagdata = utils::tnumeric(FLERR,values[0],parallel,lmp) + id_offset;
       if (tagdata <= 0 || tagdata > map_tag_max)
         error->one(FLERR,"Invalid atom ID {} in Velocities section of data file: {}", tagdata, buf);
       if ((m = map(tagdata)) >= 0) avec->data_vel(m,values);
@@ -1300,10 +1382,11 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
    if count is non-nullptr, just count bonds per atom
    else store them with atoms
    check that atom IDs are > 0 and <= map_tag_max
+   parallel = 1 if procs parse different lines
 ------------------------------------------------------------------------- */
 
 void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
-                      int type_offset, int labelflag, int *ilabel)
+                      int type_offset, int labelflag, int *ilabel, int parallel)
 {
   int m,itype;
   tagint atom1,atom2;
@@ -1329,11 +1412,11 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
     // Bonds line is: number(ignored), bond type, atomID 1, atomID 2
     if (nwords > 0) {
       if (nwords != 4)
-        error->all(FLERR, "Incorrect format in {}: {}{}", location,
+        data_error(error, parallel, FLERR, "Incorrect format in {}: {}{}", location,
                    utils::trim(buf), utils::errorurl(2));
       typestr = utils::utf8_subst(values[1]);
-      atom1 = utils::tnumeric(FLERR, values[2], false, lmp);
-      atom2 = utils::tnumeric(FLERR, values[3], false, lmp);
+      atom1 = utils::tnumeric(FLERR, values[2], parallel, lmp);
+      atom2 = utils::tnumeric(FLERR, values[3], parallel, lmp);
       if (id_offset) {
         atom1 += id_offset;
         atom2 += id_offset;
@@ -1341,16 +1424,19 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
 
       switch (utils::is_type(typestr)) {
         case 0: {    // numeric
-          itype = utils::inumeric(FLERR, typestr, false, lmp) + type_offset;
+          itype = utils::inumeric(FLERR, typestr, parallel, lmp) + type_offset;
           if ((itype < 1) || (itype > nbondtypes))
-            error->all(FLERR, "Invalid bond type {} in {}: {}", itype, location, utils::trim(buf));
+            data_error(error, parallel, FLERR, "Invalid bond type {} in {}: {}", itype, location,
+                       utils::trim(buf));
           if (labelflag) itype = ilabel[itype - 1];
           break;
         }
         case 1: {    // type label
-          if (!atom->labelmapflag) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (!atom->labelmapflag)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           itype = lmap->find(typestr, Atom::BOND);
-          if (itype == -1) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (itype == -1)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           break;
         }
         default:    // invalid
@@ -1360,9 +1446,10 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
 
       if ((atom1 <= 0) || (atom1 > map_tag_max) ||
           (atom2 <= 0) || (atom2 > map_tag_max) || (atom1 == atom2))
-        error->all(FLERR,"Invalid atom ID in {}: {}", location, utils::trim(buf));
+        data_error(error, parallel, FLERR, "Invalid atom ID in {}: {}", location, utils::trim(buf));
       if ((itype <= 0) || (itype > nbondtypes))
-        error->all(FLERR,"Invalid bond type {} in {}: {}", itype, location, utils::trim(buf));
+        data_error(error, parallel, FLERR, "Invalid bond type {} in {}: {}", itype, location,
+                   utils::trim(buf));
       if ((m = map(atom1)) >= 0) {
         if (count) count[m]++;
         else {
@@ -1393,10 +1480,11 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
    if count is non-nullptr, just count angles per atom
    else store them with atoms
    check that atom IDs are > 0 and <= map_tag_max
+   parallel = 1 if procs parse different lines
 ------------------------------------------------------------------------- */
 
 void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
-                       int type_offset, int labelflag, int *ilabel)
+                       int type_offset, int labelflag, int *ilabel, int parallel)
 {
   int m,itype;
   tagint atom1,atom2,atom3;
@@ -1422,12 +1510,12 @@ void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
     // Angles line is: number(ignored), angle type, atomID 1, atomID 2, atomID 3
     if (nwords > 0) {
       if (nwords != 5)
-        error->all(FLERR, "Incorrect format in {}: {}{}", location,
+        data_error(error, parallel, FLERR, "Incorrect format in {}: {}{}", location,
                    utils::trim(buf), utils::errorurl(2));
       typestr = utils::utf8_subst(values[1]);
-      atom1 = utils::tnumeric(FLERR, values[2], false, lmp);
-      atom2 = utils::tnumeric(FLERR, values[3], false, lmp);
-      atom3 = utils::tnumeric(FLERR, values[4], false, lmp);
+      atom1 = utils::tnumeric(FLERR, values[2], parallel, lmp);
+      atom2 = utils::tnumeric(FLERR, values[3], parallel, lmp);
+      atom3 = utils::tnumeric(FLERR, values[4], parallel, lmp);
       if (id_offset) {
         atom1 += id_offset;
         atom2 += id_offset;
@@ -1436,16 +1524,19 @@ void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
 
       switch (utils::is_type(typestr)) {
         case 0: {    // numeric
-          itype = utils::inumeric(FLERR, typestr, false, lmp) + type_offset;
+          itype = utils::inumeric(FLERR, typestr, parallel, lmp) + type_offset;
           if ((itype < 1) || (itype > nangletypes))
-            error->all(FLERR, "Invalid angle type {} in {}: {}", itype, location, utils::trim(buf));
+            data_error(error, parallel, FLERR, "Invalid angle type {} in {}: {}", itype, location,
+                       utils::trim(buf));
           if (labelflag) itype = ilabel[itype - 1];
           break;
         }
         case 1: {    // type label
-          if (!atom->labelmapflag) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (!atom->labelmapflag)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           itype = lmap->find(typestr, Atom::ANGLE);
-          if (itype == -1) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (itype == -1)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           break;
         }
         default:    // invalid
@@ -1502,10 +1593,11 @@ void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
    if count is non-nullptr, just count diihedrals per atom
    else store them with atoms
    check that atom IDs are > 0 and <= map_tag_max
+   parallel = 1 if procs parse different lines
 ------------------------------------------------------------------------- */
 
 void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
-                          int type_offset, int labelflag, int *ilabel)
+                          int type_offset, int labelflag, int *ilabel, int parallel)
 {
   int m,itype;
   tagint atom1,atom2,atom3,atom4;
@@ -1531,13 +1623,13 @@ void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
     // Dihedrals line is: number(ignored), bond type, atomID 1, atomID 2, atomID 3, atomID 4
     if (nwords > 0) {
       if (nwords != 6)
-        error->all(FLERR, "Incorrect format in {}: {}{}", location,
+        data_error(error, parallel, FLERR, "Incorrect format in {}: {}{}", location,
                    utils::trim(buf), utils::errorurl(2));
       typestr = utils::utf8_subst(values[1]);
-      atom1 = utils::tnumeric(FLERR, values[2], false, lmp);
-      atom2 = utils::tnumeric(FLERR, values[3], false, lmp);
-      atom3 = utils::tnumeric(FLERR, values[4], false, lmp);
-      atom4 = utils::tnumeric(FLERR, values[5], false, lmp);
+      atom1 = utils::tnumeric(FLERR, values[2], parallel, lmp);
+      atom2 = utils::tnumeric(FLERR, values[3], parallel, lmp);
+      atom3 = utils::tnumeric(FLERR, values[4], parallel, lmp);
+      atom4 = utils::tnumeric(FLERR, values[5], parallel, lmp);
       if (id_offset) {
         atom1 += id_offset;
         atom2 += id_offset;
@@ -1547,17 +1639,19 @@ void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
 
       switch (utils::is_type(typestr)) {
         case 0: {    // numeric
-          itype = utils::inumeric(FLERR, typestr, false, lmp) + type_offset;
+          itype = utils::inumeric(FLERR, typestr, parallel, lmp) + type_offset;
           if ((itype < 1) || (itype > ndihedraltypes))
-            error->all(FLERR, "Invalid dihedral type {} in {}: {}", itype, location,
-                       utils::trim(buf));
+            data_error(error, parallel, FLERR, "Invalid dihedral type {} in {}: {}", itype,
+                       location, utils::trim(buf));
           if (labelflag) itype = ilabel[itype - 1];
           break;
         }
         case 1: {    // type label
-          if (!atom->labelmapflag) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (!atom->labelmapflag)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           itype = lmap->find(typestr, Atom::DIHEDRAL);
-          if (itype == -1) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (itype == -1)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           break;
         }
         default:    // invalid
@@ -1630,10 +1724,11 @@ void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
    if count is non-nullptr, just count impropers per atom
    else store them with atoms
    check that atom IDs are > 0 and <= map_tag_max
+   parallel = 1 if procs parse different lines
 ------------------------------------------------------------------------- */
 
 void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
-                          int type_offset, int labelflag, int *ilabel)
+                          int type_offset, int labelflag, int *ilabel, int parallel)
 {
   int m,itype;
   tagint atom1,atom2,atom3,atom4;
@@ -1659,13 +1754,13 @@ void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
     // Impropers line is: number(ignored), bond type, atomID 1, atomID 2, atomID 3, atomID 4
     if (nwords > 0) {
       if (nwords != 6)
-        error->all(FLERR, "Incorrect format in {}: {}{}", location,
+        data_error(error, parallel, FLERR, "Incorrect format in {}: {}{}", location,
                    utils::trim(buf), utils::errorurl(2));
       typestr = utils::utf8_subst(values[1]);
-      atom1 = utils::tnumeric(FLERR, values[2], false, lmp);
-      atom2 = utils::tnumeric(FLERR, values[3], false, lmp);
-      atom3 = utils::tnumeric(FLERR, values[4], false, lmp);
-      atom4 = utils::tnumeric(FLERR, values[5], false, lmp);
+      atom1 = utils::tnumeric(FLERR, values[2], parallel, lmp);
+      atom2 = utils::tnumeric(FLERR, values[3], parallel, lmp);
+      atom3 = utils::tnumeric(FLERR, values[4], parallel, lmp);
+      atom4 = utils::tnumeric(FLERR, values[5], parallel, lmp);
       if (id_offset) {
         atom1 += id_offset;
         atom2 += id_offset;
@@ -1675,17 +1770,19 @@ void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
 
       switch (utils::is_type(typestr)) {
         case 0: {    // numeric
-          itype = utils::inumeric(FLERR, typestr, false, lmp) + type_offset;
+          itype = utils::inumeric(FLERR, typestr, parallel, lmp) + type_offset;
           if ((itype < 1) || (itype > nimpropertypes))
-            error->all(FLERR, "Invalid improper type {} in {}: {}", itype, location,
-                       utils::trim(buf));
+            data_error(error, parallel, FLERR, "Invalid improper type {} in {}: {}", itype,
+                       location, utils::trim(buf));
           if (labelflag) itype = ilabel[itype - 1];
           break;
         }
         case 1: {    // type label
-          if (!atom->labelmapflag) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (!atom->labelmapflag)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           itype = lmap->find(typestr, Atom::IMPROPER);
-          if (itype == -1) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (itype == -1)
+            data_error(error, parallel, FLERR, "Invalid {}: {}", location, utils::trim(buf));
           break;
         }
         default:    // invalid
@@ -1753,13 +1850,206 @@ void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack N rows from Atoms section of binary data file
+   each row has the values of one atom as packed by AtomVec::pack_data()
+   same operations as data_atoms() for a line of a text data file
+------------------------------------------------------------------------- */
+
+void Atom::data_atoms_binary(int n, double *buf, tagint id_offset, tagint mol_offset,
+                             int type_offset, int shiftflag, double *shift,
+                             int labelflag, int *ilabel, int triclinic_general, int keepflag)
+{
+  imageint imagedata;
+  double xdata[3],lamda[3];
+  double *coord;
+  auto location = "Atoms section of data file";
+
+  int dimension = domain->dimension;
+  int triclinic = domain->triclinic;
+
+  double sublo[3],subhi[3];
+  data_atoms_bounds(sublo,subhi,keepflag);
+
+  // xptr = which value in row starts xyz coords
+  // iptr = which value in row starts ix,iy,iz image flags
+
+  int ncol = avec->size_data_atom + 3;
+  int xptr = avec->xcol_data - 1;
+  int iptr = avec->size_data_atom;
+
+  for (int i = 0; i < n; i++) {
+    double *row = &buf[(bigint) i*ncol];
+
+    int imx = (int) ubuf(row[iptr]).i;
+    int imy = (int) ubuf(row[iptr+1]).i;
+    int imz = (int) ubuf(row[iptr+2]).i;
+    if ((dimension == 2) && (imz != 0))
+      error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+    if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
+    if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
+    if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
+    imagedata = ((imageint) (imx + IMGMAX) & IMGMASK) |
+      (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
+      (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
+
+    xdata[0] = row[xptr];
+    xdata[1] = row[xptr+1];
+    xdata[2] = row[xptr+2];
+
+    if (dimension == 2) {
+      if (fabs(xdata[2]) > EPS_ZCOORD)
+        error->one(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+      xdata[2] = 0.0;
+    }
+
+    if (triclinic_general) domain->general_to_restricted_coords(xdata);
+
+    if (shiftflag) {
+      xdata[0] += shift[0];
+      xdata[1] += shift[1];
+      xdata[2] += shift[2];
+    }
+
+    domain->remap(xdata,imagedata);
+
+    if (triclinic) {
+      domain->x2lamda(xdata,lamda);
+      coord = lamda;
+    } else coord = xdata;
+
+    if (coord[0] >= sublo[0] && coord[0] < subhi[0] &&
+        coord[1] >= sublo[1] && coord[1] < subhi[1] &&
+        coord[2] >= sublo[2] && coord[2] < subhi[2]) {
+
+      // binary data files always store numeric atom types
+
+      avec->unpack_data(xdata,imagedata,row);
+      if (id_offset) tag[nlocal-1] += id_offset;
+      if (mol_offset) molecule[nlocal-1] += mol_offset;
+
+      int itype = type[nlocal-1] + type_offset;
+      if ((itype < 1) || (itype > ntypes))
+        error->one(FLERR, "Invalid atom type {} in {}", itype, location);
+      if (labelflag) itype = ilabel[itype - 1];
+      type[nlocal-1] = itype;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from Velocities section of binary data file
+   each row has the values of one atom as packed by AtomVec::pack_vel()
+------------------------------------------------------------------------- */
+
+void Atom::data_vels_binary(int n, double *buf, tagint id_offset)
+{
+  int m;
+  int ncol = avec->size_data_vel;
+
+  for (int i = 0; i < n; i++) {
+    double *row = &buf[(bigint) i*ncol];
+    tagint tagdata = (tagint) ubuf(row[0]).i + id_offset;
+    if (tagdata <= 0 || tagdata > map_tag_max)
+      error->one(FLERR,"Invalid atom ID {} in Velocities section of data file", tagdata);
+    if ((m = map(tagdata)) >= 0) avec->unpack_vel(m,row);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   process N rows from Bonds, Angles, Dihedrals, or Impropers section
+     of binary data file, style = BOND, ANGLE, DIHEDRAL, or IMPROPER
+   each row is index (ignored), numeric type, and atom IDs
+   if count is non-nullptr, just count them per atom
+   else store them with atoms, same as data_bonds() etc
+------------------------------------------------------------------------- */
+
+void Atom::data_topology_binary(int style, int n, double *buf, int *count, tagint id_offset,
+                                int type_offset, int labelflag, int *ilabel)
+{
+  int m,itype,ntype;
+  tagint ids[4];
+  const char *location;
+  int newton_bond = force->newton_bond;
+
+  // nper = # of atoms per interaction
+  // key = which of them stores the interaction if newton_bond is set
+
+  int nper,key;
+  if (style == BOND) {
+    nper = 2; key = 0; ntype = nbondtypes; location = "Bonds section of data file";
+  } else if (style == ANGLE) {
+    nper = 3; key = 1; ntype = nangletypes; location = "Angles section of data file";
+  } else if (style == DIHEDRAL) {
+    nper = 4; key = 1; ntype = ndihedraltypes; location = "Dihedrals section of data file";
+  } else {
+    nper = 4; key = 1; ntype = nimpropertypes; location = "Impropers section of data file";
+  }
+  int ncol = nper + 2;
+
+  for (int i = 0; i < n; i++) {
+    double *row = &buf[(bigint) i*ncol];
+
+    itype = (int) ubuf(row[1]).i + type_offset;
+    if ((itype < 1) || (itype > ntype))
+      error->one(FLERR, "Invalid type {} in {}", itype, location);
+    if (labelflag) itype = ilabel[itype - 1];
+
+    for (int k = 0; k < nper; k++) {
+      ids[k] = (tagint) ubuf(row[k+2]).i + id_offset;
+      if ((ids[k] <= 0) || (ids[k] > map_tag_max))
+        error->one(FLERR, "Invalid atom ID {} in {}", ids[k], location);
+      for (int kk = 0; kk < k; kk++)
+        if (ids[kk] == ids[k])
+          error->one(FLERR, "Invalid atom ID {} in {}", ids[k], location);
+    }
+
+    for (int k = 0; k < nper; k++) {
+      if (newton_bond && k != key) continue;
+      if ((m = map(ids[k])) < 0) continue;
+      if (count) {
+        count[m]++;
+        continue;
+      }
+
+      if (style == BOND) {
+        bond_type[m][num_bond[m]] = itype;
+        bond_atom[m][num_bond[m]] = ids[1-k];
+        num_bond[m]++;
+        avec->data_bonds_post(m, num_bond[m], ids[0], ids[1], id_offset);
+      } else if (style == ANGLE) {
+        angle_type[m][num_angle[m]] = itype;
+        angle_atom1[m][num_angle[m]] = ids[0];
+        angle_atom2[m][num_angle[m]] = ids[1];
+        angle_atom3[m][num_angle[m]] = ids[2];
+        num_angle[m]++;
+      } else if (style == DIHEDRAL) {
+        dihedral_type[m][num_dihedral[m]] = itype;
+        dihedral_atom1[m][num_dihedral[m]] = ids[0];
+        dihedral_atom2[m][num_dihedral[m]] = ids[1];
+        dihedral_atom3[m][num_dihedral[m]] = ids[2];
+        dihedral_atom4[m][num_dihedral[m]] = ids[3];
+        num_dihedral[m]++;
+      } else {
+        improper_type[m][num_improper[m]] = itype;
+        improper_atom1[m][num_improper[m]] = ids[0];
+        improper_atom2[m][num_improper[m]] = ids[1];
+        improper_atom3[m][num_improper[m]] = ids[2];
+        improper_atom4[m][num_improper[m]] = ids[3];
+        num_improper[m]++;
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    unpack N lines from atom-style specific bonus section of data file
    check that atom IDs are > 0 and <= map_tag_max
    call style-specific routine to parse line
+   parallel = 1 if procs parse different lines
 ------------------------------------------------------------------------- */
 
-void Atom::data_bonus(int n, char *buf, AtomVec *avec_bonus, tagint id_offset)
+void Atom::data_bonus(int n, char *buf, AtomVec *avec_bonus, tagint id_offset, int parallel)
 {
   int m;
   char *next;
@@ -1776,10 +2066,10 @@ void Atom::data_bonus(int n, char *buf, AtomVec *avec_bonus, tagint id_offset)
     if (values.size() == 0) {
       // skip over empty or comment lines
     } else if ((int)values.size() != avec_bonus->size_data_bonus) {
-      error->all(FLERR, "Incorrect format in Bonus section of data file: {}{}",
+      data_error(error, parallel, FLERR, "Incorrect format in Bonus section of data file: {}{}",
                  utils::trim(buf), utils::errorurl(2));
     } else {
-      tagint tagdata = utils::tnumeric(FLERR,values[0],false,lmp) + id_offset;
+      tagint tagdata = utils::tnumeric(FLERR,values[0],parallel,lmp) + id_offset;
       if (tagdata <= 0 || tagdata > map_tag_max)
         error->one(FLERR,"Invalid atom ID in Bonus section of data file");
 
@@ -2346,6 +2636,7 @@ void Atom::sort()
     iy = MIN(iy,nbiny-1);
     iz = MIN(iz,nbinz-1);
     ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+    if (sortorder != SORT_LINEAR) ibin = binrank[ibin];
     next[i] = binhead[ibin];
     binhead[ibin] = i;
   }
@@ -2401,6 +2692,42 @@ void Atom::sort()
   //if (flagall) error->all(FLERR,"Atom sort did not operate correctly");
 }
 
+/* ----------------------------------------------------------------------
+   copy coords of owned and ghost atoms from first to last-1 into SoA streams
+   last < 0 means up to the last ghost atom
+   each stream is padded to a multiple of SOAPAD doubles, so all streams
+     are aligned like the buffer and vector loops may run into the padding
+   padding is set far away, so it is never within a cutoff
+   soa_valid must be reset by caller once coords change
+------------------------------------------------------------------------- */
+
+void Atom::soa_pack(int first, int last)
+{
+  int nall = nlocal + nghost;
+  if (last < 0) last = nall;
+
+  if (nmax > soa_stride) {
+    soa_stride = (nmax + SOAPAD - 1) / SOAPAD * SOAPAD;
+    memory->sfree(xsoa);
+    xsoa = (double *) memory->smalloc(sizeof(double)*3*soa_stride,"atom:xsoa");
+    first = 0;
+  }
+
+  double *_noalias xs = soa_x();
+  double *_noalias ys = soa_y();
+  double *_noalias zs = soa_z();
+
+  for (int i = first; i < last; i++) {
+    xs[i] = x[i][0];
+    ys[i] = x[i][1];
+    zs[i] = x[i][2];
+  }
+  int npad = MIN(soa_stride,(nall + SOAPAD - 1) / SOAPAD * SOAPAD);
+  for (int i = nall; i < npad; i++) xs[i] = ys[i] = zs[i] = SOAFAR;
+
+  soa_valid = 1;
+}
+
 /* ----------------------------------------------------------------------
    setup bins for spatial sorting of atoms
 ------------------------------------------------------------------------- */
@@ -2542,9 +2869,92 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binrank);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    if (sortorder != SORT_LINEAR) memory->create(binrank,maxbin,"atom:binrank");
+  }
+
+  if (sortorder != SORT_LINEAR) setup_sort_order();
+}
+
+/* ----------------------------------------------------------------------
+   compute position of each sort bin along a Morton (Z-order) or Hilbert
+     space-filling curve through the 3d (or 2d) grid of bins
+   sorting atoms by binrank instead of the linear bin index keeps atoms
+     close in space also close in memory in all dimensions
+   Hilbert index from transposed coords, see J. Skilling,
+     AIP Conf. Proc. 707, 381 (2004)
+------------------------------------------------------------------------- */
+
+void Atom::setup_sort_order()
+{
+  if (binrank == nullptr) memory->create(binrank,maxbin,"atom:binrank");
+
+  // # of bits needed for largest bin index in any dimension
+
+  const int ndim = (domain->dimension == 3) ? 3 : 2;
+  int nmaxdim = MAX(nbinx,nbiny);
+  if (ndim == 3) nmaxdim = MAX(nmaxdim,nbinz);
+  int nbits = 1;
+  while ((1 << nbits) < nmaxdim) nbits++;
+
+  // keys must fit into 64 bits, else keep the linear order
+
+  if (ndim*nbits > 64) {
+    for (int m = 0; m < nbins; m++) binrank[m] = m;
+    return;
+  }
+
+  std::vector<std::pair<uint64_t,int>> keys(nbins);
+  uint32_t c[3];
+
+  int ibin = 0;
+  for (int iz = 0; iz < nbinz; iz++) {
+    for (int iy = 0; iy < nbiny; iy++) {
+      for (int ix = 0; ix < nbinx; ix++) {
+        c[0] = ix;
+        c[1] = iy;
+        c[2] = iz;
+
+        // convert coords to transposed Hilbert index
+        // undo excess work, then Gray encode
+
+        if (sortorder == SORT_HILBERT) {
+          uint32_t p, q, t;
+          for (q = 1U << (nbits-1); q > 1; q >>= 1) {
+            p = q - 1;
+            for (int d = 0; d < ndim; d++) {
+              if (c[d] & q) c[0] ^= p;
+              else {
+                t = (c[0] ^ c[d]) & p;
+                c[0] ^= t;
+                c[d] ^= t;
+              }
+            }
+          }
+          for (int d = 1; d < ndim; d++) c[d] ^= c[d-1];
+          t = 0;
+          for (q = 1U << (nbits-1); q > 1; q >>= 1)
+            if (c[ndim-1] & q) t ^= q - 1;
+          for (int d = 0; d < ndim; d++) c[d] ^= t;
+        }
+
+        // interleave bits of (transposed) coords, most significant first
+
+        uint64_t key = 0;
+        for (int b = nbits-1; b >= 0; b--)
+          for (int d = 0; d < ndim; d++)
+            key = (key << 1) | ((c[d] >> b) & 1U);
+
+        keys[ibin] = std::make_pair(key,ibin);
+        ibin++;
+      }
+    }
   }
+
+  std::sort(keys.begin(),keys.end());
+  for (int m = 0; m < nbins; m++) binrank[keys[m].second] = m;
 }
 
 /* ----------------------------------------------------------------------
@@ -3248,6 +3658,7 @@ double Atom::memory_usage()
     bytes += memory->usage(next,maxnext);
     bytes += memory->usage(permute,maxnext);
   }
+  bytes += (double)3*soa_stride*sizeof(double);
 
   return bytes;
 }
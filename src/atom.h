@@ -36,6 +36,7 @@ class Atom : protected Pointers {
   enum { ATOM = 0, BOND = 1, ANGLE = 2, DIHEDRAL = 3, IMPROPER = 4 };
   enum { NUMERIC = 0, LABELS = 1 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { SORT_LINEAR = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
 
   // atom counts
 
@@ -284,6 +285,19 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortorder;         // order of sort bins, SORT_LINEAR, SORT_MORTON or SORT_HILBERT
+
+  // optional structure-of-arrays copy of coords for vectorized kernels
+  // only current during force computation in Verlet and minimizers
+
+  int soaflag;       // 1 if SoA coords are maintained
+  int soa_valid;     // 1 if SoA coords match x
+  int soa_stride;    // padded length of each SoA stream
+  double *xsoa;      // x, y, z streams, each aligned, of length soa_stride
+
+  double *soa_x() const { return xsoa; }
+  double *soa_y() const { return xsoa + soa_stride; }
+  double *soa_z() const { return xsoa + 2 * soa_stride; }
 
   // indices of atoms with same ID
 
@@ -329,14 +343,17 @@ class Atom : protected Pointers {
 
   virtual void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int);
-  void data_vels(int, char *, tagint);
-  void data_bonds(int, char *, int *, tagint, int, int, int *);
-  void data_angles(int, char *, int *, tagint, int, int, int *);
-  void data_dihedrals(int, char *, int *, tagint, int, int, int *);
-  void data_impropers(int, char *, int *, tagint, int, int, int *);
-  void data_bonus(int, char *, AtomVec *, tagint);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int, int);
+  void data_vels(int, char *, tagint, int);
+  void data_bonds(int, char *, int *, tagint, int, int, int *, int);
+  void data_angles(int, char *, int *, tagint, int, int, int *, int);
+  void data_dihedrals(int, char *, int *, tagint, int, int, int *, int);
+  void data_impropers(int, char *, int *, tagint, int, int, int *, int);
+  void data_bonus(int, char *, AtomVec *, tagint, int);
   void data_bodies(int, char *, AtomVec *, tagint);
+  void data_atoms_binary(int, double *, tagint, tagint, int, int, double *, int, int *, int, int);
+  void data_vels_binary(int, double *, tagint);
+  void data_topology_binary(int, int, double *, int *, tagint, int, int, int *);
   void data_fix_compute_variable(int, int);
 
   virtual void allocate_type_arrays();
@@ -358,6 +375,7 @@ class Atom : protected Pointers {
 
   void first_reorder();
   virtual void sort();
+  void soa_pack(int first = 0, int last = -1);
 
   void add_callback(int);
   void delete_callback(const char *, int);
@@ -430,6 +448,7 @@ class Atom : protected Pointers {
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
   int *binhead;                        // 1st atom in each bin
+  int *binrank;                        // position of each bin along space-filling curve
   int *next;                           // next atom in bin
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
@@ -437,7 +456,9 @@ class Atom : protected Pointers {
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  void setup_sort_order();
   int next_prime(int);
+  void data_atoms_bounds(double *, double *, int);
 };
 
 }    // namespace LAMMPS_NS
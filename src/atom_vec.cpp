@@ -1832,6 +1832,102 @@ void AtomVec::write_data(FILE *fp, int n, double **buf)
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack one row of Atoms section of binary data file
+   row has same values as packed by pack_data(), image flags are ignored
+   atom type is stored as is, caller applies offsets and checks it
+------------------------------------------------------------------------- */
+
+void AtomVec::unpack_data(double *coord, imageint imagetmp, const double *buf)
+{
+  int m, n, datatype, cols;
+  void *pdata;
+
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) grow(0);
+
+  x[nlocal][0] = coord[0];
+  x[nlocal][1] = coord[1];
+  x[nlocal][2] = coord[2];
+  mask[nlocal] = 1;
+  image[nlocal] = imagetmp;
+  v[nlocal][0] = 0.0;
+  v[nlocal][1] = 0.0;
+  v[nlocal][2] = 0.0;
+
+  int j = 0;
+  for (n = 0; n < ndata_atom; n++) {
+    pdata = mdata_atom.pdata[n];
+    datatype = mdata_atom.datatype[n];
+    cols = mdata_atom.cols[n];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[nlocal] = buf[j++];
+      } else {
+        double **array = *((double ***) pdata);
+        if (array == atom->x) {    // x was already set by coord arg
+          j += cols;
+          continue;
+        }
+        for (m = 0; m < cols; m++) array[nlocal][m] = buf[j++];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[nlocal] = (int) ubuf(buf[j++]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (m = 0; m < cols; m++) array[nlocal][m] = (int) ubuf(buf[j++]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[nlocal] = (bigint) ubuf(buf[j++]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (m = 0; m < cols; m++) array[nlocal][m] = (bigint) ubuf(buf[j++]).i;
+      }
+    }
+  }
+
+  // error checks applicable to all styles
+
+  if ((atom->tag_enable && (tag[nlocal] <= 0)) || (!atom->tag_enable && (tag[nlocal] != 0)))
+    error->one(FLERR, "Invalid atom ID {} in Atoms section of data file", tag[nlocal]);
+
+  // if needed, modify unpacked values or initialize other peratom values
+
+  data_atom_post(nlocal);
+
+  atom->nlocal++;
+}
+
+/* ----------------------------------------------------------------------
+   return type of each value packed by pack_data() or pack_vel()
+   one char per value, 'i' for integer, 'f' for floating point
+------------------------------------------------------------------------- */
+
+std::string AtomVec::data_columns(int velflag)
+{
+  int n, m, datatype, cols;
+  std::string kinds;
+
+  const Method &method = velflag ? mdata_vel : mdata_atom;
+  int ndata = velflag ? ndata_vel : ndata_atom;
+
+  for (n = 0; n < ndata; n++) {
+    datatype = method.datatype[n];
+    cols = method.cols[n];
+    char kind = (datatype == Atom::DOUBLE) ? 'f' : 'i';
+    if (cols == 0) kinds += kind;
+    else
+      for (m = 0; m < cols; m++) kinds += kind;
+  }
+  if (!velflag) kinds += "iii";
+  return kinds;
+}
+
 /* ----------------------------------------------------------------------
    unpack one line from Velocities section of data file
 ------------------------------------------------------------------------- */
@@ -1884,6 +1980,54 @@ void AtomVec::data_vel(int ilocal, const std::vector<std::string> &values)
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack one row of Velocities section of binary data file
+   row has same values as packed by pack_vel()
+------------------------------------------------------------------------- */
+
+void AtomVec::unpack_vel(int ilocal, const double *buf)
+{
+  int m, n, datatype, cols;
+  void *pdata;
+
+  double **v = atom->v;
+  int j = 1;
+  v[ilocal][0] = buf[j++];
+  v[ilocal][1] = buf[j++];
+  v[ilocal][2] = buf[j++];
+
+  for (n = 2; n < ndata_vel; n++) {
+    pdata = mdata_vel.pdata[n];
+    datatype = mdata_vel.datatype[n];
+    cols = mdata_vel.cols[n];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[ilocal] = buf[j++];
+      } else {
+        double **array = *((double ***) pdata);
+        for (m = 0; m < cols; m++) array[ilocal][m] = buf[j++];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[ilocal] = (int) ubuf(buf[j++]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (m = 0; m < cols; m++) array[ilocal][m] = (int) ubuf(buf[j++]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[ilocal] = (bigint) ubuf(buf[j++]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (m = 0; m < cols; m++) array[ilocal][m] = (bigint) ubuf(buf[j++]).i;
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    pack velocity info for data file
 ------------------------------------------------------------------------- */
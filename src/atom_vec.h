@@ -133,12 +133,15 @@ class AtomVec : protected Pointers {
 
   virtual void pack_data(double **);
   virtual void write_data(FILE *, int, double **);
+  virtual void unpack_data(double *, imageint, const double *);
   virtual void pack_data_pre(int) {}
   virtual void pack_data_post(int) {}
+  std::string data_columns(int);
 
   virtual void data_vel(int, const std::vector<std::string> &);
   virtual void pack_vel(double **);
   virtual void write_vel(FILE *, int, double **);
+  virtual void unpack_vel(int, const double *);
 
   virtual int pack_bond(tagint **);
   virtual void write_bond(FILE *, int, tagint **, int);
@@ -27,6 +27,7 @@
 #include "fix_store_atom.h"
 #include "force.h"
 #include "imbalance.h"
+#include "imbalance_cost.h"
 #include "imbalance_group.h"
 #include "imbalance_neigh.h"
 #include "imbalance_store.h"
@@ -42,10 +43,12 @@
 
 #include <cmath>
 #include <cstring>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
 double EPSNEIGH = 1.0e-3;
+static constexpr double MINCUTFRAC = 0.01;    // min distance of RCB cut to its box edge
 
 enum { XYZ, SHIFT, BISECTION };
 enum { NONE, UNIFORM, USER };
@@ -63,6 +66,13 @@ Balance::Balance(LAMMPS *lmp) : Command(lmp)
 
   rcb = nullptr;
 
+  diffuseflag = 0;
+  diffdelta = 0.1;
+  diffcap = 0.05;
+  diffproc = nullptr;
+  maxdiffproc = 0;
+  nmigrate = 0;
+
   nimbalance = 0;
   imbalances = nullptr;
   fixstore = nullptr;
@@ -95,6 +105,7 @@ Balance::~Balance()
   }
 
   delete rcb;
+  memory->destroy(diffproc);
 
   for (int i = 0; i < nimbalance; i++) delete imbalances[i];
   delete[] imbalances;
@@ -209,6 +220,14 @@ void Balance::command(int narg, char **arg)
       style = BISECTION;
       iarg++;
 
+    } else if (strcmp(arg[iarg],"rcb/diffuse") == 0) {
+      if (style != -1) error->all(FLERR,"Illegal balance command");
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR, "balance rcb/diffuse", error);
+      style = BISECTION;
+      diffuse_setup(utils::numeric(FLERR,arg[iarg+1],false,lmp),
+                    utils::numeric(FLERR,arg[iarg+2],false,lmp));
+      iarg += 3;
+
     } else break;
   }
 
@@ -340,9 +359,11 @@ void Balance::command(int narg, char **arg)
 
   // style BISECTION = recursive coordinate bisectioning
 
+  int *sendproc = nullptr;
   if (style == BISECTION) {
+    if (diffuseflag) sendproc = bisection_diffuse();
+    else sendproc = bisection();
     comm->layout = Comm::LAYOUT_TILED;
-    bisection();
   }
 
   // reset proc sub-domains
@@ -357,7 +378,7 @@ void Balance::command(int narg, char **arg)
   if (domain->triclinic) domain->x2lamda(atom->nlocal);
   auto irregular = new Irregular(lmp);
   if (wtflag) fixstore->disable = 0;
-  if (style == BISECTION) irregular->migrate_atoms(sortflag,1,rcb->sendproc);
+  if (style == BISECTION) irregular->migrate_atoms(sortflag,1,sendproc);
   else irregular->migrate_atoms(sortflag);
   delete irregular;
   if (domain->triclinic) domain->lamda2x(atom->nlocal);
@@ -395,6 +416,8 @@ void Balance::command(int narg, char **arg)
     std::string mesg = fmt::format(" rebalancing time: {:.3f} seconds\n",
                                    platform::walltime()-start_time);
     mesg += fmt::format("  iteration count = {}\n",niter);
+    if (diffuseflag && nmigrate >= 0)
+      mesg += fmt::format("  atoms moved by incremental RCB = {}\n",nmigrate);
     for (int i = 0; i < nimbalance; ++i) mesg += imbalances[i]->info();
     mesg += fmt::format("  initial/final maximal load/proc = {:.8} {:.8}\n"
                         "  initial/final imbalance factor  = {:.8} {:.8}\n",
@@ -453,6 +476,10 @@ void Balance::options(int iarg, int narg, char **arg, int sortflag_default)
         imb = new ImbalanceTime(lmp);
         nopt = imb->options(narg-iarg,arg+iarg+2);
         imbalances[nimbalance++] = imb;
+      } else if (strcmp(arg[iarg+1],"cost") == 0) {
+        imb = new ImbalanceCost(lmp);
+        nopt = imb->options(narg-iarg,arg+iarg+2);
+        imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"neigh") == 0) {
         imb = new ImbalanceNeigh(lmp);
         nopt = imb->options(narg-iarg,arg+iarg+2);
@@ -711,6 +738,286 @@ int *Balance::bisection()
   return rcb->sendproc;
 }
 
+/* ----------------------------------------------------------------------
+   set parameters for incremental RCB balancing
+------------------------------------------------------------------------- */
+
+void Balance::diffuse_setup(double delta, double cap)
+{
+  if (delta <= 0.0 || delta >= 0.5)
+    error->all(FLERR,"Illegal balance rcb/diffuse delta value: {}", delta);
+  if (cap <= 0.0 || cap > 1.0)
+    error->all(FLERR,"Illegal balance rcb/diffuse cap value: {}", cap);
+
+  diffuseflag = 1;
+  diffdelta = delta;
+  diffcap = cap;
+}
+
+/* ----------------------------------------------------------------------
+   incremental RCB: shift the cuts of the current RCB tree
+   instead of computing a new one from scratch
+   cut dims and tree topology stay the same, so only atoms near a cut move
+   cuts are processed top-down, one level of the tree at a time
+   each cut moves toward the weighted position that splits its box
+     in proportion to the # of procs on each side, but by no more than
+     diffdelta times the box length along the cut dim and no further than
+     diffcap times the # of atoms in the box crossing the cut
+   falls back to full RCB if no valid RCB tree is available
+   return list of procs to send my atoms to
+------------------------------------------------------------------------- */
+
+int *Balance::bisection_diffuse()
+{
+  int nprocs = comm->nprocs;
+  int me = comm->me;
+  nmigrate = -1;
+  if ((nprocs == 1) || (comm->layout != Comm::LAYOUT_TILED)) return bisection();
+
+  // fractional cut and dim of every tree node, stored by its procmid
+
+  struct CutInfo {
+    double cutfrac;
+    int dim;
+  } cutone, *cuts;
+
+  cutone.cutfrac = comm->rcbcutfrac;
+  cutone.dim = comm->rcbcutdim;
+  cuts = (CutInfo *) memory->smalloc(nprocs*sizeof(CutInfo),"balance:cuts");
+  MPI_Allgather(&cutone,sizeof(CutInfo),MPI_CHAR,cuts,sizeof(CutInfo),MPI_CHAR,world);
+
+  for (int iproc = 1; iproc < nprocs; iproc++)
+    if (cuts[iproc].dim < 0 || cuts[iproc].dim > 2) {
+      memory->sfree(cuts);
+      return bisection();
+    }
+
+  // atom coords in fractional form
+  // if triclinic, lamda coords are already fractional
+
+  int triclinic = domain->triclinic;
+  double *boxlo,*prd;
+  if (triclinic == 0) {
+    boxlo = domain->boxlo;
+    prd = domain->prd;
+  } else {
+    boxlo = domain->boxlo_lamda;
+    prd = domain->prd_lamda;
+  }
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  if (triclinic) domain->x2lamda(nlocal);
+
+  if (wtflag) weight = fixstore->vstore;
+
+  // plo,phi = lower/upper proc of tree partition each atom is in
+  // node = tree partition in current level of tree
+  //   procmid = 1st proc in upper half = proc that stores the cut
+
+  int *plo,*phi;
+  memory->create(plo,nlocal,"balance:plo");
+  memory->create(phi,nlocal,"balance:phi");
+  for (int i = 0; i < nlocal; i++) {
+    plo[i] = 0;
+    phi[i] = nprocs-1;
+  }
+
+  struct Node {
+    int proclower,procupper,procmid;
+    double lo[3],hi[3];
+    double wlo,whi;
+  };
+  std::vector<Node> level, next;
+  Node root;
+  root.proclower = 0;
+  root.procupper = nprocs-1;
+  for (int d = 0; d < 3; d++) {
+    root.lo[d] = 0.0;
+    root.hi[d] = 1.0;
+  }
+  level.push_back(root);
+
+  // histogram of weights and counts in window around each cut
+  // bin 0 = below window, bin NBIN+1 = above window
+
+  const int NBIN = 32;
+  const int nhist = 2*(NBIN+2);
+  int *nodeindex = new int[nprocs];
+  std::vector<double> hist,histall;
+  int nmoved = 0;
+
+  while (!level.empty()) {
+    int nnode = level.size();
+    for (int n = 0; n < nnode; n++) {
+      Node &node = level[n];
+      node.procmid = node.proclower + (node.procupper - node.proclower) / 2 + 1;
+      int dim = cuts[node.procmid].dim;
+      double len = node.hi[dim] - node.lo[dim];
+      double cut = cuts[node.procmid].cutfrac;
+      node.wlo = MAX(cut - diffdelta*len, node.lo[dim] + MINCUTFRAC*len);
+      node.whi = MIN(cut + diffdelta*len, node.hi[dim] - MINCUTFRAC*len);
+      nodeindex[node.proclower] = n;
+    }
+
+    hist.assign((size_t) nnode*nhist,0.0);
+    histall.resize((size_t) nnode*nhist);
+
+    for (int i = 0; i < nlocal; i++) {
+      if (plo[i] == phi[i]) continue;
+      int n = nodeindex[plo[i]];
+      const Node &node = level[n];
+      double xfrac = (x[i][cuts[node.procmid].dim] - boxlo[cuts[node.procmid].dim]) /
+        prd[cuts[node.procmid].dim];
+      int ibin;
+      if (xfrac < node.wlo) ibin = 0;
+      else if (xfrac >= node.whi) ibin = NBIN+1;
+      else ibin = MIN(NBIN,1 + static_cast<int>((xfrac - node.wlo) / (node.whi - node.wlo) * NBIN));
+      hist[n*nhist + ibin] += wtflag ? weight[i] : 1.0;
+      hist[n*nhist + NBIN+2 + ibin] += 1.0;
+    }
+    MPI_Allreduce(hist.data(),histall.data(),nnode*nhist,MPI_DOUBLE,MPI_SUM,world);
+
+    // new cut for each node, then split it into its 2 children
+
+    next.clear();
+    for (int n = 0; n < nnode; n++) {
+      Node &node = level[n];
+      int dim = cuts[node.procmid].dim;
+      double *wthist = &histall[n*nhist];
+      double *cnthist = &histall[n*nhist + NBIN+2];
+      double wttotal = 0.0, cnttotal = 0.0;
+      for (int ibin = 0; ibin < NBIN+2; ibin++) {
+        wttotal += wthist[ibin];
+        cnttotal += cnthist[ibin];
+      }
+
+      double oldcut = cuts[node.procmid].cutfrac;
+      double newcut = oldcut;
+      if (node.wlo < node.whi && wttotal > 0.0) {
+        double target = wttotal * (node.procmid - node.proclower) /
+          (node.procupper - node.proclower + 1);
+        newcut = diffuse_invert(wthist,NBIN,node.wlo,node.whi,target);
+
+        // limit # of atoms crossing the cut
+
+        double cntold = diffuse_cumulative(cnthist,NBIN,node.wlo,node.whi,oldcut);
+        double cntnew = diffuse_cumulative(cnthist,NBIN,node.wlo,node.whi,newcut);
+        double cntmax = diffcap * cnttotal;
+        if (cntnew - cntold > cntmax)
+          newcut = diffuse_invert(cnthist,NBIN,node.wlo,node.whi,cntold + cntmax);
+        else if (cntold - cntnew > cntmax)
+          newcut = diffuse_invert(cnthist,NBIN,node.wlo,node.whi,cntold - cntmax);
+      }
+
+      // keep every cut inside its box, also the unchanged old cut,
+      //   since the box may have shrunk when a cut above it moved
+
+      double len = node.hi[dim] - node.lo[dim];
+      double cutlo = node.lo[dim] + MINCUTFRAC*len;
+      double cuthi = node.hi[dim] - MINCUTFRAC*len;
+      newcut = MAX(newcut,cutlo);
+      newcut = MIN(newcut,cuthi);
+      cuts[node.procmid].cutfrac = newcut;
+
+      Node lower = node, upper = node;
+      lower.procupper = node.procmid-1;
+      lower.hi[dim] = newcut;
+      upper.proclower = node.procmid;
+      upper.lo[dim] = newcut;
+
+      for (Node *child : {&lower, &upper}) {
+        if (child->proclower < child->procupper) next.push_back(*child);
+        else if (child->proclower == me) {
+          for (int d = 0; d < 3; d++) {
+            comm->mysplit[d][0] = child->lo[d];
+            comm->mysplit[d][1] = child->hi[d];
+          }
+        }
+      }
+    }
+
+    // assign my atoms to the lower or upper child of their node
+    // same criterion as CommTiled::point_drop()
+
+    for (int i = 0; i < nlocal; i++) {
+      if (plo[i] == phi[i]) continue;
+      const Node &node = level[nodeindex[plo[i]]];
+      int dim = cuts[node.procmid].dim;
+      double xfrac = (x[i][dim] - boxlo[dim]) / prd[dim];
+      if (xfrac < cuts[node.procmid].cutfrac) phi[i] = node.procmid-1;
+      else plo[i] = node.procmid;
+    }
+
+    level.swap(next);
+  }
+
+  if (triclinic) domain->lamda2x(nlocal);
+
+  // store new cut I own in Comm, for CommTiled to rebuild its RCB info
+
+  comm->rcbnew = 1;
+  comm->rcbcutfrac = cuts[me].cutfrac;
+  comm->rcbcutdim = cuts[me].dim;
+
+  if (nlocal > maxdiffproc) {
+    maxdiffproc = atom->nmax;
+    memory->destroy(diffproc);
+    memory->create(diffproc,maxdiffproc,"balance:diffproc");
+  }
+  for (int i = 0; i < nlocal; i++) {
+    diffproc[i] = plo[i];
+    if (plo[i] != me) nmoved++;
+  }
+
+  memory->destroy(plo);
+  memory->destroy(phi);
+  memory->sfree(cuts);
+  delete[] nodeindex;
+
+  bigint nmovedall, nmovedme = nmoved;
+  MPI_Allreduce(&nmovedme,&nmovedall,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  nmigrate = nmovedall;
+
+  return diffproc;
+}
+
+/* ----------------------------------------------------------------------
+   cumulative histogram value at position x, linear within each bin
+   hist has bins below and above the window [lo,hi) at 0 and nbin+1
+------------------------------------------------------------------------- */
+
+double Balance::diffuse_cumulative(double *hist, int nbin, double lo, double hi, double x)
+{
+  double sum = hist[0];
+  if (x <= lo) return sum;
+  double binsize = (hi - lo) / nbin;
+  for (int ibin = 1; ibin <= nbin; ibin++) {
+    double binlo = lo + (ibin-1)*binsize;
+    if (x < binlo + binsize) return sum + hist[ibin] * (x - binlo) / binsize;
+    sum += hist[ibin];
+  }
+  return sum;
+}
+
+/* ----------------------------------------------------------------------
+   position in window [lo,hi] where cumulative histogram reaches value
+   clamped to the window
+------------------------------------------------------------------------- */
+
+double Balance::diffuse_invert(double *hist, int nbin, double lo, double hi, double value)
+{
+  double sum = hist[0];
+  if (value <= sum) return lo;
+  double binsize = (hi - lo) / nbin;
+  for (int ibin = 1; ibin <= nbin; ibin++) {
+    if (value <= sum + hist[ibin])
+      return lo + (ibin-1)*binsize + binsize * (value - sum) / hist[ibin];
+    sum += hist[ibin];
+  }
+  return hi;
+}
+
 /* ----------------------------------------------------------------------
    setup static load balance operations
    called from command and indirectly initially from fix balance
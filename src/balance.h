@@ -32,6 +32,7 @@ class Balance : public Command {
   int varflag;                     // 1 if weight style var(iable) is used
   int sortflag;                    // 1 if sorting of comm messages is done
   int outflag;                     // 1 for output of balance results to file
+  int diffuseflag;                 // 1 if RCB cuts are shifted incrementally
 
   Balance(class LAMMPS *);
   ~Balance() override;
@@ -44,6 +45,8 @@ class Balance : public Command {
   void shift_setup(const char *, int, double);
   int shift();
   int *bisection();
+  int *bisection_diffuse();
+  void diffuse_setup(double, double);
   void dumpout(bigint);
 
   static constexpr int BSTR_SIZE = 3;
@@ -55,6 +58,12 @@ class Balance : public Command {
   double *user_xsplit, *user_ysplit, *user_zsplit;    // params for xyz LB
   int oldrcb;                                         // use old-style RCB compute
 
+  double diffdelta;     // max shift of a cut as fraction of its box length
+  double diffcap;       // max fraction of atoms in a box crossing its cut
+  int *diffproc;        // proc to send each of my atoms to
+  int maxdiffproc;      // allocated length of diffproc
+  bigint nmigrate;      // # of atoms moved by last incremental RCB
+
   int nitermax;    // params for shift LB
   double stopthresh;
   std::string bstr;
@@ -82,6 +91,8 @@ class Balance : public Command {
   int firststep;
 
   double imbalance_splits();
+  double diffuse_cumulative(double *, int, double, double, double);
+  double diffuse_invert(double *, int, double, double, double);
   void shift_setup_static(const char *);
   void tally(int, int, double *);
   int adjust(int, double *);
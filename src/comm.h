@@ -35,6 +35,8 @@ class Comm : protected Pointers {
 
   int me, nprocs;               // proc info
   int ghost_velocity;           // 1 if ghost atoms have velocity, 0 if not
+  int persistent;               // 1 if forward/reverse comm use persistent MPI requests
+  int overlap;                  // 1 if forward comm may overlap with pair computation
   double cutghost[3];           // cutoffs used for acquiring ghost atoms
   double cutghostuser;          // user-specified ghost cutoff (mode == SINGLE)
   double *cutusermulti;         // per collection user ghost cutoff (mode == MULTI)
@@ -85,6 +87,11 @@ class Comm : protected Pointers {
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
 
+  // split-phase forward comm of atom coords, default is blocking comm in start
+
+  virtual void forward_comm_start() { forward_comm(); }
+  virtual void forward_comm_finish() {}
+
   // forward/reverse comm from a Pair, Bond, Fix, Compute, Dump
 
   virtual void forward_comm(class Pair *) = 0;
@@ -48,7 +48,10 @@ CommBrick::CommBrick(LAMMPS *lmp) :
   slablo(nullptr), slabhi(nullptr), multilo(nullptr), multihi(nullptr),
   multioldlo(nullptr), multioldhi(nullptr), cutghostmulti(nullptr), cutghostmultiold(nullptr),
   pbc_flag(nullptr), pbc(nullptr), firstrecv(nullptr), sendlist(nullptr),
-  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr)
+  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr),
+  fsend_request(nullptr), frecv_request(nullptr), rsend_request(nullptr), rrecv_request(nullptr),
+  sendowned(nullptr), overlap_offset(nullptr), orecv_request(nullptr), osend_request(nullptr),
+  buf_overlap(nullptr)
 {
   style = Comm::BRICK;
   layout = Comm::LAYOUT_UNIFORM;
@@ -78,6 +81,18 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+
+  free_persistent();
+  memory->sfree(fsend_request);
+  memory->sfree(frecv_request);
+  memory->sfree(rsend_request);
+  memory->sfree(rrecv_request);
+
+  memory->destroy(sendowned);
+  memory->destroy(overlap_offset);
+  memory->sfree(orecv_request);
+  memory->sfree(osend_request);
+  memory->destroy(buf_overlap);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -112,6 +127,13 @@ void CommBrick::init_buffers()
 
   buf_send = buf_recv = nullptr;
   maxsend = maxrecv = BUFMIN;
+  npersist = maxpersist = 0;
+  fsend_request = frecv_request = rsend_request = rrecv_request = nullptr;
+  persist_x = persist_f = persist_send = persist_recv = nullptr;
+  overlap_pending = maxoverlap = maxbufoverlap = 0;
+  sendowned = overlap_offset = nullptr;
+  orecv_request = osend_request = nullptr;
+  buf_overlap = nullptr;
   CommBrick::grow_send(maxsend,2);
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
@@ -546,10 +568,19 @@ void CommBrick::forward_comm(int /*dummy*/)
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
+  // if persistent requests are enabled, restart the ones created after borders()
+
+  const int persistflag = (persistent && comm_x_only) ? check_persistent() : 0;
 
   for (int iswap = 0; iswap < nswap; iswap++) {
     if (sendproc[iswap] != me) {
-      if (comm_x_only) {
+      if (persistflag) {
+        if (size_forward_recv[iswap]) MPI_Start(&frecv_request[iswap]);
+        n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        if (n) MPI_Start(&fsend_request[iswap]);
+        if (size_forward_recv[iswap]) MPI_Wait(&frecv_request[iswap],MPI_STATUS_IGNORE);
+        if (n) MPI_Wait(&fsend_request[iswap],MPI_STATUS_IGNORE);
+      } else if (comm_x_only) {
         if (size_forward_recv[iswap]) {
           buf = x[firstrecv[iswap]];
           MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,&request);
@@ -590,6 +621,92 @@ void CommBrick::forward_comm(int /*dummy*/)
   }
 }
 
+/* ----------------------------------------------------------------------
+   start forward communication of atom coords without waiting for it
+   post all receives and start swaps that send only owned atoms
+   the caller may use owned coords until forward_comm_finish() is called
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_start()
+{
+  // split-phase comm requires receiving coords directly into x
+
+  if (!comm_x_only || (nswap > maxoverlap)) {
+    forward_comm();
+    overlap_pending = 0;
+    return;
+  }
+
+  // each swap in flight needs its own section of the send buffer
+
+  int size_forward = atom->avec->size_forward;
+  int nbuf = 0;
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    overlap_offset[iswap] = nbuf;
+    if (sendproc[iswap] != me) nbuf += size_forward*sendnum[iswap];
+  }
+  if (nbuf > maxbufoverlap) {
+    maxbufoverlap = static_cast<int> (BUFFACTOR * nbuf);
+    memory->destroy(buf_overlap);
+    memory->create(buf_overlap,maxbufoverlap,"comm:buf_overlap");
+  }
+
+  // messages of different swaps may be in flight at the same time
+  // so the swap index is used as message tag
+
+  double **x = atom->x;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    orecv_request[iswap] = osend_request[iswap] = MPI_REQUEST_NULL;
+    if ((sendproc[iswap] != me) && size_forward_recv[iswap])
+      MPI_Irecv(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                recvproc[iswap],iswap,world,&orecv_request[iswap]);
+  }
+
+  for (int iswap = 0; iswap < nswap; iswap++)
+    if (sendowned[iswap]) overlap_send(iswap);
+
+  overlap_pending = 1;
+}
+
+/* ----------------------------------------------------------------------
+   complete forward communication started by forward_comm_start()
+   swaps that forward ghost atoms wait for the swaps they depend on
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_finish()
+{
+  if (!overlap_pending) return;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendowned[iswap]) continue;
+    MPI_Waitall(iswap,orecv_request,MPI_STATUS_IGNORE);
+    overlap_send(iswap);
+  }
+
+  MPI_Waitall(nswap,orecv_request,MPI_STATUS_IGNORE);
+  MPI_Waitall(nswap,osend_request,MPI_STATUS_IGNORE);
+  overlap_pending = 0;
+}
+
+/* ----------------------------------------------------------------------
+   pack coords of one swap and send them, or copy them if other proc is self
+------------------------------------------------------------------------- */
+
+void CommBrick::overlap_send(int iswap)
+{
+  AtomVec *avec = atom->avec;
+
+  if (sendproc[iswap] != me) {
+    double *buf = buf_overlap + overlap_offset[iswap];
+    int n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf,pbc_flag[iswap],pbc[iswap]);
+    if (n) MPI_Isend(buf,n,MPI_DOUBLE,sendproc[iswap],iswap,world,&osend_request[iswap]);
+  } else if (sendnum[iswap]) {
+    avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                    atom->x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    reverse communication of forces on atoms every timestep
    other per-atom attributes may also be sent via pack/unpack routines
@@ -606,10 +723,18 @@ void CommBrick::reverse_comm()
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_f_only set, exchange or copy directly from f, don't pack
+  // if persistent requests are enabled, restart the ones created after borders()
+
+  const int persistflag = (persistent && comm_f_only) ? check_persistent() : 0;
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
     if (sendproc[iswap] != me) {
-      if (comm_f_only) {
+      if (persistflag) {
+        if (size_reverse_recv[iswap]) MPI_Start(&rrecv_request[iswap]);
+        if (size_reverse_send[iswap]) MPI_Start(&rsend_request[iswap]);
+        if (size_reverse_recv[iswap]) MPI_Wait(&rrecv_request[iswap],MPI_STATUS_IGNORE);
+        if (size_reverse_send[iswap]) MPI_Wait(&rsend_request[iswap],MPI_STATUS_IGNORE);
+      } else if (comm_f_only) {
         if (size_reverse_recv[iswap])
           MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],0,world,&request);
         if (size_reverse_send[iswap]) {
@@ -780,6 +905,10 @@ void CommBrick::borders()
   MPI_Request request;
   AtomVec *avec = atom->avec;
 
+  // persistent requests become invalid since swap sizes change below
+
+  free_persistent();
+
   // After exchanging/sorting, need to reconstruct collection array for border communication
   if (mode == Comm::MULTI) neighbor->build_collection(0);
 
@@ -973,6 +1102,33 @@ void CommBrick::borders()
   max = MAX(maxforward*rmax,maxreverse*smax);
   if (max > maxrecv) grow_recv(max);
 
+  // flag swaps which send only owned atoms for split-phase forward comm
+  // they do not depend on ghost atoms received in earlier swaps
+
+  if (overlap) {
+    if (nswap > maxoverlap) {
+      maxoverlap = nswap;
+      memory->destroy(sendowned);
+      memory->destroy(overlap_offset);
+      memory->create(sendowned,maxoverlap,"comm:sendowned");
+      memory->create(overlap_offset,maxoverlap,"comm:overlap_offset");
+      orecv_request = (MPI_Request *)
+        memory->srealloc(orecv_request,maxoverlap*sizeof(MPI_Request),"comm:orecv_request");
+      osend_request = (MPI_Request *)
+        memory->srealloc(osend_request,maxoverlap*sizeof(MPI_Request),"comm:osend_request");
+    }
+    int nlocal = atom->nlocal;
+    for (iswap = 0; iswap < nswap; iswap++) {
+      int *list = sendlist[iswap];
+      sendowned[iswap] = 1;
+      for (i = 0; i < sendnum[iswap]; i++)
+        if (list[i] >= nlocal) {
+          sendowned[iswap] = 0;
+          break;
+        }
+    }
+  }
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
@@ -1455,6 +1611,90 @@ void CommBrick::forward_comm_array(int nsize, double **array)
   }
 }
 
+/* ----------------------------------------------------------------------
+   create persistent requests for forward and reverse comm of all swaps
+   send/recv counts and buffers are fixed between calls to borders()
+     except if x,f or the comm buffers are reallocated
+   return 1 if requests are valid and can be used
+------------------------------------------------------------------------- */
+
+int CommBrick::check_persistent()
+{
+  double *xcur = atom->x ? atom->x[0] : nullptr;
+  double *fcur = atom->f ? atom->f[0] : nullptr;
+
+  if ((npersist == nswap) && (xcur == persist_x) && (fcur == persist_f) &&
+      (buf_send == persist_send) && (buf_recv == persist_recv))
+    return 1;
+
+  free_persistent();
+
+  if (nswap > maxpersist) {
+    maxpersist = nswap;
+    fsend_request = (MPI_Request *)
+      memory->srealloc(fsend_request,maxpersist*sizeof(MPI_Request),"comm:fsend_request");
+    frecv_request = (MPI_Request *)
+      memory->srealloc(frecv_request,maxpersist*sizeof(MPI_Request),"comm:frecv_request");
+    rsend_request = (MPI_Request *)
+      memory->srealloc(rsend_request,maxpersist*sizeof(MPI_Request),"comm:rsend_request");
+    rrecv_request = (MPI_Request *)
+      memory->srealloc(rrecv_request,maxpersist*sizeof(MPI_Request),"comm:rrecv_request");
+  }
+
+  // forward comm: recv directly into ghost coords, send packed buf_send
+  // reverse comm: send directly from ghost forces, recv into buf_recv
+
+  double **x = atom->x;
+  double **f = atom->f;
+  const int size_forward = atom->avec->size_forward;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    fsend_request[iswap] = frecv_request[iswap] = MPI_REQUEST_NULL;
+    rsend_request[iswap] = rrecv_request[iswap] = MPI_REQUEST_NULL;
+    if (sendproc[iswap] == me) continue;
+
+    if (comm_x_only) {
+      if (size_forward_recv[iswap])
+        MPI_Recv_init(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                      recvproc[iswap],0,world,&frecv_request[iswap]);
+      if (sendnum[iswap])
+        MPI_Send_init(buf_send,size_forward*sendnum[iswap],MPI_DOUBLE,
+                      sendproc[iswap],0,world,&fsend_request[iswap]);
+    }
+    if (comm_f_only) {
+      if (size_reverse_recv[iswap])
+        MPI_Recv_init(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,
+                      sendproc[iswap],0,world,&rrecv_request[iswap]);
+      if (size_reverse_send[iswap])
+        MPI_Send_init(f[firstrecv[iswap]],size_reverse_send[iswap],MPI_DOUBLE,
+                      recvproc[iswap],0,world,&rsend_request[iswap]);
+    }
+  }
+
+  npersist = nswap;
+  persist_x = xcur;
+  persist_f = fcur;
+  persist_send = buf_send;
+  persist_recv = buf_recv;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   free all persistent requests, they will be recreated on next use
+------------------------------------------------------------------------- */
+
+void CommBrick::free_persistent()
+{
+  for (int iswap = 0; iswap < npersist; iswap++) {
+    if (fsend_request[iswap] != MPI_REQUEST_NULL) MPI_Request_free(&fsend_request[iswap]);
+    if (frecv_request[iswap] != MPI_REQUEST_NULL) MPI_Request_free(&frecv_request[iswap]);
+    if (rsend_request[iswap] != MPI_REQUEST_NULL) MPI_Request_free(&rsend_request[iswap]);
+    if (rrecv_request[iswap] != MPI_REQUEST_NULL) MPI_Request_free(&rrecv_request[iswap]);
+  }
+  npersist = 0;
+  persist_x = persist_f = persist_send = persist_recv = nullptr;
+}
+
 /* ----------------------------------------------------------------------
    realloc the size of the send buffer as needed with BUFFACTOR and bufextra
    flag = 0, don't need to realloc with copy, just free/malloc w/ BUFFACTOR
@@ -1651,5 +1891,8 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += (double)4 * maxpersist * sizeof(MPI_Request);
+  bytes += (double)2 * maxoverlap * (sizeof(int) + sizeof(MPI_Request));
+  bytes += memory->usage(buf_overlap,maxbufoverlap);
   return bytes;
 }
@@ -28,6 +28,8 @@ class CommBrick : public Comm {
   void init() override;
   void setup() override;                        // setup 3d comm pattern
   void forward_comm(int dummy = 0) override;    // forward comm of atom coords
+  void forward_comm_start() override;           // start split-phase forward comm
+  void forward_comm_finish() override;          // finish split-phase forward comm
   void reverse_comm() override;                 // reverse comm of forces
   void exchange() override;                     // move atoms to new procs
   void borders() override;                      // setup list of atoms to comm
@@ -77,6 +79,21 @@ class CommBrick : public Comm {
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  int npersist;                                  // # of swaps with persistent requests
+  int maxpersist;                                // # of swaps request arrays are allocated for
+  MPI_Request *fsend_request, *frecv_request;    // persistent forward comm requests
+  MPI_Request *rsend_request, *rrecv_request;    // persistent reverse comm requests
+  double *persist_x, *persist_f;                 // x,f storage requests were created for
+  double *persist_send, *persist_recv;           // buffers requests were created for
+
+  int overlap_pending;                           // 1 if split-phase forward comm is active
+  int maxoverlap;                                // # of swaps overlap arrays are allocated for
+  int *sendowned;                                // 1 if swap sends only owned atoms
+  int *overlap_offset;                           // offset of each swap into buf_overlap
+  MPI_Request *orecv_request, *osend_request;    // split-phase forward comm requests
+  double *buf_overlap;                           // send buffer for all split-phase swaps
+  int maxbufoverlap;                             // current size of buf_overlap
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
@@ -92,6 +109,10 @@ class CommBrick : public Comm {
   virtual void free_swap();               // free swap arrays
   virtual void free_multi();              // free multi arrays
   virtual void free_multiold();           // free multi/old arrays
+
+  int check_persistent();                 // (re)create persistent requests if stale
+  void free_persistent();                 // free persistent requests
+  void overlap_send(int);                 // pack and send one split-phase swap
 };
 
 }    // namespace LAMMPS_NS
@@ -28,10 +28,43 @@
 #include "variable.h"
 
 #include <cstring>
+#include <exception>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
+// snapshot data gathered on a filewriter proc for the background thread
+
+namespace LAMMPS_NS {
+struct DumpAsync {
+  std::thread thread;          // background thread writing the last snapshot
+  std::exception_ptr error;    // error raised while writing the last snapshot
+  std::vector<char> buf;       // per-atom data of all procs in my cluster
+  std::vector<int> count;      // # of lines or chars from each proc in buf
+  bigint nbytes;               // # of bytes used in buf
+};
+}    // namespace LAMMPS_NS
+
+// error while writing a snapshot on the background thread, raised by async_wait()
+
+namespace {
+struct DumpWriteError : public std::runtime_error {
+  std::string file;
+  int line;
+  DumpWriteError(const std::string &_file, int _line, const std::string &mesg) :
+      std::runtime_error(mesg), file(_file), line(_line)
+  {
+  }
+};
+
+// 1 on the background thread of async output
+
+thread_local int async_writer = 0;
+}    // namespace
+
 #if defined(LMP_QSORT)
 // allocate space for static class variable
 Dump *Dump::dumpptr;
@@ -50,7 +83,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
     format_int_user(nullptr), format_bigint_user(nullptr), format_column_user(nullptr), fp(nullptr),
     nameslist(nullptr), buf(nullptr), sbuf(nullptr), ids(nullptr), bufsort(nullptr),
     idsort(nullptr), index(nullptr), proclist(nullptr), xpbc(nullptr), vpbc(nullptr),
-    imagepbc(nullptr), irregular(nullptr)
+    imagepbc(nullptr), irregular(nullptr), async(nullptr)
 {
   MPI_Comm_rank(world, &me);
   MPI_Comm_size(world, &nprocs);
@@ -77,6 +110,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -140,6 +175,14 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
 Dump::~Dump()
 {
+  // finish output of last snapshot, cannot report errors from destructor
+
+  try {
+    async_wait();
+  } catch (std::exception &) {
+  }
+  delete async;
+
   delete[] id;
   delete[] style;
   delete[] filename;
@@ -200,6 +243,9 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  // background thread may still use format strings and buffers reset by init_style()
+
+  async_wait();
   init_style();
 
   if (!sort_flag) {
@@ -365,6 +411,11 @@ void Dump::write()
     if (value != 0.0) return;
   }
 
+  // wait until background thread has written previous snapshot
+  // must be done before anything is written to the file
+
+  if (async_flag) async_wait();
+
   // if file per timestep, open new file
   // do this after skip check, so no file is opened if skip occurs
 
@@ -486,9 +537,9 @@ void Dump::write()
           nlines /= size_one;
         } else nlines = nme;
 
-        write_data(nlines,buf);
+        if (async_flag) async_store(nlines,(char *) buf,(bigint) nlines*size_one*sizeof(double));
+        else write_data(nlines,buf);
       }
-      if (flush_flag && fp) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -507,9 +558,9 @@ void Dump::write()
           MPI_Get_count(&status,MPI_CHAR,&nchars);
         } else nchars = nsme;
 
-        write_data(nchars,(double *) sbuf);
+        if (async_flag) async_store(nchars,sbuf,nchars);
+        else write_data(nchars,(double *) sbuf);
       }
-      if (flush_flag && fp) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -530,22 +581,127 @@ void Dump::write()
 
   if (refreshflag) irefresh->refresh();
 
-  if (filewriter && fp != nullptr) write_footer();
+  // finish output of snapshot
+  // with async output, background thread writes the data gathered on filewriter
+  // wait for it on last step of a run and outside of MD runs,
+  //   so the file is complete when the run is over
 
-  if (fp && ferror(fp)) error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
+  if (filewriter) {
+    if (async_flag) {
+      async_start();
+      if ((update->whichflag != 1) || (update->ntimestep == update->laststep)) async_wait();
+    } else {
+      if (fp != nullptr) write_footer();
+      write_finish();
+    }
+  }
+}
 
-  // if file per timestep, close file if I am filewriter
+/* ----------------------------------------------------------------------
+   flush or close file after a snapshot was written by filewriter
+   some derived classes override this function
+------------------------------------------------------------------------- */
+
+void Dump::write_finish()
+{
+  if (flush_flag && fp) fflush(fp);
+
+  if (fp && ferror(fp))
+    write_error(FLERR, fmt::format("Error writing dump {}: {}", id, utils::getsyserror()));
+
+  // if file per timestep, close file
 
   if (multifile) {
     if (compressed) {
-      if (filewriter && fp != nullptr) platform::pclose(fp);
+      if (fp != nullptr) platform::pclose(fp);
     } else {
-      if (filewriter && fp != nullptr) fclose(fp);
+      if (fp != nullptr) fclose(fp);
     }
     fp = nullptr;
   }
 }
 
+/* ----------------------------------------------------------------------
+   append data of one proc in my cluster to snapshot for background thread
+   n = # of lines or chars, nbytes = size of data in bytes
+------------------------------------------------------------------------- */
+
+void Dump::async_store(int n, const char *data, bigint nbytes)
+{
+  if (!async) async = new DumpAsync;
+  if (async->count.empty()) async->nbytes = 0;
+
+  if (async->nbytes + nbytes > (bigint) async->buf.size())
+    async->buf.resize(async->nbytes + nbytes);
+  if (nbytes) memcpy(async->buf.data() + async->nbytes, data, nbytes);
+  async->nbytes += nbytes;
+  async->count.push_back(n);
+}
+
+/* ----------------------------------------------------------------------
+   start background thread which writes snapshot stored by async_store()
+   header was already written, thread writes data and footer, then
+     flushes or closes the file
+   an error is stored and raised on the main thread by async_wait()
+------------------------------------------------------------------------- */
+
+void Dump::async_start()
+{
+  if (!async) async = new DumpAsync;
+
+  async->thread = std::thread([this]() {
+    async_writer = 1;
+    try {
+      char *ptr = async->buf.data();
+      for (int n : async->count) {
+        write_data(n, (double *) ptr);
+        if (buffer_flag && !binary) ptr += n;
+        else ptr += (bigint) n * size_one * sizeof(double);
+      }
+      if (fp != nullptr) write_footer();
+      write_finish();
+    } catch (...) {
+      async->error = std::current_exception();
+    }
+    async->count.clear();
+  });
+}
+
+/* ----------------------------------------------------------------------
+   wait until background thread has finished writing the last snapshot
+   re-raise error from background thread
+------------------------------------------------------------------------- */
+
+void Dump::async_wait()
+{
+  if (!async) return;
+  if (async->thread.joinable()) async->thread.join();
+
+  if (async->error) {
+    std::exception_ptr eptr = async->error;
+    async->error = nullptr;
+    try {
+      std::rethrow_exception(eptr);
+    } catch (DumpWriteError &e) {
+      error->one(e.file, e.line, e.what());
+    } catch (std::exception &e) {
+      error->one(FLERR, "Error writing dump {} in background thread: {}", id, e.what());
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   raise error while writing snapshot data, footer, or finishing the file
+   the background thread must not call Error, which changes shared state,
+     so there it is stored and raised on the main thread by async_wait()
+------------------------------------------------------------------------- */
+
+void Dump::write_error(const std::string &file, int line, const std::string &mesg)
+{
+  if (async_writer) throw DumpWriteError(file, line, mesg);
+  error->one(file, line, mesg);
+}
+
 /* ----------------------------------------------------------------------
    generic opening of a dump file
    ASCII or binary or compressed
@@ -1049,6 +1205,10 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) utils::missing_cmd_args(FLERR, "dump_modify", error);
 
+  // settings must not change while background thread writes a snapshot
+
+  async_wait();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1062,6 +1222,24 @@ void Dump::modify_params(int narg, char **arg)
         balance_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify async", error);
+      int flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for dump style {}", style);
+
+      // refuse if LAMMPS was not compiled and linked with thread support
+
+      if (flag) {
+        try {
+          std::thread([]() {}).join();
+        } catch (std::system_error &e) {
+          error->all(FLERR, "Dump_modify async yes requires thread support: {}", e.what());
+        }
+      }
+      async_flag = flag;
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"buffer") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify buffer", error);
       buffer_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
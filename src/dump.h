@@ -20,6 +20,7 @@
 
 namespace LAMMPS_NS {
 class Compute;
+struct DumpAsync;
 
 class Dump : protected Pointers {
   friend class Output;
@@ -45,6 +46,7 @@ class Dump : protected Pointers {
   ~Dump() override;
   void init();
   virtual void write();
+  void async_wait();
 
   virtual int pack_forward_comm(int, int *, double *, int, int *) { return 0; }
   virtual void unpack_forward_comm(int, int, double *) {}
@@ -74,6 +76,8 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if file output is done by a background thread
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -151,6 +155,8 @@ class Dump : protected Pointers {
 
   class Irregular *irregular;
 
+  DumpAsync *async;    // background thread and snapshot data for async output
+
   virtual void init_style() = 0;
   virtual void openfile();
   virtual int modify_param(int, char **) { return 0; }
@@ -160,6 +166,7 @@ class Dump : protected Pointers {
   virtual int convert_string(int, double *) { return 0; }
   virtual void write_data(int, double *) = 0;
   virtual void write_footer() {}
+  virtual void write_finish();
 
   void pbc_allocate();
   double compute_time();
@@ -175,6 +182,10 @@ class Dump : protected Pointers {
   static int bufcompare_reverse(const int, const int, void *);
 #endif
   void balance();
+
+  void async_store(int, const char *, bigint);
+  void async_start();
+  void write_error(const std::string &, int, const std::string &);
 };
 
 }    // namespace LAMMPS_NS
@@ -16,6 +16,7 @@
 
 #include "arg_info.h"
 #include "atom.h"
+#include "comm.h"
 #include "compute.h"
 #include "domain.h"
 #include "error.h"
@@ -50,6 +51,21 @@ enum{LT,LE,GT,GE,EQ,NEQ,XOR};
 
 static constexpr int ONEFIELD = 32;
 static constexpr int DELTA = 1048576;
+static constexpr int MINCHUNK = 1024;    // min # of lines formatted by one thread
+
+// append value formatted with a printf() style format to buffer
+
+template <typename T> static void append_printf(fmt::memory_buffer &buf, const char *format, T value)
+{
+  const auto size = buf.size();
+  buf.resize(size + ONEFIELD);
+  int len = snprintf(buf.data() + size, ONEFIELD, format, value);
+  if (len >= ONEFIELD) {
+    buf.resize(size + len + 1);
+    snprintf(buf.data() + size, len + 1, format, value);
+  }
+  buf.resize(size + MAX(len, 0));
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -88,6 +104,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   triclinic_general = 0;
   nthresh = 0;
@@ -134,6 +151,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   // setup format strings
 
   vformat = new char*[nfield];
+  fformat.resize(nfield);
   std::string cols;
 
   cols.clear();
@@ -286,6 +304,18 @@ void DumpCustom::init_style()
     // remove trailing blank on last column's format
     if (i == nfield-1) vformat[i][strlen(vformat[i])-1] = '\0';
 
+    // fmtlib equivalent of the format, if there is one, is much faster than snprintf()
+    // parse it once here, since it is used by multiple threads which must not throw
+
+    std::string newformat;
+    if ((vtype[i] == Dump::INT) || (vtype[i] == Dump::BIGINT))
+      newformat = utils::printf_to_fmt(vformat[i], "di");
+    else if (vtype[i] == Dump::DOUBLE)
+      newformat = utils::printf_to_fmt(vformat[i], "eEfFgG");
+    else
+      newformat = utils::printf_to_fmt(vformat[i], "s");
+    fformat[i].valid = parse_format(newformat, fformat[i], vtype[i]);
+
     ++i;
   }
 
@@ -1339,6 +1369,46 @@ void DumpCustom::pack(tagint *ids)
   }
 }
 
+/* ----------------------------------------------------------------------
+   split fmtlib format with a single replacement field into literal prefix,
+     format spec, and literal suffix and parse the spec for the given type
+   return false if format is empty or cannot be parsed
+------------------------------------------------------------------------- */
+
+bool DumpCustom::parse_format(const std::string &format, FieldFormat &field, int type)
+{
+  field.prefix.clear();
+  field.suffix.clear();
+  if (format.empty()) return false;
+
+  std::string spec;
+  std::string *text = &field.prefix;
+  for (std::size_t k = 0; k < format.size(); ++k) {
+    if ((format[k] == '{') && (text == &field.prefix) && (format.compare(k, 2, "{{") != 0)) {
+      auto end = format.find('}', k);
+      if ((end == std::string::npos) || (format[k+1] != ':')) return false;
+      spec = format.substr(k+2, end-k-2);
+      text = &field.suffix;
+      k = end;
+    } else {
+      *text += format[k];
+      if (((format[k] == '{') || (format[k] == '}')) && (k+1 < format.size())) ++k;
+    }
+  }
+  if (text != &field.suffix) return false;
+
+  try {
+    fmt::format_parse_context ctx(spec);
+    if (type == Dump::INT) field.i.parse(ctx);
+    else if (type == Dump::BIGINT) field.b.parse(ctx);
+    else if (type == Dump::DOUBLE) field.d.parse(ctx);
+    else field.s.parse(ctx);
+  } catch (fmt::format_error &) {
+    return false;
+  }
+  return true;
+}
+
 /* ----------------------------------------------------------------------
    convert mybuf of doubles to one big formatted string in sbuf
    return -1 if strlen exceeds an int, since used as arg in MPI calls in Dump
@@ -1346,36 +1416,89 @@ void DumpCustom::pack(tagint *ids)
 
 int DumpCustom::convert_string(int n, double *mybuf)
 {
-  int i,j;
+  std::vector<fmt::memory_buffer> chunks(MAX(MIN(comm->nthreads, n / MINCHUNK), 1));
+  format_chunks(n, mybuf, chunks);
+
+  bigint nbytes = 0;
+  for (const auto &chunk : chunks) nbytes += chunk.size();
+  if (nbytes >= MAXSMALLINT) return -1;
+
+  if (nbytes >= maxsbuf) {
+    maxsbuf = MIN((nbytes / DELTA + 1) * DELTA, MAXSMALLINT);
+    memory->grow(sbuf,maxsbuf,"dump:sbuf");
+  }
 
   int offset = 0;
-  int m = 0;
-  for (i = 0; i < n; i++) {
-    if (offset + nfield*ONEFIELD > maxsbuf) {
-      if ((bigint) maxsbuf + DELTA > MAXSMALLINT) return -1;
-      maxsbuf += DELTA;
-      memory->grow(sbuf,maxsbuf,"dump:sbuf");
-    }
+  for (const auto &chunk : chunks) {
+    memcpy(&sbuf[offset],chunk.data(),chunk.size());
+    offset += chunk.size();
+  }
+  sbuf[offset] = '\0';
 
-    for (j = 0; j < nfield; j++) {
-      const auto maxsize = maxsbuf - offset;
-      if (vtype[j] == Dump::INT)
-        offset += snprintf(&sbuf[offset],maxsize,vformat[j],static_cast<int> (mybuf[m]));
-      else if (vtype[j] == Dump::DOUBLE)
-        offset += snprintf(&sbuf[offset],maxsize,vformat[j],mybuf[m]);
-      else if (vtype[j] == Dump::STRING)
-        offset += snprintf(&sbuf[offset],maxsize,vformat[j],typenames[(int) mybuf[m]]);
-      else if (vtype[j] == Dump::STRING2)
-        offset += snprintf(&sbuf[offset],maxsize,vformat[j],atom->lmap->typelabel[(int) mybuf[m]-1].c_str());
-      else if (vtype[j] == Dump::BIGINT)
-        offset += snprintf(&sbuf[offset],maxsize,vformat[j],
-                          static_cast<bigint> (mybuf[m]));
+  return offset;
+}
+
+/* ----------------------------------------------------------------------
+   format the n lines in mybuf into one text buffer per chunk
+   chunks are formatted in parallel by multiple threads, if available
+------------------------------------------------------------------------- */
+
+void DumpCustom::format_chunks(int n, double *mybuf, std::vector<fmt::memory_buffer> &chunks)
+{
+  const int nchunk = chunks.size();
+
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) num_threads(nchunk) schedule(static,1)
+#endif
+  for (int ichunk = 0; ichunk < nchunk; ichunk++) {
+    const int ilo = (bigint) n * ichunk / nchunk;
+    const int ihi = (bigint) n * (ichunk+1) / nchunk;
+    format_lines(ilo, ihi, mybuf, chunks[ichunk]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   append lines ilo to ihi-1 of mybuf formatted as text to buf
+   use fmtlib formats where available, since much faster than snprintf()
+------------------------------------------------------------------------- */
+
+void DumpCustom::format_lines(int ilo, int ihi, double *mybuf, fmt::memory_buffer &buf)
+{
+  fmt::format_context ctx(fmt::appender(buf), {});
+
+  int m = ilo*nfield;
+  for (int i = ilo; i < ihi; i++) {
+    for (int j = 0; j < nfield; j++) {
+      const auto &field = fformat[j];
+      if (!field.valid) {
+        if (vtype[j] == Dump::INT)
+          append_printf(buf,vformat[j],static_cast<int> (mybuf[m]));
+        else if (vtype[j] == Dump::DOUBLE)
+          append_printf(buf,vformat[j],mybuf[m]);
+        else if (vtype[j] == Dump::STRING)
+          append_printf(buf,vformat[j],typenames[(int) mybuf[m]]);
+        else if (vtype[j] == Dump::STRING2)
+          append_printf(buf,vformat[j],atom->lmap->typelabel[(int) mybuf[m]-1].c_str());
+        else if (vtype[j] == Dump::BIGINT)
+          append_printf(buf,vformat[j],static_cast<bigint> (mybuf[m]));
+      } else {
+        buf.append(field.prefix.data(),field.prefix.data()+field.prefix.size());
+        if (vtype[j] == Dump::INT)
+          field.i.format(static_cast<int> (mybuf[m]),ctx);
+        else if (vtype[j] == Dump::DOUBLE)
+          field.d.format(mybuf[m],ctx);
+        else if (vtype[j] == Dump::STRING)
+          field.s.format(typenames[(int) mybuf[m]],ctx);
+        else if (vtype[j] == Dump::STRING2)
+          field.s.format(atom->lmap->typelabel[(int) mybuf[m]-1].c_str(),ctx);
+        else if (vtype[j] == Dump::BIGINT)
+          field.b.format(static_cast<bigint> (mybuf[m]),ctx);
+        buf.append(field.suffix.data(),field.suffix.data()+field.suffix.size());
+      }
       m++;
     }
-    offset += snprintf(&sbuf[offset],maxsbuf-offset,"\n");
+    buf.push_back('\n');
   }
-
-  return offset;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -1406,23 +1529,10 @@ void DumpCustom::write_string(int n, double *mybuf)
 
 void DumpCustom::write_lines(int n, double *mybuf)
 {
-  int i,j;
-
-  int m = 0;
-  for (i = 0; i < n; i++) {
-    for (j = 0; j < nfield; j++) {
-      if (vtype[j] == Dump::INT) fprintf(fp,vformat[j],static_cast<int> (mybuf[m]));
-      else if (vtype[j] == Dump::DOUBLE) fprintf(fp,vformat[j],mybuf[m]);
-      else if (vtype[j] == Dump::STRING)
-        fprintf(fp,vformat[j],typenames[(int) mybuf[m]]);
-      else if (vtype[j] == Dump::STRING2)
-        fprintf(fp,vformat[j],atom->lmap->typelabel[(int) mybuf[m]-1].c_str());
-      else if (vtype[j] == Dump::BIGINT)
-        fprintf(fp,vformat[j],static_cast<bigint> (mybuf[m]));
-      m++;
-    }
-    fprintf(fp,"\n");
-  }
+  std::vector<fmt::memory_buffer> chunks(MAX(MIN(comm->nthreads, n / MINCHUNK), 1));
+  format_chunks(n, mybuf, chunks);
+
+  for (const auto &chunk : chunks) fwrite(chunk.data(),sizeof(char),chunk.size(),fp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -59,6 +59,16 @@ class DumpCustom : public Dump {
   int *vtype;        // type of each vector (INT, DOUBLE)
   char **vformat;    // format string for each vector element
                      //
+  struct FieldFormat {    // pre-parsed fmtlib equivalent of a vformat element
+    bool valid = false;   // false if there is none and snprintf() must be used
+    std::string prefix, suffix;
+    fmt::formatter<int> i;
+    fmt::formatter<bigint> b;
+    fmt::formatter<double> d;
+    fmt::formatter<const char *> s;
+  };
+  std::vector<FieldFormat> fformat;
+                     //
   char *columns;     // column labels
   char *columns_default;
   //
@@ -135,6 +145,9 @@ class DumpCustom : public Dump {
   void write_binary(int, double *);
   void write_string(int, double *);
   void write_lines(int, double *);
+  void format_chunks(int, double *, std::vector<fmt::memory_buffer> &);
+  void format_lines(int, int, double *, fmt::memory_buffer &);
+  bool parse_format(const std::string &, FieldFormat &, int);
 
   // customize by adding a method prototype
 
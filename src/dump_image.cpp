@@ -71,6 +71,10 @@ DumpImage::DumpImage(LAMMPS *lmp, int narg, char **arg) :
   // force binary flag on to avoid corrupted output on Windows
 
   binary = 1;
+
+  // images are written by DumpImage::write(), not by a background thread
+
+  async_allow = 0;
   multifile_override = 0;
 
   // flag has_id as true to avoid bogus warnings about atom IDs for dump styles derived from DumpCustom
@@ -18,6 +18,7 @@
 #include "atom.h"
 #include "atom_vec.h"
 #include "comm.h"
+#include "dump.h"
 #include "error.h"
 #include "force.h"
 #include "kspace.h"
@@ -76,6 +77,10 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // complete output of dumps still written by a background thread
+
+  for (auto &dump : output->get_dump_list()) dump->async_wait();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -62,10 +62,15 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
   thresh = utils::numeric(FLERR,arg[4],false,lmp);
 
   reportonly = 0;
+  int diffuse = 0;
+  double delta = 0.0, cap = 0.0;
   if (strcmp(arg[5],"shift") == 0) {
     lbstyle = SHIFT;
   } else if (strcmp(arg[5],"rcb") == 0) {
     lbstyle = BISECTION;
+  } else if (strcmp(arg[5],"rcb/diffuse") == 0) {
+    lbstyle = BISECTION;
+    diffuse = 1;
   } else if (strcmp(arg[5],"report") == 0) {
     lbstyle = SHIFT;
     reportonly = 1;
@@ -93,7 +98,12 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
     }
 
   } else if (lbstyle == BISECTION) {
-    iarg++;
+    if (diffuse) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR, "fix balance rcb/diffuse", error);
+      delta = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      cap = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      iarg += 3;
+    } else iarg++;
   }
 
   // error checks
@@ -120,6 +130,7 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   balance = new Balance(lmp);
   if (lbstyle == SHIFT) balance->shift_setup(bstr.c_str(),nitermax,thresh);
+  if (diffuse) balance->diffuse_setup(delta,cap);
   balance->options(iarg,narg,arg,0);
   wtflag = balance->wtflag;
   sortflag = balance->sortflag;
@@ -296,7 +307,8 @@ void FixBalance::rebalance()
     itercount = balance->shift();
     comm->layout = Comm::LAYOUT_NONUNIFORM;
   } else if (lbstyle == BISECTION) {
-    sendproc = balance->bisection();
+    if (balance->diffuseflag) sendproc = balance->bisection_diffuse();
+    else sendproc = balance->bisection();
     comm->layout = Comm::LAYOUT_TILED;
   }
 
@@ -50,10 +50,11 @@ static constexpr int OFFSET = 16384;
 ------------------------------------------------------------------------- */
 
 Grid3d::Grid3d(LAMMPS *lmp, MPI_Comm gcomm, int gnx, int gny, int gnz) :
-  Pointers(lmp), swap(nullptr), requests(nullptr), srequest(nullptr), rrequest(nullptr),
-    sresponse(nullptr), rresponse(nullptr), send(nullptr), recv(nullptr), copy(nullptr),
-    send_remap(nullptr), recv_remap(nullptr), overlap_procs(nullptr), xsplit(nullptr),
-    ysplit(nullptr), zsplit(nullptr), grid2proc(nullptr), rcbinfo(nullptr), overlap_list(nullptr)
+  Pointers(lmp), async_requests(nullptr), async_buf(nullptr), swap(nullptr), requests(nullptr),
+    srequest(nullptr), rrequest(nullptr), sresponse(nullptr), rresponse(nullptr), send(nullptr),
+    recv(nullptr), copy(nullptr), send_remap(nullptr), recv_remap(nullptr), overlap_procs(nullptr),
+    xsplit(nullptr), ysplit(nullptr), zsplit(nullptr), grid2proc(nullptr), rcbinfo(nullptr),
+    overlap_list(nullptr)
 
 {
   gridcomm = gcomm;
@@ -93,10 +94,11 @@ Grid3d::Grid3d(LAMMPS *lmp, MPI_Comm gcomm, int gnx, int gny, int gnz) :
 Grid3d::Grid3d(LAMMPS *lmp, MPI_Comm gcomm, int gnx, int gny, int gnz,
                int ixlo, int ixhi, int iylo, int iyhi, int izlo, int izhi,
                int oxlo, int oxhi, int oylo, int oyhi, int ozlo, int ozhi) :
-  Pointers(lmp), swap(nullptr), requests(nullptr), srequest(nullptr), rrequest(nullptr),
-    sresponse(nullptr), rresponse(nullptr), send(nullptr), recv(nullptr), copy(nullptr),
-    send_remap(nullptr), recv_remap(nullptr), overlap_procs(nullptr), xsplit(nullptr),
-    ysplit(nullptr), zsplit(nullptr), grid2proc(nullptr), rcbinfo(nullptr), overlap_list(nullptr)
+  Pointers(lmp), async_requests(nullptr), async_buf(nullptr), swap(nullptr), requests(nullptr),
+    srequest(nullptr), rrequest(nullptr), sresponse(nullptr), rresponse(nullptr), send(nullptr),
+    recv(nullptr), copy(nullptr), send_remap(nullptr), recv_remap(nullptr), overlap_procs(nullptr),
+    xsplit(nullptr), ysplit(nullptr), zsplit(nullptr), grid2proc(nullptr), rcbinfo(nullptr),
+    overlap_list(nullptr)
 {
   gridcomm = gcomm;
   MPI_Comm_rank(gridcomm,&me);
@@ -166,6 +168,11 @@ Grid3d::~Grid3d()
 
   memory->sfree(rcbinfo);
 
+  // split comm data structs
+
+  delete [] async_requests;
+  memory->sfree(async_buf);
+
   // remap data structs
 
   deallocate_remap();
@@ -355,6 +362,23 @@ void Grid3d::get_bounds_ghost(int &xlo, int &xhi, int &ylo, int &yhi,
 // also store comm and grid partitioning info
 // ----------------------------------------------------------------------
 
+/* ----------------------------------------------------------------------
+   return extent of my owned cells which reverse comm does not sum into
+   they can be used by caller between reverse_comm_start() and finish()
+   lo > hi if there are no such cells
+------------------------------------------------------------------------- */
+
+void Grid3d::get_bounds_interior(int &xlo, int &xhi, int &ylo, int &yhi,
+                                 int &zlo, int &zhi)
+{
+  xlo = interior[0];
+  xhi = interior[1];
+  ylo = interior[2];
+  yhi = interior[3];
+  zlo = interior[4];
+  zhi = interior[5];
+}
+
 /* ----------------------------------------------------------------------
    setup grid partition for each proc = owned + ghost cells
    return:
@@ -467,6 +491,21 @@ void Grid3d::initialize()
   send_remap = nullptr;
   recv_remap = nullptr;
 
+  // no interior cells and no swaps sent by start, until setup_comm()
+
+  interior[0] = inxlo;
+  interior[1] = inxlo-1;
+  interior[2] = inylo;
+  interior[3] = inylo-1;
+  interior[4] = inzlo;
+  interior[5] = inzlo-1;
+  nforward_async = nreverse_async = 0;
+  async_pending = 0;
+  nasync_request = maxasync_request = 0;
+  async_requests = nullptr;
+  async_buf = nullptr;
+  maxasync_buf = 0;
+
   // store info about Comm decomposition needed for remap operation
   // two Grid instances will exist for duration of remap
   // each must know Comm decomp at time Grid instance was created
@@ -983,6 +1022,60 @@ void Grid3d::setup_comm_brick(int &nbuf1, int &nbuf2)
   }
 
   nbuf1 = nbuf2 = ngrid;
+
+  setup_async_brick();
+}
+
+/* ----------------------------------------------------------------------
+   setup info for forward/reverse comm split into start/finish for brick comm
+   interior = owned cells minus the planes neighbor procs hold as ghosts
+   swaps of later dims send ghost cells filled by earlier swaps,
+     only the leading swaps which do not read cells written by a
+     preceding swap are sent by start, finish performs the others
+------------------------------------------------------------------------- */
+
+void Grid3d::setup_async_brick()
+{
+  interior[0] = inxlo + ghostxlo;
+  interior[1] = inxhi - ghostxhi;
+  interior[2] = inylo + ghostylo;
+  interior[3] = inyhi - ghostyhi;
+  interior[4] = inzlo + ghostzlo;
+  interior[5] = inzhi - ghostzhi;
+
+  int nfull = (fullxhi-fullxlo+1) * (fullyhi-fullylo+1) * (fullzhi-fullzlo+1);
+  int *written;
+  memory->create(written,nfull,"grid3d:written");
+
+  // forward comm: swap packs owned or ghost cells, unpacks into ghost cells
+
+  int i,m,flag,flagall;
+
+  for (i = 0; i < nfull; i++) written[i] = 0;
+  for (m = 0; m < nswap; m++) {
+    flag = 0;
+    for (i = 0; i < swap[m].npack; i++)
+      if (written[swap[m].packlist[i]]) flag = 1;
+    MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,gridcomm);
+    if (flagall) break;
+    for (i = 0; i < swap[m].nunpack; i++) written[swap[m].unpacklist[i]] = 1;
+  }
+  nforward_async = m;
+
+  // reverse comm: swaps in reverse order, pack ghost cells, sum into packlist cells
+
+  for (i = 0; i < nfull; i++) written[i] = 0;
+  for (m = nswap-1; m >= 0; m--) {
+    flag = 0;
+    for (i = 0; i < swap[m].nunpack; i++)
+      if (written[swap[m].unpacklist[i]]) flag = 1;
+    MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,gridcomm);
+    if (flagall) break;
+    for (i = 0; i < swap[m].npack; i++) written[swap[m].packlist[i]] = 1;
+  }
+  nreverse_async = nswap-1 - m;
+
+  memory->destroy(written);
 }
 
 /* ----------------------------------------------------------------------
@@ -1030,6 +1123,16 @@ void Grid3d::setup_comm_tiled(int &nbuf1, int &nbuf2)
   int nsend_request = 0;
   ncopy = 0;
 
+  // interior starts as all owned cells, boxes sent to other procs
+  //   or copied to myself are cut off below
+
+  interior[0] = inxlo;
+  interior[1] = inxhi;
+  interior[2] = inylo;
+  interior[3] = inyhi;
+  interior[4] = inzlo;
+  interior[5] = inzhi;
+
   for (m = 0; m < noverlap; m++) {
     if (overlap[m].proc == me) {
       if (overlap[m].pbc[0] == 0 && overlap[m].pbc[1] == 0 &&
@@ -1068,6 +1171,7 @@ void Grid3d::setup_comm_tiled(int &nbuf1, int &nbuf2)
     zlo = MAX(rrequest[m].box[4],inzlo);
     zhi = MIN(rrequest[m].box[5],inzhi);
     send[m].npack = indices(send[m].packlist,xlo,xhi,ylo,yhi,zlo,zhi);
+    shrink_interior(xlo,xhi,ylo,yhi,zlo,zhi);
 
     proclist[m] = rrequest[m].sender;
     sresponse[m].index = rrequest[m].index;
@@ -1133,6 +1237,7 @@ void Grid3d::setup_comm_tiled(int &nbuf1, int &nbuf2)
     zlo = overlap[m].box[4];
     zhi = overlap[m].box[5];
     copy[ncopy].npack = indices(copy[ncopy].packlist,xlo,xhi,ylo,yhi,zlo,zhi);
+    shrink_interior(xlo,xhi,ylo,yhi,zlo,zhi);
     xlo = overlap[m].box[0] + overlap[m].pbc[0] * nx;
     xhi = overlap[m].box[1] + overlap[m].pbc[0] * nx;
     ylo = overlap[m].box[2] + overlap[m].pbc[1] * ny;
@@ -1458,6 +1563,423 @@ reverse_comm_tiled(T *ptr, int which, int nper, int nbyte,
   }
 }
 
+// ----------------------------------------------------------------------
+// forward/reverse comm split into start/finish
+// caller can work on owned cells in between, while messages are in flight
+// ----------------------------------------------------------------------
+
+/* ----------------------------------------------------------------------
+   start forward comm of my owned cells to other's ghost cells
+   caller must not change owned cells until forward_comm_finish()
+   ghost cells are valid after forward_comm_finish()
+------------------------------------------------------------------------- */
+
+void Grid3d::forward_comm_start(int caller, void *ptr, int which, int nper, int nbyte,
+                                void * /*buf1*/, void * /*buf2*/, MPI_Datatype datatype)
+{
+  if (async_pending) error->all(FLERR,"Grid3d comm is already started");
+  async_pending = 1;
+
+  if (comm->layout != Comm::LAYOUT_TILED) {
+    if (caller == KSPACE)
+      forward_comm_brick_start<KSpace>((KSpace *) ptr,which,nper,nbyte,datatype);
+    else if (caller == PAIR)
+      forward_comm_brick_start<Pair>((Pair *) ptr,which,nper,nbyte,datatype);
+    else if (caller == FIX)
+      forward_comm_brick_start<Fix>((Fix *) ptr,which,nper,nbyte,datatype);
+  } else {
+    if (caller == KSPACE)
+      forward_comm_tiled_start<KSpace>((KSpace *) ptr,which,nper,nbyte,datatype);
+    else if (caller == PAIR)
+      forward_comm_tiled_start<Pair>((Pair *) ptr,which,nper,nbyte,datatype);
+    else if (caller == FIX)
+      forward_comm_tiled_start<Fix>((Fix *) ptr,which,nper,nbyte,datatype);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   finish forward comm started by forward_comm_start() with same arguments
+------------------------------------------------------------------------- */
+
+void Grid3d::forward_comm_finish(int caller, void *ptr, int which, int nper, int nbyte,
+                                 void *buf1, void *buf2, MPI_Datatype datatype)
+{
+  if (!async_pending) error->all(FLERR,"Grid3d comm is not started");
+  async_pending = 0;
+
+  if (comm->layout != Comm::LAYOUT_TILED) {
+    if (caller == KSPACE)
+      forward_comm_brick_finish<KSpace>((KSpace *) ptr,which,nper,nbyte,
+                                        buf1,buf2,datatype);
+    else if (caller == PAIR)
+      forward_comm_brick_finish<Pair>((Pair *) ptr,which,nper,nbyte,
+                                      buf1,buf2,datatype);
+    else if (caller == FIX)
+      forward_comm_brick_finish<Fix>((Fix *) ptr,which,nper,nbyte,
+                                     buf1,buf2,datatype);
+  } else {
+    if (caller == KSPACE)
+      forward_comm_tiled_finish<KSpace>((KSpace *) ptr,which,nper,nbyte,buf1,datatype);
+    else if (caller == PAIR)
+      forward_comm_tiled_finish<Pair>((Pair *) ptr,which,nper,nbyte,buf1,datatype);
+    else if (caller == FIX)
+      forward_comm_tiled_finish<Fix>((Fix *) ptr,which,nper,nbyte,buf1,datatype);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start forward comm for brick decomp
+   pack and send the leading independent swaps, post their receives
+   swap m uses bytes at offset m of async_buf for its send and recv
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+forward_comm_brick_start(T *ptr, int which, int nper, int nbyte, MPI_Datatype datatype)
+{
+  int m;
+  bigint nbuf = 0;
+
+  for (m = 0; m < nforward_async; m++)
+    nbuf += (bigint) nper * nbyte * (swap[m].npack + swap[m].nunpack);
+  grow_async(nbuf,2*nforward_async);
+
+  // self swaps are unpacked from their send buffer in finish
+
+  bigint offset = 0;
+  nasync_request = 0;
+
+  for (m = 0; m < nforward_async; m++) {
+    char *sbuf = &async_buf[offset];
+    char *rbuf = &async_buf[offset + (bigint) nper * nbyte * swap[m].npack];
+    offset += (bigint) nper * nbyte * (swap[m].npack + swap[m].nunpack);
+
+    ptr->pack_forward_grid(which,sbuf,swap[m].npack,swap[m].packlist);
+    if (swap[m].sendproc == me) continue;
+
+    if (swap[m].nunpack)
+      MPI_Irecv(rbuf,nper*swap[m].nunpack,datatype,swap[m].recvproc,m,
+                gridcomm,&async_requests[nasync_request++]);
+    if (swap[m].npack)
+      MPI_Isend(sbuf,nper*swap[m].npack,datatype,swap[m].sendproc,m,
+                gridcomm,&async_requests[nasync_request++]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   finish forward comm for brick decomp
+   unpack swaps sent by start in order, then perform remaining swaps
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+forward_comm_brick_finish(T *ptr, int which, int nper, int nbyte,
+                          void *buf1, void *buf2, MPI_Datatype datatype)
+{
+  int m;
+  MPI_Request request;
+
+  MPI_Waitall(nasync_request,async_requests,MPI_STATUSES_IGNORE);
+
+  bigint offset = 0;
+  for (m = 0; m < nforward_async; m++) {
+    char *sbuf = &async_buf[offset];
+    char *rbuf = &async_buf[offset + (bigint) nper * nbyte * swap[m].npack];
+    offset += (bigint) nper * nbyte * (swap[m].npack + swap[m].nunpack);
+
+    if (swap[m].sendproc == me)
+      ptr->unpack_forward_grid(which,sbuf,swap[m].nunpack,swap[m].unpacklist);
+    else
+      ptr->unpack_forward_grid(which,rbuf,swap[m].nunpack,swap[m].unpacklist);
+  }
+
+  for (m = nforward_async; m < nswap; m++) {
+    if (swap[m].sendproc == me)
+      ptr->pack_forward_grid(which,buf2,swap[m].npack,swap[m].packlist);
+    else
+      ptr->pack_forward_grid(which,buf1,swap[m].npack,swap[m].packlist);
+
+    if (swap[m].sendproc != me) {
+      if (swap[m].nunpack) MPI_Irecv(buf2,nper*swap[m].nunpack,datatype,
+                                     swap[m].recvproc,0,gridcomm,&request);
+      if (swap[m].npack) MPI_Send(buf1,nper*swap[m].npack,datatype,
+                                  swap[m].sendproc,0,gridcomm);
+      if (swap[m].nunpack) MPI_Wait(&request,MPI_STATUS_IGNORE);
+    }
+
+    ptr->unpack_forward_grid(which,buf2,swap[m].nunpack,swap[m].unpacklist);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start forward comm for tiled decomp
+   post all receives, pack and send to all other procs
+   sends use the front of async_buf, receives follow at their offsets
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+forward_comm_tiled_start(T *ptr, int which, int nper, int nbyte, MPI_Datatype datatype)
+{
+  int m;
+  bigint nsendbuf = 0, nrecvbuf = 0;
+
+  for (m = 0; m < nsend; m++) nsendbuf += send[m].npack;
+  for (m = 0; m < nrecv; m++) nrecvbuf += recv[m].nunpack;
+  nsendbuf *= (bigint) nper * nbyte;
+  nrecvbuf *= (bigint) nper * nbyte;
+  grow_async(nsendbuf+nrecvbuf,nrecv+nsend);
+
+  for (m = 0; m < nrecv; m++)
+    MPI_Irecv(&async_buf[nsendbuf + (bigint) nper * nbyte * recv[m].offset],
+              nper*recv[m].nunpack,datatype,recv[m].proc,0,gridcomm,&async_requests[m]);
+
+  for (m = 0; m < nsend; m++) {
+    char *sbuf = &async_buf[(bigint) nper * nbyte * send[m].offset];
+    ptr->pack_forward_grid(which,sbuf,send[m].npack,send[m].packlist);
+    MPI_Isend(sbuf,nper*send[m].npack,datatype,send[m].proc,0,gridcomm,
+              &async_requests[nrecv+m]);
+  }
+
+  nasync_request = nrecv + nsend;
+}
+
+/* ----------------------------------------------------------------------
+   finish forward comm for tiled decomp
+   perform copies to self, unpack received data, wait on sends
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+forward_comm_tiled_finish(T *ptr, int which, int nper, int nbyte,
+                          void *buf1, MPI_Datatype /*datatype*/)
+{
+  int i,m;
+
+  for (m = 0; m < ncopy; m++) {
+    ptr->pack_forward_grid(which,buf1,copy[m].npack,copy[m].packlist);
+    ptr->unpack_forward_grid(which,buf1,copy[m].nunpack,copy[m].unpacklist);
+  }
+
+  bigint nsendbuf = 0;
+  for (m = 0; m < nsend; m++) nsendbuf += send[m].npack;
+  nsendbuf *= (bigint) nper * nbyte;
+
+  for (i = 0; i < nrecv; i++) {
+    MPI_Waitany(nrecv,async_requests,&m,MPI_STATUS_IGNORE);
+    ptr->unpack_forward_grid(which,&async_buf[nsendbuf + (bigint) nper * nbyte * recv[m].offset],
+                             recv[m].nunpack,recv[m].unpacklist);
+  }
+
+  MPI_Waitall(nsend,&async_requests[nrecv],MPI_STATUSES_IGNORE);
+}
+
+/* ----------------------------------------------------------------------
+   start reverse comm of my ghost cells to sum to owner cells
+   caller must not change ghost cells until reverse_comm_finish()
+   owned cells are fully summed after reverse_comm_finish(),
+     except for interior cells, see get_bounds_interior()
+------------------------------------------------------------------------- */
+
+void Grid3d::reverse_comm_start(int caller, void *ptr, int which, int nper, int nbyte,
+                                void * /*buf1*/, void * /*buf2*/, MPI_Datatype datatype)
+{
+  if (async_pending) error->all(FLERR,"Grid3d comm is already started");
+  async_pending = 1;
+
+  if (comm->layout != Comm::LAYOUT_TILED) {
+    if (caller == KSPACE)
+      reverse_comm_brick_start<KSpace>((KSpace *) ptr,which,nper,nbyte,datatype);
+    else if (caller == PAIR)
+      reverse_comm_brick_start<Pair>((Pair *) ptr,which,nper,nbyte,datatype);
+    else if (caller == FIX)
+      reverse_comm_brick_start<Fix>((Fix *) ptr,which,nper,nbyte,datatype);
+  } else {
+    if (caller == KSPACE)
+      reverse_comm_tiled_start<KSpace>((KSpace *) ptr,which,nper,nbyte,datatype);
+    else if (caller == PAIR)
+      reverse_comm_tiled_start<Pair>((Pair *) ptr,which,nper,nbyte,datatype);
+    else if (caller == FIX)
+      reverse_comm_tiled_start<Fix>((Fix *) ptr,which,nper,nbyte,datatype);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   finish reverse comm started by reverse_comm_start() with same arguments
+------------------------------------------------------------------------- */
+
+void Grid3d::reverse_comm_finish(int caller, void *ptr, int which, int nper, int nbyte,
+                                 void *buf1, void *buf2, MPI_Datatype datatype)
+{
+  if (!async_pending) error->all(FLERR,"Grid3d comm is not started");
+  async_pending = 0;
+
+  if (comm->layout != Comm::LAYOUT_TILED) {
+    if (caller == KSPACE)
+      reverse_comm_brick_finish<KSpace>((KSpace *) ptr,which,nper,nbyte,
+                                        buf1,buf2,datatype);
+    else if (caller == PAIR)
+      reverse_comm_brick_finish<Pair>((Pair *) ptr,which,nper,nbyte,
+                                      buf1,buf2,datatype);
+    else if (caller == FIX)
+      reverse_comm_brick_finish<Fix>((Fix *) ptr,which,nper,nbyte,
+                                     buf1,buf2,datatype);
+  } else {
+    if (caller == KSPACE)
+      reverse_comm_tiled_finish<KSpace>((KSpace *) ptr,which,nper,nbyte,buf1,datatype);
+    else if (caller == PAIR)
+      reverse_comm_tiled_finish<Pair>((Pair *) ptr,which,nper,nbyte,buf1,datatype);
+    else if (caller == FIX)
+      reverse_comm_tiled_finish<Fix>((Fix *) ptr,which,nper,nbyte,buf1,datatype);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start reverse comm for brick decomp
+   pack and send the trailing independent swaps, post their receives
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+reverse_comm_brick_start(T *ptr, int which, int nper, int nbyte, MPI_Datatype datatype)
+{
+  int m;
+  bigint nbuf = 0;
+
+  for (m = nswap-1; m >= nswap-nreverse_async; m--)
+    nbuf += (bigint) nper * nbyte * (swap[m].npack + swap[m].nunpack);
+  grow_async(nbuf,2*nreverse_async);
+
+  // self swaps are unpacked from their send buffer in finish
+
+  bigint offset = 0;
+  nasync_request = 0;
+
+  for (m = nswap-1; m >= nswap-nreverse_async; m--) {
+    char *sbuf = &async_buf[offset];
+    char *rbuf = &async_buf[offset + (bigint) nper * nbyte * swap[m].nunpack];
+    offset += (bigint) nper * nbyte * (swap[m].npack + swap[m].nunpack);
+
+    ptr->pack_reverse_grid(which,sbuf,swap[m].nunpack,swap[m].unpacklist);
+    if (swap[m].recvproc == me) continue;
+
+    if (swap[m].npack)
+      MPI_Irecv(rbuf,nper*swap[m].npack,datatype,swap[m].sendproc,m,
+                gridcomm,&async_requests[nasync_request++]);
+    if (swap[m].nunpack)
+      MPI_Isend(sbuf,nper*swap[m].nunpack,datatype,swap[m].recvproc,m,
+                gridcomm,&async_requests[nasync_request++]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   finish reverse comm for brick decomp
+   unpack swaps sent by start in order, then perform remaining swaps
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+reverse_comm_brick_finish(T *ptr, int which, int nper, int nbyte,
+                          void *buf1, void *buf2, MPI_Datatype datatype)
+{
+  int m;
+  MPI_Request request;
+
+  MPI_Waitall(nasync_request,async_requests,MPI_STATUSES_IGNORE);
+
+  bigint offset = 0;
+  for (m = nswap-1; m >= nswap-nreverse_async; m--) {
+    char *sbuf = &async_buf[offset];
+    char *rbuf = &async_buf[offset + (bigint) nper * nbyte * swap[m].nunpack];
+    offset += (bigint) nper * nbyte * (swap[m].npack + swap[m].nunpack);
+
+    if (swap[m].recvproc == me)
+      ptr->unpack_reverse_grid(which,sbuf,swap[m].npack,swap[m].packlist);
+    else
+      ptr->unpack_reverse_grid(which,rbuf,swap[m].npack,swap[m].packlist);
+  }
+
+  for (m = nswap-1-nreverse_async; m >= 0; m--) {
+    if (swap[m].recvproc == me)
+      ptr->pack_reverse_grid(which,buf2,swap[m].nunpack,swap[m].unpacklist);
+    else
+      ptr->pack_reverse_grid(which,buf1,swap[m].nunpack,swap[m].unpacklist);
+
+    if (swap[m].recvproc != me) {
+      if (swap[m].npack) MPI_Irecv(buf2,nper*swap[m].npack,datatype,
+                                   swap[m].sendproc,0,gridcomm,&request);
+      if (swap[m].nunpack) MPI_Send(buf1,nper*swap[m].nunpack,datatype,
+                                     swap[m].recvproc,0,gridcomm);
+      if (swap[m].npack) MPI_Wait(&request,MPI_STATUS_IGNORE);
+    }
+
+    ptr->unpack_reverse_grid(which,buf2,swap[m].npack,swap[m].packlist);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start reverse comm for tiled decomp
+   post all receives, pack and send to all other procs
+   sends use the front of async_buf, receives follow at their offsets
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+reverse_comm_tiled_start(T *ptr, int which, int nper, int nbyte, MPI_Datatype datatype)
+{
+  int m;
+  bigint nsendbuf = 0, nrecvbuf = 0;
+
+  for (m = 0; m < nrecv; m++) nsendbuf += recv[m].nunpack;
+  for (m = 0; m < nsend; m++) nrecvbuf += send[m].npack;
+  nsendbuf *= (bigint) nper * nbyte;
+  nrecvbuf *= (bigint) nper * nbyte;
+  grow_async(nsendbuf+nrecvbuf,nsend+nrecv);
+
+  for (m = 0; m < nsend; m++)
+    MPI_Irecv(&async_buf[nsendbuf + (bigint) nper * nbyte * send[m].offset],
+              nper*send[m].npack,datatype,send[m].proc,0,gridcomm,&async_requests[m]);
+
+  for (m = 0; m < nrecv; m++) {
+    char *sbuf = &async_buf[(bigint) nper * nbyte * recv[m].offset];
+    ptr->pack_reverse_grid(which,sbuf,recv[m].nunpack,recv[m].unpacklist);
+    MPI_Isend(sbuf,nper*recv[m].nunpack,datatype,recv[m].proc,0,gridcomm,
+              &async_requests[nsend+m]);
+  }
+
+  nasync_request = nsend + nrecv;
+}
+
+/* ----------------------------------------------------------------------
+   finish reverse comm for tiled decomp
+   perform copies to self, unpack received data, wait on sends
+------------------------------------------------------------------------- */
+
+template < class T >
+void Grid3d::
+reverse_comm_tiled_finish(T *ptr, int which, int nper, int nbyte,
+                          void *buf1, MPI_Datatype /*datatype*/)
+{
+  int i,m;
+
+  for (m = 0; m < ncopy; m++) {
+    ptr->pack_reverse_grid(which,buf1,copy[m].nunpack,copy[m].unpacklist);
+    ptr->unpack_reverse_grid(which,buf1,copy[m].npack,copy[m].packlist);
+  }
+
+  bigint nsendbuf = 0;
+  for (m = 0; m < nrecv; m++) nsendbuf += recv[m].nunpack;
+  nsendbuf *= (bigint) nper * nbyte;
+
+  for (i = 0; i < nsend; i++) {
+    MPI_Waitany(nsend,async_requests,&m,MPI_STATUS_IGNORE);
+    ptr->unpack_reverse_grid(which,&async_buf[nsendbuf + (bigint) nper * nbyte * send[m].offset],
+                             send[m].npack,send[m].packlist);
+  }
+
+  MPI_Waitall(nrecv,&async_requests[nsend],MPI_STATUSES_IGNORE);
+}
+
 // ----------------------------------------------------------------------
 // remap comm between 2 old/new grid decomposition of owned grid data
 // ----------------------------------------------------------------------
@@ -2028,6 +2550,61 @@ void Grid3d::grow_swap()
   swap = (Swap *) memory->srealloc(swap,maxswap*sizeof(Swap),"grid3d:swap");
 }
 
+/* ----------------------------------------------------------------------
+   cut box of owned cells which reverse comm sums into from the interior
+   the face of the interior which cuts off the least is moved
+------------------------------------------------------------------------- */
+
+void Grid3d::shrink_interior(int xlo, int xhi, int ylo, int yhi, int zlo, int zhi)
+{
+  const int box[6] = {xlo, xhi, ylo, yhi, zlo, zhi};
+
+  // nothing to do if box and interior do not overlap
+
+  for (int d = 0; d < 3; d++)
+    if (box[2*d] > box[2*d+1] || box[2*d] > interior[2*d+1] ||
+        box[2*d+1] < interior[2*d]) return;
+
+  int dmin = 0, side = 0;
+  int cutmin = MAXSMALLINT;
+  for (int d = 0; d < 3; d++) {
+    int cutlo = box[2*d+1] - interior[2*d] + 1;
+    int cuthi = interior[2*d+1] - box[2*d] + 1;
+    if (cutlo < cutmin) {
+      cutmin = cutlo;
+      dmin = d;
+      side = 0;
+    }
+    if (cuthi < cutmin) {
+      cutmin = cuthi;
+      dmin = d;
+      side = 1;
+    }
+  }
+
+  if (side == 0) interior[2*dmin] = box[2*dmin+1] + 1;
+  else interior[2*dmin+1] = box[2*dmin] - 1;
+}
+
+/* ----------------------------------------------------------------------
+   grow buffer and requests of split comm
+   nbytes = size of buffer in bytes, nrequest = # of requests
+------------------------------------------------------------------------- */
+
+void Grid3d::grow_async(bigint nbytes, int nrequest)
+{
+  if (nbytes > maxasync_buf) {
+    maxasync_buf = nbytes;
+    memory->sfree(async_buf);
+    async_buf = (char *) memory->smalloc(maxasync_buf,"grid3d:async_buf");
+  }
+  if (nrequest > maxasync_request) {
+    maxasync_request = nrequest;
+    delete [] async_requests;
+    async_requests = new MPI_Request[maxasync_request];
+  }
+}
+
 /* ----------------------------------------------------------------------
    grow list of overlaps by DELTA
 ------------------------------------------------------------------------- */
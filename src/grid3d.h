@@ -40,6 +40,7 @@ class Grid3d : protected Pointers {
   void get_size(int &, int &, int &);
   void get_bounds_owned(int &, int &, int &, int &, int &, int &);
   void get_bounds_ghost(int &, int &, int &, int &, int &, int &);
+  void get_bounds_interior(int &, int &, int &, int &, int &, int &);
 
   void setup_grid(int &, int &, int &, int &, int &, int &, int &, int &, int &, int &, int &,
                   int &);
@@ -48,6 +49,10 @@ class Grid3d : protected Pointers {
   int ghost_adjacent();
   void forward_comm(int, void *, int, int, int, void *, void *, MPI_Datatype);
   void reverse_comm(int, void *, int, int, int, void *, void *, MPI_Datatype);
+  void forward_comm_start(int, void *, int, int, int, void *, void *, MPI_Datatype);
+  void forward_comm_finish(int, void *, int, int, int, void *, void *, MPI_Datatype);
+  void reverse_comm_start(int, void *, int, int, int, void *, void *, MPI_Datatype);
+  void reverse_comm_finish(int, void *, int, int, int, void *, void *, MPI_Datatype);
 
   void setup_remap(Grid3d *, int &, int &);
   void remap(int, void *, int, int, int, void *, void *, MPI_Datatype);
@@ -87,6 +92,20 @@ class Grid3d : protected Pointers {
   int fullylo, fullyhi;    //   can be same as out indices or larger
   int fullzlo, fullzhi;
 
+  // -------------------------------------------
+  // internal variables for comm split into start/finish
+  // -------------------------------------------
+
+  int interior[6];               // extent of my owned cells reverse comm does not sum into
+                                 //   lo > hi if there are none
+  int nforward_async;            // # of leading brick swaps which do not depend on each other
+  int nreverse_async;            //   for forward and reverse comm, sent by start
+  int async_pending;             // 1 between start and finish of a comm
+  int nasync_request, maxasync_request;
+  MPI_Request *async_requests;    // recv requests first, then send requests
+  char *async_buf;                // send and recv buffer of a split comm
+  bigint maxasync_buf;
+
   // -------------------------------------------
   // internal variables for BRICK layout
   // -------------------------------------------
@@ -246,6 +265,18 @@ class Grid3d : protected Pointers {
   template <class T> void reverse_comm_brick(T *, int, int, int, void *, void *, MPI_Datatype);
   template <class T> void reverse_comm_tiled(T *, int, int, int, void *, void *, MPI_Datatype);
 
+  void setup_async_brick();
+  void shrink_interior(int, int, int, int, int, int);
+  void grow_async(bigint, int);
+  template <class T> void forward_comm_brick_start(T *, int, int, int, MPI_Datatype);
+  template <class T> void forward_comm_brick_finish(T *, int, int, int, void *, void *, MPI_Datatype);
+  template <class T> void forward_comm_tiled_start(T *, int, int, int, MPI_Datatype);
+  template <class T> void forward_comm_tiled_finish(T *, int, int, int, void *, MPI_Datatype);
+  template <class T> void reverse_comm_brick_start(T *, int, int, int, MPI_Datatype);
+  template <class T> void reverse_comm_brick_finish(T *, int, int, int, void *, void *, MPI_Datatype);
+  template <class T> void reverse_comm_tiled_start(T *, int, int, int, MPI_Datatype);
+  template <class T> void reverse_comm_tiled_finish(T *, int, int, int, void *, MPI_Datatype);
+
   template <class T> void remap_style(T *, int, int, int, void *, void *, MPI_Datatype);
 
   template <class T> void read_file_style(T *, FILE *, int, int);
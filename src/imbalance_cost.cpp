@@ -0,0 +1,160 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "imbalance_cost.h"
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "pair.h"
+#include "timer.h"
+
+using namespace LAMMPS_NS;
+
+static constexpr double BIG = 1.0e20;
+static constexpr double MINCOST = 0.01;    // min atom cost as fraction of average atom cost
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCost::ImbalanceCost(LAMMPS *lmp) : Imbalance(lmp), last(0.0), index(-1) {}
+
+/* ----------------------------------------------------------------------
+   stop cost measurement in pair style, so later runs use the regular path
+------------------------------------------------------------------------- */
+
+ImbalanceCost::~ImbalanceCost()
+{
+  if (force->pair) force->pair->costflag = 0;
+}
+
+/* -------------------------------------------------------------------- */
+
+int ImbalanceCost::options(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR, "Illegal balance weight command");
+  factor = utils::numeric(FLERR, arg[0], false, lmp);
+  if (factor <= 0.0) error->all(FLERR, "Illegal balance weight command");
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   create per-atom cost vector and enable cost measurement in pair style
+     when called from FixBalance
+------------------------------------------------------------------------- */
+
+void ImbalanceCost::init(int flag)
+{
+  if (!force->pair) error->all(FLERR, "Balance weight cost requires a pair style");
+
+  // only FixBalance measures the cost during the following run
+  // Balance uses the cost measured in the last run and must not enable measurement
+
+  force->pair->costflag = flag ? 1 : 0;
+
+  int dflag, cols;
+  index = atom->find_custom("balance_cost", dflag, cols);
+  if (index < 0) {
+    index = atom->add_custom("balance_cost", 1, 0);
+    flag = 1;
+  } else if ((dflag != 1) || cols)
+    error->all(FLERR, "Per-atom property balance_cost must be a floating point vector");
+
+  last = 0.0;
+
+  // flag = 1 if called from FixBalance at start of run
+  //   init Timer and clear per-atom cost, so nothing is carried over from previous run
+  // should NOT do this if called from Balance, it uses cost from last run
+
+  if (flag) {
+    timer->init();
+    double *cost = atom->dvector[index];
+    int nlocal = atom->nlocal;
+    for (int i = 0; i < nlocal; i++) cost[i] = 0.0;
+  }
+}
+
+/* -------------------------------------------------------------------- */
+
+void ImbalanceCost::compute(double *weight)
+{
+  if (index < 0) return;
+
+  // other = neigh, bond, kspace time since last invocation, shared evenly by all owned atoms
+  // pair time is measured per atom and accumulated in cost vector
+
+  double *cost = atom->dvector[index];
+  int nlocal = atom->nlocal;
+
+  double other = 0.0;
+  if (timer->has_normal()) {
+    other = timer->get_wall(Timer::NEIGH);
+    other += timer->get_wall(Timer::BOND);
+    other += timer->get_wall(Timer::KSPACE);
+    other -= last;
+    last += other;
+  }
+
+  double mycost = other;
+  for (int i = 0; i < nlocal; i++) mycost += cost[i];
+
+  double totalcost;
+  MPI_Allreduce(&mycost, &totalcost, 1, MPI_DOUBLE, MPI_SUM, world);
+  if (totalcost <= 0.0) return;
+
+  // atoms without measured cost, e.g. newly created atoms,
+  // get a small minimum weight to avoid a zero weight
+
+  double share = 0.0;
+  if (nlocal) share = other / nlocal;
+  double mincost = MINCOST * totalcost / atom->natoms;
+
+  double wt, wtlo = BIG, wthi = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    wt = MAX(cost[i] + share, mincost);
+    cost[i] = wt;
+    wtlo = MIN(wtlo, wt);
+    wthi = MAX(wthi, wt);
+  }
+
+  // apply factor if specified != 1.0
+  // wtlo,wthi = lo/hi values of per-atom cost across all procs
+  // lo value does not change
+  // newhi = new hi value to give hi/lo ratio factor times larger/smaller
+  // expand/contract all per-atom costs from lo->hi to lo->newhi
+
+  if (factor != 1.0) {
+    double tmp = wtlo;
+    MPI_Allreduce(&tmp, &wtlo, 1, MPI_DOUBLE, MPI_MIN, world);
+    tmp = wthi;
+    MPI_Allreduce(&tmp, &wthi, 1, MPI_DOUBLE, MPI_MAX, world);
+    if (wtlo < wthi) {
+      double newhi = wthi * factor;
+      for (int i = 0; i < nlocal; i++)
+        cost[i] = wtlo + ((cost[i] - wtlo) / (wthi - wtlo)) * (newhi - wtlo);
+    }
+  }
+
+  // apply weights and restart accumulation of per-atom cost
+
+  for (int i = 0; i < nlocal; i++) {
+    weight[i] *= cost[i];
+    cost[i] = 0.0;
+  }
+}
+
+/* -------------------------------------------------------------------- */
+
+std::string ImbalanceCost::info()
+{
+  return fmt::format("  cost weight factor: {}\n", factor);
+}
@@ -0,0 +1,44 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_IMBALANCE_COST_H
+#define LMP_IMBALANCE_COST_H
+
+#include "imbalance.h"
+
+namespace LAMMPS_NS {
+
+class ImbalanceCost : public Imbalance {
+ public:
+  ImbalanceCost(class LAMMPS *);
+  ~ImbalanceCost() override;
+
+ public:
+  // parse options, return number of arguments consumed
+  int options(int, char **) override;
+  // reinitialize internal data
+  void init(int) override;
+  // compute and apply weight factors to local atom array
+  void compute(double *) override;
+  // print information about the state of this imbalance compute
+  std::string info() override;
+
+ private:
+  double factor;    // weight factor for cost imbalance
+  double last;      // combined neigh, bond, kspace wall time from last call
+  int index;        // index of per-atom cost vector in Atom class
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
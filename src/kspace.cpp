@@ -20,6 +20,8 @@
 #include "domain.h"
 #include "error.h"
 #include "force.h"
+#include "group.h"
+#include "lmpfftsettings.h"
 #include "memory.h"
 #include "pair.h"
 #include "suffix.h"
@@ -44,6 +46,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
     dipoleflag = spinflag = 0;
   compute_flag = 1;
   group_group_enable = 0;
+  frozen_support = 0;
   stagger_flag = 0;
 
   order = 5;
@@ -60,8 +63,12 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
 #else
   collective_flag = 0;
 #endif
+  realfft_flag = 1;
+  remap_precision = FFT_PRECISION;
+  npy_fft = npz_fft = 0;
 
   kewaldflag = 0;
+  frozen_groupbit = 0;
 
   order_6 = 5;
   gridflag_6 = 0;
@@ -547,7 +554,28 @@ void KSpace::modify_params(int narg, char **arg)
       iarg += 2;
     } else if (strcmp(arg[iarg],"collective") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
-      collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (strcmp(arg[iarg+1],"node") == 0) collective_flag = 2;
+      else collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/real") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      realfft_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/grid") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      npy_fft = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      npz_fft = utils::inumeric(FLERR,arg[iarg+2],false,lmp);
+      if (npy_fft < 0 || npz_fft < 0)
+        error->all(FLERR,"Bad kspace_modify fft/grid parameter");
+      if (npy_fft == 0 || npz_fft == 0) npy_fft = npz_fft = 0;
+      else if (npy_fft*npz_fft != comm->nprocs)
+        error->all(FLERR,"Kspace_modify fft/grid {}x{} does not match {} MPI processes",
+                   npy_fft,npz_fft,comm->nprocs);
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"remap/compress") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (utils::logical(FLERR,arg[iarg+1],false,lmp)) remap_precision = 1;
+      else remap_precision = FFT_PRECISION;
       iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
@@ -571,6 +599,19 @@ void KSpace::modify_params(int narg, char **arg)
       else
         kewaldflag = 0;
       iarg += 4;
+    } else if (strcmp(arg[iarg],"frozen/ewald") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (!frozen_support)
+        error->all(FLERR,"Kspace style {} does not support kspace_modify frozen/ewald",
+                   force->kspace_style);
+      if (strcmp(arg[iarg+1],"none") == 0) frozen_groupbit = 0;
+      else {
+        int igroup = group->find(arg[iarg+1]);
+        if (igroup < 0)
+          error->all(FLERR,"Could not find kspace_modify frozen/ewald group ID {}",arg[iarg+1]);
+        frozen_groupbit = group->bitmask[igroup];
+      }
+      iarg += 2;
     } else if (strcmp(arg[iarg],"mix/disp") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"pair") == 0) mixflag = 0;
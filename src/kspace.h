@@ -73,6 +73,7 @@ class KSpace : protected Pointers {
   int nx_msm_max, ny_msm_max, nz_msm_max;
 
   int group_group_enable;    // 1 if style supports group/group calculation
+  int frozen_support;        // 1 if style supports kspace_modify frozen/ewald
 
   int centroidstressflag;    // centroid stress compared to two-body stress
                              // CENTROID_SAME = same as two-body stress
@@ -87,7 +88,10 @@ class KSpace : protected Pointers {
 
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
-  int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  int collective_flag;    // 1 if use MPI collectives for FFT/remap, 2 if node-aware
+  int realfft_flag;       // 1 if use real-to-complex FFTs when supported
+  int remap_precision;    // 1/2 = single/double precision of FFT remap messages
+  int npy_fft, npz_fft;   // user-set 2d proc grid of FFT pencils, 0 = automatic
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -194,6 +198,7 @@ class KSpace : protected Pointers {
 
   int kewaldflag;                      // 1 if kspace range set for Ewald sum
   int kx_ewald, ky_ewald, kz_ewald;    // kspace settings for Ewald sum
+  int frozen_groupbit;                 // group whose Ewald structure factor is reused
 
   void pair_check();
   void ev_init(int eflag, int vflag, int alloc = 1)
@@ -0,0 +1,31 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_BINARY_DATA_H
+#define LMP_BINARY_DATA_H
+
+// binary data file written by write_data and read by read_data
+//   magic string, int endian flag, int format revision,
+//     int64 byte offset of text part, then column data, then text part
+// text part is a text data file with a 1-line descriptor in place of
+//   the lines of each per-atom section stored as columns:
+//   # of rows, byte offset of 1st column, one char per column
+//   'i' = 64-bit integer, 'f' = 64-bit floating point
+// each column holds the values of all rows in a contiguous block
+
+#define DATA_MAGIC_STRING "LAMMPS binary data file\n"
+#define DATA_ENDIAN 0x00000001
+#define DATA_ENDIANSWAP 0x01000000
+#define DATA_FORMAT_REVISION 1
+
+#endif
@@ -289,6 +289,7 @@ void Min::setup(int flag)
 
   force->setup();
   ev_set(update->ntimestep);
+  if (atom->soaflag) atom->soa_pack();
   force_clear();
   modify->setup_pre_force(vflag);
 
@@ -310,6 +311,7 @@ void Min::setup(int flag)
 
   modify->setup_pre_reverse(eflag,vflag);
   if (force->newton) comm->reverse_comm();
+  atom->soa_valid = 0;
 
   // update per-atom minimization variables stored by pair styles
 
@@ -371,6 +373,7 @@ void Min::setup_minimal(int flag)
   // compute all forces
 
   ev_set(update->ntimestep);
+  if (atom->soaflag) atom->soa_pack();
   force_clear();
   modify->setup_pre_force(vflag);
 
@@ -392,6 +395,7 @@ void Min::setup_minimal(int flag)
 
   modify->setup_pre_reverse(eflag,vflag);
   if (force->newton) comm->reverse_comm();
+  atom->soa_valid = 0;
 
   // update per-atom minimization variables stored by pair styles
 
@@ -535,6 +539,7 @@ double Min::energy_force(int resetflag)
   }
 
   ev_set(update->ntimestep);
+  if (atom->soaflag) atom->soa_pack();
   force_clear();
 
   timer->stamp();
@@ -571,6 +576,7 @@ double Min::energy_force(int resetflag)
     comm->reverse_comm();
     timer->stamp(Timer::COMM);
   }
+  atom->soa_valid = 0;
 
   // update per-atom minimization variables stored by pair styles
 
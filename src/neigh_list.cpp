@@ -50,6 +50,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   copy = 0;
   trim = 0;
   copymode = 0;
+  cluster = 0;
 
   // ptrs
 
@@ -79,6 +80,24 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   ipage_inner = nullptr;
   ipage_middle = nullptr;
 
+  // cluster-pair lists
+
+  nclus = cinum = 0;
+  clatom = nullptr;
+  cilist = nullptr;
+  cnumneigh = nullptr;
+  cfirstneigh = nullptr;
+  cmaskwords = 0;
+  maxclus = 0;
+  cpage = nullptr;
+
+  // interior/border split
+
+  ninterior = 0;
+  ilist_split = nullptr;
+  maxsplit = 0;
+  splitstamp = -1;
+
   // Kokkos package
 
   kokkos = 0;
@@ -120,6 +139,16 @@ NeighList::~NeighList()
     delete [] ipage_middle;
   }
 
+  if (cluster) {
+    memory->destroy(clatom);
+    memory->destroy(cilist);
+    memory->destroy(cnumneigh);
+    memory->sfree(cfirstneigh);
+    delete [] cpage;
+  }
+
+  memory->destroy(ilist_split);
+
   delete [] iskip;
   memory->destroy(ijskip);
 }
@@ -149,6 +178,8 @@ void NeighList::post_constructor(NeighRequest *nq)
   trim = nq->trim;
   id = nq->id;
   molskip = nq->molskip;
+  cluster = nq->cluster;
+  if (cluster) cmaskwords = (cluster*cluster + 31) / 32;
 
   if (nq->copy) {
     listcopy = neighbor->lists[nq->copylist];
@@ -199,6 +230,15 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
     for (int i = 0; i < nmypage; i++)
       ipage_middle[i].init(oneatom,pgsize,PGDELTA);
   }
+
+  // each J cluster entry is one index plus cmaskwords mask ints
+
+  if (cluster) {
+    int stride = 1 + cmaskwords;
+    cpage = new MyPage<int>[nmypage];
+    for (int i = 0; i < nmypage; i++)
+      cpage[i].init(oneatom*stride,pgsize*stride,PGDELTA);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -251,6 +291,72 @@ void NeighList::grow(int nlocal, int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   grow per-cluster data to allow for n clusters
+   called by cluster-pair NPair classes once the # of clusters is known
+------------------------------------------------------------------------- */
+
+void NeighList::grow_cluster(int n)
+{
+  if (n <= maxclus) return;
+  maxclus = n;
+
+  memory->destroy(clatom);
+  memory->destroy(cilist);
+  memory->destroy(cnumneigh);
+  memory->sfree(cfirstneigh);
+  memory->create(clatom,maxclus*cluster,"neighlist:clatom");
+  memory->create(cilist,maxclus,"neighlist:cilist");
+  memory->create(cnumneigh,maxclus,"neighlist:cnumneigh");
+  cfirstneigh = (int **) memory->smalloc(maxclus*sizeof(int *),
+                                         "neighlist:cfirstneigh");
+}
+
+/* ----------------------------------------------------------------------
+   reorder ilist into ilist_split, interior atoms first, then border atoms
+   interior atom = all its neighbors are owned atoms, so its interactions
+     can be computed before ghost atom coords are updated
+   order within each group is the same as in ilist
+------------------------------------------------------------------------- */
+
+void NeighList::split_interior()
+{
+  if (inum > maxsplit) {
+    maxsplit = atom->nmax;
+    if (inum > maxsplit) maxsplit = inum;
+    memory->destroy(ilist_split);
+    memory->create(ilist_split,maxsplit,"neighlist:ilist_split");
+  }
+
+  const int nlocal = atom->nlocal;
+  int i,j,ii,jj,jnum,nborder;
+  int *jlist;
+
+  ninterior = 0;
+  nborder = 0;
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj] & NEIGHMASK;
+      if (j >= nlocal) break;
+    }
+    if (jj == jnum) ilist_split[ninterior++] = i;
+    else ilist_split[inum - (++nborder)] = i;
+  }
+
+  // border atoms were stored from the end, reverse them into ilist order
+
+  for (ii = 0; ii < nborder/2; ii++) {
+    i = ilist_split[ninterior + ii];
+    ilist_split[ninterior + ii] = ilist_split[inum - 1 - ii];
+    ilist_split[inum - 1 - ii] = i;
+  }
+
+  splitstamp = neighbor->ncalls;
+}
+
 /* ----------------------------------------------------------------------
    print attributes of this list and associated request
 ------------------------------------------------------------------------- */
@@ -288,6 +394,7 @@ void NeighList::print_attributes()
   printf("  %d = kokkos host\n",rq->kokkos_host);
   printf("  %d = kokkos device\n",rq->kokkos_device);
   printf("  %d = ssa flag\n",ssa);
+  printf("  %d = cluster\n",cluster);
   printf("\n");
   printf("  %d = skip flag\n",rq->skip);
   printf("  %d = off2on\n",rq->off2on);
@@ -338,5 +445,18 @@ double NeighList::memory_usage()
     }
   }
 
+  bytes += memory->usage(ilist_split,maxsplit);
+
+  if (cluster) {
+    bytes += memory->usage(clatom,maxclus*cluster);
+    bytes += memory->usage(cilist,maxclus);
+    bytes += memory->usage(cnumneigh,maxclus);
+    bytes += (double)maxclus * sizeof(int *);
+    if (cpage) {
+      for (int i = 0; i < nmypage; i++)
+        bytes += cpage[i].size();
+    }
+  }
+
   return bytes;
 }
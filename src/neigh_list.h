@@ -47,6 +47,7 @@ class NeighList : protected Pointers {
   int copymode;       // 1 if this is a Kokkos on-device copy
   int id;             // copied from neighbor list request
   int molskip;        // 1/2 if this is an intra-/inter-molecular skip list
+  int cluster;        // # of atoms per cluster if a cluster-pair list, else 0
 
   // data structs to store neighbor pairs I,J and associated values
 
@@ -78,6 +79,30 @@ class NeighList : protected Pointers {
   MyPage<int> *ipage_inner;     // pages of neighbor indices for inner
   MyPage<int> *ipage_middle;    // pages of neighbor indices for middle
 
+  // data structs to store cluster-pair lists
+  // each cluster holds up to cluster owned or ghost atoms, padded with -1
+  // each J entry is a J cluster index followed by cmaskwords ints
+  //   of interaction mask bits, bit (I*cluster + J) set if pair I,J interacts
+  // special pairs are not in masks, they are stored in ilist/firstneigh
+
+  int nclus;             // # of clusters of owned and ghost atoms
+  int cinum;             // # of I clusters neighbors are stored for
+  int *clatom;           // atom indices of each cluster, nclus*cluster
+  int *cilist;           // indices of I clusters
+  int *cnumneigh;        // # of J cluster entries for each I cluster
+  int **cfirstneigh;     // ptr to 1st J cluster entry of each I cluster
+  int cmaskwords;        // # of ints of interaction mask per J entry
+  int maxclus;           // size of allocated per-cluster arrays
+  MyPage<int> *cpage;    // pages of J cluster entries
+
+  // interior/border split of ilist for overlapping comm with computation
+  // interior atoms have only owned neighbors, border atoms have a ghost one
+
+  int ninterior;          // # of interior atoms at start of ilist_split
+  int *ilist_split;       // ilist reordered into interior then border atoms
+  int maxsplit;           // size of ilist_split
+  bigint splitstamp;      // neighbor build count when split was done
+
   // atom types to skip when building list
   // copied info from corresponding request into realloced vec/array
 
@@ -108,6 +133,8 @@ class NeighList : protected Pointers {
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);    // setup page data structures
   void grow(int, int);           // grow all data structs
+  void grow_cluster(int);        // grow cluster-pair data structs
+  void split_interior();         // split ilist into interior and border atoms
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
   double memory_usage();
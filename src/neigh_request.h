@@ -83,6 +83,7 @@ class NeighRequest : protected Pointers {
   int kokkos_host;     // set by KOKKOS package
   int kokkos_device;
   int ssa;          // set by DPD-REACT package, for Shardlow lists
+  int cluster;      // # of atoms per cluster for a cluster-pair list, 0 if not
   int cut;          // 1 if use a non-standard cutoff length
   double cutoff;    // special cutoff distance for this list
 
@@ -142,6 +143,7 @@ class NeighRequest : protected Pointers {
   void set_kokkos_host(int);
   void set_skip(int *, int **);
   void set_molskip(int);
+  void set_cluster(int);
   void enable_full();
   void enable_ghost();
   void enable_intel();
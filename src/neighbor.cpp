@@ -48,6 +48,7 @@
 #include "style_nstencil.h"  // IWYU pragma: keep
 #include "style_ntopo.h"  // IWYU pragma: keep
 #include "suffix.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "update.h"
 
@@ -138,6 +139,14 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   cluster_check = 0;
   ago = -1;
 
+  skin_user = -1.0;
+  tuneflag = 0;
+  tunewindow = 1000;
+  tunelo = 0.5;
+  tunehi = 1.5;
+  tuneactive = tunedone = 0;
+  itune = -1;
+
   cutneighmax = 0.0;
   cutneighsq = nullptr;
   cutneighghostsq = nullptr;
@@ -322,6 +331,38 @@ void Neighbor::init()
   if (pgsize < 10*oneatom)
     error->all(FLERR,"Neighbor page size must be >= 10x the one atom setting");
 
+  // skin tuning restarts from the user skin unless a skin was already selected
+  // trial skins larger than the user skin would invalidate ghost grids
+  //   which KSpace, grid-based pair styles and per-grid fixes size for it once
+
+  tuneactive = 0;
+  if (tuneflag && !tunedone && update->whichflag == 1) {
+    if (dist_check == 0) error->all(FLERR,"Neigh_modify tune requires check yes");
+    if (build_once) error->all(FLERR,"Neigh_modify tune is incompatible with once yes");
+    if (lmp->kokkos || modify->get_fix_by_id("package_gpu") || modify->get_fix_by_id("package_intel"))
+      error->all(FLERR,"Neigh_modify tune is not supported with accelerator packages");
+
+    tuneactive = 1;
+    if (skin_user < 0.0) skin_user = skin;
+    else skin = skin_user;
+    int gridflag = 0;
+    if (force->kspace || force->pair_match("^amoeba",0) || force->pair_match("^hippo",0))
+      gridflag = 1;
+    for (const auto &ifix : modify->get_fix_list())
+      if (ifix->pergrid_flag) gridflag = 1;
+    double lo = tunelo;
+    double hi = tunehi;
+    if (gridflag) {
+      lo = MIN(lo,1.0);
+      hi = MIN(hi,1.0);
+    }
+    for (i = 0; i < NTUNE; i++) {
+      tuneskin[i] = skin_user * (lo + (hi-lo)*i/(NTUNE-1));
+      tuneint[i] = MAXBIGINT;
+    }
+    itune = -1;
+  }
+
   // ------------------------------------------------------------------
   // settings
 
@@ -335,168 +376,7 @@ void Neighbor::init()
     bboxhi = domain->boxhi_bound;
   }
 
-  // set neighbor cutoffs (force cutoff + skin)
-  // trigger determines when atoms migrate and neighbor lists are rebuilt
-  //   needs to be non-zero for migration distance check
-  //   even if pair = nullptr and no neighbor lists are used
-  // cutneigh = force cutoff + skin if cutforce > 0, else cutneigh = 0
-  // cutneighghost = pair cutghost if it requests it, else same as cutneigh
-
-  triggersq = 0.25*skin*skin;
-  boxcheck = 0;
-  if (domain->box_change && (domain->xperiodic || domain->yperiodic ||
-                             (dimension == 3 && domain->zperiodic)))
-      boxcheck = 1;
-
-  n = atom->ntypes;
-  if (cutneighsq == nullptr) {
-    if (lmp->kokkos) init_cutneighsq_kokkos(n);
-    else memory->create(cutneighsq,n+1,n+1,"neigh:cutneighsq");
-    memory->create(cutneighghostsq,n+1,n+1,"neigh:cutneighghostsq");
-    cuttype = new double[n+1];
-    cuttypesq = new double[n+1];
-  }
-
-  double cutoff,delta,cut;
-  cutneighmin = BIG;
-  cutneighmax = 0.0;
-
-  for (i = 1; i <= n; i++) {
-    cuttype[i] = cuttypesq[i] = 0.0;
-    for (j = 1; j <= n; j++) {
-      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
-      else cutoff = 0.0;
-      if (cutoff > 0.0) delta = skin;
-      else delta = 0.0;
-      cut = cutoff + delta;
-
-      cutneighsq[i][j] = cut*cut;
-      cuttype[i] = MAX(cuttype[i],cut);
-      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
-      cutneighmin = MIN(cutneighmin,cut);
-      cutneighmax = MAX(cutneighmax,cut);
-
-      if (force->pair && force->pair->ghostneigh) {
-        cut = force->pair->cutghost[i][j] + skin;
-        cutneighghostsq[i][j] = cut*cut;
-      } else cutneighghostsq[i][j] = cut*cut;
-    }
-  }
-  cutneighmaxsq = cutneighmax * cutneighmax;
-
-  // Define cutoffs for multi
-  if (style == Neighbor::MULTI) {
-    int icollection, jcollection;
-
-    // If collections not yet defined, create default map using types
-    if (!custom_collection_flag) {
-      ncollections = n;
-      interval_collection_flag = 0;
-      if (!type2collection)
-        memory->create(type2collection,n+1,"neigh:type2collection");
-      for (i = 1; i <= n; i++)
-        type2collection[i] = i-1;
-    }
-
-    memory->grow(cutcollectionsq, ncollections, ncollections, "neigh:cutcollectionsq");
-
-    // 3 possible ways of defining collections
-    // 1) Types are used to define collections
-    //    Each collection loops through its owned types, and uses cutneighsq to calculate its cutoff
-    // 2) Collections are defined by intervals, point particles
-    //    Types are first sorted into collections based on cutneighsq[i][i]
-    //    Each collection loops through its owned types, and uses cutneighsq to calculate its cutoff
-    // 3) Collections are defined by intervals, finite particles
-    //
-
-    // Define collection cutoffs
-    for (i = 0; i < ncollections; i++)
-      for (j = 0; j < ncollections; j++)
-        cutcollectionsq[i][j] = 0.0;
-
-    if (!interval_collection_flag) {
-      finite_cut_flag = 0;
-      for (i = 1; i <= n; i++){
-        icollection = type2collection[i];
-        for (j = 1; j <= n; j++){
-          jcollection = type2collection[j];
-          if (cutneighsq[i][j] > cutcollectionsq[icollection][jcollection]) {
-            cutcollectionsq[icollection][jcollection] = cutneighsq[i][j];
-            cutcollectionsq[jcollection][icollection] = cutneighsq[i][j];
-          }
-        }
-      }
-    } else {
-      if (!force->pair)
-        error->all(FLERR, "Cannot use collection/interval command without defining a pairstyle");
-
-      if (force->pair->finitecutflag) {
-        finite_cut_flag = 1;
-        // If cutoffs depend on finite atom sizes, use radii of intervals to find cutoffs
-        double ri, rj, tmp;
-        for (i = 0; i < ncollections; i++){
-          ri = collection2cut[i]*0.5;
-          for (j = 0; j < ncollections; j++){
-            rj = collection2cut[j]*0.5;
-            tmp = force->pair->radii2cut(ri, rj) + skin;
-            cutcollectionsq[i][j] = tmp*tmp;
-          }
-        }
-      } else {
-        finite_cut_flag = 0;
-
-        // Map types to collections
-        if (!type2collection)
-          memory->create(type2collection,n+1,"neigh:type2collection");
-
-        for (i = 1; i <= n; i++)
-          type2collection[i] = -1;
-
-        double cuttmp;
-        for (i = 1; i <= n; i++){
-          // Remove skin added to cutneighsq
-          cuttmp = sqrt(cutneighsq[i][i]) - skin;
-          for (icollection = 0; icollection < ncollections; icollection ++){
-            if (collection2cut[icollection] >= cuttmp) {
-              type2collection[i] = icollection;
-              break;
-            }
-          }
-
-          if (type2collection[i] == -1)
-            error->all(FLERR, "Pair cutoff exceeds interval cutoffs for multi");
-        }
-
-        // Define cutoffs
-        for (i = 1; i <= n; i++){
-          icollection = type2collection[i];
-          for (j = 1; j <= n; j++){
-            jcollection = type2collection[j];
-            if (cutneighsq[i][j] > cutcollectionsq[icollection][jcollection]) {
-              cutcollectionsq[icollection][jcollection] = cutneighsq[i][j];
-              cutcollectionsq[jcollection][icollection] = cutneighsq[i][j];
-            }
-          }
-        }
-      }
-    }
-  }
-
-  // rRESPA cutoffs
-
-  int respa = 0;
-  if (update->whichflag == 1 && utils::strmatch(update->integrate_style,"^respa")) {
-    if ((dynamic_cast<Respa *>(update->integrate))->level_inner >= 0) respa = 1;
-    if ((dynamic_cast<Respa *>(update->integrate))->level_middle >= 0) respa = 2;
-  }
-
-  if (respa) {
-    double *cut_respa = (dynamic_cast<Respa *>(update->integrate))->cutoff;
-    cut_inner_sq = (cut_respa[1] + skin) * (cut_respa[1] + skin);
-    cut_middle_sq = (cut_respa[3] + skin) * (cut_respa[3] + skin);
-    cut_middle_inside_sq = (cut_respa[0] - skin) * (cut_respa[0] - skin);
-    if (cut_respa[0]-skin < 0) cut_middle_inside_sq = 0.0;
-  }
+  set_cutoffs();
 
   must_check = restart_check = 0;
   if (output->restart_flag) must_check = restart_check = 1;
@@ -681,7 +561,14 @@ void Neighbor::init()
   // print_pairwise_info() made use of requests
   // set of NeighLists now stores all needed info
 
+  // lists with a custom cutoff have the skin folded into their cutoff
+
   for (i = 0; i < nrequest; i++) {
+    if (tuneactive && requests[i]->cut) {
+      if (me == 0) error->warning(FLERR,"Neigh_modify tune is disabled by neighbor lists "
+                                  "with a custom cutoff");
+      tuneactive = 0;
+    }
     delete requests[i];
     requests[i] = nullptr;
   }
@@ -694,6 +581,179 @@ void Neighbor::init()
   init_topology();
 }
 
+/* ----------------------------------------------------------------------
+   set neighbor cutoffs and trigger distance from pair cutoffs and skin
+   called from init() and whenever the skin is changed during a run
+------------------------------------------------------------------------- */
+
+void Neighbor::set_cutoffs()
+{
+  int i,j,n;
+
+  // set neighbor cutoffs (force cutoff + skin)
+  // trigger determines when atoms migrate and neighbor lists are rebuilt
+  //   needs to be non-zero for migration distance check
+  //   even if pair = nullptr and no neighbor lists are used
+  // cutneigh = force cutoff + skin if cutforce > 0, else cutneigh = 0
+  // cutneighghost = pair cutghost if it requests it, else same as cutneigh
+
+  triggersq = 0.25*skin*skin;
+  boxcheck = 0;
+  if (domain->box_change && (domain->xperiodic || domain->yperiodic ||
+                             (dimension == 3 && domain->zperiodic)))
+      boxcheck = 1;
+
+  n = atom->ntypes;
+  if (cutneighsq == nullptr) {
+    if (lmp->kokkos) init_cutneighsq_kokkos(n);
+    else memory->create(cutneighsq,n+1,n+1,"neigh:cutneighsq");
+    memory->create(cutneighghostsq,n+1,n+1,"neigh:cutneighghostsq");
+    cuttype = new double[n+1];
+    cuttypesq = new double[n+1];
+  }
+
+  double cutoff,delta,cut;
+  cutneighmin = BIG;
+  cutneighmax = 0.0;
+
+  for (i = 1; i <= n; i++) {
+    cuttype[i] = cuttypesq[i] = 0.0;
+    for (j = 1; j <= n; j++) {
+      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
+      else cutoff = 0.0;
+      if (cutoff > 0.0) delta = skin;
+      else delta = 0.0;
+      cut = cutoff + delta;
+
+      cutneighsq[i][j] = cut*cut;
+      cuttype[i] = MAX(cuttype[i],cut);
+      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
+      cutneighmin = MIN(cutneighmin,cut);
+      cutneighmax = MAX(cutneighmax,cut);
+
+      if (force->pair && force->pair->ghostneigh) {
+        cut = force->pair->cutghost[i][j] + skin;
+        cutneighghostsq[i][j] = cut*cut;
+      } else cutneighghostsq[i][j] = cut*cut;
+    }
+  }
+  cutneighmaxsq = cutneighmax * cutneighmax;
+
+  // Define cutoffs for multi
+  if (style == Neighbor::MULTI) {
+    int icollection, jcollection;
+
+    // If collections not yet defined, create default map using types
+    if (!custom_collection_flag) {
+      ncollections = n;
+      interval_collection_flag = 0;
+      if (!type2collection)
+        memory->create(type2collection,n+1,"neigh:type2collection");
+      for (i = 1; i <= n; i++)
+        type2collection[i] = i-1;
+    }
+
+    memory->grow(cutcollectionsq, ncollections, ncollections, "neigh:cutcollectionsq");
+
+    // 3 possible ways of defining collections
+    // 1) Types are used to define collections
+    //    Each collection loops through its owned types, and uses cutneighsq to calculate its cutoff
+    // 2) Collections are defined by intervals, point particles
+    //    Types are first sorted into collections based on cutneighsq[i][i]
+    //    Each collection loops through its owned types, and uses cutneighsq to calculate its cutoff
+    // 3) Collections are defined by intervals, finite particles
+    //
+
+    // Define collection cutoffs
+    for (i = 0; i < ncollections; i++)
+      for (j = 0; j < ncollections; j++)
+        cutcollectionsq[i][j] = 0.0;
+
+    if (!interval_collection_flag) {
+      finite_cut_flag = 0;
+      for (i = 1; i <= n; i++){
+        icollection = type2collection[i];
+        for (j = 1; j <= n; j++){
+          jcollection = type2collection[j];
+          if (cutneighsq[i][j] > cutcollectionsq[icollection][jcollection]) {
+            cutcollectionsq[icollection][jcollection] = cutneighsq[i][j];
+            cutcollectionsq[jcollection][icollection] = cutneighsq[i][j];
+          }
+        }
+      }
+    } else {
+      if (!force->pair)
+        error->all(FLERR, "Cannot use collection/interval command without defining a pairstyle");
+
+      if (force->pair->finitecutflag) {
+        finite_cut_flag = 1;
+        // If cutoffs depend on finite atom sizes, use radii of intervals to find cutoffs
+        double ri, rj, tmp;
+        for (i = 0; i < ncollections; i++){
+          ri = collection2cut[i]*0.5;
+          for (j = 0; j < ncollections; j++){
+            rj = collection2cut[j]*0.5;
+            tmp = force->pair->radii2cut(ri, rj) + skin;
+            cutcollectionsq[i][j] = tmp*tmp;
+          }
+        }
+      } else {
+        finite_cut_flag = 0;
+
+        // Map types to collections
+        if (!type2collection)
+          memory->create(type2collection,n+1,"neigh:type2collection");
+
+        for (i = 1; i <= n; i++)
+          type2collection[i] = -1;
+
+        double cuttmp;
+        for (i = 1; i <= n; i++){
+          // Remove skin added to cutneighsq
+          cuttmp = sqrt(cutneighsq[i][i]) - skin;
+          for (icollection = 0; icollection < ncollections; icollection ++){
+            if (collection2cut[icollection] >= cuttmp) {
+              type2collection[i] = icollection;
+              break;
+            }
+          }
+
+          if (type2collection[i] == -1)
+            error->all(FLERR, "Pair cutoff exceeds interval cutoffs for multi");
+        }
+
+        // Define cutoffs
+        for (i = 1; i <= n; i++){
+          icollection = type2collection[i];
+          for (j = 1; j <= n; j++){
+            jcollection = type2collection[j];
+            if (cutneighsq[i][j] > cutcollectionsq[icollection][jcollection]) {
+              cutcollectionsq[icollection][jcollection] = cutneighsq[i][j];
+              cutcollectionsq[jcollection][icollection] = cutneighsq[i][j];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // rRESPA cutoffs
+
+  int respa = 0;
+  if (update->whichflag == 1 && utils::strmatch(update->integrate_style,"^respa")) {
+    if ((dynamic_cast<Respa *>(update->integrate))->level_inner >= 0) respa = 1;
+    if ((dynamic_cast<Respa *>(update->integrate))->level_middle >= 0) respa = 2;
+  }
+
+  if (respa) {
+    double *cut_respa = (dynamic_cast<Respa *>(update->integrate))->cutoff;
+    cut_inner_sq = (cut_respa[1] + skin) * (cut_respa[1] + skin);
+    cut_middle_sq = (cut_respa[3] + skin) * (cut_respa[3] + skin);
+    cut_middle_inside_sq = (cut_respa[0] - skin) * (cut_respa[0] - skin);
+    if (cut_respa[0]-skin < 0) cut_middle_inside_sq = 0.0;
+  }
+}
+
 /* ----------------------------------------------------------------------
    create and initialize lists of Nbin, Nstencil, NPair classes
    lists have info on all classes in 3 style*.h files
@@ -1281,6 +1341,7 @@ void Neighbor::morph_skip()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // 2 lists are a match
 
@@ -1444,6 +1505,7 @@ void Neighbor::morph_halffull()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1553,6 +1615,7 @@ void Neighbor::morph_copy_trim()
       if (irq->kokkos_host && !jrq->kokkos_host) continue;
       if (irq->kokkos_device && !jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1838,6 +1901,7 @@ void Neighbor::print_pairwise_info()
     if (rq->kokkos_device) out += ", kokkos_device";
     if (rq->kokkos_host) out += ", kokkos_host";
     if (rq->ssa) out += ", ssa";
+    if (rq->cluster) out += fmt::format(", cluster {}",rq->cluster);
     if (rq->cut) out += fmt::format(", cut {}",rq->cutoff);
     if (rq->off2on) out += ", off2on";
     out += "\n";
@@ -2168,6 +2232,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!rq->cluster != !(mask & NP_CLUSTER)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2318,20 +2383,132 @@ void Neighbor::setup_bins()
 
 int Neighbor::decide()
 {
+  int flag = 0;
+
   if (must_check) {
     bigint n = update->ntimestep;
-    if (restart_check && n == output->next_restart) return 1;
+    if (restart_check && n == output->next_restart) flag = 1;
     for (auto &ifix : fixchecklist) {
-      if (n == ifix->next_reneighbor) return 1;
+      if (n == ifix->next_reneighbor) flag = 1;
+    }
+  }
+
+  if (!flag) {
+    ago++;
+    if (ago >= delay && ago % every == 0) {
+      if (build_once) return 0;
+      if (dist_check == 0) flag = 1;
+      else flag = check_distance();
+    }
+  }
+
+  if (flag && tuneactive) tune_skin();
+  return flag;
+}
+
+/* ----------------------------------------------------------------------
+   auto-tune skin and check interval, invoked on steps that reneighbor
+   each trial skin is timed for at least tunewindow steps
+   cost = pair + neigh + comm time per step, max across procs
+   a larger skin means fewer rebuilds but more pairs and ghost atoms
+   once all trials are timed, switch to the cheapest skin and set every
+     to half the shortest observed rebuild interval for that skin
+------------------------------------------------------------------------- */
+
+void Neighbor::tune_skin()
+{
+  bigint ntimestep = update->ntimestep;
+  int i,m;
+
+  if (itune >= 0) {
+    if (lastcall >= 0) tuneint[itune] = MIN(tuneint[itune],ntimestep-lastcall);
+    if (ntimestep - tunestep < tunewindow) return;
+
+    double now[3];
+    tune_timers(now);
+    for (m = 0; m < 3; m++)
+      tunecost[itune][m] = (now[m]-tunestart[m]) / (ntimestep-tunestep);
+  }
+
+  itune++;
+  if (itune < NTUNE) {
+    reset_skin(tuneskin[itune]);
+    tunestep = ntimestep;
+    tune_timers(tunestart);
+    return;
+  }
+
+  int ibest = 0;
+  double cost,costbest = BIG;
+  for (i = 0; i < NTUNE; i++) {
+    cost = tunecost[i][0] + tunecost[i][1] + tunecost[i][2];
+    if (cost < costbest) {
+      costbest = cost;
+      ibest = i;
+    }
+  }
+
+  every = MAX(1,tuneint[ibest]/2);
+  delay = 0;
+  reset_skin(tuneskin[ibest]);
+  tuneactive = 0;
+  tunedone = 1;
+
+  if (me == 0) {
+    std::string mesg = fmt::format("Neighbor skin auto-tuning on step {}:\n", ntimestep);
+    if (timer->has_normal())
+      mesg += "      Skin  Pair/step Neigh/step  Comm/step Min-interval\n";
+    else
+      mesg += "      Skin  Time/step Min-interval\n";
+    for (i = 0; i < NTUNE; i++) {
+      if (timer->has_normal())
+        mesg += fmt::format("{:10.4g} {:10.4g} {:10.4g} {:10.4g} {:12}\n", tuneskin[i],
+                            tunecost[i][0], tunecost[i][1], tunecost[i][2], tuneint[i]);
+      else
+        mesg += fmt::format("{:10.4g} {:10.4g} {:12}\n", tuneskin[i], tunecost[i][0], tuneint[i]);
     }
+    mesg += fmt::format("  selected skin = {:.8g}, every = {}, delay = 0\n", skin, every);
+    utils::logmesg(lmp, mesg);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   accumulated pair, neigh, comm wall time, max across procs
+   without detailed timers, use total wall time instead
+------------------------------------------------------------------------- */
+
+void Neighbor::tune_timers(double *tall)
+{
+  double t[3];
+
+  if (timer->has_normal()) {
+    t[0] = timer->get_wall(Timer::PAIR);
+    t[1] = timer->get_wall(Timer::NEIGH);
+    t[2] = timer->get_wall(Timer::COMM);
+  } else {
+    t[0] = platform::walltime();
+    t[1] = t[2] = 0.0;
   }
+  MPI_Allreduce(t,tall,3,MPI_DOUBLE,MPI_MAX,world);
+}
+
+/* ----------------------------------------------------------------------
+   change skin distance during a run, invoked just before a rebuild
+   recompute cutoffs, ghost comm cutoff, bins and stencils
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_skin(double newskin)
+{
+  skin = newskin;
+  set_cutoffs();
+
+  for (int i = 0; i < nbin; i++) neigh_bin[i]->copy_neighbor_info();
+  for (int i = 0; i < nstencil; i++) neigh_stencil[i]->copy_neighbor_info();
+  for (int i = 0; i < nlist; i++)
+    if (neigh_pair[i]) neigh_pair[i]->copy_neighbor_info();
 
-  ago++;
-  if (ago >= delay && ago % every == 0) {
-    if (build_once) return 0;
-    if (dist_check == 0) return 1;
-    return check_distance();
-  } else return 0;
+  comm->setup();
+  if (style) setup_bins();
 }
 
 /* ----------------------------------------------------------------------
@@ -2586,6 +2763,8 @@ void Neighbor::set(int narg, char **arg)
 
   skin = utils::numeric(FLERR,arg[0],false,lmp);
   if (skin < 0.0) error->all(FLERR, "Invalid neighbor argument: {}", arg[0]);
+  skin_user = -1.0;
+  tunedone = 0;
 
   if (strcmp(arg[1],"nsq") == 0) style = Neighbor::NSQ;
   else if (strcmp(arg[1],"bin") == 0) style = Neighbor::BIN;
@@ -2642,6 +2821,24 @@ void Neighbor::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify check", error);
       dist_check = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"tune") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify tune", error);
+      tuneflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      tunedone = 0;
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"tune/window") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify tune/window", error);
+      tunewindow = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (tunewindow <= 0)
+        error->all(FLERR, "Invalid neigh_modify tune/window argument: {}", tunewindow);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"tune/range") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR, "neigh_modify tune/range", error);
+      tunelo = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      tunehi = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (tunelo <= 0.0 || tunehi < tunelo)
+        error->all(FLERR, "Invalid neigh_modify tune/range arguments: {} {}", tunelo, tunehi);
+      iarg += 3;
     } else if (strcmp(arg[iarg],"once") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify once", error);
       build_once = utils::logical(FLERR,arg[iarg+1],false,lmp);
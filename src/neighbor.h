@@ -201,6 +201,23 @@ class Neighbor : protected Pointers {
 
   double inner[2], middle[2];    // rRESPA cutoffs for extra lists
 
+  // auto-tuning of skin and check interval
+
+  static constexpr int NTUNE = 5;    // # of trial skins
+
+  int tuneflag;               // 1 if skin and every are auto-tuned
+  int tunewindow;             // min # of steps each trial skin is timed
+  double tunelo, tunehi;      // range of trial skins as fraction of user skin
+  int tuneactive;             // 1 if tuning in this run
+  int tunedone;               // 1 once a skin has been selected
+  int itune;                  // index of current trial skin, -1 before first
+  double skin_user;           // skin set by neighbor command
+  double tuneskin[NTUNE];     // trial skins
+  bigint tuneint[NTUNE];      // min # of steps between builds for each trial
+  bigint tunestep;            // step the current trial started on
+  double tunestart[3];        // pair,neigh,comm time when current trial started
+  double tunecost[NTUNE][3];  // pair,neigh,comm time per step for each trial
+
   int old_style, old_triclinic;    // previous run info
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
 
@@ -254,6 +271,11 @@ class Neighbor : protected Pointers {
 
   void sort_requests();
 
+  void set_cutoffs();
+  void reset_skin(double);
+  void tune_skin();
+  void tune_timers(double *);
+
   void morph_unique();
   void morph_skip();
   void morph_granular();
@@ -334,7 +356,8 @@ namespace NeighConst {
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
     NP_MULTI_OLD = 1 << 25,
-    NP_TRIM = 1 << 26
+    NP_TRIM = 1 << 26,
+    NP_CLUSTER = 1 << 27
   };
 
   enum {
@@ -349,6 +372,7 @@ namespace NeighConst {
     REQ_NEWTON_ON = 1 << 8,
     REQ_NEWTON_OFF = 1 << 9,
     REQ_SSA = 1 << 10,
+    REQ_CLUSTER = 1 << 11,
   };
 }    // namespace NeighConst
 
@@ -15,6 +15,7 @@
 
 #include "atom.h"
 #include "atom_vec.h"
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
 #include "force.h"
@@ -25,6 +26,10 @@
 
 #include <cmath>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 using namespace LAMMPS_NS;
 using namespace NeighConst;
 
@@ -51,11 +56,6 @@ NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::NPairBin(LAMMPS *lmp) : NPair(lmp)
 template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
 void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
 {
-  int i, j, jh, k, n, itype, jtype, ibin, bin_start, which, imol, iatom, moltemplate;
-  tagint itag, jtag, tagprev;
-  double xtmp, ytmp, ztmp, delx, dely, delz, rsq, radsum,cut,cutsq;
-  int *neighptr;
-
   const double delta = 0.01 * force->angstrom;
 
   double **x = atom->x;
@@ -72,12 +72,8 @@ void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
   int *molindex = atom->molindex;
   int *molatom = atom->molatom;
   Molecule **onemols = atom->avec->onemols;
-  if (!ATOMONLY) {
-    if (molecular == Atom::TEMPLATE)
-      moltemplate = 1;
-    else
-      moltemplate = 0;
-  }
+  int moltemplate = 0;
+  if (!ATOMONLY && (molecular == Atom::TEMPLATE)) moltemplate = 1;
 
   int history = list->history;
   int mask_history = 1 << HISTBITS;
@@ -85,170 +81,194 @@ void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
   int *ilist = list->ilist;
   int *numneigh = list->numneigh;
   int **firstneigh = list->firstneigh;
-  MyPage<int> *ipage = list->ipage;
-
-  int inum = 0;
-  ipage->reset();
-
-  for (i = 0; i < nlocal; i++) {
-    n = 0;
-    neighptr = ipage->vget();
-
-    itag = tag[i];
-    itype = type[i];
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
-    if (!ATOMONLY) {
-      if (moltemplate) {
-        imol = molindex[i];
-        iatom = molatom[i];
-        tagprev = tag[i] - iatom - 1;
-      }
-    }
 
-    ibin = atom2bin[i];
+  // each thread builds the lists for a contiguous chunk of owned atoms
+  //   and stores them in its own pages
+  // ilist is in atom order independent of the number of threads
+
+  const int nthreads = comm->nthreads;
 
-    for (k = 0; k < nstencil; k++) {
-      bin_start = binhead[ibin + stencil[k]];
-      if (HALF && NEWTON && (!TRI)) {
-        if (k == 0) {
-          // Half neighbor list, newton on, orthonormal
-          // loop over rest of atoms in i's bin, ghosts are at end of linked list
-          bin_start = bins[i];
+#if defined(_OPENMP)
+#pragma omp parallel default(shared) num_threads(nthreads)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+    const int idelta = 1 + nlocal / nthreads;
+    const int ifrom = tid * idelta;
+    const int ito = ((ifrom + idelta) > nlocal) ? nlocal : (ifrom + idelta);
+
+    int i, j, jh, k, n, itype, jtype, ibin, bin_start, which, imol, iatom;
+    tagint itag, jtag, tagprev;
+    double xtmp, ytmp, ztmp, delx, dely, delz, rsq, radsum, cut, cutsq;
+    int *neighptr;
+
+    MyPage<int> *ipage = &list->ipage[tid];
+    ipage->reset();
+
+    for (i = ifrom; i < ito; i++) {
+      n = 0;
+      neighptr = ipage->vget();
+
+      itag = tag[i];
+      itype = type[i];
+      xtmp = x[i][0];
+      ytmp = x[i][1];
+      ztmp = x[i][2];
+      if (!ATOMONLY) {
+        if (moltemplate) {
+          imol = molindex[i];
+          iatom = molatom[i];
+          tagprev = tag[i] - iatom - 1;
         }
       }
 
-      for (j = bin_start; j >= 0; j = bins[j]) {
-        if (!HALF) {
-          // Full neighbor list
-          // only skip i = j
-          if (i == j) continue;
-        } else if (!NEWTON) {
-          // Half neighbor list, newton off
-          // only store pair if i < j
-          // stores own/own pairs only once
-          // stores own/ghost pairs on both procs
-          if (j <= i) continue;
-        } else if (TRI) {
-          // for triclinic, bin stencil is full in all 3 dims
-          // must use itag/jtag to eliminate half the I/J interactions
-          // cannot use I/J exact coord comparision
-          //   b/c transforming orthog -> lambda -> orthog for ghost atoms
-          //   with an added PBC offset can shift all 3 coords by epsilon
-          if (j <= i) continue;
-          if (j >= nlocal) {
-            jtag = tag[j];
-            if (itag > jtag) {
-              if ((itag + jtag) % 2 == 0) continue;
-            } else if (itag < jtag) {
-              if ((itag + jtag) % 2 == 1) continue;
-            } else {
-              if (fabs(x[j][2] - ztmp) > delta) {
-                if (x[j][2] < ztmp) continue;
-              } else if (fabs(x[j][1] - ytmp) > delta) {
-                if (x[j][1] < ytmp) continue;
+      ibin = atom2bin[i];
+
+      for (k = 0; k < nstencil; k++) {
+        bin_start = binhead[ibin + stencil[k]];
+        if (HALF && NEWTON && (!TRI)) {
+          if (k == 0) {
+            // Half neighbor list, newton on, orthonormal
+            // loop over rest of atoms in i's bin, ghosts are at end of linked list
+            bin_start = bins[i];
+          }
+        }
+
+        for (j = bin_start; j >= 0; j = bins[j]) {
+          if (!HALF) {
+            // Full neighbor list
+            // only skip i = j
+            if (i == j) continue;
+          } else if (!NEWTON) {
+            // Half neighbor list, newton off
+            // only store pair if i < j
+            // stores own/own pairs only once
+            // stores own/ghost pairs on both procs
+            if (j <= i) continue;
+          } else if (TRI) {
+            // for triclinic, bin stencil is full in all 3 dims
+            // must use itag/jtag to eliminate half the I/J interactions
+            // cannot use I/J exact coord comparision
+            //   b/c transforming orthog -> lambda -> orthog for ghost atoms
+            //   with an added PBC offset can shift all 3 coords by epsilon
+            if (j <= i) continue;
+            if (j >= nlocal) {
+              jtag = tag[j];
+              if (itag > jtag) {
+                if ((itag + jtag) % 2 == 0) continue;
+              } else if (itag < jtag) {
+                if ((itag + jtag) % 2 == 1) continue;
               } else {
-                if (x[j][0] < xtmp) continue;
+                if (fabs(x[j][2] - ztmp) > delta) {
+                  if (x[j][2] < ztmp) continue;
+                } else if (fabs(x[j][1] - ytmp) > delta) {
+                  if (x[j][1] < ytmp) continue;
+                } else {
+                  if (x[j][0] < xtmp) continue;
+                }
               }
             }
-          }
-        } else {
-          // Half neighbor list, newton on, orthonormal
-          // store every pair for every bin in stencil, except for i's bin
+          } else {
+            // Half neighbor list, newton on, orthonormal
+            // store every pair for every bin in stencil, except for i's bin
 
-          if (k == 0) {
-            // if j is owned atom, store it, since j is beyond i in linked list
-            // if j is ghost, only store if j coords are "above and to the "right" of i
-            if (j >= nlocal) {
-              if (x[j][2] < ztmp) continue;
-              if (x[j][2] == ztmp) {
-                if (x[j][1] < ytmp) continue;
-                if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
+            if (k == 0) {
+              // if j is owned atom, store it, since j is beyond i in linked list
+              // if j is ghost, only store if j coords are "above and to the "right" of i
+              if (j >= nlocal) {
+                if (x[j][2] < ztmp) continue;
+                if (x[j][2] == ztmp) {
+                  if (x[j][1] < ytmp) continue;
+                  if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
+                }
               }
             }
           }
-        }
 
-        jtype = type[j];
-        if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx * delx + dely * dely + delz * delz;
-
-        if (SIZE) {
-          radsum = radius[i] + radius[j];
-          cut = radsum + skin;
-          cutsq = cut * cut;
-
-          if (ATOMONLY) {
-            if (rsq <= cutsq) {
-              jh = j;
-              if (history && rsq < (radsum * radsum))
-                jh = jh ^ mask_history;
-              neighptr[n++] = jh;
-            }
-          } else {
-            if (rsq <= cutsq) {
-              jh = j;
-              if (history && rsq < (radsum * radsum))
-                jh = jh ^ mask_history;
-
-              if (molecular != Atom::ATOMIC) {
-                if (!moltemplate)
-                  which = find_special(special[i], nspecial[i], tag[j]);
-                else if (imol >= 0)
-                  which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
-                                       tag[j] - tagprev);
-                else
-                  which = 0;
-                if (which == 0)
-                  neighptr[n++] = jh;
-                else if (domain->minimum_image_check(delx, dely, delz))
-                  neighptr[n++] = jh;
-                else if (which > 0)
-                  neighptr[n++] = jh ^ (which << SBBITS);
-              } else
+          jtype = type[j];
+          if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx * delx + dely * dely + delz * delz;
+
+          if (SIZE) {
+            radsum = radius[i] + radius[j];
+            cut = radsum + skin;
+            cutsq = cut * cut;
+
+            if (ATOMONLY) {
+              if (rsq <= cutsq) {
+                jh = j;
+                if (history && rsq < (radsum * radsum))
+                  jh = jh ^ mask_history;
                 neighptr[n++] = jh;
+              }
+            } else {
+              if (rsq <= cutsq) {
+                jh = j;
+                if (history && rsq < (radsum * radsum))
+                  jh = jh ^ mask_history;
+
+                if (molecular != Atom::ATOMIC) {
+                  if (!moltemplate)
+                    which = find_special(special[i], nspecial[i], tag[j]);
+                  else if (imol >= 0)
+                    which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
+                                         tag[j] - tagprev);
+                  else
+                    which = 0;
+                  if (which == 0)
+                    neighptr[n++] = jh;
+                  else if (domain->minimum_image_check(delx, dely, delz))
+                    neighptr[n++] = jh;
+                  else if (which > 0)
+                    neighptr[n++] = jh ^ (which << SBBITS);
+                } else
+                  neighptr[n++] = jh;
+              }
             }
-          }
-        } else {
-          if (ATOMONLY) {
-            if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
           } else {
-            if (rsq <= cutneighsq[itype][jtype]) {
-              if (molecular != Atom::ATOMIC) {
-                if (!moltemplate)
-                  which = find_special(special[i], nspecial[i], tag[j]);
-                else if (imol >= 0)
-                  which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
-                                       tag[j] - tagprev);
-                else
-                  which = 0;
-                if (which == 0)
-                  neighptr[n++] = j;
-                else if (domain->minimum_image_check(delx, dely, delz))
+            if (ATOMONLY) {
+              if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
+            } else {
+              if (rsq <= cutneighsq[itype][jtype]) {
+                if (molecular != Atom::ATOMIC) {
+                  if (!moltemplate)
+                    which = find_special(special[i], nspecial[i], tag[j]);
+                  else if (imol >= 0)
+                    which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
+                                         tag[j] - tagprev);
+                  else
+                    which = 0;
+                  if (which == 0)
+                    neighptr[n++] = j;
+                  else if (domain->minimum_image_check(delx, dely, delz))
+                    neighptr[n++] = j;
+                  else if (which > 0)
+                    neighptr[n++] = j ^ (which << SBBITS);
+                } else
                   neighptr[n++] = j;
-                else if (which > 0)
-                  neighptr[n++] = j ^ (which << SBBITS);
-              } else
-                neighptr[n++] = j;
+              }
             }
           }
         }
       }
-    }
 
-    ilist[inum++] = i;
-    firstneigh[i] = neighptr;
-    numneigh[i] = n;
-    ipage->vgot(n);
-    if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+      ilist[i] = i;
+      firstneigh[i] = neighptr;
+      numneigh[i] = n;
+      ipage->vgot(n);
+      if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    }
   }
 
-  list->inum = inum;
+  list->inum = nlocal;
   if (!HALF) list->gnum = 0;
 }
 
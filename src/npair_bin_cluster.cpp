@@ -0,0 +1,361 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_bin_cluster.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "domain.h"
+#include "error.h"
+#include "group.h"
+#include "memory.h"
+#include "molecule.h"
+#include "my_page.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace LAMMPS_NS;
+using namespace NeighConst;
+
+static constexpr double BIG = 1.0e20;
+
+/* ---------------------------------------------------------------------- */
+
+NPairBinCluster::NPairBinCluster(LAMMPS *lmp) : NPair(lmp)
+{
+  ncolx = ncoly = 0;
+  maxcol = maxatom = maxbbox = maxspecial = 0;
+  colhead = colclus = colatom = nullptr;
+  bbox = nullptr;
+  specialbuf = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairBinCluster::~NPairBinCluster()
+{
+  memory->destroy(colhead);
+  memory->destroy(colclus);
+  memory->destroy(colatom);
+  memory->destroy(bbox);
+  memory->destroy(specialbuf);
+}
+
+/* ----------------------------------------------------------------------
+   cluster-pair neighbor list construction for all neighbors
+   owned and ghost atoms are sorted into x-y columns, then by z in each column
+   each column is cut into clusters of list->cluster consecutive atoms
+   every cluster with an owned atom is an I cluster
+   J clusters are found by bounding box distance to the I cluster
+   each stored I,J cluster pair has a bit mask of interacting atom pairs
+   every neighbor pair appears in the masks of both atoms i and j
+   special pairs are stored per atom in ilist/firstneigh instead of the masks
+------------------------------------------------------------------------- */
+
+void NPairBinCluster::build(NeighList *list)
+{
+  int i, j, a, m, mi, mj, n, ns, itype, jtype, which, imol, iatom, moltemplate;
+  tagint tagprev;
+  double delx, dely, delz, rsq;
+  int *neighptr;
+
+  const int csize = list->cluster;
+  const int nmask = list->cmaskwords;
+  const int oneatom = neighbor->oneatom;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  tagint **special = atom->special;
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  if (includegroup) nlocal = atom->nfirst;
+
+  int *molindex = atom->molindex;
+  int *molatom = atom->molatom;
+  Molecule **onemols = atom->avec->onemols;
+  if (molecular == Atom::TEMPLATE)
+    moltemplate = 1;
+  else
+    moltemplate = 0;
+
+  // largest cutoff of any type pair bounds the cluster search
+
+  int ntypes = atom->ntypes;
+  double cutmaxsq = 0.0;
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++) cutmaxsq = MAX(cutmaxsq, cutneighsq[i][j]);
+  const double cutmax = sqrt(cutmaxsq);
+
+  // atoms that take part in the list
+  // with an include group only owned atoms up to nfirst and group ghosts
+
+  int bitmask = 0;
+  if (includegroup) bitmask = group->bitmask[includegroup];
+
+  if (nall > maxatom) {
+    maxatom = atom->nmax;
+    memory->destroy(colatom);
+    memory->create(colatom, maxatom, "neigh:colatom");
+  }
+
+  double xlo = BIG, xhi = -BIG, ylo = BIG, yhi = -BIG;
+  int nuse = 0;
+  for (i = 0; i < nall; i++) {
+    if (includegroup && (i >= nlocal) && ((i < atom->nlocal) || !(mask[i] & bitmask))) continue;
+    xlo = MIN(xlo, x[i][0]);
+    xhi = MAX(xhi, x[i][0]);
+    ylo = MIN(ylo, x[i][1]);
+    yhi = MAX(yhi, x[i][1]);
+    nuse++;
+  }
+
+  // column width so that a column segment as tall as it is wide holds csize atoms
+  // based on the global number density, limited to a sane # of columns
+
+  double volume = domain->xprd * domain->yprd;
+  if (domain->dimension == 3) volume *= domain->zprd;
+  double density = (atom->natoms > 0) ? atom->natoms / volume : 1.0;
+  double width;
+  if (domain->dimension == 3)
+    width = cbrt(csize / density);
+  else
+    width = sqrt(csize / density);
+
+  if (nuse == 0) xlo = xhi = ylo = yhi = 0.0;
+  while (true) {
+    ncolx = static_cast<int>((xhi - xlo) / width) + 1;
+    ncoly = static_cast<int>((yhi - ylo) / width) + 1;
+    if ((bigint) ncolx * ncoly <= 4 * (bigint) nuse + 16) break;
+    width *= 2.0;
+  }
+  const double colinv = 1.0 / width;
+  const int ncol = ncolx * ncoly;
+
+  if (ncol + 1 > maxcol) {
+    maxcol = ncol + 1;
+    memory->destroy(colhead);
+    memory->destroy(colclus);
+    memory->create(colhead, maxcol, "neigh:colhead");
+    memory->create(colclus, maxcol, "neigh:colclus");
+  }
+
+  // counting sort of atoms into columns, then sort each column by z
+
+  for (m = 0; m <= ncol; m++) colhead[m] = 0;
+  for (i = 0; i < nall; i++) {
+    if (includegroup && (i >= nlocal) && ((i < atom->nlocal) || !(mask[i] & bitmask))) continue;
+    int ix = MIN(static_cast<int>((x[i][0] - xlo) * colinv), ncolx - 1);
+    int iy = MIN(static_cast<int>((x[i][1] - ylo) * colinv), ncoly - 1);
+    colhead[iy * ncolx + ix + 1]++;
+  }
+  for (m = 0; m < ncol; m++) colhead[m + 1] += colhead[m];
+  for (i = 0; i < nall; i++) {
+    if (includegroup && (i >= nlocal) && ((i < atom->nlocal) || !(mask[i] & bitmask))) continue;
+    int ix = MIN(static_cast<int>((x[i][0] - xlo) * colinv), ncolx - 1);
+    int iy = MIN(static_cast<int>((x[i][1] - ylo) * colinv), ncoly - 1);
+    colatom[colhead[iy * ncolx + ix]++] = i;
+  }
+  for (m = ncol; m > 0; m--) colhead[m] = colhead[m - 1];
+  colhead[0] = 0;
+
+  int nclus = 0;
+  for (m = 0; m < ncol; m++) {
+    std::sort(colatom + colhead[m], colatom + colhead[m + 1],
+              [x](int ia, int ib) { return x[ia][2] < x[ib][2]; });
+    colclus[m] = nclus;
+    nclus += (colhead[m + 1] - colhead[m] + csize - 1) / csize;
+  }
+  colclus[ncol] = nclus;
+
+  // fill clusters and their bounding boxes, padded slots are -1
+
+  list->grow_cluster(nclus);
+  int *clatom = list->clatom;
+
+  if (nclus > maxbbox) {
+    maxbbox = list->maxclus;
+    memory->destroy(bbox);
+    memory->create(bbox, maxbbox, 6, "neigh:bbox");
+  }
+
+  for (m = 0; m < ncol; m++) {
+    int c = colclus[m];
+    for (int k = colhead[m]; k < colhead[m + 1]; k += csize, c++) {
+      double *bb = bbox[c];
+      bb[0] = bb[1] = bb[2] = BIG;
+      bb[3] = bb[4] = bb[5] = -BIG;
+      for (a = 0; a < csize; a++) {
+        if (k + a < colhead[m + 1]) {
+          i = colatom[k + a];
+          clatom[c * csize + a] = i;
+          bb[0] = MIN(bb[0], x[i][0]);
+          bb[1] = MIN(bb[1], x[i][1]);
+          bb[2] = MIN(bb[2], x[i][2]);
+          bb[3] = MAX(bb[3], x[i][0]);
+          bb[4] = MAX(bb[4], x[i][1]);
+          bb[5] = MAX(bb[5], x[i][2]);
+        } else
+          clatom[c * csize + a] = -1;
+      }
+    }
+  }
+
+  if (csize * oneatom > maxspecial) {
+    maxspecial = csize * oneatom;
+    memory->destroy(specialbuf);
+    memory->create(specialbuf, maxspecial, "neigh:specialbuf");
+  }
+  int nspecialbuf[32];
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  MyPage<int> *ipage = list->ipage;
+
+  int *cilist = list->cilist;
+  int *cnumneigh = list->cnumneigh;
+  int **cfirstneigh = list->cfirstneigh;
+  MyPage<int> *cpage = list->cpage;
+
+  int inum = 0;
+  int cinum = 0;
+  ipage->reset();
+  cpage->reset();
+
+  const int ncut = static_cast<int>(cutmax * colinv) + 1;
+
+  for (int ci = 0; ci < nclus; ci++) {
+
+    // only clusters with at least one owned atom are I clusters
+
+    const int *iatoms = &clatom[ci * csize];
+    for (mi = 0; mi < csize; mi++)
+      if (iatoms[mi] >= 0 && iatoms[mi] < nlocal) break;
+    if (mi == csize) continue;
+
+    n = 0;
+    neighptr = cpage->vget();
+    for (mi = 0; mi < csize; mi++) nspecialbuf[mi] = 0;
+
+    const double *ib = bbox[ci];
+    int cxlo = MAX(static_cast<int>((ib[0] - xlo) * colinv) - ncut, 0);
+    int cxhi = MIN(static_cast<int>((ib[3] - xlo) * colinv) + ncut, ncolx - 1);
+    int cylo = MAX(static_cast<int>((ib[1] - ylo) * colinv) - ncut, 0);
+    int cyhi = MIN(static_cast<int>((ib[4] - ylo) * colinv) + ncut, ncoly - 1);
+
+    for (int cy = cylo; cy <= cyhi; cy++) {
+      for (int cx = cxlo; cx <= cxhi; cx++) {
+        const int col = cy * ncolx + cx;
+        for (int cj = colclus[col]; cj < colclus[col + 1]; cj++) {
+          const double *jb = bbox[cj];
+
+          // clusters in a column are ordered by the z of their lowest atom
+
+          if (jb[2] > ib[5] + cutmax) break;
+          if (jb[5] < ib[2] - cutmax) continue;
+
+          delx = MAX(0.0, MAX(jb[0] - ib[3], ib[0] - jb[3]));
+          dely = MAX(0.0, MAX(jb[1] - ib[4], ib[1] - jb[4]));
+          delz = MAX(0.0, MAX(jb[2] - ib[5], ib[2] - jb[5]));
+          if (delx * delx + dely * dely + delz * delz > cutmaxsq) continue;
+
+          const int *jatoms = &clatom[cj * csize];
+          unsigned int bits[2] = {0, 0};
+          int any = 0;
+
+          for (mi = 0; mi < csize; mi++) {
+            i = iatoms[mi];
+            if (i < 0 || i >= nlocal) continue;
+            itype = type[i];
+            if (moltemplate) {
+              imol = molindex[i];
+              iatom = molatom[i];
+              tagprev = tag[i] - iatom - 1;
+            }
+
+            for (mj = 0; mj < csize; mj++) {
+              j = jatoms[mj];
+              if (j < 0 || j == i) continue;
+              jtype = type[j];
+              if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+
+              delx = x[i][0] - x[j][0];
+              dely = x[i][1] - x[j][1];
+              delz = x[i][2] - x[j][2];
+              rsq = delx * delx + dely * dely + delz * delz;
+              if (rsq > cutneighsq[itype][jtype]) continue;
+
+              which = 0;
+              if (molecular != Atom::ATOMIC) {
+                if (!moltemplate)
+                  which = find_special(special[i], nspecial[i], tag[j]);
+                else if (imol >= 0)
+                  which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
+                                       tag[j] - tagprev);
+                if (which != 0 && domain->minimum_image_check(delx, dely, delz)) which = 0;
+              }
+
+              if (which == 0) {
+                const int bit = mi * csize + mj;
+                bits[bit >> 5] |= 1U << (bit & 31);
+                any = 1;
+              } else if (which > 0) {
+                if (nspecialbuf[mi] == oneatom)
+                  error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+                specialbuf[mi * oneatom + nspecialbuf[mi]++] = j ^ (which << SBBITS);
+              }
+            }
+          }
+
+          if (any) {
+            neighptr[n++] = cj;
+            for (m = 0; m < nmask; m++) neighptr[n++] = static_cast<int>(bits[m]);
+          }
+        }
+      }
+    }
+
+    cilist[cinum++] = ci;
+    cfirstneigh[ci] = neighptr;
+    cnumneigh[ci] = n / (1 + nmask);
+    cpage->vgot(n);
+    if (cpage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+
+    // special neighbors of each owned atom of the I cluster
+
+    for (mi = 0; mi < csize; mi++) {
+      i = iatoms[mi];
+      if (i < 0 || i >= nlocal) continue;
+      ns = nspecialbuf[mi];
+      neighptr = ipage->vget();
+      for (m = 0; m < ns; m++) neighptr[m] = specialbuf[mi * oneatom + m];
+      ilist[inum++] = i;
+      firstneigh[i] = neighptr;
+      numneigh[i] = ns;
+      ipage->vgot(ns);
+      if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    }
+  }
+
+  list->nclus = nclus;
+  list->cinum = cinum;
+  list->inum = inum;
+  list->gnum = 0;
+}
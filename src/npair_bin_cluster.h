@@ -0,0 +1,52 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(full/bin/cluster,
+           NPairBinCluster,
+           NP_FULL | NP_BIN | NP_CLUSTER |
+           NP_NEWTON | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_BIN_CLUSTER_H
+#define LMP_NPAIR_BIN_CLUSTER_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+class NPairBinCluster : public NPair {
+ public:
+  NPairBinCluster(class LAMMPS *);
+  ~NPairBinCluster() override;
+  void build(class NeighList *) override;
+
+ protected:
+  int ncolx, ncoly;     // # of columns of the cluster grid in x,y
+  int maxcol;           // size of allocated per-column arrays
+  int *colhead;         // index into colatom of 1st atom of each column
+  int *colclus;         // index of 1st cluster of each column
+  int maxatom;          // size of allocated colatom
+  int *colatom;         // atom indices sorted by column, then by z
+  int maxbbox;          // size of allocated bounding box array
+  double **bbox;        // lo/hi bounding box of each cluster
+  int maxspecial;       // size of allocated special buffer
+  int *specialbuf;      // special neighbors of the atoms of one I cluster
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
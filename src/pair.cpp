@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -43,6 +44,7 @@ using MathConst::THIRD;
 using MathSpecial::powint;
 
 enum { NONE, RLINEAR, RSQ, BMP };
+static constexpr int COSTSLICE = 32;    // # of atoms timed together in compute_cost()
 static const std::string mixing_rule_names[Pair::SIXTHPOWER + 1] = {"geometric", "arithmetic",
                                                                     "sixthpower"};
 
@@ -73,6 +75,9 @@ Pair::Pair(LAMMPS *lmp) :
   single_hessian_enable = 0;
   restartinfo = 1;
   respa_enable = 0;
+  overlap_enable = 0;
+  costflag = 0;
+  mixed_prec_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
   writedata = 0;
@@ -102,6 +107,7 @@ Pair::Pair(LAMMPS *lmp) :
   tabinner = sqrt(2.0);
   tabinner_disp = sqrt(2.0);
   trim_flag = 1;
+  mixed_prec_flag = 0;
 
   allocated = 0;
   suffix_flag = Suffix::NONE;
@@ -206,6 +212,12 @@ void Pair::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "pair_modify neigh/trim", error);
       trim_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"precision") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "pair_modify precision", error);
+      if (strcmp(arg[iarg+1],"double") == 0) mixed_prec_flag = 0;
+      else if (strcmp(arg[iarg+1],"mixed") == 0) mixed_prec_flag = 1;
+      else error->all(FLERR,"Unknown pair_modify precision argument: {}", arg[iarg+1]);
+      iarg += 2;
     } else error->all(FLERR,"Unknown pair_modify keyword: {}", arg[iarg]);
   }
 }
@@ -243,6 +255,20 @@ void Pair::init()
                      "bonds/angles/dihedrals and special_bond exclusions");
   }
 
+  // accelerator styles with their own neighbor lists or force kernels
+  // cannot be split into interior and border atoms
+  // OPENMP styles reduce their per-thread forces once per compute() call
+
+  if (suffix_flag & (Suffix::GPU | Suffix::INTEL | Suffix::KOKKOS | Suffix::OMP))
+    overlap_enable = 0;
+
+  // accelerator styles have their own precision settings
+
+  if (suffix_flag) mixed_prec_enable = 0;
+  if (mixed_prec_flag && !mixed_prec_enable && comm->me == 0)
+    error->warning(FLERR,"Pair style {} has no mixed precision kernel, using double precision",
+                   force->pair_style);
+
   // I,I coeffs must be set
   // init_one() will check if I,J is set explicitly or inferred by mixing
 
@@ -738,6 +764,144 @@ void Pair::compute_dummy(int eflag, int vflag)
   ev_init(eflag,vflag);
 }
 
+/* ----------------------------------------------------------------------
+   compute interactions of interior atoms only, i.e. atoms of the
+     neighbor list without ghost neighbors
+   called while the forward comm of ghost coords is still in progress
+   the fdotr virial is skipped here, it is done once for all atoms in
+     compute_border() after all forces are known
+------------------------------------------------------------------------- */
+
+void Pair::compute_interior(int eflag, int vflag)
+{
+  if (list->splitstamp != neighbor->ncalls) list->split_interior();
+
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = list->ninterior;
+  list->ilist = list->ilist_split;
+  if (no_virial_fdotr_compute == 0) vflag &= ~VIRIAL_FDOTR;
+  compute(eflag,vflag);
+  list->inum = inum;
+  list->ilist = ilist;
+
+  eng_vdwl_interior = eng_vdwl;
+  eng_coul_interior = eng_coul;
+  for (int i = 0; i < 6; i++) virial_interior[i] = vflag_global ? virial[i] : 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   compute interactions of border atoms after compute_interior()
+   once ghost coords are current and add the interior energy and virial
+------------------------------------------------------------------------- */
+
+void Pair::compute_border(int eflag, int vflag)
+{
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = inum - list->ninterior;
+  list->ilist = list->ilist_split + list->ninterior;
+  compute(eflag,vflag);
+  list->inum = inum;
+  list->ilist = ilist;
+
+  if (eflag_global) {
+    eng_vdwl += eng_vdwl_interior;
+    eng_coul += eng_coul_interior;
+  }
+  if (vflag_global)
+    for (int i = 0; i < 6; i++) virial[i] += virial_interior[i];
+}
+
+/* ----------------------------------------------------------------------
+   compute() and add the time it takes to the per-atom "balance_cost"
+     vector used for load balancing with fix balance weight cost
+   if compute() can be split by ilist, time slices of COSTSLICE atoms
+     and share the slice time evenly among its atoms
+   else time the whole call and share it in proportion to neighbor counts
+------------------------------------------------------------------------- */
+
+void Pair::compute_cost(int eflag, int vflag)
+{
+  int flag,cols;
+  int index = atom->find_custom("balance_cost",flag,cols);
+  if ((index < 0) || (flag != 1) || cols || !list || (list->inum == 0)) {
+    compute(eflag,vflag);
+    return;
+  }
+
+  double *cost = atom->dvector[index];
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int ii;
+  double t;
+
+  if (!overlap_enable || num_tally_compute || (eflag & ENERGY_ATOM) ||
+      (vflag & (VIRIAL_ATOM | VIRIAL_CENTROID))) {
+    t = platform::walltime();
+    compute(eflag,vflag);
+    t = platform::walltime() - t;
+
+    int *numneigh = list->numneigh;
+    double nsum = 0.0;
+    for (ii = 0; ii < inum; ii++) nsum += (numneigh ? numneigh[ilist[ii]] : 0) + 1.0;
+    t /= nsum;
+    for (ii = 0; ii < inum; ii++) cost[ilist[ii]] += t * ((numneigh ? numneigh[ilist[ii]] : 0) + 1.0);
+    return;
+  }
+
+  // the fdotr virial is only done with the last slice, once all forces are known
+
+  int vflag_slice = vflag;
+  if (no_virial_fdotr_compute == 0) vflag_slice &= ~VIRIAL_FDOTR;
+
+  double evdwl = 0.0, ecoul = 0.0;
+  double v[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  int n;
+
+  for (int ifrom = 0; ifrom < inum; ifrom += COSTSLICE) {
+    n = MIN(COSTSLICE,inum-ifrom);
+    list->inum = n;
+    list->ilist = ilist + ifrom;
+    t = platform::walltime();
+    compute(eflag, (ifrom+n < inum) ? vflag_slice : vflag);
+    t = (platform::walltime() - t) / n;
+    for (ii = ifrom; ii < ifrom+n; ii++) cost[ilist[ii]] += t;
+
+    if (eflag_global) {
+      evdwl += eng_vdwl;
+      ecoul += eng_coul;
+    }
+    if (vflag_global)
+      for (int i = 0; i < 6; i++) v[i] += virial[i];
+  }
+  list->inum = inum;
+  list->ilist = ilist;
+
+  if (eflag_global) {
+    eng_vdwl = evdwl;
+    eng_coul = ecoul;
+  }
+  if (vflag_global)
+    for (int i = 0; i < 6; i++) virial[i] = v[i];
+}
+
+/* ----------------------------------------------------------------------
+   copy per type pair coeffs to single precision for mixed precision kernels
+   single is allocated on first use and must be destroyed by the pair style
+   cheap enough to be called on every compute(), so changes of coeffs
+     e.g. by fix adapt are always picked up
+------------------------------------------------------------------------- */
+
+void Pair::coeff_single(float **&single, double **coeff)
+{
+  const int n = atom->ntypes;
+  if (!single) memory->create(single,n+1,n+1,"pair:coeff_single");
+
+  for (int i = 1; i <= n; i++)
+    for (int j = 1; j <= n; j++) single[i][j] = coeff[i][j];
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Pair::read_restart(FILE *)
@@ -56,6 +56,9 @@ class Pair : protected Pointers {
   int single_hessian_enable;      // 1 if single_hessian() routine exists
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
+  int overlap_enable;             // 1 if compute() can be split into interior/border atoms
+  int costflag;                   // 1 if per-atom cost of compute() is measured
+  int mixed_prec_enable;          // 1 if compute() has a mixed precision kernel
   int one_coeff;                  // 1 if allows only one coeff * * call
   int manybody_flag;              // 1 if a manybody potential
   int unit_convert_flag;          // value != 0 indicates support for unit conversion.
@@ -82,7 +85,8 @@ class Pair : protected Pointers {
   int tail_flag;          // pair_modify flag for LJ tail correction
   double etail, ptail;    // energy/pressure tail corrections
   double etail_ij, ptail_ij;
-  int trim_flag;    // pair_modify flag for trimming neigh list
+  int trim_flag;          // pair_modify flag for trimming neigh list
+  int mixed_prec_flag;    // pair_modify flag for mixed precision kernel
 
   int evflag;    // energy,virial settings
   int eflag_either, eflag_global, eflag_atom;
@@ -141,6 +145,9 @@ class Pair : protected Pointers {
   void init_bitmap(double, double, int, int &, int &, int &, int &);
   virtual void modify_params(int, char **);
   void compute_dummy(int, int);
+  void compute_interior(int, int);
+  void compute_border(int, int);
+  void compute_cost(int, int);
 
   // need to be public, so can be called by pair_style reaxc
 
@@ -278,6 +285,15 @@ class Pair : protected Pointers {
   int vflag_fdotr;
   int maxeatom, maxvatom, maxcvatom;
 
+  double eng_vdwl_interior, eng_coul_interior;    // accumulated by compute_interior()
+  double virial_interior[6];
+
+  // per type pair coeffs in the precision of a mixed precision kernel
+
+  static double **coeff_prec(double **c, float **, double) { return c; }
+  static float **coeff_prec(double **, float **cs, float) { return cs; }
+  void coeff_single(float **&, double **);
+
   int copymode;    // if set, do not deallocate during destruction
                    // required when classes are used as functors by Kokkos
 
@@ -33,6 +33,7 @@ using namespace MathConst;
 PairBuck::PairBuck(LAMMPS *lmp) : Pair(lmp)
 {
   born_matrix_enable = 1;
+  overlap_enable = 1;
   writedata = 1;
 }
 
@@ -41,6 +41,10 @@ PairHybrid::PairHybrid(LAMMPS *lmp) :
 
   outerflag = 0;
   respaflag = 0;
+
+  // precision is checked for each sub-style in init_style()
+
+  mixed_prec_enable = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -613,6 +617,15 @@ void PairHybrid::init_style()
       error->all(FLERR,"GPU package styles must not be used multiple times");
   }
 
+  // sub-styles without a mixed precision kernel use double precision
+
+  for (istyle = 0; istyle < nstyles; istyle++) {
+    if (styles[istyle]->suffix_flag) styles[istyle]->mixed_prec_enable = 0;
+    if (styles[istyle]->mixed_prec_flag && !styles[istyle]->mixed_prec_enable && comm->me == 0)
+      error->warning(FLERR,"Pair hybrid sub-style {} has no mixed precision kernel, "
+                     "using double precision", keywords[istyle]);
+  }
+
   // check if special_lj/special_coul overrides are compatible
 
   for (istyle = 0; istyle < nstyles; istyle++) {
@@ -39,8 +39,11 @@ using namespace MathConst;
 PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
 {
   respa_enable = 1;
+  overlap_enable = 1;
   born_matrix_enable = 1;
+  mixed_prec_enable = 1;
   writedata = 1;
+  cutsqf = lj1f = lj2f = lj3f = lj4f = offsetf = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -62,27 +65,79 @@ PairLJCut::~PairLJCut()
     memory->destroy(lj4);
     memory->destroy(offset);
   }
+
+  memory->destroy(cutsqf);
+  memory->destroy(lj1f);
+  memory->destroy(lj2f);
+  memory->destroy(lj3f);
+  memory->destroy(lj4f);
+  memory->destroy(offsetf);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairLJCut::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  if (mixed_prec_flag) {
+    coeff_single(cutsqf, cutsq);
+    coeff_single(lj1f, lj1);
+    coeff_single(lj2f, lj2);
+    coeff_single(lj3f, lj3);
+    coeff_single(lj4f, lj4);
+    coeff_single(offsetf, offset);
+  }
+
+  // read coords from the unit-stride SoA copy if it is current
+  // else from the x array with stride 3
+
+  if (atom->soa_valid) {
+    if (mixed_prec_flag)
+      eval<1, float>(atom->soa_x(), atom->soa_y(), atom->soa_z());
+    else
+      eval<1, double>(atom->soa_x(), atom->soa_y(), atom->soa_z());
+  } else if (atom->x) {
+    if (mixed_prec_flag)
+      eval<3, float>(&atom->x[0][0], &atom->x[0][1], &atom->x[0][2]);
+    else
+      eval<3, double>(&atom->x[0][0], &atom->x[0][1], &atom->x[0][2]);
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   force kernel with distances and forces in precision flt_t
+   coords are read in double, their differences are stored in flt_t
+   per-atom forces and energies are accumulated in double
+------------------------------------------------------------------------- */
+
+template <int STRIDE, class flt_t>
+void PairLJCut::eval(const double *_noalias xs, const double *_noalias ys,
+                     const double *_noalias zs)
 {
   int i, j, ii, jj, inum, jnum, itype, jtype;
-  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
-  double rsq, r2inv, r6inv, forcelj, factor_lj;
+  double xtmp, ytmp, ztmp, evdwl;
+  flt_t delx, dely, delz, fpair;
+  flt_t rsq, r2inv, r6inv, forcelj, factor_lj;
   int *ilist, *jlist, *numneigh, **firstneigh;
 
   evdwl = 0.0;
-  ev_init(eflag, vflag);
 
-  double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
   int nlocal = atom->nlocal;
   double *special_lj = force->special_lj;
   int newton_pair = force->newton_pair;
 
+  flt_t **cutsq_p = coeff_prec(cutsq, cutsqf, flt_t());
+  flt_t **lj1_p = coeff_prec(lj1, lj1f, flt_t());
+  flt_t **lj2_p = coeff_prec(lj2, lj2f, flt_t());
+  flt_t **lj3_p = coeff_prec(lj3, lj3f, flt_t());
+  flt_t **lj4_p = coeff_prec(lj4, lj4f, flt_t());
+  flt_t **offset_p = coeff_prec(offset, offsetf, flt_t());
+
   inum = list->inum;
   ilist = list->ilist;
   numneigh = list->numneigh;
@@ -92,9 +147,9 @@ void PairLJCut::compute(int eflag, int vflag)
 
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
+    xtmp = xs[STRIDE * i];
+    ytmp = ys[STRIDE * i];
+    ztmp = zs[STRIDE * i];
     itype = type[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
@@ -104,16 +159,16 @@ void PairLJCut::compute(int eflag, int vflag)
       factor_lj = special_lj[sbmask(j)];
       j &= NEIGHMASK;
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
+      delx = xtmp - xs[STRIDE * j];
+      dely = ytmp - ys[STRIDE * j];
+      delz = ztmp - zs[STRIDE * j];
       rsq = delx * delx + dely * dely + delz * delz;
       jtype = type[j];
 
-      if (rsq < cutsq[itype][jtype]) {
-        r2inv = 1.0 / rsq;
+      if (rsq < cutsq_p[itype][jtype]) {
+        r2inv = (flt_t) 1.0 / rsq;
         r6inv = r2inv * r2inv * r2inv;
-        forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype]);
+        forcelj = r6inv * (lj1_p[itype][jtype] * r6inv - lj2_p[itype][jtype]);
         fpair = factor_lj * forcelj * r2inv;
 
         f[i][0] += delx * fpair;
@@ -125,8 +180,9 @@ void PairLJCut::compute(int eflag, int vflag)
           f[j][2] -= delz * fpair;
         }
 
-        if (eflag) {
-          evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) - offset[itype][jtype];
+        if (eflag_either) {
+          evdwl = r6inv * (lj3_p[itype][jtype] * r6inv - lj4_p[itype][jtype]) -
+              offset_p[itype][jtype];
           evdwl *= factor_lj;
         }
 
@@ -134,8 +190,6 @@ void PairLJCut::compute(int eflag, int vflag)
       }
     }
   }
-
-  if (vflag_fdotr) virial_fdotr_compute();
 }
 
 /* ---------------------------------------------------------------------- */
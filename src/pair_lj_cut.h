@@ -53,8 +53,10 @@ class PairLJCut : public Pair {
   double **epsilon, **sigma;
   double **lj1, **lj2, **lj3, **lj4, **offset;
   double *cut_respa;
+  float **cutsqf, **lj1f, **lj2f, **lj3f, **lj4f, **offsetf;    // for mixed precision
 
   virtual void allocate();
+  template <int STRIDE, class flt_t> void eval(const double *, const double *, const double *);
 };
 
 }    // namespace LAMMPS_NS
@@ -0,0 +1,282 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_cluster.h"
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCluster::PairLJCutCluster(LAMMPS *lmp) : PairLJCut(lmp)
+{
+  respa_enable = 0;
+  overlap_enable = 0;
+  mixed_prec_enable = 0;
+  no_virial_fdotr_compute = 1;
+  clustersize = 4;
+  maxpack = 0;
+  xpack = nullptr;
+  typepack = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCluster::~PairLJCutCluster()
+{
+  if (copymode) return;
+
+  memory->destroy(xpack);
+  memory->destroy(typepack);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCluster::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  pack_clusters();
+
+  if (clustersize == 8) {
+    if (evflag) eval<8, 1>();
+    else eval<8, 0>();
+  } else {
+    if (evflag) eval<4, 1>();
+    else eval<4, 0>();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy coords and types into cluster order so J clusters are unit stride
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::pack_clusters()
+{
+  const int csize = clustersize;
+  const int nclus = list->nclus;
+  const int *clatom = list->clatom;
+  double **x = atom->x;
+  int *type = atom->type;
+
+  if (nclus > maxpack) {
+    maxpack = list->maxclus;
+    memory->destroy(xpack);
+    memory->destroy(typepack);
+    memory->create(xpack, 3 * csize * maxpack, "pair:xpack");
+    memory->create(typepack, csize * maxpack, "pair:typepack");
+  }
+
+  for (int c = 0; c < nclus; c++) {
+    double *xc = &xpack[3 * csize * c];
+    int *tc = &typepack[csize * c];
+    for (int m = 0; m < csize; m++) {
+      const int i = clatom[c * csize + m];
+      if (i >= 0) {
+        xc[m] = x[i][0];
+        xc[csize + m] = x[i][1];
+        xc[2 * csize + m] = x[i][2];
+        tc[m] = type[i];
+      } else {
+        xc[m] = xc[csize + m] = xc[2 * csize + m] = 0.0;
+        tc[m] = 1;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   cluster-pair kernel, full list, forces only on owned I atoms
+   the inner loop over the CSIZE atoms of a J cluster has no branches
+   pairs not set in the interaction mask or beyond cutoff get fpair = 0
+------------------------------------------------------------------------- */
+
+template <int CSIZE, int EVFLAG> void PairLJCutCluster::eval()
+{
+  int i, j, ii, jj, jnum, itype, jtype;
+  double xtmp, ytmp, ztmp, delx, dely, delz, rsq, r2inv, r6inv, forcelj, fpair;
+  double factor_lj, evdwl = 0.0;
+  int *jlist;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double *special_lj = force->special_lj;
+
+  const int stride = 1 + list->cmaskwords;
+  const int *_noalias clatom = list->clatom;
+  const double *_noalias xp = xpack;
+  const int *_noalias tp = typepack;
+
+  for (ii = 0; ii < list->cinum; ii++) {
+    const int ci = list->cilist[ii];
+    const double *_noalias xi = &xp[3 * CSIZE * ci];
+    const int *_noalias ti = &tp[CSIZE * ci];
+    const int *jclist = list->cfirstneigh[ci];
+    const int jcnum = list->cnumneigh[ci];
+
+    double fxi[CSIZE], fyi[CSIZE], fzi[CSIZE];
+    for (int mi = 0; mi < CSIZE; mi++) fxi[mi] = fyi[mi] = fzi[mi] = 0.0;
+
+    for (jj = 0; jj < jcnum; jj++) {
+      const int *entry = &jclist[jj * stride];
+      const int cj = entry[0];
+      uint64_t bits = static_cast<uint32_t>(entry[1]);
+      if (CSIZE == 8) bits |= static_cast<uint64_t>(static_cast<uint32_t>(entry[2])) << 32;
+
+      const double *_noalias xj = &xp[3 * CSIZE * cj];
+      const int *_noalias tj = &tp[CSIZE * cj];
+
+      for (int mi = 0; mi < CSIZE; mi++) {
+        const unsigned int ibits = (bits >> (mi * CSIZE)) & ((1U << CSIZE) - 1);
+        if (!ibits) continue;
+
+        xtmp = xi[mi];
+        ytmp = xi[CSIZE + mi];
+        ztmp = xi[2 * CSIZE + mi];
+        itype = ti[mi];
+        const double *_noalias cutsqi = cutsq[itype];
+        const double *_noalias lj1i = lj1[itype];
+        const double *_noalias lj2i = lj2[itype];
+
+        double sfx = 0.0, sfy = 0.0, sfz = 0.0;
+        for (int mj = 0; mj < CSIZE; mj++) {
+          delx = xtmp - xj[mj];
+          dely = ytmp - xj[CSIZE + mj];
+          delz = ztmp - xj[2 * CSIZE + mj];
+          rsq = delx * delx + dely * dely + delz * delz;
+          jtype = tj[mj];
+          const bool inter = ((ibits >> mj) & 1U) && (rsq < cutsqi[jtype]);
+
+          r2inv = 1.0 / (inter ? rsq : 1.0);
+          r6inv = r2inv * r2inv * r2inv;
+          forcelj = r6inv * (lj1i[jtype] * r6inv - lj2i[jtype]);
+          fpair = inter ? forcelj * r2inv : 0.0;
+
+          sfx += delx * fpair;
+          sfy += dely * fpair;
+          sfz += delz * fpair;
+
+          if (EVFLAG && inter) {
+            if (eflag_either) evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) -
+                  offset[itype][jtype];
+            ev_tally_full(clatom[CSIZE * ci + mi], evdwl, 0.0, fpair, delx, dely, delz);
+          }
+        }
+        fxi[mi] += sfx;
+        fyi[mi] += sfy;
+        fzi[mi] += sfz;
+      }
+    }
+
+    for (int mi = 0; mi < CSIZE; mi++) {
+      i = clatom[CSIZE * ci + mi];
+      if (i < 0 || i >= nlocal) continue;
+      f[i][0] += fxi[mi];
+      f[i][1] += fyi[mi];
+      f[i][2] += fzi[mi];
+    }
+  }
+
+  // special pairs are kept out of the cluster masks and handled per atom
+
+  for (ii = 0; ii < list->inum; ii++) {
+    i = list->ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    jlist = list->firstneigh[i];
+    jnum = list->numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < cutsq[itype][jtype]) {
+        r2inv = 1.0 / rsq;
+        r6inv = r2inv * r2inv * r2inv;
+        forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype]);
+        fpair = factor_lj * forcelj * r2inv;
+
+        f[i][0] += delx * fpair;
+        f[i][1] += dely * fpair;
+        f[i][2] += delz * fpair;
+
+        if (EVFLAG) {
+          if (eflag_either) {
+            evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) - offset[itype][jtype];
+            evdwl *= factor_lj;
+          }
+          ev_tally_full(i, evdwl, 0.0, fpair, delx, dely, delz);
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   global settings, optional trailing cluster keyword
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::settings(int narg, char **arg)
+{
+  if ((narg > 2) && (strcmp(arg[narg - 2], "cluster") == 0)) {
+    clustersize = utils::inumeric(FLERR, arg[narg - 1], false, lmp);
+    if ((clustersize != 4) && (clustersize != 8))
+      error->all(FLERR, "Pair style {} cluster size must be 4 or 8", force->pair_style);
+    narg -= 2;
+  }
+  PairLJCut::settings(narg, arg);
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::init_style()
+{
+  PairLJCut::init_style();
+
+  auto req = neighbor->find_request(this);
+  req->enable_full();
+  req->set_cluster(clustersize);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJCutCluster::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double) 3 * clustersize * maxpack * sizeof(double);
+  bytes += (double) clustersize * maxpack * sizeof(int);
+  return bytes;
+}
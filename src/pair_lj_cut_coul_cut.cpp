@@ -33,7 +33,11 @@ using namespace MathConst;
 PairLJCutCoulCut::PairLJCutCoulCut(LAMMPS *lmp) : Pair(lmp)
 {
   born_matrix_enable = 1;
+  overlap_enable = 1;
+  mixed_prec_enable = 1;
   writedata = 1;
+  cutsqf = cut_ljsqf = cut_coulsqf = nullptr;
+  lj1f = lj2f = lj3f = lj4f = offsetf = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -58,19 +62,54 @@ PairLJCutCoulCut::~PairLJCutCoulCut()
     memory->destroy(lj4);
     memory->destroy(offset);
   }
+
+  memory->destroy(cutsqf);
+  memory->destroy(cut_ljsqf);
+  memory->destroy(cut_coulsqf);
+  memory->destroy(lj1f);
+  memory->destroy(lj2f);
+  memory->destroy(lj3f);
+  memory->destroy(lj4f);
+  memory->destroy(offsetf);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairLJCutCoulCut::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  if (mixed_prec_flag) {
+    coeff_single(cutsqf, cutsq);
+    coeff_single(cut_ljsqf, cut_ljsq);
+    coeff_single(cut_coulsqf, cut_coulsq);
+    coeff_single(lj1f, lj1);
+    coeff_single(lj2f, lj2);
+    coeff_single(lj3f, lj3);
+    coeff_single(lj4f, lj4);
+    coeff_single(offsetf, offset);
+    eval<float>(eflag);
+  } else
+    eval<double>(eflag);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   force kernel with distances and forces in precision flt_t
+   coords are read in double, their differences are stored in flt_t
+   per-atom forces and energies are accumulated in double
+------------------------------------------------------------------------- */
+
+template <class flt_t> void PairLJCutCoulCut::eval(int eflag)
 {
   int i, j, ii, jj, inum, jnum, itype, jtype;
-  double qtmp, xtmp, ytmp, ztmp, delx, dely, delz, evdwl, ecoul, fpair;
-  double rsq, r2inv, r6inv, forcecoul, forcelj, factor_coul, factor_lj;
+  double qtmp, xtmp, ytmp, ztmp, evdwl, ecoul;
+  flt_t delx, dely, delz, fpair;
+  flt_t rsq, r2inv, r6inv, forcecoul, forcelj, factor_coul, factor_lj;
   int *ilist, *jlist, *numneigh, **firstneigh;
 
   evdwl = ecoul = 0.0;
-  ev_init(eflag, vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -82,6 +121,15 @@ void PairLJCutCoulCut::compute(int eflag, int vflag)
   int newton_pair = force->newton_pair;
   double qqrd2e = force->qqrd2e;
 
+  flt_t **cutsq_p = coeff_prec(cutsq, cutsqf, flt_t());
+  flt_t **cut_ljsq_p = coeff_prec(cut_ljsq, cut_ljsqf, flt_t());
+  flt_t **cut_coulsq_p = coeff_prec(cut_coulsq, cut_coulsqf, flt_t());
+  flt_t **lj1_p = coeff_prec(lj1, lj1f, flt_t());
+  flt_t **lj2_p = coeff_prec(lj2, lj2f, flt_t());
+  flt_t **lj3_p = coeff_prec(lj3, lj3f, flt_t());
+  flt_t **lj4_p = coeff_prec(lj4, lj4f, flt_t());
+  flt_t **offset_p = coeff_prec(offset, offsetf, flt_t());
+
   inum = list->inum;
   ilist = list->ilist;
   numneigh = list->numneigh;
@@ -111,17 +159,17 @@ void PairLJCutCoulCut::compute(int eflag, int vflag)
       rsq = delx * delx + dely * dely + delz * delz;
       jtype = type[j];
 
-      if (rsq < cutsq[itype][jtype]) {
-        r2inv = 1.0 / rsq;
+      if (rsq < cutsq_p[itype][jtype]) {
+        r2inv = (flt_t) 1.0 / rsq;
 
-        if (rsq < cut_coulsq[itype][jtype])
-          forcecoul = qqrd2e * qtmp * q[j] * sqrt(r2inv);
+        if (rsq < cut_coulsq_p[itype][jtype])
+          forcecoul = (flt_t) (qqrd2e * qtmp * q[j]) * std::sqrt(r2inv);
         else
           forcecoul = 0.0;
 
-        if (rsq < cut_ljsq[itype][jtype]) {
+        if (rsq < cut_ljsq_p[itype][jtype]) {
           r6inv = r2inv * r2inv * r2inv;
-          forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype]);
+          forcelj = r6inv * (lj1_p[itype][jtype] * r6inv - lj2_p[itype][jtype]);
         } else
           forcelj = 0.0;
 
@@ -137,12 +185,13 @@ void PairLJCutCoulCut::compute(int eflag, int vflag)
         }
 
         if (eflag) {
-          if (rsq < cut_coulsq[itype][jtype])
-            ecoul = factor_coul * qqrd2e * qtmp * q[j] * sqrt(r2inv);
+          if (rsq < cut_coulsq_p[itype][jtype])
+            ecoul = factor_coul * qqrd2e * qtmp * q[j] * std::sqrt(r2inv);
           else
             ecoul = 0.0;
-          if (rsq < cut_ljsq[itype][jtype]) {
-            evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) - offset[itype][jtype];
+          if (rsq < cut_ljsq_p[itype][jtype]) {
+            evdwl = r6inv * (lj3_p[itype][jtype] * r6inv - lj4_p[itype][jtype]) -
+                offset_p[itype][jtype];
             evdwl *= factor_lj;
           } else
             evdwl = 0.0;
@@ -152,8 +201,6 @@ void PairLJCutCoulCut::compute(int eflag, int vflag)
       }
     }
   }
-
-  if (vflag_fdotr) virial_fdotr_compute();
 }
 
 /* ----------------------------------------------------------------------
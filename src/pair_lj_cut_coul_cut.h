@@ -49,8 +49,11 @@ class PairLJCutCoulCut : public Pair {
   double **cut_coul, **cut_coulsq;
   double **epsilon, **sigma;
   double **lj1, **lj2, **lj3, **lj4, **offset;
+  float **cutsqf, **cut_ljsqf, **cut_coulsqf;    // for mixed precision
+  float **lj1f, **lj2f, **lj3f, **lj4f, **offsetf;
 
   virtual void allocate();
+  template <class flt_t> void eval(int);
 };
 
 }    // namespace LAMMPS_NS
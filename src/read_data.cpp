@@ -31,6 +31,7 @@
 #include "improper.h"
 #include "irregular.h"
 #include "label_map.h"
+#include "lmpbinarydata.h"
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
@@ -39,6 +40,7 @@
 #include "tokenizer.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <unordered_map>
@@ -49,6 +51,8 @@ using namespace LAMMPS_NS;
 static constexpr int MAXLINE = 256;
 static constexpr double LB_FACTOR = 1.1;
 static constexpr int CHUNK = 1024;
+static constexpr int MAXCHUNK = 256 * CHUNK;    // max # of lines per chunk in parallel mode
+static constexpr int RVOUS = 1;                 // 0 for irregular, 1 for all2all
 static constexpr int DELTA = 4;       // must be 2 or larger
 static constexpr int MAXBODY = 32;    // max # of lines in one body
 
@@ -77,6 +81,29 @@ bool ReadData::is_data_section(const std::string &keyword)
 
 enum{NONE, APPEND, VALUE, MERGE};
 
+// datums for rendezvous comm of parallel mode
+
+namespace {
+struct IDRvous {
+  int me;
+  tagint atomID;
+};
+
+struct LineRvous {
+  bigint index;    // index of line in section
+  tagint atomID;
+  char line[MAXLINE];
+};
+}    // namespace
+
+// reverse byte order of N values of given size, for binary data files
+
+static void swap_bytes(void *ptr, int size, int n)
+{
+  auto bytes = (unsigned char *) ptr;
+  for (int i = 0; i < n; i++, bytes += size) std::reverse(bytes, bytes + size);
+}
+
 // pair style suffixes to ignore
 // when matching Pair Coeffs comment to currently-defined pair style
 
@@ -90,12 +117,25 @@ static const char *labeltypes[] = {"Atom", "Bond", "Angle", "Dihedral", "Imprope
 ReadData::ReadData(LAMMPS *_lmp) : Command(_lmp), fp(nullptr), coeffarg(nullptr), lmap(nullptr)
 {
   MPI_Comm_rank(world, &me);
+  MPI_Comm_size(world, &nprocs);
   line = new char[MAXLINE];
   keyword = new char[MAXLINE];
   style = new char[MAXLINE];
   buffer = new char[CHUNK * MAXLINE];
+  maxbuffer = CHUNK;
   ncoeffarg = maxcoeffarg = 0;
 
+  parallelflag = 0;
+  pchunk = CHUNK;
+  readbuf = nullptr;
+  ownerflag = 0;
+
+  binary = swapflag = 0;
+  textoffset = 0;
+  fpbin = nullptr;
+  rowbuf = nullptr;
+  maxrows = 0;
+
   // customize for new sections
   // pointers to atom styles that store bonus info
 
@@ -117,6 +157,8 @@ ReadData::~ReadData()
   delete[] keyword;
   delete[] style;
   delete[] buffer;
+  delete[] readbuf;
+  memory->destroy(rowbuf);
   memory->sfree(coeffarg);
 
   for (int i = 0; i < nfix; i++) {
@@ -209,6 +251,10 @@ void ReadData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg], "nocoeff") == 0) {
       coeffflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel", error);
+      parallelflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg], "extra/atom/types") == 0) {
       if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data extra/atom/types", error);
       extra_atom_types = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
@@ -366,6 +412,28 @@ void ReadData::command(int narg, char **arg)
   if (!platform::file_is_readable(arg[0]))
     error->all(FLERR, "Cannot open file {}: {}", arg[0], utils::getsyserror());
 
+  // check if data file is a binary data file written by write_data
+  // if so, all procs open it to read their share of each section stored as columns
+
+  binary = 0;
+  if (me == 0 && !platform::has_compress_extension(arg[0])) binary_check(arg[0]);
+  MPI_Bcast(&binary, 1, MPI_INT, 0, world);
+  if (binary) {
+    MPI_Bcast(&swapflag, 1, MPI_INT, 0, world);
+    MPI_Bcast(&textoffset, 1, MPI_LMP_BIGINT, 0, world);
+    fpbin = fopen(arg[0], "rb");
+    if (!fpbin) error->one(FLERR, "Cannot open file {}: {}", arg[0], utils::getsyserror());
+  }
+
+  // parallel mode: proc 0 reads chunks of lines for all procs
+  // always used for binary data files, procs then read their own rows
+
+  if (binary) parallelflag = 1;
+  if (nprocs == 1) parallelflag = 0;
+  if (parallelflag || binary) pchunk = static_cast<int>(MIN((bigint) CHUNK * nprocs, MAXCHUNK));
+  if (parallelflag && !binary && me == 0) readbuf = new char[(bigint) pchunk * MAXLINE];
+  ownerflag = 0;
+
   // reset so we can warn about reset image flags exactly once per data file
 
   atom->reset_image_flag[0] = atom->reset_image_flag[1] = atom->reset_image_flag[2] = false;
@@ -707,14 +775,14 @@ void ReadData::command(int narg, char **arg)
                 style, atom->atom_style);
           atoms();
         } else
-          skip_lines(natoms);
+          skip_lines(binary ? 1 : natoms);
 
       } else if (strcmp(keyword, "Velocities") == 0) {
         if (atomflag == 0) error->all(FLERR, "Must read Atoms before Velocities");
         if (firstpass)
           velocities();
         else
-          skip_lines(natoms);
+          skip_lines(binary ? 1 : natoms);
 
       } else if (strcmp(keyword, "Bonds") == 0) {
         topoflag = bondflag = 1;
@@ -747,7 +815,7 @@ void ReadData::command(int narg, char **arg)
         if (firstpass)
           bonus(nellipsoids, (AtomVec *) avec_ellipsoid, "ellipsoids");
         else
-          skip_lines(nellipsoids);
+          skip_lines(binary ? 1 : nellipsoids);
 
       } else if (strcmp(keyword, "Lines") == 0) {
         lineflag = 1;
@@ -756,7 +824,7 @@ void ReadData::command(int narg, char **arg)
         if (firstpass)
           bonus(nlines, (AtomVec *) avec_line, "lines");
         else
-          skip_lines(nlines);
+          skip_lines(binary ? 1 : nlines);
 
       } else if (strcmp(keyword, "Triangles") == 0) {
         triflag = 1;
@@ -765,7 +833,7 @@ void ReadData::command(int narg, char **arg)
         if (firstpass)
           bonus(ntris, (AtomVec *) avec_tri, "triangles");
         else
-          skip_lines(ntris);
+          skip_lines(binary ? 1 : ntris);
 
       } else if (strcmp(keyword, "Bodies") == 0) {
         bodyflag = 1;
@@ -1065,6 +1133,17 @@ void ReadData::command(int narg, char **arg)
     atom->avec->grow(atom->nmax);
   }
 
+  if (fpbin) {
+    fclose(fpbin);
+    fpbin = nullptr;
+  }
+
+  // in parallel mode, atoms were kept by the procs that parsed them
+  // move them to the procs owning their sub-domain now that all
+  //   per-atom sections (incl bonus data) have been read
+
+  if (parallelflag) migrate_atoms();
+
   // if general triclinic, perform general to restricted rotation operation
   //   on any quantities read from data file which require it
 
@@ -1515,20 +1594,27 @@ void ReadData::header(int firstpass)
 
 void ReadData::atoms()
 {
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   if (me == 0) utils::logmesg(lmp, "  reading atoms ...\n");
 
   bigint nread = 0;
 
+  // in parallel mode, each proc keeps all atoms in its block of lines
+  //   and they are migrated to their owning procs after all sections are read
+
+  if (binary) binary_section("Atoms", natoms, atom->avec->data_columns(0));
+
   while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+    nbuf = read_chunk(natoms - nread, nread, 0, nullptr, "Atoms", nchunk);
     if (tlabelflag && !lmap->is_complete(Atom::ATOM))
       error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
-    atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset,
-                     shiftflag, shift, tlabelflag, lmap->lmap2lmap.atom, triclinic_general);
+    if (nbuf && binary)
+      atom->data_atoms_binary(nbuf, rowbuf, id_offset, mol_offset, toffset, shiftflag, shift,
+                              tlabelflag, lmap->lmap2lmap.atom, triclinic_general, parallelflag);
+    else if (nbuf)
+      atom->data_atoms(nbuf, buffer, id_offset, mol_offset, toffset, shiftflag, shift, tlabelflag,
+                       lmap->lmap2lmap.atom, triclinic_general, parallelflag);
     nread += nchunk;
   }
 
@@ -1586,17 +1672,17 @@ void ReadData::atoms()
 void ReadData::velocities()
 {
   bigint nread = 0;
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   // cannot map velocities to atoms without atom IDs
 
+  if (binary) binary_section("Velocities", natoms, atom->avec->data_columns(1));
+
   if (!atom->tag_enable) {
     if (me == 0) utils::logmesg(lmp, "  skipping velocities without atom IDs ...\n");
 
-    while (nread < natoms) {
-      nchunk = MIN(natoms - nread, CHUNK);
-      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-      if (eof) error->all(FLERR, "Unexpected end of data file");
+    while (!binary && nread < natoms) {
+      read_chunk(natoms - nread, nread, 0, nullptr, "Velocities", nchunk);
       nread += nchunk;
     }
     return;
@@ -1611,11 +1697,14 @@ void ReadData::velocities()
     atom->map_set();
   }
 
+  const int cols[1] = {0};
+
   while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
-    atom->data_vels(nchunk, buffer, id_offset);
+    nbuf = read_chunk(natoms - nread, nread, 1, cols, "Velocities", nchunk);
+    if (binary)
+      atom->data_vels_binary(nbuf, rowbuf, id_offset);
+    else
+      atom->data_vels(nbuf, buffer, id_offset, parallelflag);
     nread += nchunk;
   }
 
@@ -1633,7 +1722,7 @@ void ReadData::velocities()
 
 void ReadData::bonds(int firstpass)
 {
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   if (me == 0) {
     if (firstpass)
@@ -1652,18 +1741,30 @@ void ReadData::bonds(int firstpass)
   }
 
   // read and process bonds
+  // in parallel mode, each line is sent to the procs owning the atoms
+  //   which Atom::data_bonds() stores it with
+
+  const int cols_on[1] = {2};
+  const int cols_off[2] = {2, 3};
+  int ncol = force->newton_bond ? 1 : 2;
+  const int *cols = force->newton_bond ? cols_on : cols_off;
 
   bigint nread = 0;
 
+  if (binary) binary_section("Bonds", nbonds, std::string(4, 'i'));
+
   while (nread < nbonds) {
-    nchunk = MIN(nbonds - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+    nbuf = read_chunk(nbonds - nread, nread, ncol, cols, "Bonds", nchunk);
     if (blabelflag && !lmap->is_complete(Atom::BOND))
       error->all(FLERR,
                  "Label map is incomplete: "
                  "all types must be assigned a unique type label");
-    atom->data_bonds(nchunk, buffer, count, id_offset, boffset, blabelflag, lmap->lmap2lmap.bond);
+    if (binary)
+      atom->data_topology_binary(Atom::BOND, nbuf, rowbuf, count, id_offset, boffset, blabelflag,
+                                 lmap->lmap2lmap.bond);
+    else
+      atom->data_bonds(nbuf, buffer, count, id_offset, boffset, blabelflag, lmap->lmap2lmap.bond,
+                       parallelflag);
     nread += nchunk;
   }
 
@@ -1712,7 +1813,7 @@ void ReadData::bonds(int firstpass)
 
 void ReadData::angles(int firstpass)
 {
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   if (me == 0) {
     if (firstpass)
@@ -1731,18 +1832,30 @@ void ReadData::angles(int firstpass)
   }
 
   // read and process angles
+  // in parallel mode, each line is sent to the procs owning the atoms
+  //   which Atom::data_angles() stores it with
+
+  const int cols_on[1] = {3};
+  const int cols_off[3] = {2, 3, 4};
+  int ncol = force->newton_bond ? 1 : 3;
+  const int *cols = force->newton_bond ? cols_on : cols_off;
 
   bigint nread = 0;
 
+  if (binary) binary_section("Angles", nangles, std::string(5, 'i'));
+
   while (nread < nangles) {
-    nchunk = MIN(nangles - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+    nbuf = read_chunk(nangles - nread, nread, ncol, cols, "Angles", nchunk);
     if (alabelflag && !lmap->is_complete(Atom::ANGLE))
       error->all(FLERR,
                  "Label map is incomplete: "
                  "all types must be assigned a unique type label");
-    atom->data_angles(nchunk, buffer, count, id_offset, aoffset, alabelflag, lmap->lmap2lmap.angle);
+    if (binary)
+      atom->data_topology_binary(Atom::ANGLE, nbuf, rowbuf, count, id_offset, aoffset, alabelflag,
+                                 lmap->lmap2lmap.angle);
+    else
+      atom->data_angles(nbuf, buffer, count, id_offset, aoffset, alabelflag, lmap->lmap2lmap.angle,
+                        parallelflag);
     nread += nchunk;
   }
 
@@ -1791,7 +1904,7 @@ void ReadData::angles(int firstpass)
 
 void ReadData::dihedrals(int firstpass)
 {
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   if (me == 0) {
     if (firstpass)
@@ -1810,19 +1923,30 @@ void ReadData::dihedrals(int firstpass)
   }
 
   // read and process dihedrals
+  // in parallel mode, each line is sent to the procs owning the atoms
+  //   which Atom::data_dihedrals() stores it with
+
+  const int cols_on[1] = {3};
+  const int cols_off[4] = {2, 3, 4, 5};
+  int ncol = force->newton_bond ? 1 : 4;
+  const int *cols = force->newton_bond ? cols_on : cols_off;
 
   bigint nread = 0;
 
+  if (binary) binary_section("Dihedrals", ndihedrals, std::string(6, 'i'));
+
   while (nread < ndihedrals) {
-    nchunk = MIN(ndihedrals - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+    nbuf = read_chunk(ndihedrals - nread, nread, ncol, cols, "Dihedrals", nchunk);
     if (dlabelflag && !lmap->is_complete(Atom::DIHEDRAL))
       error->all(FLERR,
                  "Label map is incomplete: "
                  "all types must be assigned a unique type label");
-    atom->data_dihedrals(nchunk, buffer, count, id_offset, doffset, dlabelflag,
-                         lmap->lmap2lmap.dihedral);
+    if (binary)
+      atom->data_topology_binary(Atom::DIHEDRAL, nbuf, rowbuf, count, id_offset, doffset,
+                                 dlabelflag, lmap->lmap2lmap.dihedral);
+    else
+      atom->data_dihedrals(nbuf, buffer, count, id_offset, doffset, dlabelflag,
+                           lmap->lmap2lmap.dihedral, parallelflag);
     nread += nchunk;
   }
 
@@ -1871,7 +1995,7 @@ void ReadData::dihedrals(int firstpass)
 
 void ReadData::impropers(int firstpass)
 {
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   if (me == 0) {
     if (firstpass)
@@ -1890,19 +2014,30 @@ void ReadData::impropers(int firstpass)
   }
 
   // read and process impropers
+  // in parallel mode, each line is sent to the procs owning the atoms
+  //   which Atom::data_impropers() stores it with
+
+  const int cols_on[1] = {3};
+  const int cols_off[4] = {2, 3, 4, 5};
+  int ncol = force->newton_bond ? 1 : 4;
+  const int *cols = force->newton_bond ? cols_on : cols_off;
 
   bigint nread = 0;
 
+  if (binary) binary_section("Impropers", nimpropers, std::string(6, 'i'));
+
   while (nread < nimpropers) {
-    nchunk = MIN(nimpropers - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+    nbuf = read_chunk(nimpropers - nread, nread, ncol, cols, "Impropers", nchunk);
     if (ilabelflag && !lmap->is_complete(Atom::IMPROPER))
       error->all(FLERR,
                  "Label map is incomplete: "
                  "all types must be assigned a unique type label");
-    atom->data_impropers(nchunk, buffer, count, id_offset, ioffset, ilabelflag,
-                         lmap->lmap2lmap.improper);
+    if (binary)
+      atom->data_topology_binary(Atom::IMPROPER, nbuf, rowbuf, count, id_offset, ioffset,
+                                 ilabelflag, lmap->lmap2lmap.improper);
+    else
+      atom->data_impropers(nbuf, buffer, count, id_offset, ioffset, ilabelflag,
+                           lmap->lmap2lmap.improper, parallelflag);
     nread += nchunk;
   }
 
@@ -1950,7 +2085,7 @@ void ReadData::impropers(int firstpass)
 
 void ReadData::bonus(bigint nbonus, AtomVec *ptr, const char *type)
 {
-  int nchunk, eof;
+  int nbuf, nchunk;
 
   int mapflag = 0;
   if (atom->map_style == Atom::MAP_NONE) {
@@ -1962,11 +2097,16 @@ void ReadData::bonus(bigint nbonus, AtomVec *ptr, const char *type)
   bigint nread = 0;
   bigint natoms = nbonus;
 
+  const int cols[1] = {0};
+
+  // bonus rows of binary data file are converted to lines, atom ID is 1st value
+
+  if (binary) binary_section(type, natoms, "i" + std::string(ptr->size_data_bonus - 1, 'f'));
+
   while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
-    atom->data_bonus(nchunk, buffer, ptr, id_offset);
+    nbuf = read_chunk(natoms - nread, nread, 1, cols, "Bonus", nchunk);
+    if (binary) rows_to_lines(nbuf);
+    atom->data_bonus(nbuf, buffer, ptr, id_offset, parallelflag);
     nread += nchunk;
   }
 
@@ -2442,8 +2582,9 @@ void ReadData::open(const std::string &file)
     if (!fp) error->one(FLERR, "Cannot open compressed file {}", file);
   } else {
     compressed = 0;
-    fp = fopen(file.c_str(), "r");
+    fp = fopen(file.c_str(), binary ? "rb" : "r");
     if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+    if (binary) platform::fseek(fp, textoffset);
   }
 }
 
@@ -2534,6 +2675,525 @@ void ReadData::skip_lines(bigint n)
   if (eof == nullptr) error->one(FLERR, "Unexpected end of data file");
 }
 
+/* ----------------------------------------------------------------------
+   read next chunk of at most nremain lines of a section into buffer
+   nread = # of lines of section read before
+   default: all procs receive all lines of the chunk
+   parallel mode: each proc receives a block of the lines
+   binary data file: each proc reads a block of the rows into rowbuf
+     if ncol > 0, lines are then sent to the procs owning the atoms
+     whose IDs are in columns cols of the line
+   location = section name for error messages
+   return # of lines in buffer, nchunk = # of lines read from file
+------------------------------------------------------------------------- */
+
+int ReadData::read_chunk(bigint nremain, bigint nread, int ncol, const int *cols,
+                         const char *location, int &nchunk)
+{
+  int eof, nmine, first;
+
+  // binary data file: each proc reads its block of rows of the chunk
+
+  if (binary) {
+    nchunk = MIN(nremain, pchunk);
+    first = static_cast<int>((bigint) me * nchunk / nprocs);
+    nmine = static_cast<int>((bigint) (me + 1) * nchunk / nprocs) - first;
+    read_rows(nread + first, nmine);
+    if (ncol == 0 || nprocs == 1) return nmine;
+    return route_rows(nmine, nread + first, ncol, cols, location);
+  }
+
+  if (!parallelflag) {
+    nchunk = MIN(nremain, CHUNK);
+    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+    if (eof) error->all(FLERR, "Unexpected end of data file");
+    return nchunk;
+  }
+
+  nchunk = MIN(nremain, pchunk);
+  eof = scatter_lines(nchunk, nmine, first);
+  if (eof) error->all(FLERR, "Unexpected end of data file");
+  if (ncol == 0) return nmine;
+  return route_lines(nmine, nread + first, ncol, cols, location);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads N lines and scatters them in contiguous blocks to all procs
+   proc I receives lines I*N/P to (I+1)*N/P - 1 into buffer
+   nmine = # of lines I received, first = index of my first line in chunk
+   return 1 if end of file was reached, else 0
+------------------------------------------------------------------------- */
+
+int ReadData::scatter_lines(int nlines, int &nmine, int &first)
+{
+  int eof = 0;
+  int *counts = nullptr;
+  int *displs = nullptr;
+
+  if (me == 0) {
+    memory->create(counts, nprocs, "read_data:counts");
+    memory->create(displs, nprocs + 1, "read_data:displs");
+
+    char *ptr = readbuf;
+    int iproc = 0;
+    for (int i = 0; i < nlines; i++) {
+      while (iproc < nprocs && i == (bigint) iproc * nlines / nprocs)
+        displs[iproc++] = ptr - readbuf;
+      if (!utils::fgets_trunc(ptr, MAXLINE, fp)) {
+        eof = 1;
+        break;
+      }
+      ptr += strlen(ptr);
+    }
+    while (iproc <= nprocs) displs[iproc++] = ptr - readbuf;
+    for (int i = 0; i < nprocs; i++) counts[i] = displs[i + 1] - displs[i];
+  }
+
+  MPI_Bcast(&eof, 1, MPI_INT, 0, world);
+  if (eof) {
+    memory->destroy(counts);
+    memory->destroy(displs);
+    return 1;
+  }
+
+  int n;
+  MPI_Scatter(counts, 1, MPI_INT, &n, 1, MPI_INT, 0, world);
+  MPI_Scatterv(readbuf, counts, displs, MPI_CHAR, buffer, n, MPI_CHAR, 0, world);
+  buffer[n] = '\0';
+
+  memory->destroy(counts);
+  memory->destroy(displs);
+
+  first = static_cast<int>((bigint) me * nlines / nprocs);
+  nmine = static_cast<int>((bigint) (me + 1) * nlines / nprocs) - first;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   send each of my nmine lines in buffer to the procs owning
+     the atoms whose IDs are in columns cols[0..ncol-1] of the line
+   first = index of my first line in section
+   uses rendezvous comm with owners of atom IDs set by atom_owners()
+   lines for unknown atom IDs are dropped, caller checks the counts
+   received lines are put into buffer in the order of the data file,
+     a line received more than once is only kept once
+   return # of lines in buffer
+------------------------------------------------------------------------- */
+
+int ReadData::route_lines(int nmine, bigint first, int ncol, const int *cols,
+                          const char *location)
+{
+  if (!ownerflag) atom_owners();
+
+  int *proclist;
+  memory->create(proclist, nmine * ncol, "read_data:proclist");
+  auto inbuf = (LineRvous *) memory->smalloc((bigint) nmine * ncol * sizeof(LineRvous),
+                                             "read_data:inbuf");
+
+  // setup input buf for rendezvous comm
+  // one datum for each distinct atom ID in the key columns of a line
+  // rendezvous proc for each datum = atom ID % nprocs
+
+  int nsend = 0;
+  char *buf = buffer;
+  char *next;
+  tagint ids[4];
+
+  for (int i = 0; i < nmine; i++) {
+    next = strchr(buf, '\n');
+    *next = '\0';
+    auto values = Tokenizer(utils::trim_comment(buf)).as_vector();
+    int nwords = values.size();
+
+    if (nwords > 0) {
+      for (int k = 0; k < ncol; k++) {
+        if (cols[k] >= nwords)
+          error->one(FLERR, "Incorrect format in {} section of data file: {}{}", location,
+                     utils::trim(buf), utils::errorurl(2));
+        ids[k] = utils::tnumeric(FLERR, values[cols[k]], true, lmp) + id_offset;
+        if ((ids[k] <= 0) || (ids[k] > atom->map_tag_max))
+          error->one(FLERR, "Invalid atom ID {} in {} section of data file: {}", ids[k],
+                     location, utils::trim(buf));
+
+        int dup = 0;
+        for (int kk = 0; kk < k; kk++)
+          if (ids[kk] == ids[k]) dup = 1;
+        if (dup) continue;
+
+        proclist[nsend] = ids[k] % nprocs;
+        inbuf[nsend].index = first + i;
+        inbuf[nsend].atomID = ids[k];
+        strcpy(inbuf[nsend].line, buf);
+        nsend++;
+      }
+    }
+    buf = next + 1;
+  }
+
+  // perform rendezvous operation
+
+  std::vector<int> order;
+  auto out = (LineRvous *) route_datums(nsend, proclist, (char *) inbuf, order);
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  int n = order.size();
+  if (n > maxbuffer) {
+    delete[] buffer;
+    maxbuffer = n;
+    buffer = new char[(bigint) maxbuffer * MAXLINE];
+  }
+
+  char *ptr = buffer;
+  for (int i = 0; i < n; i++) {
+    strcpy(ptr, out[order[i]].line);
+    ptr += strlen(ptr);
+    *ptr++ = '\n';
+  }
+  *ptr = '\0';
+
+  memory->sfree(out);
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   send each of my nmine rows in rowbuf to the procs owning
+     the atoms whose IDs are in columns cols[0..ncol-1] of the row
+   same as route_lines() for rows of a binary data file
+   return # of rows in rowbuf
+------------------------------------------------------------------------- */
+
+int ReadData::route_rows(int nmine, bigint first, int ncol, const int *cols,
+                         const char *location)
+{
+  if (!ownerflag) atom_owners();
+
+  int rowbytes = sectioncols * sizeof(double);
+  if (rowbytes > MAXLINE)
+    error->all(FLERR, "Too many columns in {} section of binary data file", location);
+
+  int *proclist;
+  memory->create(proclist, nmine * ncol, "read_data:proclist");
+  auto inbuf = (LineRvous *) memory->smalloc((bigint) nmine * ncol * sizeof(LineRvous),
+                                             "read_data:inbuf");
+
+  int nsend = 0;
+  tagint ids[4];
+
+  for (int i = 0; i < nmine; i++) {
+    double *row = &rowbuf[(bigint) i * sectioncols];
+    for (int k = 0; k < ncol; k++) {
+      ids[k] = (tagint) ubuf(row[cols[k]]).i + id_offset;
+      if ((ids[k] <= 0) || (ids[k] > atom->map_tag_max))
+        error->one(FLERR, "Invalid atom ID {} in {} section of data file", ids[k], location);
+
+      int dup = 0;
+      for (int kk = 0; kk < k; kk++)
+        if (ids[kk] == ids[k]) dup = 1;
+      if (dup) continue;
+
+      proclist[nsend] = ids[k] % nprocs;
+      inbuf[nsend].index = first + i;
+      inbuf[nsend].atomID = ids[k];
+      memcpy(inbuf[nsend].line, row, rowbytes);
+      nsend++;
+    }
+  }
+
+  std::vector<int> order;
+  auto out = (LineRvous *) route_datums(nsend, proclist, (char *) inbuf, order);
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  int n = order.size();
+  grow_rows(n);
+  for (int i = 0; i < n; i++)
+    memcpy(&rowbuf[(bigint) i * sectioncols], out[order[i]].line, rowbytes);
+
+  memory->sfree(out);
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   perform rendezvous comm of nsend LineRvous datums in inbuf
+   order = indices of received datums sorted by their index in the data file,
+     a datum received more than once is only listed once
+   return buffer of received datums, caller frees it
+------------------------------------------------------------------------- */
+
+char *ReadData::route_datums(int nsend, int *proclist, char *inbuf, std::vector<int> &order)
+{
+  char *outbuf;
+  int nreturn = comm->rendezvous(RVOUS, nsend, inbuf, sizeof(LineRvous), 0, proclist,
+                                 rendezvous_lines, 0, outbuf, sizeof(LineRvous), (void *) this);
+  auto out = (LineRvous *) outbuf;
+
+  std::vector<int> all(nreturn);
+  for (int i = 0; i < nreturn; i++) all[i] = i;
+  std::sort(all.begin(), all.end(), [out](int a, int b) { return out[a].index < out[b].index; });
+
+  order.clear();
+  for (int i = 0; i < nreturn; i++)
+    if (i == 0 || out[all[i]].index != out[all[i - 1]].index) order.push_back(all[i]);
+
+  return outbuf;
+}
+
+/* ----------------------------------------------------------------------
+   store owning proc of each atom ID in rendezvous decomposition
+   each proc is assigned every 1/Pth atom ID
+------------------------------------------------------------------------- */
+
+void ReadData::atom_owners()
+{
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  int *proclist;
+  memory->create(proclist, nlocal, "read_data:proclist");
+  auto idbuf = (IDRvous *) memory->smalloc((bigint) nlocal * sizeof(IDRvous), "read_data:idbuf");
+
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].me = me;
+    idbuf[i].atomID = tag[i];
+  }
+
+  char *buf;
+  comm->rendezvous(RVOUS, nlocal, (char *) idbuf, sizeof(IDRvous), 0, proclist, rendezvous_ids, 0,
+                   buf, 0, (void *) this);
+
+  memory->destroy(proclist);
+  memory->sfree(idbuf);
+  ownerflag = 1;
+}
+
+/* ----------------------------------------------------------------------
+   callback from atom_owners() for rendezvous decomposition
+   inbuf = list of N IDRvous datums
+   no outbuf
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_ids(int n, char *inbuf, int &flag, int *& /*proclist*/,
+                             char *& /*outbuf*/, void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  auto in = (IDRvous *) inbuf;
+
+  rptr->owners.clear();
+  rptr->owners.reserve(n);
+  for (int i = 0; i < n; i++) rptr->owners[in[i].atomID] = in[i].me;
+
+  // flag = 0: no second comm needed in rendezvous
+
+  flag = 0;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   callback from route_lines() for rendezvous decomposition
+   inbuf = list of N LineRvous datums
+   outbuf = same list of datums, routed to the owners of their atom IDs
+     datums with atom IDs that do not exist are removed
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_lines(int n, char *inbuf, int &flag, int *&proclist, char *&outbuf,
+                               void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  auto in = (LineRvous *) inbuf;
+  auto &owners = rptr->owners;
+
+  rptr->memory->create(proclist, n, "read_data:proclist");
+
+  int nout = 0;
+  for (int i = 0; i < n; i++) {
+    auto it = owners.find(in[i].atomID);
+    if (it == owners.end()) continue;
+    if (nout != i) in[nout] = in[i];
+    proclist[nout++] = it->second;
+  }
+
+  outbuf = inbuf;
+
+  // flag = 1: outbuf = inbuf
+
+  flag = 1;
+  return nout;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 checks if file is a binary data file written by write_data
+   if so, sets binary flag, byte swap flag, and offset of text part
+------------------------------------------------------------------------- */
+
+void ReadData::binary_check(const std::string &file)
+{
+  FILE *fptest = fopen(file.c_str(), "rb");
+  if (!fptest) return;
+
+  int n = strlen(DATA_MAGIC_STRING);
+  char magic[64];
+  if ((fread(magic, sizeof(char), n, fptest) != (size_t) n) ||
+      (strncmp(magic, DATA_MAGIC_STRING, n) != 0)) {
+    fclose(fptest);
+    return;
+  }
+
+  int endian, revision;
+  int64_t offset;
+  if ((fread(&endian, sizeof(int), 1, fptest) != 1) ||
+      (fread(&revision, sizeof(int), 1, fptest) != 1) ||
+      (fread(&offset, sizeof(int64_t), 1, fptest) != 1))
+    error->one(FLERR, "Unexpected end of binary data file {}", file);
+  fclose(fptest);
+
+  if (endian == DATA_ENDIAN) swapflag = 0;
+  else if (endian == DATA_ENDIANSWAP) swapflag = 1;
+  else error->one(FLERR, "Unrecognized byte order in binary data file {}", file);
+
+  if (swapflag) {
+    swap_bytes(&revision, sizeof(int), 1);
+    swap_bytes(&offset, sizeof(int64_t), 1);
+  }
+  if (revision > DATA_FORMAT_REVISION)
+    error->one(FLERR, "Binary data file {} has format revision {}, only up to {} is supported",
+               file, revision, DATA_FORMAT_REVISION);
+
+  binary = 1;
+  textoffset = offset;
+}
+
+/* ----------------------------------------------------------------------
+   read 1-line descriptor of section of binary data file stored as columns
+   check it has nrows rows and columns of kinds
+------------------------------------------------------------------------- */
+
+void ReadData::binary_section(const char *keyword, bigint nrows, const std::string &kinds)
+{
+  int n;
+  if (me == 0) {
+    if (utils::fgets_trunc(line, MAXLINE, fp) == nullptr)
+      error->one(FLERR, "Unexpected end of data file while reading {} section", keyword);
+    n = strlen(line) + 1;
+  }
+  MPI_Bcast(&n, 1, MPI_INT, 0, world);
+  MPI_Bcast(line, n, MPI_CHAR, 0, world);
+
+  ValueTokenizer values(line);
+  std::string words;
+  try {
+    sectionrows = values.next_bigint();
+    sectionoffset = values.next_bigint();
+    if (values.has_next()) words = values.next_string();
+  } catch (TokenizerException &e) {
+    error->all(FLERR, "Invalid {} section descriptor in binary data file: {}", keyword,
+               e.what());
+  }
+
+  if (sectionrows != nrows)
+    error->all(FLERR, "{} section of binary data file has {} rows, expected {}", keyword,
+               sectionrows, nrows);
+  if (nrows && words != kinds)
+    error->all(FLERR, "{} section of binary data file has columns {}, expected {}", keyword,
+               words, kinds);
+  sectioncols = kinds.size();
+}
+
+/* ----------------------------------------------------------------------
+   read N rows of current binary section, starting at row0, into rowbuf
+   each column is read as a contiguous block of values
+------------------------------------------------------------------------- */
+
+void ReadData::read_rows(bigint row0, int n)
+{
+  grow_rows(n);
+  if (n == 0) return;
+
+  std::vector<double> column(n);
+  for (int k = 0; k < sectioncols; k++) {
+    platform::fseek(fpbin, sectionoffset + ((bigint) k * sectionrows + row0) * sizeof(double));
+    if (fread(column.data(), sizeof(double), n, fpbin) != (size_t) n)
+      error->one(FLERR, "Unexpected end of binary data file");
+    if (swapflag) swap_bytes(column.data(), sizeof(double), n);
+    for (int i = 0; i < n; i++) rowbuf[(bigint) i * sectioncols + k] = column[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   insure rowbuf can hold N rows of current binary section
+------------------------------------------------------------------------- */
+
+void ReadData::grow_rows(int n)
+{
+  if ((bigint) n * sectioncols <= maxrows) return;
+  maxrows = (bigint) n * sectioncols;
+  memory->destroy(rowbuf);
+  memory->create(rowbuf, maxrows, "read_data:rowbuf");
+}
+
+/* ----------------------------------------------------------------------
+   convert N rows of current binary section in rowbuf to text lines in buffer
+   1st value of each row is an atom ID, all others are floating point
+------------------------------------------------------------------------- */
+
+void ReadData::rows_to_lines(int n)
+{
+  if (n > maxbuffer) {
+    delete[] buffer;
+    maxbuffer = n;
+    buffer = new char[(bigint) maxbuffer * MAXLINE];
+  }
+
+  char *ptr = buffer;
+  for (int i = 0; i < n; i++) {
+    double *row = &rowbuf[(bigint) i * sectioncols];
+    std::string str = std::to_string(ubuf(row[0]).i);
+    for (int k = 1; k < sectioncols; k++) str += fmt::format(" {}", row[k]);
+    if (str.size() >= MAXLINE - 1)
+      error->one(FLERR, "Too many values in bonus section of binary data file");
+    strcpy(ptr, str.c_str());
+    ptr += str.size();
+    *ptr++ = '\n';
+  }
+  *ptr = '\0';
+}
+
+/* ----------------------------------------------------------------------
+   move atoms read in parallel mode to the procs owning their sub-domain
+   atoms owned before this data file was read stay where they are
+------------------------------------------------------------------------- */
+
+void ReadData::migrate_atoms()
+{
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+
+  int *procassign;
+  memory->create(procassign, nlocal, "read_data:procassign");
+
+  comm->coord2proc_setup();
+
+  int igx, igy, igz;
+  double lamda[3];
+  for (int i = 0; i < nlocal_previous; i++) procassign[i] = me;
+  for (int i = nlocal_previous; i < nlocal; i++) {
+    if (domain->triclinic) {
+      domain->x2lamda(x[i], lamda);
+      procassign[i] = comm->coord2proc(lamda, igx, igy, igz);
+    } else
+      procassign[i] = comm->coord2proc(x[i], igx, igy, igz);
+  }
+
+  auto irregular = new Irregular(lmp);
+  irregular->migrate_atoms(1, 1, procassign);
+  delete irregular;
+
+  memory->destroy(procassign);
+}
+
 /* ----------------------------------------------------------------------
    parse a line of coeffs into words, storing them in ncoeffarg,coeffarg
    trim anything from '#' onward
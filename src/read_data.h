@@ -22,6 +22,9 @@ CommandStyle(read_data,ReadData);
 
 #include "command.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace LAMMPS_NS {
 class Fix;
 class ReadData : public Command {
@@ -32,8 +35,9 @@ class ReadData : public Command {
   static bool is_data_section(const std::string &);
 
  private:
-  int me, compressed;
+  int me, nprocs, compressed;
   char *line, *keyword, *buffer, *style;
+  int maxbuffer;
   FILE *fp;
   char **coeffarg;
   int ncoeffarg, maxcoeffarg;
@@ -81,6 +85,26 @@ class ReadData : public Command {
   int extra_dihedral_types, extra_improper_types;
   int groupbit;
 
+  // parallel parsing of sections
+
+  int parallelflag;    // 1 if procs parse separate blocks of lines
+  int pchunk;          // # of lines read by proc 0 per chunk
+  char *readbuf;       // buffer for lines read by proc 0
+  int ownerflag;       // 1 if owners of atom IDs are set
+  std::unordered_map<tagint, int> owners;    // owning proc of atom IDs in rendezvous decomp
+
+  // binary data file
+
+  int binary;              // 1 if data file is a binary data file
+  int swapflag;            // 1 if byte order of binary data file must be swapped
+  bigint textoffset;       // byte offset of text part of binary data file
+  FILE *fpbin;             // binary data file, opened by all procs
+  bigint sectionrows;      // # of rows in current binary section
+  bigint sectionoffset;    // byte offset of 1st column of current binary section
+  int sectioncols;         // # of columns in current binary section
+  double *rowbuf;          // rows of current binary section read by this proc
+  bigint maxrows;          // allocated length of rowbuf
+
   int nfix;
   Fix **fix_index;
   char **fix_header;
@@ -97,6 +121,22 @@ class ReadData : public Command {
   void parse_coeffs(char *, const char *, int, int, int, int, int *);
   int style_match(const char *, const char *);
 
+  int read_chunk(bigint, bigint, int, const int *, const char *, int &);
+  int scatter_lines(int, int &, int &);
+  int route_lines(int, bigint, int, const int *, const char *);
+  int route_rows(int, bigint, int, const int *, const char *);
+  char *route_datums(int, int *, char *, std::vector<int> &);
+  void atom_owners();
+  void migrate_atoms();
+  static int rendezvous_ids(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_lines(int, char *, int &, int *&, char *&, void *);
+
+  void binary_check(const std::string &);
+  void binary_section(const char *, bigint, const std::string &);
+  void read_rows(bigint, int);
+  void grow_rows(int);
+  void rows_to_lines(int);
+
   void atoms();
   void velocities();
 
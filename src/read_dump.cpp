@@ -276,7 +276,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
       } else readers[0]->open_file(files[ifile]);
 
       while (true) {
-        eofflag = readers[0]->read_time(ntimestep);
+        eofflag = readers[0]->seek_time(ntimestep,nrequest);
         if (eofflag) break;
         if (ntimestep >= nrequest) break;
         readers[0]->skip();
@@ -320,7 +320,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
 
       bigint step;
       while (true) {
-        eofflag = readers[i]->read_time(step);
+        eofflag = readers[i]->seek_time(step,ntimestep);
         if (eofflag) break;
         if (step == ntimestep) break;
         readers[i]->skip();
@@ -368,7 +368,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
       }
 
       while (true) {
-        eofflag = readers[0]->read_time(ntimestep);
+        eofflag = readers[0]->seek_time(ntimestep,ncurrent+1);
         if (eofflag) break;
         if (ntimestep > nlast) break;
         if (ntimestep <= ncurrent) {
@@ -421,7 +421,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
 
       bigint step;
       while (true) {
-        eofflag = readers[i]->read_time(step);
+        eofflag = readers[i]->seek_time(step,ntimestep);
         if (eofflag) break;
         if (step == ntimestep) break;
         readers[i]->skip();
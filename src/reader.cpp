@@ -13,10 +13,24 @@
 
 #include "reader.h"
 
+#include "comm.h"
 #include "error.h"
 
+#include <cstring>
+
+#if defined(LAMMPS_ZSTD)
+#include <zstd.h>
+#endif
+
 using namespace LAMMPS_NS;
 
+// snapshot index at the end of seekable compressed dump files
+// must match the definitions in COMPRESS/zstd_file_writer.cpp
+
+static constexpr unsigned int INDEX_FRAME_MAGIC = 0x184D2A5D;
+static constexpr char INDEX_MAGIC[] = "LMPZSTIX";
+static constexpr int INDEX_MAGIC_SIZE = 8;
+
 // only proc 0 calls methods of this class, except for constructor/destructor
 
 /* ---------------------------------------------------------------------- */
@@ -26,12 +40,15 @@ Reader::Reader(LAMMPS *lmp) : Pointers(lmp)
   fp = nullptr;
   binary = false;
   compressed = false;
+  fpindex = nullptr;
+  indexoffset = 0;
+  isnapshot = 0;
 }
 
 // avoid resource leak
 Reader::~Reader()
 {
-  if (fp != nullptr) close_file();
+  if ((fp != nullptr) || (fpindex != nullptr)) close_file();
 }
 
 /* ----------------------------------------------------------------------
@@ -41,10 +58,14 @@ Reader::~Reader()
 
 void Reader::open_file(const std::string &file)
 {
-  if (fp != nullptr) close_file();
+  if ((fp != nullptr) || (fpindex != nullptr)) close_file();
 
   if (platform::has_compress_extension(file)) {
     compressed = true;
+
+    // seekable zstd files are decompressed one snapshot at a time by seek_time()
+
+    if (open_index(file)) return;
     fp = platform::compressed_read(file);
     if (!fp) error->one(FLERR, "Cannot open compressed file for reading");
   } else {
@@ -68,6 +89,14 @@ void Reader::open_file(const std::string &file)
 
 void Reader::close_file()
 {
+  if (fpindex != nullptr) {
+    fclose(fpindex);
+    fpindex = nullptr;
+    index.clear();
+    if (fp != nullptr) fclose(fp);
+    fp = nullptr;
+  }
+
   if (fp == nullptr) return;
   if (compressed)
     platform::pclose(fp);
@@ -76,6 +105,158 @@ void Reader::close_file()
   fp = nullptr;
 }
 
+/* ----------------------------------------------------------------------
+   read timestep of next snapshot, same as read_time()
+   snapshots with a timestep < Nmin may be skipped without reading them,
+     which is done for files with a snapshot index
+   return 1 if no more snapshots
+------------------------------------------------------------------------- */
+
+int Reader::seek_time(bigint &ntimestep, bigint nmin)
+{
+  if (fpindex == nullptr) return read_time(ntimestep);
+
+  const int nsnapshot = index.size() / 2;
+  while ((isnapshot < nsnapshot) && (index[2 * isnapshot] < nmin)) ++isnapshot;
+  if (isnapshot >= nsnapshot) return 1;
+
+  read_snapshot(isnapshot++);
+  return read_time(ntimestep);
+}
+
+/* ----------------------------------------------------------------------
+   check for a snapshot index at the end of a zstd compressed file
+   if found, read it and keep the file open for reading snapshots
+   return true if file has an index
+------------------------------------------------------------------------- */
+
+bool Reader::open_index(const std::string &file)
+{
+#if defined(LAMMPS_ZSTD)
+  if (!utils::strmatch(file, "\\.zst$")) return false;
+
+  FILE *fpz = fopen(file.c_str(), "rb");
+  if (!fpz) return false;
+
+  // footer = # of snapshots and magic string
+  // preceded by skippable frame header and timestep/offset pairs
+
+  int64_t nsnapshot = -1;
+  char magic[INDEX_MAGIC_SIZE];
+  unsigned int header[2];
+  platform::fseek(fpz, platform::END_OF_FILE);
+  const bigint filesize = platform::ftell(fpz);
+  const bigint footer = sizeof(int64_t) + INDEX_MAGIC_SIZE;
+
+  if ((filesize >= footer) && (platform::fseek(fpz, filesize - footer) == 0) &&
+      (fread(&nsnapshot, sizeof(int64_t), 1, fpz) == 1) &&
+      (fread(magic, sizeof(char), INDEX_MAGIC_SIZE, fpz) == INDEX_MAGIC_SIZE) &&
+      (memcmp(magic, INDEX_MAGIC, INDEX_MAGIC_SIZE) == 0) && (nsnapshot >= 0) &&
+      (nsnapshot <= (filesize - footer) / 16)) {
+    indexoffset = filesize - footer - 2 * nsnapshot * sizeof(int64_t) - sizeof(header);
+    index.resize(2 * nsnapshot);
+    if ((indexoffset >= 0) && (platform::fseek(fpz, indexoffset) == 0) &&
+        (fread(header, sizeof(unsigned int), 2, fpz) == 2) &&
+        (header[0] == INDEX_FRAME_MAGIC) &&
+        (fread(index.data(), sizeof(int64_t), index.size(), fpz) == index.size())) {
+      fpindex = fpz;
+      isnapshot = 0;
+      return true;
+    }
+  }
+
+  index.clear();
+  fclose(fpz);
+#else
+  (void) file;
+#endif
+  return false;
+}
+
+/* ----------------------------------------------------------------------
+   decompress snapshot I of a file with index into a temporary file
+   its frames are decompressed in parallel by multiple threads, if available
+------------------------------------------------------------------------- */
+
+void Reader::read_snapshot(int i)
+{
+#if defined(LAMMPS_ZSTD)
+  const bigint offset = index[2 * i + 1];
+  const bigint nbytes = ((2 * i + 2 < (int) index.size()) ? index[2 * i + 3] : indexoffset) - offset;
+  if ((nbytes < 0) || (offset < 0)) error->one(FLERR, "Dump file snapshot index is corrupted");
+
+  std::vector<char> src(nbytes);
+  if ((platform::fseek(fpindex, offset) != 0) ||
+      (fread(src.data(), sizeof(char), nbytes, fpindex) != (size_t) nbytes))
+    error->one(FLERR, "Unexpected end of compressed dump file");
+
+  // find start of each frame
+
+  std::vector<size_t> start;
+  size_t pos = 0;
+  while (pos < (size_t) nbytes) {
+    size_t len = ZSTD_findFrameCompressedSize(src.data() + pos, nbytes - pos);
+    if (ZSTD_isError(len))
+      error->one(FLERR, "Invalid frame in compressed dump file: {}", ZSTD_getErrorName(len));
+    start.push_back(pos);
+    pos += len;
+  }
+  start.push_back(pos);
+
+  // decompress frames
+  // frames with unknown content size were streamed and are decompressed in pieces
+
+  const int nframe = start.size() - 1;
+  std::vector<std::vector<char>> text(nframe);
+  std::vector<size_t> status(nframe, 0);
+
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) num_threads(comm->nthreads) schedule(dynamic)
+#endif
+  for (int iframe = 0; iframe < nframe; iframe++) {
+    const char *frame = src.data() + start[iframe];
+    const size_t len = start[iframe + 1] - start[iframe];
+    auto size = ZSTD_getFrameContentSize(frame, len);
+    ZSTD_DCtx *dctx = ZSTD_createDCtx();
+
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN) {
+      ZSTD_inBuffer input = {frame, len, 0};
+      std::vector<char> out(ZSTD_DStreamOutSize());
+      do {
+        ZSTD_outBuffer output = {out.data(), out.size(), 0};
+        status[iframe] = ZSTD_decompressStream(dctx, &output, &input);
+        if (ZSTD_isError(status[iframe])) break;
+        if ((output.pos == 0) && (input.pos == input.size)) break;
+        text[iframe].insert(text[iframe].end(), out.data(), out.data() + output.pos);
+      } while (status[iframe] != 0);
+    } else if (size == ZSTD_CONTENTSIZE_ERROR) {
+      status[iframe] = size;
+    } else {
+      text[iframe].resize(size);
+      status[iframe] = ZSTD_decompressDCtx(dctx, text[iframe].data(), size, frame, len);
+    }
+    ZSTD_freeDCtx(dctx);
+  }
+
+  // write text of snapshot to temporary file for reading it with read_time() etc
+
+  if (fp != nullptr) fclose(fp);
+  fp = tmpfile();
+  if (fp == nullptr)
+    error->one(FLERR, "Cannot open temporary file for dump snapshot: {}", utils::getsyserror());
+
+  for (int iframe = 0; iframe < nframe; iframe++) {
+    if (ZSTD_isError(status[iframe]))
+      error->one(FLERR, "Cannot decompress dump file snapshot: {}",
+                 ZSTD_getErrorName(status[iframe]));
+    fwrite(text[iframe].data(), sizeof(char), text[iframe].size(), fp);
+  }
+  rewind(fp);
+#else
+  (void) i;
+#endif
+}
+
 /* ----------------------------------------------------------------------
    detect unused arguments
 ------------------------------------------------------------------------- */
@@ -39,10 +39,20 @@ class Reader : protected Pointers {
   virtual void open_file(const std::string &);
   virtual void close_file();
 
+  int seek_time(bigint &, bigint);
+
  protected:
   FILE *fp;           // pointer to opened file or pipe
   bool compressed;    // flag for dump file compression
   bool binary;        // flag for (native) binary files
+
+  FILE *fpindex;                 // compressed file with snapshot index, nullptr if none
+  std::vector<int64_t> index;    // pairs of timestep and file offset of each snapshot
+  bigint indexoffset;            // file offset of the index, ends the last snapshot
+  int isnapshot;                 // index of next snapshot to read
+
+  bool open_index(const std::string &);
+  void read_snapshot(int);
 };
 
 }    // namespace LAMMPS_NS
@@ -1166,6 +1166,98 @@ std::string utils::star_subst(const std::string &name, bigint step, int pad)
   return fmt::format("{}{:0{}}{}", name.substr(0, star), step, pad, name.substr(star + 1));
 }
 
+/* ----------------------------------------------------------------------
+   Translate printf() style format with one conversion to fmtlib format
+------------------------------------------------------------------------- */
+std::string utils::printf_to_fmt(const std::string &format, const std::string &conversions)
+{
+  std::string newformat;
+  bool found = false;
+  const std::size_t len = format.size();
+
+  for (std::size_t i = 0; i < len; ++i) {
+    const char c = format[i];
+    if ((c == '{') || (c == '}')) {
+      newformat += c;
+      newformat += c;
+      continue;
+    }
+    if (c != '%') {
+      newformat += c;
+      continue;
+    }
+    if ((i + 1 < len) && (format[i + 1] == '%')) {
+      newformat += '%';
+      ++i;
+      continue;
+    }
+
+    // only a single conversion is supported
+
+    if (found) return "";
+    found = true;
+
+    // flags
+
+    bool left = false, zero = false;
+    char sign = '\0';
+    for (++i; i < len; ++i) {
+      if (format[i] == '-')
+        left = true;
+      else if (format[i] == '0')
+        zero = true;
+      else if (format[i] == '+')
+        sign = '+';
+      else if (format[i] == ' ') {
+        if (sign != '+') sign = ' ';
+      } else if (strchr("#'*", format[i]))
+        return "";
+      else
+        break;
+    }
+
+    // field width and precision
+
+    std::string width, precision;
+    while ((i < len) && isdigit(format[i])) width += format[i++];
+    if ((i < len) && (format[i] == '.')) {
+      precision = ".";
+      ++i;
+      while ((i < len) && isdigit(format[i])) precision += format[i++];
+      if (precision.size() == 1) precision += '0';
+    }
+
+    // length modifiers are irrelevant since fmtlib uses the type of the argument
+
+    while ((i < len) && strchr("hlLqjzt", format[i])) ++i;
+    if ((i >= len) || (conversions.find(format[i]) == std::string::npos)) return "";
+
+    char type = format[i];
+    if ((type == 'd') || (type == 'i')) {
+      if (!precision.empty()) return "";
+      type = 'd';
+    } else if (type == 's') {
+      if (zero || sign) return "";
+    } else if (!strchr("eEfFgG", type)) {
+      return "";
+    }
+
+    // printf() right aligns strings and ignores '0' with '-'
+
+    newformat += "{:";
+    if (left)
+      newformat += '<';
+    else if (!zero)
+      newformat += '>';
+    if (sign) newformat += sign;
+    if (zero && !left) newformat += '0';
+    newformat += width + precision + type + '}';
+  }
+
+  if (!found) return "";
+  return newformat;
+}
+
 /* ----------------------------------------------------------------------
    Remove accelerator style suffix from string
 ------------------------------------------------------------------------- */
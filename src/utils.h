@@ -498,6 +498,23 @@ This functions adds the following case to :cpp:func:`utils::bounds() <LAMMPS_NS:
 
   std::string star_subst(const std::string &name, bigint step, int pad);
 
+  /*! Translate a printf() style format string into an equivalent fmtlib format string
+   *
+   * The format must contain exactly one conversion and the conversion
+   * character must be one of the characters in *conversions*.  Flags
+   * '-', '+', ' ', and '0', field width, precision, and length modifiers
+   * are supported; any other flag, a '*' width or precision, or a
+   * precision for an integer conversion are not.  Braces in the literal
+   * text are escaped and "%%" is replaced by a single '%'.  For the
+   * supported subset, formatting a value of the matching type with the
+   * returned string produces the same text as printf().
+   *
+   * \param format       printf() style format string
+   * \param conversions  string with accepted conversion characters (e.g. "di" or "eEfFgG")
+   * \return  fmtlib format string or empty string if there is no equivalent */
+
+  std::string printf_to_fmt(const std::string &format, const std::string &conversions);
+
   /*! Remove style suffix from string if suffix flag is active
    *
    *
@@ -134,6 +134,7 @@ void Verlet::setup(int flag)
 
   force->setup();
   ev_set(update->ntimestep);
+  if (atom->soaflag) atom->soa_pack();
   force_clear();
   modify->setup_pre_force(vflag);
 
@@ -155,6 +156,7 @@ void Verlet::setup(int flag)
 
   modify->setup_pre_reverse(eflag,vflag);
   if (force->newton) comm->reverse_comm();
+  atom->soa_valid = 0;
 
   modify->setup(vflag);
   output->setup(flag);
@@ -196,6 +198,7 @@ void Verlet::setup_minimal(int flag)
   // compute all forces
 
   ev_set(update->ntimestep);
+  if (atom->soaflag) atom->soa_pack();
   force_clear();
   modify->setup_pre_force(vflag);
 
@@ -217,6 +220,7 @@ void Verlet::setup_minimal(int flag)
 
   modify->setup_pre_reverse(eflag,vflag);
   if (force->newton) comm->reverse_comm();
+  atom->soa_valid = 0;
 
   modify->setup(vflag);
   update->setupflag = 0;
@@ -243,6 +247,15 @@ void Verlet::run(int n)
   if (atom->sortfreq > 0) sortflag = 1;
   else sortflag = 0;
 
+  // overlap forward comm with pair forces of interior atoms if possible
+  // not with pre_force fixes, since they may need current ghost coords
+
+  int overlapflag = 0;
+  if (comm->overlap && pair_compute_flag && force->pair->overlap_enable &&
+      !force->pair->costflag && !n_pre_force)
+    overlapflag = 1;
+  int overlap;
+
   for (int i = 0; i < n; i++) {
     if (timer->check_timeout(i)) {
       update->nsteps = i;
@@ -262,10 +275,14 @@ void Verlet::run(int n)
     // regular communication vs neighbor list rebuild
 
     nflag = neighbor->decide();
+    overlap = 0;
 
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
+      if (overlapflag && !(eflag & ENERGY_ATOM) && !(vflag & (VIRIAL_ATOM | VIRIAL_CENTROID))) {
+        comm->forward_comm_start();
+        overlap = 1;
+      } else comm->forward_comm();
       timer->stamp(Timer::COMM);
     } else {
       if (n_pre_exchange) {
@@ -303,6 +320,12 @@ void Verlet::run(int n)
     // since some bonded potentials tally pairwise energy/virial
     // and Pair:ev_tally() needs to be called before any tallying
 
+    // with overlap, ghost coords are still being received and packed later
+
+    if (atom->soaflag) {
+      if (overlap) atom->soa_pack(0,atom->nlocal);
+      else atom->soa_pack();
+    }
     force_clear();
 
     timer->stamp();
@@ -313,7 +336,15 @@ void Verlet::run(int n)
     }
 
     if (pair_compute_flag) {
-      force->pair->compute(eflag,vflag);
+      if (overlap) {
+        force->pair->compute_interior(eflag,vflag);
+        timer->stamp(Timer::PAIR);
+        comm->forward_comm_finish();
+        if (atom->soaflag) atom->soa_pack(atom->nlocal);
+        timer->stamp(Timer::COMM);
+        force->pair->compute_border(eflag,vflag);
+      } else if (force->pair->costflag) force->pair->compute_cost(eflag,vflag);
+      else force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
 
@@ -341,6 +372,7 @@ void Verlet::run(int n)
       comm->reverse_comm();
       timer->stamp(Timer::COMM);
     }
+    atom->soa_valid = 0;
 
     // force modifications, final time integration, diagnostics
 
@@ -26,6 +26,7 @@
 #include "force.h"
 #include "improper.h"
 #include "label_map.h"
+#include "lmpbinarydata.h"
 #include "memory.h"
 #include "modify.h"
 #include "output.h"
@@ -34,6 +35,7 @@
 #include "update.h"
 
 #include <cstring>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -46,6 +48,8 @@ WriteData::WriteData(LAMMPS *lmp) : Command(lmp)
 {
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
+  binary = 0;
+  fp = fpbin = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -66,6 +70,10 @@ void WriteData::command(int narg, char **arg)
   if (found != std::string::npos)
     file.replace(found,1,fmt::format("{}",update->ntimestep));
 
+  // a file name ending in ".bin" selects the binary data file format
+
+  binary = utils::strmatch(file,"\\.bin$") ? 1 : 0;
+
   // read optional args
   // noinit is a hidden arg, only used by -r command-line switch
 
@@ -206,10 +214,24 @@ void WriteData::write(const std::string &file)
 
   // open data file
 
+  // for a binary data file, the text part is assembled in a temporary file
+  //   and appended to the column data when the file is closed
+
   if (me == 0) {
-    fp = fopen(file.c_str(),"w");
-    if (fp == nullptr)
-      error->one(FLERR,"Cannot open data file {}: {}", file, utils::getsyserror());
+    if (binary) {
+      fpbin = fopen(file.c_str(),"wb");
+      if (fpbin == nullptr)
+        error->one(FLERR,"Cannot open data file {}: {}", file, utils::getsyserror());
+      fp = tmpfile();
+      if (fp == nullptr)
+        error->one(FLERR,"Cannot open temporary file for data file {}: {}", file,
+                   utils::getsyserror());
+      binary_open();
+    } else {
+      fp = fopen(file.c_str(),"w");
+      if (fp == nullptr)
+        error->one(FLERR,"Cannot open data file {}: {}", file, utils::getsyserror());
+    }
   }
 
   // proc 0 writes header, ntype-length arrays, force fields
@@ -269,7 +291,10 @@ void WriteData::write(const std::string &file)
 
   // close data file
 
-  if (me == 0) fclose(fp);
+  if (me == 0) {
+    if (binary) binary_close();
+    else fclose(fp);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -420,11 +445,14 @@ void WriteData::atoms()
 
   int tmp,recvrow;
 
+  if (me == 0) fmt::print(fp,"\nAtoms # {}\n\n",atom->atom_style);
+  if (binary) binary_section(sendrow,atom->avec->data_columns(0));
+
   if (me == 0) {
     MPI_Status status;
     MPI_Request request;
+    bigint first = 0;
 
-    fmt::print(fp,"\nAtoms # {}\n\n",atom->atom_style);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
@@ -434,7 +462,9 @@ void WriteData::atoms()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_data(fp,recvrow,buf);
+      if (binary) binary_rows(first,recvrow,ncol,&buf[0][0]);
+      else atom->avec->write_data(fp,recvrow,buf);
+      first += recvrow;
     }
 
   } else {
@@ -473,11 +503,14 @@ void WriteData::velocities()
 
   int tmp,recvrow;
 
+  if (me == 0) fputs("\nVelocities\n\n",fp);
+  if (binary) binary_section(sendrow,atom->avec->data_columns(1));
+
   if (me == 0) {
     MPI_Status status;
     MPI_Request request;
+    bigint first = 0;
 
-    fputs("\nVelocities\n\n",fp);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
@@ -487,7 +520,9 @@ void WriteData::velocities()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_vel(fp,recvrow,buf);
+      if (binary) binary_rows(first,recvrow,ncol,&buf[0][0]);
+      else atom->avec->write_vel(fp,recvrow,buf);
+      first += recvrow;
     }
 
   } else {
@@ -527,11 +562,13 @@ void WriteData::bonds()
   int tmp,recvrow;
 
   int index = 1;
+  if (me == 0) fputs("\nBonds\n\n",fp);
+  if (binary) binary_section(sendrow,std::string(ncol+1,'i'));
+
   if (me == 0) {
     MPI_Status status;
     MPI_Request request;
 
-    fputs("\nBonds\n\n",fp);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -541,7 +578,8 @@ void WriteData::bonds()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_bond(fp,recvrow,buf,index);
+      if (binary) binary_topology(recvrow,ncol,buf,index);
+      else atom->avec->write_bond(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -582,11 +620,13 @@ void WriteData::angles()
   int tmp,recvrow;
 
   int index = 1;
+  if (me == 0) fputs("\nAngles\n\n",fp);
+  if (binary) binary_section(sendrow,std::string(ncol+1,'i'));
+
   if (me == 0) {
     MPI_Status status;
     MPI_Request request;
 
-    fputs("\nAngles\n\n",fp);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -596,7 +636,8 @@ void WriteData::angles()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_angle(fp,recvrow,buf,index);
+      if (binary) binary_topology(recvrow,ncol,buf,index);
+      else atom->avec->write_angle(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -637,11 +678,13 @@ void WriteData::dihedrals()
   int tmp,recvrow;
 
   int index = 1;
+  if (me == 0) fputs("\nDihedrals\n\n",fp);
+  if (binary) binary_section(sendrow,std::string(ncol+1,'i'));
+
   if (me == 0) {
     MPI_Status status;
     MPI_Request request;
 
-    fputs("\nDihedrals\n\n",fp);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -651,7 +694,8 @@ void WriteData::dihedrals()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_dihedral(fp,recvrow,buf,index);
+      if (binary) binary_topology(recvrow,ncol,buf,index);
+      else atom->avec->write_dihedral(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -692,11 +736,13 @@ void WriteData::impropers()
   int tmp,recvrow;
 
   int index = 1;
+  if (me == 0) fputs("\nImpropers\n\n",fp);
+  if (binary) binary_section(sendrow,std::string(ncol+1,'i'));
+
   if (me == 0) {
     MPI_Status status;
     MPI_Request request;
 
-    fputs("\nImpropers\n\n",fp);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -706,7 +752,8 @@ void WriteData::impropers()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_improper(fp,recvrow,buf,index);
+      if (binary) binary_topology(recvrow,ncol,buf,index);
+      else atom->avec->write_improper(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -747,13 +794,34 @@ void WriteData::bonus(int flag)
   int tmp;
 
   if (me == 0) {
-    MPI_Status status;
-    MPI_Request request;
-
     if (flag == ELLIPSOID) fputs("\nEllipsoids\n\n",fp);
     if (flag == LINE)      fputs("\nLines\n\n",fp);
     if (flag == TRIANGLE)  fputs("\nTriangles\n\n",fp);
     if (flag == BODY)      fputs("\nBodies\n\n",fp);
+  }
+
+  // in a binary data file, bonus values are stored as columns
+  //   except for bodies, which have a variable # of values per body
+  // ncol = # of values per bonus, 1st is the atom ID
+
+  int bflag = (binary && flag != BODY) ? 1 : 0;
+  int ncol = 0;
+  if (bflag) {
+    bigint nbonus = 0;
+    if (flag == ELLIPSOID) nbonus = atom->nellipsoids;
+    if (flag == LINE) nbonus = atom->nlines;
+    if (flag == TRIANGLE) nbonus = atom->ntris;
+    bigint nvalues_all, nvalues_me = nvalues;
+    MPI_Allreduce(&nvalues_me,&nvalues_all,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    if (nbonus) ncol = static_cast<int>(nvalues_all / nbonus);
+    if (ncol) binary_section(nvalues / ncol,"i" + std::string(ncol-1,'f'));
+    else binary_section(0,"");
+  }
+
+  if (me == 0) {
+    MPI_Status status;
+    MPI_Request request;
+    bigint first = 0;
 
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
@@ -763,7 +831,12 @@ void WriteData::bonus(int flag)
         MPI_Get_count(&status,MPI_DOUBLE,&nvalues);
       }
 
-      atom->avec->write_data_bonus(fp,nvalues,buf,flag);
+      if (bflag) {
+        if (ncol) {
+          binary_rows(first,nvalues/ncol,ncol,buf);
+          first += nvalues/ncol;
+        }
+      } else atom->avec->write_data_bonus(fp,nvalues,buf,flag);
     }
 
   } else {
@@ -774,6 +847,102 @@ void WriteData::bonus(int flag)
   memory->destroy(buf);
 }
 
+/* ----------------------------------------------------------------------
+   proc 0 writes header of binary data file
+   byte offset of text part is filled in by binary_close()
+------------------------------------------------------------------------- */
+
+void WriteData::binary_open()
+{
+  fwrite(DATA_MAGIC_STRING,sizeof(char),strlen(DATA_MAGIC_STRING),fpbin);
+  int endian = DATA_ENDIAN;
+  fwrite(&endian,sizeof(int),1,fpbin);
+  int revision = DATA_FORMAT_REVISION;
+  fwrite(&revision,sizeof(int),1,fpbin);
+  int64_t textoffset = 0;
+  fwrite(&textoffset,sizeof(int64_t),1,fpbin);
+  binoffset = platform::ftell(fpbin);
+}
+
+/* ----------------------------------------------------------------------
+   start a section of binary data file stored as columns
+   called by all procs, nmine = # of rows from this proc
+   kinds = one char per column, 'i' = integer, 'f' = floating point
+   proc 0 writes 1-line descriptor of section to text part
+------------------------------------------------------------------------- */
+
+void WriteData::binary_section(bigint nmine, const std::string &kinds)
+{
+  MPI_Allreduce(&nmine,&sectionrows,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  if (me == 0) {
+    sectionoffset = binoffset;
+    fmt::print(fp,"{} {} {}\n",sectionrows,sectionoffset,kinds);
+    binoffset += sectionrows * kinds.size() * sizeof(double);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes N rows of ncol values, starting at row first of section
+   each value is stored in its column, integer values are in ubuf format
+------------------------------------------------------------------------- */
+
+void WriteData::binary_rows(bigint first, int n, int ncol, double *rows)
+{
+  if (n == 0) return;
+
+  std::vector<double> column(n);
+  for (int k = 0; k < ncol; k++) {
+    for (int i = 0; i < n; i++) column[i] = rows[(bigint) i*ncol + k];
+    platform::fseek(fpbin,sectionoffset + ((bigint) k*sectionrows + first)*sizeof(double));
+    fwrite(column.data(),sizeof(double),n,fpbin);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes N bonds, angles, dihedrals, or impropers as rows
+   same values as in text data file, index followed by ncol values of buf
+------------------------------------------------------------------------- */
+
+void WriteData::binary_topology(int n, int ncol, tagint **buf, int index)
+{
+  std::vector<double> rows((bigint) n*(ncol+1));
+
+  bigint m = 0;
+  for (int i = 0; i < n; i++) {
+    rows[m++] = ubuf(index+i).d;
+    for (int k = 0; k < ncol; k++) rows[m++] = ubuf(buf[i][k]).d;
+  }
+
+  binary_rows(index-1,n,ncol+1,rows.data());
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 appends text part of binary data file to the column data
+   and stores its byte offset in the file header
+------------------------------------------------------------------------- */
+
+void WriteData::binary_close()
+{
+  bigint textoffset = binoffset;
+  platform::fseek(fpbin,textoffset);
+
+  char copybuf[BUFSIZ];
+  size_t n;
+  rewind(fp);
+  while ((n = fread(copybuf,sizeof(char),BUFSIZ,fp)) > 0)
+    fwrite(copybuf,sizeof(char),n,fpbin);
+  fclose(fp);
+
+  int64_t offset = textoffset;
+  platform::fseek(fpbin,strlen(DATA_MAGIC_STRING) + 2*sizeof(int));
+  fwrite(&offset,sizeof(int64_t),1,fpbin);
+
+  if (ferror(fpbin))
+    error->one(FLERR,"Error writing binary data file: {}", utils::getsyserror());
+  fclose(fpbin);
+}
+
 /* ----------------------------------------------------------------------
    write out Mth section of data file owned by Fix ifix
 ------------------------------------------------------------------------- */
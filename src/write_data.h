@@ -37,7 +37,12 @@ class WriteData : public Command {
   int fixflag;
   int triclinic_general;
   int lmapflag;
+  int binary;    // 1 if writing binary data file
   FILE *fp;
+  FILE *fpbin;    // binary data file, fp is then its text part
+  bigint binoffset;        // byte offset of next section of column data
+  bigint sectionoffset;    // byte offset of current section
+  bigint sectionrows;      // # of rows of current section
   bigint nbonds_local, nbonds;
   bigint nangles_local, nangles;
   bigint ndihedrals_local, ndihedrals;
@@ -54,6 +59,12 @@ class WriteData : public Command {
   void impropers();
   void bonus(int);
   void fix(class Fix *, int);
+
+  void binary_open();
+  void binary_section(bigint, const std::string &);
+  void binary_rows(bigint, int, int, double *);
+  void binary_topology(int, int, tagint **, int);
+  void binary_close();
 };
 
 }    // namespace LAMMPS_NS
@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+
+# Script:  pair_precision.py
+# Purpose: report the accuracy of mixed precision pair styles
+#          compare energy, pressure, and per-atom forces computed with
+#          "pair_modify precision mixed" to "pair_modify precision double"
+# Syntax:  pair_precision.py in.lammps [-f Nframes] [-e Nevery]
+#          in.lammps = LAMMPS input that sets up the system and pair style
+#          Nframes = # of configurations to compare (default 1)
+#          Nevery = # of double precision MD steps between configurations
+#                   (default 100)
+# Note:    requires the LAMMPS Python module, may be run in parallel with mpi4py
+
+from __future__ import print_function
+
+import sys,argparse,math
+from lammps import lammps
+
+parser = argparse.ArgumentParser()
+parser.add_argument('infile', help='LAMMPS input setting up the system')
+parser.add_argument('-f', '--frames', type=int, default=1,
+                    help='number of configurations to compare')
+parser.add_argument('-e', '--every', type=int, default=100,
+                    help='MD steps between configurations')
+args = parser.parse_args()
+
+lmp = lammps(cmdargs=['-screen','none','-log','none'])
+lmp.file(args.infile)
+if lmp.get_natoms() == 0:
+  sys.exit("Input did not define any atoms")
+me = lmp.extract_setting("world_rank")
+
+def evaluate(precision):
+  lmp.command("pair_modify precision %s" % precision)
+  lmp.command("run 0 post no")
+  natoms = lmp.get_natoms()
+  ids = lmp.gather_atoms_concat("id",0,1)
+  f = lmp.gather_atoms_concat("f",1,3)
+  order = sorted(range(natoms),key=lambda i: ids[i])
+  forces = [f[3*i+k] for i in order for k in range(3)]
+  return lmp.get_thermo("pe"),lmp.get_thermo("press"),forces
+
+def relerr(a,b):
+  return abs(a-b)/abs(b) if b != 0.0 else abs(a-b)
+
+if me == 0:
+  print("%6s %12s %12s %12s %12s %12s" %
+        ("frame","pe relerr","press relerr","f maxerr","f rmserr","f rms relerr"))
+
+worst = 0.0
+for frame in range(args.frames):
+  if frame: lmp.command("run %d post no" % args.every)
+  pe_d,press_d,f_d = evaluate("double")
+  pe_m,press_m,f_m = evaluate("mixed")
+
+  maxerr = sumerr = sumf = 0.0
+  for fd,fm in zip(f_d,f_m):
+    maxerr = max(maxerr,abs(fm-fd))
+    sumerr += (fm-fd)*(fm-fd)
+    sumf += fd*fd
+  n = max(1,len(f_d))
+  rmserr = math.sqrt(sumerr/n)
+  rmsrel = rmserr/math.sqrt(sumf/n) if sumf > 0.0 else rmserr
+  worst = max(worst,rmsrel)
+
+  if me == 0:
+    print("%6d %12.4e %12.4e %12.4e %12.4e %12.4e" %
+          (frame,relerr(pe_m,pe_d),relerr(press_m,press_d),maxerr,rmserr,rmsrel))
+
+# leave the style in double precision for whatever follows
+
+lmp.command("pair_modify precision double")
+if me == 0: print("largest relative RMS force error: %.4e" % worst)
+lmp.close()
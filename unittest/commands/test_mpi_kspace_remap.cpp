@@ -0,0 +1,123 @@
+// unit tests for the parallel FFT remap options of PPPM with MPI
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "force.h"
+#include "info.h"
+#include "input.h"
+#include "kspace.h"
+#include "lammps.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+namespace LAMMPS_NS {
+
+// kspace energy and total forces on all atoms indexed by atom ID
+
+struct KSpaceResult {
+    double energy;
+    std::vector<double> f;
+};
+
+class MPIKSpaceRemapTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // set up the fourmol system with coul/long and PPPM and compute forces once
+
+    KSpaceResult run_pppm(const std::string &modify)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("variable input_dir index \"" STRINGIFY(TEST_INPUT_FOLDER) "\"");
+        command("variable pair_style index 'coul/long 8.0'");
+        command("include \"${input_dir}/in.fourmol\"");
+        command("variable input_dir delete");
+        command("variable pair_style delete");
+        command("pair_coeff * *");
+        command("kspace_style pppm 1.0e-5");
+        command("kspace_modify gewald 0.3 mesh 12 15 18 " + modify);
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        Atom *atom = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> f(3 * (natoms + 1), 0.0);
+        for (int i = 0; i < atom->nlocal; i++)
+            for (int k = 0; k < 3; k++)
+                f[3 * atom->tag[i] + k] = atom->f[i][k];
+
+        KSpaceResult result;
+        result.energy = lmp->force->kspace->energy;
+        result.f.resize(f.size());
+        MPI_Allreduce(f.data(), result.f.data(), f.size(), MPI_DOUBLE, MPI_SUM, lmp->world);
+        return result;
+    }
+};
+
+// collective and node-aware remaps and different FFT proc grids must reproduce
+// the results of point-to-point remaps, the single precision remap only approximately
+
+TEST_F(MPIKSpaceRemapTest, remap_options)
+{
+    if (!Info(lmp).has_style("kspace", "pppm")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+
+    KSpaceResult ref = run_pppm("collective no");
+    ASSERT_NE(ref.energy, 0.0);
+
+    const std::vector<std::pair<std::string, double>> cases = {
+        {"collective yes", 1.0e-12},
+        {"collective node", 1.0e-12},
+        {"fft/grid 4 1", 1.0e-12},
+        {"collective node fft/grid 1 4", 1.0e-12},
+        {"collective no remap/compress yes", 1.0e-5},
+        {"collective node remap/compress yes", 1.0e-5},
+        {"collective node fft/grid 4 1 remap/compress yes", 1.0e-5}};
+
+    double fmax = 0.0;
+    for (const auto &f : ref.f) fmax = std::max(fmax, std::fabs(f));
+    ASSERT_GT(fmax, 0.0);
+
+    for (const auto &c : cases) {
+        SCOPED_TRACE("kspace_modify " + c.first);
+        KSpaceResult res = run_pppm(c.first);
+        EXPECT_NEAR(res.energy, ref.energy, c.second * std::fabs(ref.energy));
+        ASSERT_EQ(res.f.size(), ref.f.size());
+        for (std::size_t i = 0; i < ref.f.size(); i++)
+            EXPECT_NEAR(res.f[i], ref.f[i], c.second * fmax);
+    }
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,207 @@
+// unit tests for reading data files in parallel with MPI
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+namespace LAMMPS_NS {
+
+// per-atom data indexed by atom ID and sorted topology lists of the whole system
+
+struct SystemData {
+    std::vector<int> owner, type;
+    std::vector<tagint> molecule;
+    std::vector<double> q;
+    std::vector<std::array<double, 3>> x, v;
+    std::vector<std::array<tagint, 5>> bonds, angles, dihedrals, impropers;
+};
+
+class MPIReadDataTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void read_fourmol(const std::string &parallel)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("variable input_dir index \"" STRINGIFY(TEST_INPUT_FOLDER) "\"");
+        command("variable data_file index \"" STRINGIFY(TEST_INPUT_FOLDER) "/data.fourmol "
+                "parallel " + parallel + "\"");
+        command("include \"${input_dir}/in.fourmol\"");
+        command("variable input_dir delete");
+        command("variable data_file delete");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // collect topology entries of all procs as (type, atom IDs) tuples
+
+    static void gather_topology(std::vector<std::array<tagint, 5>> &list, MPI_Comm world)
+    {
+        int me, nprocs;
+        MPI_Comm_rank(world, &me);
+        MPI_Comm_size(world, &nprocs);
+
+        int nmine = list.size() * 5;
+        std::vector<int> counts(nprocs), displs(nprocs);
+        MPI_Allgather(&nmine, 1, MPI_INT, counts.data(), 1, MPI_INT, world);
+        int ntotal = 0;
+        for (int i = 0; i < nprocs; i++) {
+            displs[i] = ntotal;
+            ntotal += counts[i];
+        }
+
+        std::vector<std::array<tagint, 5>> all(ntotal / 5);
+        MPI_Allgatherv(list.data(), nmine, MPI_LMP_TAGINT, all.data(), counts.data(),
+                       displs.data(), MPI_LMP_TAGINT, world);
+        std::sort(all.begin(), all.end());
+        list = all;
+    }
+
+    SystemData gather_system()
+    {
+        Atom *atom = lmp->atom;
+        MPI_Comm world = lmp->world;
+        const int natoms = atom->natoms;
+        const int nlocal = atom->nlocal;
+        SystemData data;
+
+        std::vector<int> owner(natoms + 1, 0), type(natoms + 1, 0);
+        std::vector<tagint> molecule(natoms + 1, 0);
+        std::vector<double> q(natoms + 1, 0.0), x(3 * (natoms + 1), 0.0),
+            v(3 * (natoms + 1), 0.0);
+
+        for (int i = 0; i < nlocal; i++) {
+            const tagint tag = atom->tag[i];
+            owner[tag] = lmp->comm->me + 1;
+            type[tag] = atom->type[i];
+            molecule[tag] = atom->molecule[i];
+            q[tag] = atom->q[i];
+            for (int k = 0; k < 3; k++) {
+                x[3 * tag + k] = atom->x[i][k];
+                v[3 * tag + k] = atom->v[i][k];
+            }
+
+            for (int m = 0; m < atom->num_bond[i]; m++)
+                data.bonds.push_back({atom->bond_type[i][m], tag, atom->bond_atom[i][m], 0, 0});
+            for (int m = 0; m < atom->num_angle[i]; m++)
+                data.angles.push_back({atom->angle_type[i][m], atom->angle_atom1[i][m],
+                                       atom->angle_atom2[i][m], atom->angle_atom3[i][m], 0});
+            for (int m = 0; m < atom->num_dihedral[i]; m++)
+                data.dihedrals.push_back({atom->dihedral_type[i][m], atom->dihedral_atom1[i][m],
+                                          atom->dihedral_atom2[i][m], atom->dihedral_atom3[i][m],
+                                          atom->dihedral_atom4[i][m]});
+            for (int m = 0; m < atom->num_improper[i]; m++)
+                data.impropers.push_back({atom->improper_type[i][m], atom->improper_atom1[i][m],
+                                          atom->improper_atom2[i][m], atom->improper_atom3[i][m],
+                                          atom->improper_atom4[i][m]});
+        }
+
+        data.owner.resize(natoms + 1);
+        data.type.resize(natoms + 1);
+        data.molecule.resize(natoms + 1);
+        data.q.resize(natoms + 1);
+        MPI_Allreduce(owner.data(), data.owner.data(), natoms + 1, MPI_INT, MPI_SUM, world);
+        MPI_Allreduce(type.data(), data.type.data(), natoms + 1, MPI_INT, MPI_SUM, world);
+        MPI_Allreduce(molecule.data(), data.molecule.data(), natoms + 1, MPI_LMP_TAGINT, MPI_SUM,
+                      world);
+        MPI_Allreduce(q.data(), data.q.data(), natoms + 1, MPI_DOUBLE, MPI_SUM, world);
+
+        std::vector<double> sum(3 * (natoms + 1));
+        MPI_Allreduce(x.data(), sum.data(), 3 * (natoms + 1), MPI_DOUBLE, MPI_SUM, world);
+        for (int i = 0; i <= natoms; i++)
+            data.x.push_back({sum[3 * i], sum[3 * i + 1], sum[3 * i + 2]});
+        MPI_Allreduce(v.data(), sum.data(), 3 * (natoms + 1), MPI_DOUBLE, MPI_SUM, world);
+        for (int i = 0; i <= natoms; i++)
+            data.v.push_back({sum[3 * i], sum[3 * i + 1], sum[3 * i + 2]});
+
+        gather_topology(data.bonds, world);
+        gather_topology(data.angles, world);
+        gather_topology(data.dihedrals, world);
+        gather_topology(data.impropers, world);
+        return data;
+    }
+};
+
+TEST_F(MPIReadDataTest, parallel_matches_serial)
+{
+    if (!Info(lmp).has_style("atom", "full")) GTEST_SKIP();
+    ASSERT_GT(lmp->comm->nprocs, 1);
+
+    read_fourmol("no");
+    ASSERT_EQ(lmp->atom->natoms, 29);
+    SystemData serial = gather_system();
+    ASSERT_EQ(serial.bonds.size(), 24U);
+    ASSERT_EQ(serial.angles.size(), 30U);
+    ASSERT_EQ(serial.dihedrals.size(), 31U);
+    ASSERT_EQ(serial.impropers.size(), 2U);
+
+    read_fourmol("yes");
+    ASSERT_EQ(lmp->atom->natoms, 29);
+    ASSERT_EQ(lmp->atom->nbonds, 24);
+    ASSERT_EQ(lmp->atom->nangles, 30);
+    ASSERT_EQ(lmp->atom->ndihedrals, 31);
+    ASSERT_EQ(lmp->atom->nimpropers, 2);
+    SystemData parallel = gather_system();
+
+    // every atom is owned by exactly one proc, the same one as with serial reading
+
+    for (int i = 1; i <= 29; i++) {
+        ASSERT_GT(parallel.owner[i], 0);
+        ASSERT_EQ(parallel.owner[i], serial.owner[i]);
+        ASSERT_EQ(parallel.type[i], serial.type[i]);
+        ASSERT_EQ(parallel.molecule[i], serial.molecule[i]);
+        ASSERT_DOUBLE_EQ(parallel.q[i], serial.q[i]);
+        for (int k = 0; k < 3; k++) {
+            ASSERT_DOUBLE_EQ(parallel.x[i][k], serial.x[i][k]);
+            ASSERT_DOUBLE_EQ(parallel.v[i][k], serial.v[i][k]);
+        }
+    }
+
+    // at least one atom has a non-zero velocity from the Velocities section
+
+    bool moving = false;
+    for (int i = 1; i <= 29; i++)
+        if (serial.v[i][0] != 0.0) moving = true;
+    ASSERT_TRUE(moving);
+
+    ASSERT_EQ(parallel.bonds, serial.bonds);
+    ASSERT_EQ(parallel.angles, serial.angles);
+    ASSERT_EQ(parallel.dihedrals, serial.dihedrals);
+    ASSERT_EQ(parallel.impropers, serial.impropers);
+}
+} // namespace LAMMPS_NS
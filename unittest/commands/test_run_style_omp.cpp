@@ -0,0 +1,172 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "atom.h"
+#include "info.h"
+#include "lammps.h"
+#include "library.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+using ::testing::ContainsRegex;
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+// energies after a short run and positions and forces indexed by atom ID
+
+struct RunResult {
+    double pe, ecoul, elong;
+    std::vector<double> x, f;
+};
+
+class RunStyleOMPTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "RunStyleOMPTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // fourmol with coulomb, PPPM and bonded forces on 4 OpenMP threads
+
+    void init_fourmol()
+    {
+        command("clear");
+        command("package omp 4");
+        command("variable input_dir index \"" STRINGIFY(TEST_INPUT_FOLDER) "\"");
+        command("include \"${input_dir}/in.fourmol\"");
+        command("pair_style lj/cut/coul/long/omp 8.0");
+        command("pair_coeff * * 0.02 2.5");
+        command("bond_style harmonic/omp");
+        command("bond_coeff * 250.0 1.5");
+        command("angle_style harmonic/omp");
+        command("angle_coeff * 50.0 110.0");
+        command("kspace_style pppm/omp 1.0e-5");
+        command("velocity all create 100.0 4928459 loop geom");
+        command("fix 1 all nve");
+        command("compute pe all pe");
+        command("thermo_style custom step c_pe ecoul elong");
+    }
+
+    RunResult run_fourmol(const std::string &run_style)
+    {
+        BEGIN_HIDE_OUTPUT();
+        init_fourmol();
+        command("run_style " + run_style);
+        command("run 20 post no");
+        END_HIDE_OUTPUT();
+
+        RunResult result;
+        result.pe    = lammps_get_thermo(lmp, "c_pe");
+        result.ecoul = lammps_get_thermo(lmp, "ecoul");
+        result.elong = lammps_get_thermo(lmp, "elong");
+
+        Atom *atom = lmp->atom;
+        result.x.resize(3 * (atom->natoms + 1), 0.0);
+        result.f.resize(3 * (atom->natoms + 1), 0.0);
+        for (int i = 0; i < atom->nlocal; i++) {
+            for (int k = 0; k < 3; k++) {
+                result.x[3 * atom->tag[i] + k] = atom->x[i][k];
+                result.f[3 * atom->tag[i] + k] = atom->f[i][k];
+            }
+        }
+        return result;
+    }
+};
+
+// concurrent kspace only changes the order of summation of forces
+
+TEST_F(RunStyleOMPTest, VerletKSpaceOMP)
+{
+    if (!info->has_style("integrate", "verlet/kspace/omp")) GTEST_SKIP();
+    if (!info->has_style("atom", "full")) GTEST_SKIP();
+
+    RunResult ref = run_fourmol("verlet");
+    ASSERT_NE(ref.elong, 0.0);
+
+    for (const auto &nk : {"1", "3"}) {
+        SCOPED_TRACE(std::string("run_style verlet/kspace/omp ") + nk);
+        RunResult res = run_fourmol(std::string("verlet/kspace/omp ") + nk);
+
+        EXPECT_NEAR(res.pe, ref.pe, 1.0e-10 * std::fabs(ref.pe));
+        EXPECT_NEAR(res.ecoul, ref.ecoul, 1.0e-10 * std::fabs(ref.ecoul));
+        EXPECT_NEAR(res.elong, ref.elong, 1.0e-10 * std::fabs(ref.elong));
+
+        double fmax = 0.0;
+        for (const auto &f : ref.f)
+            fmax = std::max(fmax, std::fabs(f));
+        for (std::size_t i = 0; i < ref.f.size(); i++) {
+            EXPECT_NEAR(res.x[i], ref.x[i], 1.0e-10);
+            EXPECT_NEAR(res.f[i], ref.f[i], 1.0e-10 * fmax);
+        }
+    }
+}
+
+TEST_F(RunStyleOMPTest, VerletKSpaceOMPErrors)
+{
+    if (!info->has_style("integrate", "verlet/kspace/omp")) GTEST_SKIP();
+    if (!info->has_style("atom", "full")) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    init_fourmol();
+    command("run_style verlet/kspace/omp 4");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Run style verlet/kspace/omp uses 4 kspace threads, but only 4 .*",
+                 command("run 0 post no"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("run_style verlet/kspace/omp 2");
+    command("kspace_style pppm 1.0e-5");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Run style verlet/kspace/omp requires kspace style pppm/omp.*",
+                 command("run 0 post no"););
+
+    TEST_FAILURE(".*ERROR: Illegal run_style verlet/kspace/omp thread count 0.*",
+                 command("run_style verlet/kspace/omp 0"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -18,6 +18,7 @@
 #include "force.h"
 #include "info.h"
 #include "input.h"
+#include "neighbor.h"
 #include "output.h"
 #include "update.h"
 #include "utils.h"
@@ -125,6 +126,42 @@ TEST_F(SimpleCommandsTest, Log)
     TEST_FAILURE(".*ERROR: Illegal log command.*", command("log"););
 }
 
+TEST_F(SimpleCommandsTest, NeighModifyTune)
+{
+    // trial skins are above the user skin, unless a per-grid fix is defined
+    auto setup = [&]() {
+        command("clear");
+        command("units lj");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 1 delay 0 check yes tune yes tune/window 5 "
+                "tune/range 1.2 2.0");
+        command("fix 1 all nve");
+    };
+
+    BEGIN_CAPTURE_OUTPUT();
+    setup();
+    command("run 300 post no");
+    auto text = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(text, ContainsRegex(".*selected skin = .*"));
+    ASSERT_GT(lmp->neighbor->skin, 0.3);
+
+    BEGIN_CAPTURE_OUTPUT();
+    setup();
+    command("fix 2 all ave/grid 10 1 10 4 4 4 vx");
+    command("run 300 post no");
+    text = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(text, ContainsRegex(".*selected skin = .*"));
+    ASSERT_LE(lmp->neighbor->skin, 0.3);
+}
+
 TEST_F(SimpleCommandsTest, Newton)
 {
     // default setting is "on" for both
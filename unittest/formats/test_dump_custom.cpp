@@ -57,7 +57,7 @@ public:
                        const std::string &dump_modify_options, int ntimesteps)
     {
         BEGIN_HIDE_OUTPUT();
-        command(fmt::format("dump id all {} 1 {} {}", dump_style, dump_file, fields));
+        command(fmt::format("dump id all custom 1 {} {}", dump_file, fields));
 
         if (!dump_modify_options.empty()) {
             command(fmt::format("dump_modify id {}", dump_modify_options));
@@ -326,6 +326,94 @@ TEST_F(DumpCustomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpCustomTest, async_run2)
+{
+    auto dump_file      = dump_filename("async_run2");
+    auto sync_dump_file = dump_filename("sync_run2");
+    const auto *fields  = "id type x y z vx vy vz";
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all custom 1 {} {}", sync_dump_file, fields));
+    command(fmt::format("dump id all custom 1 {} {}", dump_file, fields));
+    command("dump_modify id async yes buffer no");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 123);
+    ASSERT_TRUE(equal_lines(dump_file, sync_dump_file));
+    continue_dump(1);
+    ASSERT_EQ(count_lines(dump_file), 164);
+    ASSERT_TRUE(equal_lines(dump_file, sync_dump_file));
+    close_dump();
+    delete_file(dump_file);
+    delete_file(sync_dump_file);
+}
+
+TEST_F(DumpCustomTest, async_every3_run4)
+{
+    auto dump_file      = dump_filename("async_every3_run4");
+    auto sync_dump_file = dump_filename("sync_every3_run4");
+    const auto *fields  = "id type x y z vx vy vz";
+
+    // last snapshot is not on the last step, must still be complete after the run
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all custom 3 {} {}", sync_dump_file, fields));
+    command(fmt::format("dump id all custom 3 {} {}", dump_file, fields));
+    command("dump_modify id0 flush yes");
+    command("dump_modify id async yes buffer no flush yes");
+    command("run 4 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 82);
+    ASSERT_TRUE(equal_lines(dump_file, sync_dump_file));
+    close_dump();
+    delete_file(dump_file);
+    delete_file(sync_dump_file);
+}
+
+TEST_F(DumpCustomTest, format_line_mixed)
+{
+    auto dump_file     = dump_filename("format_line_mixed");
+    auto ref_file      = dump_filename("format_line_ref");
+    const auto *fields = "id type x y z";
+
+    // formats with and without fmtlib equivalent must both match printf()
+
+    const char *format[] = {"%5d|", "%-3d", "%#.3g", "{%-12.3e}", "%+09.4f"};
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all custom 1 {} {}", ref_file, fields));
+    command("dump_modify id0 format line \"%d %d %.17g %.17g %.17g\"");
+    command(fmt::format("dump id all custom 1 {} {}", dump_file, fields));
+    command(fmt::format("dump_modify id format line \"{} {} {} {} {}\"", format[0], format[1],
+                        format[2], format[3], format[4]));
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+
+    auto lines = read_lines(dump_file);
+    auto ref   = read_lines(ref_file);
+    ASSERT_EQ(lines.size(), 41);
+    ASSERT_EQ(ref.size(), 41);
+    char buf[256];
+    for (int i = 9; i < 41; ++i) {
+        auto values = utils::split_words(ref[i]);
+        std::string expected;
+        for (int j = 0; j < 5; ++j) {
+            if (j < 2)
+                snprintf(buf, sizeof(buf), format[j], std::stoi(values[j]));
+            else
+                snprintf(buf, sizeof(buf), format[j], std::stod(values[j]));
+            expected += buf;
+            if (j < 4) expected += " ";
+        }
+        ASSERT_THAT(lines[i], Eq(expected));
+    }
+    delete_file(dump_file);
+    delete_file(ref_file);
+}
+
 TEST_F(DumpCustomTest, rerun)
 {
     auto dump_file     = dump_filename("rerun");
@@ -12,8 +12,10 @@
 ------------------------------------------------------------------------- */
 
 #include "../testing/utils.h"
+#include "atom.h"
 #include "compressed_dump_test.h"
 #include "fmt/format.h"
+#include "update.h"
 #include "utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -120,6 +122,91 @@ TEST_F(DumpCustomCompressTest, compressed_no_buffer_run1)
     delete_file(converted_file);
 }
 
+TEST_F(DumpCustomCompressTest, compressed_async_multi_file_run1)
+{
+    if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
+
+    const auto *base_name   = "async_multi_file_run1_*.melt.custom";
+    const auto *base_name_0 = "async_multi_file_run1_0.melt.custom";
+    const auto *base_name_1 = "async_multi_file_run1_1.melt.custom";
+    auto text_file          = text_dump_filename(base_name);
+    auto text_file_0        = text_dump_filename(base_name_0);
+    auto text_file_1        = text_dump_filename(base_name_1);
+    auto compressed_file    = compressed_dump_filename(base_name);
+    auto compressed_file_0  = compressed_dump_filename(base_name_0);
+    auto compressed_file_1  = compressed_dump_filename(base_name_1);
+    const auto *fields      = "id type proc x y z vx vy vz fx fy fz";
+
+    generate_text_and_compressed_dump(text_file, compressed_file, fields, fields, "",
+                                      "async yes buffer no", 1);
+
+    TearDown();
+
+    auto converted_file_0 = convert_compressed_to_text(compressed_file_0);
+    auto converted_file_1 = convert_compressed_to_text(compressed_file_1);
+
+    ASSERT_FILE_EXISTS(converted_file_0);
+    ASSERT_FILE_EXISTS(converted_file_1);
+    ASSERT_FILE_EQUAL(text_file_0, converted_file_0);
+    ASSERT_FILE_EQUAL(text_file_1, converted_file_1);
+
+    delete_file(text_file_0);
+    delete_file(text_file_1);
+    delete_file(compressed_file_0);
+    delete_file(compressed_file_1);
+    delete_file(converted_file_0);
+    delete_file(converted_file_1);
+}
+
+TEST_F(DumpCustomCompressTest, compressed_seekable_run2)
+{
+    if (!COMPRESS_EXECUTABLE || (compression_style != "custom/zstd")) GTEST_SKIP();
+
+    const auto *base_name = "seekable_run2.melt.custom";
+    auto text_file        = text_dump_filename(base_name);
+    auto compressed_file  = compressed_dump_filename(base_name);
+    const auto *fields    = "id type x y z vx vy vz";
+
+    generate_text_and_compressed_dump(text_file, compressed_file, fields, fields, "",
+                                      "seekable yes", 2);
+
+    // the index is appended when the file is closed
+
+    BEGIN_HIDE_OUTPUT();
+    command("undump id0");
+    command("undump id1");
+    END_HIDE_OUTPUT();
+
+    auto converted_file = convert_compressed_to_text(compressed_file);
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+
+    // read snapshots out of order via the index and compare with text file
+
+    const int nlocal = lmp->atom->nlocal;
+    for (int step : {2, 0, 1}) {
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("read_dump {} {} x y z vx vy vz box no", text_file, step));
+        END_HIDE_OUTPUT();
+        std::vector<double> xref(&lmp->atom->x[0][0], &lmp->atom->x[0][0] + 3 * nlocal);
+        std::vector<double> vref(&lmp->atom->v[0][0], &lmp->atom->v[0][0] + 3 * nlocal);
+
+        BEGIN_HIDE_OUTPUT();
+        command("run 1 post no");
+        command(fmt::format("read_dump {} {} x y z vx vy vz box no", compressed_file, step));
+        END_HIDE_OUTPUT();
+        ASSERT_EQ(lmp->update->ntimestep, step);
+        for (int i = 0; i < 3 * nlocal; ++i) {
+            ASSERT_DOUBLE_EQ((&lmp->atom->x[0][0])[i], xref[i]);
+            ASSERT_DOUBLE_EQ((&lmp->atom->v[0][0])[i], vref[i]);
+        }
+    }
+
+    delete_file(text_file);
+    delete_file(compressed_file);
+    delete_file(converted_file);
+}
+
 TEST_F(DumpCustomCompressTest, compressed_triclinic_run1)
 {
     if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
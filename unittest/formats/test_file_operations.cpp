@@ -457,6 +457,8 @@ TEST_F(FileOperationsTest, write_data)
                  command("read_data noexist.data"););
     TEST_FAILURE(".*ERROR: Unknown read_data keyword xxx.*",
                  command("read_data noexist.data xxx"););
+    TEST_FAILURE(".*ERROR: Illegal read_data parallel command: missing argument.*",
+                 command("read_data noexist.data parallel"););
 
     BEGIN_HIDE_OUTPUT();
     command("pair_style zero 1.0");
@@ -478,8 +480,33 @@ TEST_F(FileOperationsTest, write_data)
     END_HIDE_OUTPUT();
     ASSERT_EQ(lmp->atom->natoms, 1);
     ASSERT_EQ(lmp->domain->triclinic, 1);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data triclinic.data parallel yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->domain->triclinic, 1);
+
+    // binary data file round trip must reproduce the text data file
+
+    BEGIN_HIDE_OUTPUT();
+    command("velocity all set 0.1 -0.2 0.3");
+    command("write_data text.data");
+    command("write_data triclinic.bin");
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data triclinic.bin");
+    command("write_data binary.data");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->domain->triclinic, 1);
+    ASSERT_TRUE(equal_lines("text.data", "binary.data"));
 
     // clean up
+    delete_file("text.data");
+    delete_file("binary.data");
+    delete_file("triclinic.bin");
     delete_file("charge.data");
     delete_file("nocoeff.data");
     delete_file("noinit.data");
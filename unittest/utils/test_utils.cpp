@@ -97,6 +97,50 @@ TEST(Utils, star_subst)
     ASSERT_THAT(subst, StrEq("1234after"));
 }
 
+TEST(Utils, printf_to_fmt)
+{
+    ASSERT_THAT(utils::printf_to_fmt("%d", "di"), StrEq("{:>d}"));
+    ASSERT_THAT(utils::printf_to_fmt("%-8i ", "di"), StrEq("{:<8d} "));
+    ASSERT_THAT(utils::printf_to_fmt("%ld", "di"), StrEq("{:>d}"));
+    ASSERT_THAT(utils::printf_to_fmt("%+010.4f", "eEfFgG"), StrEq("{:+010.4f}"));
+    ASSERT_THAT(utils::printf_to_fmt("%-0 12.e", "eEfFgG"), StrEq("{:< 12.0e}"));
+    ASSERT_THAT(utils::printf_to_fmt("{%s}%%", "s"), StrEq("{{{:>s}}}%"));
+    ASSERT_THAT(utils::printf_to_fmt("%g", "di"), StrEq(""));
+    ASSERT_THAT(utils::printf_to_fmt("%.3d", "di"), StrEq(""));
+    ASSERT_THAT(utils::printf_to_fmt("%#g", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf_to_fmt("%*g", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf_to_fmt("%g %g", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf_to_fmt("none", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf_to_fmt("%", "eEfFgG"), StrEq(""));
+
+    // translated formats must produce the same text as printf()
+
+    char buf[256];
+    for (const char *format : {"%g", "%20.15g", "%-14.8e", "%+.3E", "% f", "%012.4f", "%.0g",
+                               "%-+10.2F", "%G", "%.12g"}) {
+        auto newformat = utils::printf_to_fmt(format, "eEfFgG");
+        for (double value : {0.0, -0.0, 1.0, -2.5, 0.125, 1.0e-5, 123456789.0, 3.0e100,
+                             -7.25e-300, 1.0 / 3.0, 0.5, 1.5, 2.5, 1.0e300 * 1.0e300}) {
+            snprintf(buf, sizeof(buf), format, value);
+            ASSERT_THAT(fmt::format(fmt::runtime(newformat), value), StrEq(buf)) << format;
+        }
+    }
+    for (const char *format : {"%d", "%8d", "%-8d", "%+d", "% 05d", "%i"}) {
+        auto newformat = utils::printf_to_fmt(format, "di");
+        for (int value : {0, 1, -1, 42, -12345, 2147483647}) {
+            snprintf(buf, sizeof(buf), format, value);
+            ASSERT_THAT(fmt::format(fmt::runtime(newformat), value), StrEq(buf)) << format;
+        }
+    }
+    for (const char *format : {"%s", "%6s", "%-6s", "%.2s"}) {
+        auto newformat = utils::printf_to_fmt(format, "s");
+        for (const char *value : {"", "C", "Cl", "Ar_long"}) {
+            snprintf(buf, sizeof(buf), format, value);
+            ASSERT_THAT(fmt::format(fmt::runtime(newformat), value), StrEq(buf)) << format;
+        }
+    }
+}
+
 TEST(Utils, has_utf8)
 {
     const char ascii_string[] = " -2";